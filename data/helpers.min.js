@@ -1 +1 @@
-const RELAY_NAMES=["Plants","Grass","Patio Grass","Front Lawn"];function showToast(t,e="error"){let o=document.getElementById("toast-container");o||(o=document.createElement("div"),o.id="toast-container",document.body.appendChild(o));const n=document.createElement("div");n.className=`toast ${e}`,n.textContent=t,o.appendChild(n),setTimeout(()=>{n.classList.add("fade-out"),setTimeout(()=>n.remove(),500)},3e3)}
\ No newline at end of file
+const RELAY_NAMES=["Plants","Grass","Patio Grass","Front Lawn"];function zoneName(t){return RELAY_NAMES[t]||`Zone ${t+1}`}function showToast(t,e="error"){let o=document.getElementById("toast-container");o||(o=document.createElement("div"),o.id="toast-container",document.body.appendChild(o));const n=document.createElement("div");n.className=`toast ${e}`,n.textContent=t,o.appendChild(n),setTimeout(()=>{n.classList.add("fade-out"),setTimeout(()=>n.remove(),500)},3e3)}
\ No newline at end of file
@@ -1 +1 @@
-async function startOTA(){const e=document.getElementById("ota-file"),t=document.querySelector('input[name="update-type"]:checked'),o=document.getElementById("ota-btn"),s=document.getElementById("ota-progress-bar"),n=document.getElementById("ota-percent"),a=document.getElementById("ota-progress-container");if(0===e.files.length)return void showToast("Please select a file first.");const d=e.files[0],l=t.value;if(!confirm(`Are you sure you want to flash this ${l} update? The device will reboot.`))return;o.disabled=!0,o.classList.add("loading"),a.style.display="block";const i=new XMLHttpRequest;i.open("POST","/api/ota?type="+("spiffs"===l?"spiffs":"app"),!0),i.upload.onprogress=e=>{if(e.lengthComputable){const t=Math.round(e.loaded/e.total*100);s.style.width=t+"%",n.textContent=t+"%"}},i.onload=()=>{o.classList.remove("loading"),200===i.status?(showToast("Update successful! Rebooting...","success"),s.style.width="100%",n.textContent="100%",setTimeout(()=>{window.location.href="/"},5e3)):(showToast("Update failed: "+i.responseText),o.disabled=!1)},i.onerror=()=>{showToast("Connection error during update."),o.disabled=!1,o.classList.remove("loading")},i.send(d)}
\ No newline at end of file
+const SHA256_K=[1116352408,1899447441,3049323471,3921009573,961987163,1508970993,2453635748,2870763221,3624381080,310598401,607225278,1426881987,1925078388,2162078206,2614888103,3248222580,3835390401,4022224774,264347078,604807628,770255983,1249150122,1555081692,1996064986,2554220882,2821834349,2952996808,3210313671,3336571891,3584528711,113926993,338241895,666307205,773529912,1294757372,1396182291,1695183700,1986661051,2177026350,2456956037,2730485921,2820302411,3259730800,3345764771,3516065817,3600352804,4094571909,275423344,430227734,506948616,659060556,883997877,958139571,1322822218,1537002063,1747873779,1955562222,2024104815,2227730452,2361852424,2428436474,2756734187,3204031479,3329325298];async function sha256Hex(e){const t=e=>Array.from(e,e=>(e>>>0).toString(16).padStart(8,"0")).join("");if(window.crypto&&crypto.subtle){const n=new DataView(await crypto.subtle.digest("SHA-256",e));return t(Array.from({length:8},(e,t)=>n.getUint32(4*t)))}const n=e.byteLength,o=new Uint8Array(n+72>>6<<6);o.set(new Uint8Array(e)),o[n]=128;const r=new DataView(o.buffer);r.setUint32(o.length-8,Math.floor(n/536870912)),r.setUint32(o.length-4,n<<3>>>0);const s=(e,t)=>e>>>t|e<<32-t,a=[1779033703,3144134277,1013904242,2773480762,1359893119,2600822924,528734635,1541459225],l=new Uint32Array(64);for(let e=0;e<o.length;e+=64){for(let t=0;t<16;t++)l[t]=r.getUint32(e+4*t);for(let e=16;e<64;e++){const t=s(l[e-15],7)^s(l[e-15],18)^l[e-15]>>>3,n=s(l[e-2],17)^s(l[e-2],19)^l[e-2]>>>10;l[e]=l[e-16]+t+l[e-7]+n}let[t,n,c,i,d,h,u,f]=a;for(let e=0;e<64;e++){const o=f+(s(d,6)^s(d,11)^s(d,25))+(d&h^~d&u)+SHA256_K[e]+l[e]|0,r=(s(t,2)^s(t,13)^s(t,22))+(t&n^t&c^n&c)|0;f=u,u=h,h=d,d=i+o|0,i=c,c=n,n=t,t=o+r|0}[t,n,c,i,d,h,u,f].forEach((e,t)=>{a[t]=a[t]+e|0})}return t(a)}async function imageDigest(e,t){if(!t)return sha256Hex(e);if(!window.DecompressionStream)return null;const o=new Blob([e]).stream().pipeThrough(new DecompressionStream("gzip"));return sha256Hex(await new Response(o).arrayBuffer())}async function startOTA(){const e=document.getElementById("ota-file"),t=document.querySelector('input[name="update-type"]:checked'),o=document.getElementById("ota-btn"),s=document.getElementById("ota-progress-bar"),n=document.getElementById("ota-percent"),a=document.getElementById("ota-progress-container");if(0===e.files.length)return void showToast("Please select a file first.");const d=e.files[0],l=t.value;if(!confirm(`Are you sure you want to flash this ${l} update? The device will reboot.`))return;o.disabled=!0,o.classList.add("loading"),a.style.display="block";const r=await d.arrayBuffer(),p=new Uint8Array(r,0,Math.min(2,r.byteLength)),g=31===p[0]&&139===p[1];let c;try{c=await imageDigest(r,g)}catch(e){return showToast("The file is not a valid gzip image."),o.disabled=!1,o.classList.remove("loading"),void(a.style.display="none")}const i=new XMLHttpRequest;i.open("POST","/api/ota?type="+("spiffs"===l?"spiffs":"app"),!0),g&&i.setRequestHeader("Content-Encoding","gzip"),c&&i.setRequestHeader("X-SHA256",c),i.upload.onprogress=e=>{if(e.lengthComputable){const t=Math.round(e.loaded/e.total*100);s.style.width=t+"%",n.textContent=t+"%"}},i.onload=()=>{o.classList.remove("loading"),200===i.status?(showToast("Update successful! Rebooting...","success"),s.style.width="100%",n.textContent="100%",setTimeout(()=>{window.location.href="/"},5e3)):(showToast("Update failed: "+i.responseText),o.disabled=!1)},i.onerror=()=>{showToast("Connection error during update."),o.disabled=!1,o.classList.remove("loading")},i.send(r)}
\ No newline at end of file
@@ -5,6 +5,7 @@ const path = require('path');
 const { minify: minifyHTML } = require('html-minifier-terser');
 const { minify: minifyJS } = require('terser');
 const CleanCSS = require('clean-css');
+const { packAssets } = require('./pack_web');
 
 const WEB_DIR = path.join(__dirname, 'web');
 const OUTPUT_DIR = path.join(__dirname, 'data');
@@ -162,6 +163,11 @@ async function main() {
   log(`  Total minified: ${stats.totalMinified.toLocaleString()} bytes`);
   log(`  Total saved: ${stats.totalSaved.toLocaleString()} bytes (${totalPercent}%)`, 'green');
   log('✅ Minification complete!\n', 'green');
+
+  // Gzip variants and ETag manifest for the web server
+  log('📦 Packing assets...', 'blue');
+  packAssets(log);
+  log('');
 }
 
 // Main execution
@@ -0,0 +1,49 @@
+#!/usr/bin/env node
+
+// Compresses OTA images for upload:
+//  - writes <image>.gz (gzip, level 9) next to every image given, or next
+//    to firmware.bin and spiffs.bin of every build in .pio/build/
+//  - prints the SHA-256 of the uncompressed image, which is what the
+//    device checks X-SHA256 against after inflating the upload.
+
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+const crypto = require('crypto');
+
+const BUILD_DIR = path.join(__dirname, '.pio', 'build');
+
+function defaultImages() {
+  if (!fs.existsSync(BUILD_DIR)) return [];
+  const images = [];
+  for (const env of fs.readdirSync(BUILD_DIR).sort()) {
+    for (const name of ['firmware.bin', 'spiffs.bin']) {
+      const file = path.join(BUILD_DIR, env, name);
+      if (fs.existsSync(file)) images.push(file);
+    }
+  }
+  return images;
+}
+
+function packImage(file, log = console.log) {
+  const image = fs.readFileSync(file);
+  // The device inflates with a 32 KB window, gzip's default
+  const gz = zlib.gzipSync(image, { level: 9, windowBits: 15 });
+  fs.writeFileSync(`${file}.gz`, gz);
+  const sha = crypto.createHash('sha256').update(image).digest('hex');
+  const pct = Math.round(gz.length * 100 / image.length);
+  log(`  🗜  ${path.relative(process.cwd(), file)}: ${image.length} → ${gz.length} bytes (${pct}%)`);
+  log(`     sha256 ${sha}`);
+  return { file: `${file}.gz`, sha256: sha };
+}
+
+module.exports = { packImage };
+
+if (require.main === module) {
+  const images = process.argv.length > 2 ? process.argv.slice(2) : defaultImages();
+  if (images.length === 0) {
+    console.error('No images given and none found in .pio/build/ (run "pio run" and "pio run -t buildfs" first)');
+    process.exit(1);
+  }
+  for (const file of images) packImage(file);
+}
@@ -0,0 +1,114 @@
+#!/usr/bin/env node
+
+// Packs the minified assets in data/ for serving:
+//  - writes a gzip variant (<file>.gz) next to every minified asset
+//  - writes data/etags.txt with one "<file> <hash> <gz>" line per asset,
+//    which the firmware loads once at boot to answer If-None-Match
+//    requests without touching the filesystem.
+//  - writes src/web_assets_data.c, a flash-resident asset table compiled
+//    in when the firmware is built with -D WEB_EMBED_ASSETS=1.
+
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+const crypto = require('crypto');
+
+const DATA_DIR = path.join(__dirname, 'data');
+const MANIFEST = 'etags.txt';
+const ASSET_TABLE = path.join(__dirname, 'src', 'web_assets_data.c');
+
+const MIME_TYPES = {
+  '.html': 'text/html',
+  '.css': 'text/css',
+  '.js': 'application/javascript'
+};
+
+function isPackable(file) {
+  return /\.min\.(html|css|js)$/.test(file);
+}
+
+function cIdent(file) {
+  return 'asset_' + file.replace(/[^A-Za-z0-9]/g, '_');
+}
+
+function cBytes(buf) {
+  const rows = [];
+  for (let i = 0; i < buf.length; i += 16) {
+    const row = Array.from(buf.subarray(i, i + 16), b => '0x' + b.toString(16).padStart(2, '0'));
+    rows.push('    ' + row.join(', ') + ',');
+  }
+  return rows.join('\n');
+}
+
+// Embed the smallest representation of each asset; clients that do not
+// accept gzip fall back to the SPIFFS copy.
+function writeAssetTable(assets) {
+  const out = [];
+  out.push('// Generated by pack_web.js - do not edit.');
+  out.push('#include "web_assets.h"');
+  out.push('');
+  out.push('#if WEB_EMBED_ASSETS');
+  out.push('');
+  for (const a of assets) {
+    out.push(`static const uint8_t ${cIdent(a.file)}[${a.body.length}] = {`);
+    out.push(cBytes(a.body));
+    out.push('};');
+    out.push('');
+  }
+  out.push('const web_asset_t web_assets[] = {');
+  for (const a of assets) {
+    out.push(`    { "${a.uri}", "${a.mime}", "${a.hash}", ${cIdent(a.file)}, sizeof(${cIdent(a.file)}), ${a.gzip} },`);
+  }
+  out.push('};');
+  out.push('');
+  out.push('const size_t web_assets_count = sizeof(web_assets) / sizeof(web_assets[0]);');
+  out.push('');
+  out.push('#endif');
+  fs.writeFileSync(ASSET_TABLE, out.join('\n') + '\n', 'utf-8');
+}
+
+function packAssets(log = console.log) {
+  const files = fs.readdirSync(DATA_DIR).filter(isPackable).sort();
+  const lines = [];
+  const assets = [];
+  const totals = { raw: 0, gz: 0 };
+
+  for (const file of files) {
+    const content = fs.readFileSync(path.join(DATA_DIR, file));
+    const hash = crypto.createHash('sha256').update(content).digest('hex').slice(0, 16);
+    const gz = zlib.gzipSync(content, { level: 9 });
+    const gzPath = path.join(DATA_DIR, `${file}.gz`);
+
+    // Only keep the gzip variant when it actually saves bytes
+    const useGz = gz.length < content.length;
+    if (useGz) {
+      fs.writeFileSync(gzPath, gz);
+    } else if (fs.existsSync(gzPath)) {
+      fs.unlinkSync(gzPath);
+    }
+
+    lines.push(`${file} ${hash} ${useGz ? 1 : 0}`);
+    assets.push({
+      file,
+      uri: '/' + file.replace('.min.', '.'),
+      mime: MIME_TYPES[path.extname(file)],
+      hash,
+      body: useGz ? gz : content,
+      gzip: useGz
+    });
+    totals.raw += content.length;
+    totals.gz += useGz ? gz.length : content.length;
+    log(`  🗜  ${file}: ${content.length} → ${useGz ? gz.length : content.length} bytes (etag ${hash})`);
+  }
+
+  fs.writeFileSync(path.join(DATA_DIR, MANIFEST), lines.join('\n') + '\n', 'utf-8');
+  writeAssetTable(assets);
+  log(`  📦 ${files.length} assets packed, ${totals.raw} → ${totals.gz} bytes over the wire`);
+  return totals;
+}
+
+module.exports = { packAssets };
+
+if (require.main === module) {
+  packAssets();
+}
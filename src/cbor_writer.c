@@ -0,0 +1,125 @@
+#include "cbor_writer.h"
+
+#include <string.h>
+
+#define CBOR_UINT   0
+#define CBOR_NEGINT 1
+#define CBOR_TEXT   3
+#define CBOR_ARRAY  4
+#define CBOR_MAP    5
+#define CBOR_FALSE  0xf4
+#define CBOR_TRUE   0xf5
+
+void cbor_writer_init(cbor_writer_t *w, uint8_t *buf, size_t cap, cbor_flush_fn flush, void *ctx) {
+    w->buf = buf;
+    w->cap = cap;
+    w->len = 0;
+    w->flush = flush;
+    w->ctx = ctx;
+    w->flushed = false;
+    w->error = false;
+}
+
+bool cbor_writer_flush(cbor_writer_t *w) {
+    if (w->error) return false;
+    if (w->len == 0) return true;
+    if (w->flush == NULL || !w->flush(w->ctx, w->buf, w->len)) {
+        w->error = true;
+        return false;
+    }
+    w->len = 0;
+    w->flushed = true;
+    return true;
+}
+
+static void put(cbor_writer_t *w, const void *data, size_t n) {
+    const uint8_t *p = data;
+    while (n > 0 && !w->error) {
+        if (w->len == w->cap && !cbor_writer_flush(w)) return;
+        size_t room = w->cap - w->len;
+        size_t take = n < room ? n : room;
+        memcpy(w->buf + w->len, p, take);
+        w->len += take;
+        p += take;
+        n -= take;
+    }
+}
+
+// Major type and argument, big-endian in the fewest bytes
+static void put_head(cbor_writer_t *w, uint8_t major, uint32_t arg) {
+    uint8_t head[5];
+    size_t n;
+    if (arg < 24) {
+        head[0] = (major << 5) | arg;
+        n = 1;
+    } else if (arg <= 0xff) {
+        head[0] = (major << 5) | 24;
+        head[1] = arg;
+        n = 2;
+    } else if (arg <= 0xffff) {
+        head[0] = (major << 5) | 25;
+        head[1] = arg >> 8;
+        head[2] = arg;
+        n = 3;
+    } else {
+        head[0] = (major << 5) | 26;
+        head[1] = arg >> 24;
+        head[2] = arg >> 16;
+        head[3] = arg >> 8;
+        head[4] = arg;
+        n = 5;
+    }
+    put(w, head, n);
+}
+
+void cbor_map(cbor_writer_t *w, size_t pairs) {
+    put_head(w, CBOR_MAP, pairs);
+}
+
+void cbor_array(cbor_writer_t *w, size_t items) {
+    put_head(w, CBOR_ARRAY, items);
+}
+
+void cbor_str(cbor_writer_t *w, const char *value) {
+    size_t n = strlen(value);
+    put_head(w, CBOR_TEXT, n);
+    put(w, value, n);
+}
+
+void cbor_int(cbor_writer_t *w, int32_t value) {
+    if (value < 0) {
+        // -1 - n, computed without overflowing INT32_MIN
+        put_head(w, CBOR_NEGINT, (uint32_t)(-(value + 1)));
+    } else {
+        put_head(w, CBOR_UINT, value);
+    }
+}
+
+void cbor_uint(cbor_writer_t *w, uint32_t value) {
+    put_head(w, CBOR_UINT, value);
+}
+
+void cbor_bool(cbor_writer_t *w, bool value) {
+    uint8_t b = value ? CBOR_TRUE : CBOR_FALSE;
+    put(w, &b, 1);
+}
+
+void cbor_kv_str(cbor_writer_t *w, const char *key, const char *value) {
+    cbor_str(w, key);
+    cbor_str(w, value);
+}
+
+void cbor_kv_int(cbor_writer_t *w, const char *key, int32_t value) {
+    cbor_str(w, key);
+    cbor_int(w, value);
+}
+
+void cbor_kv_uint(cbor_writer_t *w, const char *key, uint32_t value) {
+    cbor_str(w, key);
+    cbor_uint(w, value);
+}
+
+void cbor_kv_bool(cbor_writer_t *w, const char *key, bool value) {
+    cbor_str(w, key);
+    cbor_bool(w, value);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Allocation-free CBOR (RFC 8949) writer, the binary twin of json_writer.
+// Maps and arrays have definite lengths, so the caller gives the number
+// of pairs or items up front. Integers use the shortest head.
+
+// Returns false to abort the document
+typedef bool (*cbor_flush_fn)(void *ctx, const uint8_t *buf, size_t len);
+
+typedef struct {
+    uint8_t *buf;
+    size_t cap;
+    size_t len;
+    cbor_flush_fn flush;
+    void *ctx;
+    bool flushed;       // At least one flush happened
+    bool error;         // Overflow without a flush callback, or flush failed
+} cbor_writer_t;
+
+void cbor_writer_init(cbor_writer_t *w, uint8_t *buf, size_t cap, cbor_flush_fn flush, void *ctx);
+// Hands any buffered output to the flush callback
+bool cbor_writer_flush(cbor_writer_t *w);
+
+void cbor_map(cbor_writer_t *w, size_t pairs);
+void cbor_array(cbor_writer_t *w, size_t items);
+
+void cbor_str(cbor_writer_t *w, const char *value);
+void cbor_int(cbor_writer_t *w, int32_t value);
+void cbor_uint(cbor_writer_t *w, uint32_t value);
+void cbor_bool(cbor_writer_t *w, bool value);
+
+void cbor_kv_str(cbor_writer_t *w, const char *key, const char *value);
+void cbor_kv_int(cbor_writer_t *w, const char *key, int32_t value);
+void cbor_kv_uint(cbor_writer_t *w, const char *key, uint32_t value);
+void cbor_kv_bool(cbor_writer_t *w, const char *key, bool value);
@@ -0,0 +1,220 @@
+#include "event_stream.h"
+#include "relay_controller.h"
+#include "metrics.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include "json_writer.h"
+#include "status_json.h"
+
+static const char *TAG = "EVENTS";
+
+#define EVENT_FRAME_MAX (STATUS_JSON_MAX + 1024)
+#define CHUNK_HDR_MAX 8
+#define EVENT_PING_INTERVAL_US (30 * 1000 * 1000)
+
+typedef struct {
+    int fd;
+    bool dead;
+} event_client_t;
+
+// Client slots and the frame buffer are only touched from the httpd task
+// (the handler and queued work), so they need no locking. num_clients is
+// also read by relay writers on other tasks, so it is accessed atomically.
+static httpd_handle_t server_handle = NULL;
+static event_client_t clients[MAX_EVENT_CLIENTS];
+static int num_clients = 0;
+static char frame[EVENT_FRAME_MAX];
+static esp_timer_handle_t ping_timer = NULL;
+
+// Set from any task by the relay listener, drained by flush_events()
+static relay_mask_t pending_relays = 0;
+static uint32_t pending_routine = 0;
+static uint32_t flush_queued = 0;
+
+// Formats one "state" event carrying only the relays in relay_mask and,
+// if asked, the routine. The body is written after CHUNK_HDR_MAX bytes of
+// headroom so a chunk header can be prepended without copying.
+static int build_event(relay_mask_t relay_mask, bool routine) {
+    static const char prefix[] = "event: state\ndata: ";
+    static const char resync[] = "event: resync\ndata: {}\n\n";
+    char *body = frame + CHUNK_HDR_MAX;
+    size_t avail = sizeof(frame) - CHUNK_HDR_MAX - 2;
+
+    // Only the httpd task builds events
+    static routine_state_t rs;
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, routine ? &rs : NULL);
+
+    memcpy(body, prefix, sizeof(prefix) - 1);
+    json_writer_t w;
+    json_writer_init(&w, body + sizeof(prefix) - 1, avail - (sizeof(prefix) - 1) - 2, NULL, NULL);
+    json_obj_begin(&w);
+    json_key(&w, "relays");
+    json_arr_begin(&w);
+    for (int i = 0; i < snap.count; i++) {
+        if (relay_mask & RELAY_BIT(i)) {
+            status_json_relay(&w, &snap, i);
+        }
+    }
+    json_arr_end(&w);
+    if (routine) {
+        status_json_routine(&w, &rs);
+    }
+    json_obj_end(&w);
+
+    if (w.error) {
+        // Tell clients to fall back to a full /api/status read
+        memcpy(body, resync, sizeof(resync) - 1);
+        return sizeof(resync) - 1;
+    }
+    size_t len = sizeof(prefix) - 1 + w.len;
+    memcpy(body + len, "\n\n", 2);
+    return len + 2;
+}
+
+// Wraps the body built by build_event() in HTTP chunked framing
+static const char* frame_chunk(int body_len, size_t *out_len) {
+    char hdr[CHUNK_HDR_MAX + 1];
+    int hdr_len = snprintf(hdr, sizeof(hdr), "%x\r\n", body_len);
+    char *start = frame + CHUNK_HDR_MAX - hdr_len;
+    memcpy(start, hdr, hdr_len);
+    memcpy(frame + CHUNK_HDR_MAX + body_len, "\r\n", 2);
+    *out_len = hdr_len + body_len + 2;
+    return start;
+}
+
+// One payload for everyone; a client that cannot take it without
+// blocking is dropped so a slow tab never stalls the server task
+static void broadcast(const char *buf, size_t len) {
+    for (int i = 0; i < MAX_EVENT_CLIENTS; i++) {
+        event_client_t *c = &clients[i];
+        if (c->fd < 0 || c->dead) continue;
+        int ret = httpd_socket_send(server_handle, c->fd, buf, len, MSG_DONTWAIT);
+        if (ret != (int)len) {
+            ESP_LOGW(TAG, "Dropping event client fd=%d", c->fd);
+            c->dead = true;
+            httpd_sess_trigger_close(server_handle, c->fd);
+        }
+    }
+}
+
+static void flush_events(void *arg) {
+    __atomic_store_n(&flush_queued, 0, __ATOMIC_SEQ_CST);
+    relay_mask_t relays = __atomic_exchange_n(&pending_relays, 0, __ATOMIC_SEQ_CST);
+    bool routine = __atomic_exchange_n(&pending_routine, 0, __ATOMIC_SEQ_CST) != 0;
+    if (__atomic_load_n(&num_clients, __ATOMIC_SEQ_CST) == 0 || (relays == 0 && !routine)) return;
+
+    int body_len = build_event(relays, routine);
+    if (body_len <= 0) return;
+
+    size_t len;
+    const char *chunk = frame_chunk(body_len, &len);
+    broadcast(chunk, len);
+}
+
+static void ping_clients(void *arg) {
+    static const char ping[] = "3\r\n:\n\n\r\n";
+    broadcast(ping, sizeof(ping) - 1);
+}
+
+static void ping_timer_callback(void *arg) {
+    httpd_queue_work(server_handle, ping_clients, NULL);
+}
+
+// Coalesces bursts (e.g. a routine stop switching every relay off) into a
+// single queued flush, so fan-out cost is bounded by MAX_EVENT_CLIENTS
+// sends per burst rather than per state change
+static void on_relay_event(relay_event_t event, uint8_t relay_num) {
+    if (event == RELAY_EVENT_RELAY) {
+        __atomic_fetch_or(&pending_relays, RELAY_BIT(relay_num), __ATOMIC_SEQ_CST);
+    } else {
+        __atomic_store_n(&pending_routine, 1, __ATOMIC_SEQ_CST);
+    }
+
+    if (__atomic_load_n(&num_clients, __ATOMIC_SEQ_CST) == 0) return;
+    if (__atomic_exchange_n(&flush_queued, 1, __ATOMIC_SEQ_CST) == 0) {
+        if (httpd_queue_work(server_handle, flush_events, NULL) != ESP_OK) {
+            __atomic_store_n(&flush_queued, 0, __ATOMIC_SEQ_CST);
+        }
+    }
+}
+
+// Called by httpd when an event client's session is closed
+static void client_closed(void *ctx) {
+    event_client_t *c = (event_client_t *)ctx;
+    ESP_LOGI(TAG, "Event client fd=%d disconnected", c->fd);
+    c->fd = -1;
+    c->dead = false;
+    if (__atomic_sub_fetch(&num_clients, 1, __ATOMIC_SEQ_CST) == 0) {
+        esp_timer_stop(ping_timer);
+    }
+}
+
+static esp_err_t api_events_handler(httpd_req_t *req) {
+    event_client_t *slot = NULL;
+    for (int i = 0; i < MAX_EVENT_CLIENTS; i++) {
+        if (clients[i].fd < 0) {
+            slot = &clients[i];
+            break;
+        }
+    }
+    if (slot == NULL) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_sendstr(req, "Too many event clients");
+        return ESP_OK;
+    }
+
+    httpd_resp_set_type(req, "text/event-stream");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+
+    // Start with a full snapshot; later events only carry deltas
+    httpd_resp_sendstr_chunk(req, "retry: 3000\n\n");
+    int body_len = build_event(~(relay_mask_t)0, true);
+    if (body_len <= 0 || httpd_resp_send_chunk(req, frame + CHUNK_HDR_MAX, body_len) != ESP_OK) {
+        return ESP_FAIL;
+    }
+
+    // Leave the chunked response open and keep the socket for pushes
+    slot->fd = httpd_req_to_sockfd(req);
+    slot->dead = false;
+    req->sess_ctx = slot;
+    req->free_ctx = client_closed;
+    int clients_now = __atomic_add_fetch(&num_clients, 1, __ATOMIC_SEQ_CST);
+    if (clients_now == 1) {
+        esp_timer_start_periodic(ping_timer, EVENT_PING_INTERVAL_US);
+    }
+
+    ESP_LOGI(TAG, "Event client fd=%d subscribed (%d/%d)", slot->fd, clients_now, MAX_EVENT_CLIENTS);
+    return ESP_OK;
+}
+
+esp_err_t event_stream_register(httpd_handle_t server) {
+    server_handle = server;
+    for (int i = 0; i < MAX_EVENT_CLIENTS; i++) {
+        clients[i].fd = -1;
+        clients[i].dead = false;
+    }
+
+    const esp_timer_create_args_t ping_args = {
+        .callback = ping_timer_callback,
+        .name = "sse_ping"
+    };
+    esp_err_t err = esp_timer_create(&ping_args, &ping_timer);
+    if (err != ESP_OK) return err;
+
+    if (!relay_add_listener(on_relay_event)) {
+        ESP_LOGE(TAG, "No free relay listener slot");
+        return ESP_FAIL;
+    }
+
+    httpd_uri_t api_events_uri = {
+        .uri = "/api/events",
+        .method = HTTP_GET,
+        .handler = api_events_handler
+    };
+    return metrics_register_uri(server, &api_events_uri);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+#define MAX_EVENT_CLIENTS 3
+
+// Registers GET /api/events, a Server-Sent Events stream that pushes
+// relay and routine changes to every subscribed client
+esp_err_t event_stream_register(httpd_handle_t server);
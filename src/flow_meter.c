@@ -0,0 +1,325 @@
+#include "flow_meter.h"
+#include "history.h"
+
+#include <esp_log.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+#include "freertos/task.h"
+#if FLOW_METER_GPIO >= 0
+#include "driver/gpio.h"
+#include "driver/pulse_cnt.h"
+#endif
+
+const char *flow_alarm_to_str(flow_alarm_t alarm) {
+    switch (alarm) {
+        case FLOW_ALARM_NO_FLOW: return "noflow";
+        case FLOW_ALARM_LEAK: return "leak";
+        default: return "none";
+    }
+}
+
+#if FLOW_METER_GPIO >= 0
+
+static const char *TAG = "FLOW";
+
+// The counter goes back to 0 when it reaches this. Read at least every
+// FLOW_SAMPLE_MS it cannot come round twice between reads below 32 kHz,
+// so it needs no overflow interrupt either.
+#define PCNT_WRAP 32767
+
+// Iterates over the relays in a mask, lowest first
+#define FOR_EACH_RELAY(i, mask) \
+    for (relay_mask_t m_ = (mask); m_; m_ &= m_ - 1) \
+        for (int i = __builtin_ctzll(m_), once_ = 1; once_; once_ = 0)
+
+static bool present = false;
+static pcnt_unit_handle_t unit = NULL;
+// Reads the counter while water should flow and for FLOW_SETTLE_SEC
+// after; the unit is only enabled, and sampled, from this timer
+static TimerHandle_t sample_timer = NULL;
+
+// The listener runs on whichever task switched a relay, the sampler on
+// the timer service task and the readers anywhere; all of the below is
+// under flow_lock
+static portMUX_TYPE flow_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool counting = false;           // The unit is running
+static relay_mask_t open = 0;           // Relays on, as the listener last saw them
+static int last_count = 0;
+static uint32_t total_pulses = 0;
+static uint32_t zone_mp[RELAY_MAX];     // Milli-pulses through each open relay
+static uint32_t target_ml[RELAY_MAX];   // 0 for none
+static uint32_t pending_ml[RELAY_MAX];  // Target for the relay's next opening
+static TickType_t opened_at[RELAY_MAX];
+static TickType_t closed_at;            // When the last open relay closed
+static TickType_t window_start;         // The rate is measured over >= FLOW_SAMPLE_MS
+static uint32_t window_pulses;
+static uint32_t rate_mpps = 0;          // Milli-pulses per second, last window
+static bool high = false;               // Above FLOW_MAX_ML_PER_MIN since high_since
+static TickType_t high_since;
+static uint8_t alarm = FLOW_ALARM_NONE;
+
+// Credits the pulses since the last read to the open relays. Call with
+// flow_lock held.
+static void account(void) {
+    if (!counting) return;
+    int count = 0;
+    pcnt_unit_get_count(unit, &count);
+    uint32_t pulses = (uint32_t)(count - last_count + PCNT_WRAP) % PCNT_WRAP;
+    last_count = count;
+    total_pulses += pulses;
+    window_pulses += pulses;
+    if (open) {
+        uint32_t share = pulses * 1000 / __builtin_popcountll(open);
+        FOR_EACH_RELAY(i, open) zone_mp[i] += share;
+    }
+}
+
+static uint32_t rate_ml_per_min(void) {
+    return (uint64_t)rate_mpps * 60 / FLOW_PULSES_PER_LITRE;
+}
+
+static void start_counting(void) {
+    esp_err_t err = pcnt_unit_enable(unit);
+    if (err == ESP_OK) err = pcnt_unit_clear_count(unit);
+    if (err == ESP_OK) err = pcnt_unit_start(unit);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start the pulse counter (%s)", esp_err_to_name(err));
+        return;
+    }
+    portENTER_CRITICAL(&flow_lock);
+    counting = true;
+    last_count = 0;
+    window_start = xTaskGetTickCount();
+    window_pulses = 0;
+    high = false;
+    portEXIT_CRITICAL(&flow_lock);
+    xTimerChangePeriod(sample_timer, pdMS_TO_TICKS(FLOW_SAMPLE_MS), 0);
+}
+
+static void sample_callback(TimerHandle_t xTimer) {
+    portENTER_CRITICAL(&flow_lock);
+    bool start = !counting && open != 0;
+    portEXIT_CRITICAL(&flow_lock);
+    if (start) {
+        start_counting();
+        return;
+    }
+
+    relay_mask_t reached = 0, dry = 0, leak = 0;
+    bool stop = false, leaking = false;
+    TickType_t next = pdMS_TO_TICKS(FLOW_SAMPLE_MS);
+    portENTER_CRITICAL(&flow_lock);
+    TickType_t now = xTaskGetTickCount();
+    account();
+    uint32_t window_ms = pdTICKS_TO_MS(now - window_start);
+    bool new_rate = window_ms >= FLOW_SAMPLE_MS;
+    if (new_rate) {
+        rate_mpps = (uint64_t)window_pulses * 1000000 / window_ms;
+        window_start = now;
+        window_pulses = 0;
+    }
+    uint32_t rate = rate_ml_per_min();
+
+    if (open) {
+        FOR_EACH_RELAY(i, open) {
+            if (target_ml[i] && zone_mp[i] >= target_ml[i] * FLOW_PULSES_PER_LITRE) reached |= RELAY_BIT(i);
+        }
+        if (new_rate && rate < FLOW_MIN_ML_PER_MIN) {
+            high = false;
+            FOR_EACH_RELAY(i, open) {
+                if (now - opened_at[i] >= pdMS_TO_TICKS(FLOW_START_SEC * 1000)) dry |= RELAY_BIT(i);
+            }
+        } else if (new_rate && rate > FLOW_MAX_ML_PER_MIN) {
+            if (!high) {
+                high = true;
+                high_since = now;
+            } else if (now - high_since >= pdMS_TO_TICKS(FLOW_LEAK_SEC * 1000)) {
+                leak = open;
+            }
+        } else if (new_rate) {
+            high = false;
+            alarm = FLOW_ALARM_NONE;
+        }
+
+        // Read again when the first target is due rather than up to a
+        // whole sample later
+        uint32_t share = rate_mpps / __builtin_popcountll(open);
+        FOR_EACH_RELAY(i, open & ~reached) {
+            if (!target_ml[i] || share == 0) continue;
+            uint32_t left_ms = (uint64_t)(target_ml[i] * FLOW_PULSES_PER_LITRE - zone_mp[i]) * 1000 / share + 1;
+            TickType_t due = pdMS_TO_TICKS(left_ms);
+            if (due < next) next = due > 0 ? due : 1;
+        }
+    } else if (now - closed_at >= pdMS_TO_TICKS(FLOW_SETTLE_SEC * 1000)) {
+        // Every zone closed a while ago; any flow left is a leak
+        leaking = rate >= FLOW_MIN_ML_PER_MIN;
+        if (leaking) alarm = FLOW_ALARM_LEAK;
+        counting = false;
+        rate_mpps = 0;
+        stop = true;
+    }
+    if (dry) alarm = FLOW_ALARM_NO_FLOW;
+    if (leak) alarm = FLOW_ALARM_LEAK;
+    portEXIT_CRITICAL(&flow_lock);
+
+    if (reached) {
+        relay_off_mask(reached, HISTORY_END_VOLUME);
+    }
+    if (dry) {
+        ESP_LOGW(TAG, "Below %d ml/min after %d s, closing the open zones", FLOW_MIN_ML_PER_MIN, FLOW_START_SEC);
+        relay_off_mask(dry, HISTORY_END_NO_FLOW);
+    }
+    if (leak) {
+        ESP_LOGE(TAG, "%lu ml/min for %d s, closing the open zones", (unsigned long)rate, FLOW_LEAK_SEC);
+        relay_off_mask(leak, HISTORY_END_LEAK);
+    }
+    if (stop) {
+        if (leaking) {
+            ESP_LOGE(TAG, "%lu ml/min with every zone closed", (unsigned long)rate);
+        }
+        pcnt_unit_stop(unit);
+        pcnt_unit_disable(unit);
+        // A relay that opened while this ran found the unit still counting
+        portENTER_CRITICAL(&flow_lock);
+        bool restart = open != 0;
+        portEXIT_CRITICAL(&flow_lock);
+        if (!restart) return;
+        next = 1;
+    }
+    xTimerChangePeriod(sample_timer, next, 0);
+}
+
+static void on_relay_event(relay_event_t event, uint8_t relay_num) {
+    if (event != RELAY_EVENT_RELAY) return;
+    bool on = relay_get_state(relay_num);
+    relay_mask_t bit = RELAY_BIT(relay_num);
+    bool closed = false, wake = false;
+    uint32_t ml = 0;
+
+    portENTER_CRITICAL(&flow_lock);
+    TickType_t now = xTaskGetTickCount();
+    account();
+    if (on && !(open & bit)) {
+        open |= bit;
+        zone_mp[relay_num] = 0;
+        target_ml[relay_num] = pending_ml[relay_num];
+        pending_ml[relay_num] = 0;
+        opened_at[relay_num] = now;
+        wake = !counting;
+    } else if (!on && (open & bit)) {
+        open &= ~bit;
+        ml = zone_mp[relay_num] / FLOW_PULSES_PER_LITRE;
+        target_ml[relay_num] = 0;
+        if (!open) closed_at = now;
+        closed = true;
+    }
+    portEXIT_CRITICAL(&flow_lock);
+
+    // The sampler starts the unit, so only the timer service task ever
+    // enables or disables it
+    if (wake) xTimerChangePeriod(sample_timer, 1, 0);
+    if (closed) ESP_LOGI(TAG, "Relay %d: %lu ml", relay_num + 1, (unsigned long)ml);
+}
+
+void flow_meter_init(void) {
+    pcnt_unit_config_t unit_config = {
+        .low_limit = -1,
+        .high_limit = PCNT_WRAP,
+    };
+    pcnt_chan_config_t chan_config = {
+        .edge_gpio_num = FLOW_METER_GPIO,
+        .level_gpio_num = -1,
+    };
+    // Contact bounce and noise on the sensor cable are far shorter than a
+    // pulse, which lasts milliseconds even at full flow
+    pcnt_glitch_filter_config_t filter = {
+        .max_glitch_ns = 1000,
+    };
+    pcnt_channel_handle_t chan = NULL;
+    esp_err_t err = pcnt_new_unit(&unit_config, &unit);
+    if (err == ESP_OK) err = pcnt_unit_set_glitch_filter(unit, &filter);
+    if (err == ESP_OK) err = pcnt_new_channel(unit, &chan_config, &chan);
+    if (err == ESP_OK) {
+        err = pcnt_channel_set_edge_action(chan, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_HOLD);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set up the pulse counter (%s)", esp_err_to_name(err));
+        return;
+    }
+    // Hall sensors have an open-collector output
+    gpio_pullup_en(FLOW_METER_GPIO);
+
+    sample_timer = xTimerCreate("flow_sample", 1, pdFALSE, NULL, sample_callback);
+    if (!relay_add_listener(on_relay_event)) {
+        ESP_LOGE(TAG, "No room for the flow meter listener");
+        return;
+    }
+    present = true;
+    ESP_LOGI(TAG, "Flow meter on GPIO %d, %d pulses per litre", FLOW_METER_GPIO, FLOW_PULSES_PER_LITRE);
+}
+
+bool flow_meter_present(void) {
+    return present;
+}
+
+void flow_meter_set_target(uint8_t relay_num, uint32_t ml) {
+    if (relay_num >= RELAY_MAX) return;
+    portENTER_CRITICAL(&flow_lock);
+    if (open & RELAY_BIT(relay_num)) {
+        // Already on, e.g. by hand: the target counts from now
+        account();
+        zone_mp[relay_num] = 0;
+        target_ml[relay_num] = ml;
+        pending_ml[relay_num] = 0;
+    } else {
+        pending_ml[relay_num] = ml;
+    }
+    portEXIT_CRITICAL(&flow_lock);
+}
+
+uint32_t flow_meter_zone_ml(uint8_t relay_num) {
+    if (relay_num >= RELAY_MAX) return 0;
+    portENTER_CRITICAL(&flow_lock);
+    account();
+    uint32_t ml = (open & RELAY_BIT(relay_num)) ? zone_mp[relay_num] / FLOW_PULSES_PER_LITRE : 0;
+    portEXIT_CRITICAL(&flow_lock);
+    return ml;
+}
+
+void flow_meter_write_json(json_writer_t *w) {
+    if (!present) return;
+    portENTER_CRITICAL(&flow_lock);
+    account();
+    uint32_t rate = rate_ml_per_min();
+    uint32_t total = (uint64_t)total_pulses * 1000 / FLOW_PULSES_PER_LITRE;
+    flow_alarm_t state = alarm;
+    portEXIT_CRITICAL(&flow_lock);
+
+    json_key(w, "flow");
+    json_obj_begin(w);
+    json_kv_uint(w, "rate", rate);
+    json_kv_uint(w, "total", total);
+    json_kv_str(w, "alarm", flow_alarm_to_str(state));
+    json_obj_end(w);
+}
+
+#else
+
+void flow_meter_init(void) {
+}
+
+bool flow_meter_present(void) {
+    return false;
+}
+
+void flow_meter_set_target(uint8_t relay_num, uint32_t ml) {
+}
+
+uint32_t flow_meter_zone_ml(uint8_t relay_num) {
+    return 0;
+}
+
+void flow_meter_write_json(json_writer_t *w) {
+}
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "json_writer.h"
+#include "relay_controller.h"
+
+// Optional flow meter on the supply line: a hall sensor whose pulses the
+// PCNT peripheral counts, with no interrupt per pulse. Set the pin with
+// -D FLOW_METER_GPIO=<n> in platformio.ini; without it every call below
+// is a no-op and steps run on time alone.
+#ifndef FLOW_METER_GPIO
+#define FLOW_METER_GPIO -1
+#endif
+#ifndef FLOW_PULSES_PER_LITRE
+#define FLOW_PULSES_PER_LITRE 450       // YF-S201 and similar, 7.5 Hz per L/min
+#endif
+// An open zone that stays below this counts as dry (supply off, valve
+// stuck shut)
+#ifndef FLOW_MIN_ML_PER_MIN
+#define FLOW_MIN_ML_PER_MIN 500
+#endif
+// Above this something is open that should not be (burst pipe, broken head)
+#ifndef FLOW_MAX_ML_PER_MIN
+#define FLOW_MAX_ML_PER_MIN 40000
+#endif
+#define FLOW_START_SEC 20       // Time a zone gets to reach FLOW_MIN_ML_PER_MIN
+#define FLOW_LEAK_SEC 5         // Time above FLOW_MAX_ML_PER_MIN before the zones close
+#define FLOW_SETTLE_SEC 10      // After the last zone closes, the flow must stop within this
+#define FLOW_SAMPLE_MS 1000     // Counter reads while water should flow
+#define FLOW_MAX_STEP_LITRES 1000
+
+typedef enum {
+    FLOW_ALARM_NONE = 0,
+    FLOW_ALARM_NO_FLOW,     // Zones were closed for lack of flow
+    FLOW_ALARM_LEAK         // Too much flow, or flow with every zone closed
+} flow_alarm_t;
+
+// Sets up the counter and starts following the relays. Call after
+// relay_init() and before anything can switch a relay.
+void flow_meter_init(void);
+bool flow_meter_present(void);
+// The next time the relay opens it closes again once `ml` went through
+// it, or when its time runs out, whichever comes first. 0 for time alone.
+void flow_meter_set_target(uint8_t relay_num, uint32_t ml);
+// Millilitres through an open relay since it opened. With several open at
+// once, the flow is split evenly between them.
+uint32_t flow_meter_zone_ml(uint8_t relay_num);
+// "flow":{"rate":..,"total":..,"alarm":..}; nothing without a flow meter
+void flow_meter_write_json(json_writer_t *w);
+const char *flow_alarm_to_str(flow_alarm_t alarm);
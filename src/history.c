@@ -0,0 +1,285 @@
+#include "history.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "HISTORY";
+
+#define SECTOR_SIZE 4096
+#define SEQ_NONE UINT32_MAX
+#define READ_CHUNK 16           // Records per flash read
+
+// On flash. Erased flash reads as all ones, so records are appended into
+// the first all-ones slot and the log never rewrites a byte.
+typedef struct {
+    uint32_t seq;
+    uint32_t start;
+    uint16_t duration;
+    uint8_t zone;
+    uint8_t source;
+    uint8_t end;
+    uint8_t reserved[2];
+    uint8_t crc;                // Over the bytes before it; fails for a torn write
+} history_record_t;
+
+_Static_assert(SECTOR_SIZE % sizeof(history_record_t) == 0, "records must tile a sector");
+
+#define RECORDS_PER_SECTOR (SECTOR_SIZE / sizeof(history_record_t))
+
+// What a query needs to know to skip a sector without reading it
+typedef struct {
+    uint32_t first_seq;         // SEQ_NONE without a valid record
+    uint32_t last_seq;
+    uint32_t min_start;
+    uint32_t max_start;
+    uint16_t used;              // Slots written, including torn ones
+    uint8_t zones;              // Bit n % 8 set if a record is for zone n
+} sector_index_t;
+
+static const esp_partition_t *partition = NULL;
+static int num_sectors = 0;
+
+// Written by the writer task, copied by queries
+static portMUX_TYPE index_lock = portMUX_INITIALIZER_UNLOCKED;
+static sector_index_t sectors[HISTORY_MAX_SECTORS];
+static int head_sector = 0;     // Newest sector, where appends go
+static uint32_t next_seq = 1;
+
+static portMUX_TYPE pending_lock = portMUX_INITIALIZER_UNLOCKED;
+static history_entry_t pending[HISTORY_PENDING];
+static uint32_t pending_head = 0;
+static uint32_t pending_tail = 0;
+static uint32_t dropped = 0;
+static TaskHandle_t history_task_handle = NULL;
+
+static uint8_t crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0;
+    while (len--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static bool record_erased(const history_record_t *rec) {
+    const uint8_t *b = (const uint8_t *)rec;
+    for (size_t i = 0; i < sizeof(*rec); i++) {
+        if (b[i] != 0xff) return false;
+    }
+    return true;
+}
+
+static bool record_valid(const history_record_t *rec) {
+    return rec->seq != SEQ_NONE && rec->crc == crc8((const uint8_t *)rec, offsetof(history_record_t, crc));
+}
+
+static void index_reset(sector_index_t *idx) {
+    *idx = (sector_index_t){
+        .first_seq = SEQ_NONE, .last_seq = SEQ_NONE, .min_start = UINT32_MAX, .max_start = 0
+    };
+}
+
+static void index_add(sector_index_t *idx, const history_record_t *rec) {
+    if (idx->first_seq == SEQ_NONE) idx->first_seq = rec->seq;
+    idx->last_seq = rec->seq;
+    if (rec->start < idx->min_start) idx->min_start = rec->start;
+    if (rec->start > idx->max_start) idx->max_start = rec->start;
+    idx->zones |= 1u << (rec->zone & 7);
+}
+
+static void index_sector(int s) {
+    sector_index_t idx;
+    index_reset(&idx);
+    history_record_t buf[READ_CHUNK];
+    for (size_t r = 0; r < RECORDS_PER_SECTOR; r += READ_CHUNK) {
+        if (esp_partition_read(partition, s * SECTOR_SIZE + r * sizeof(history_record_t), buf, sizeof(buf)) != ESP_OK) {
+            break;
+        }
+        for (int k = 0; k < READ_CHUNK; k++) {
+            // Appends are in order, so the first free slot ends the sector
+            if (record_erased(&buf[k])) goto done;
+            idx.used++;
+            if (record_valid(&buf[k])) index_add(&idx, &buf[k]);
+        }
+    }
+done:
+    sectors[s] = idx;
+}
+
+static void append(const history_entry_t *entry) {
+    int s = head_sector;
+    if (sectors[s].used >= RECORDS_PER_SECTOR) {
+        // The log is full up to here: the oldest sector makes room
+        s = (s + 1) % num_sectors;
+        portENTER_CRITICAL(&index_lock);
+        index_reset(&sectors[s]);
+        head_sector = s;
+        portEXIT_CRITICAL(&index_lock);
+        esp_err_t err = esp_partition_erase_range(partition, s * SECTOR_SIZE, SECTOR_SIZE);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to erase sector %d (%s)", s, esp_err_to_name(err));
+            sectors[s].used = RECORDS_PER_SECTOR;   // Try the next one next time
+            return;
+        }
+    }
+
+    history_record_t rec = {
+        .seq = next_seq,
+        .start = entry->start,
+        .duration = entry->duration,
+        .zone = entry->zone,
+        .source = entry->source,
+        .end = entry->end,
+        .reserved = {0xff, 0xff},
+    };
+    rec.crc = crc8((const uint8_t *)&rec, offsetof(history_record_t, crc));
+    esp_err_t err = esp_partition_write(partition, s * SECTOR_SIZE + sectors[s].used * sizeof(rec), &rec, sizeof(rec));
+
+    portENTER_CRITICAL(&index_lock);
+    sectors[s].used++;  // A failed write may still have touched the slot
+    if (err == ESP_OK) {
+        index_add(&sectors[s], &rec);
+        next_seq++;
+    }
+    portEXIT_CRITICAL(&index_lock);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write record (%s)", esp_err_to_name(err));
+    }
+}
+
+static void history_task(void *pvParameters) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        for (;;) {
+            history_entry_t entry;
+            uint32_t lost = 0;
+            portENTER_CRITICAL(&pending_lock);
+            bool empty = pending_tail == pending_head;
+            if (!empty) entry = pending[pending_tail++ % HISTORY_PENDING];
+            if (empty) {
+                lost = dropped;
+                dropped = 0;
+            }
+            portEXIT_CRITICAL(&pending_lock);
+            if (lost) {
+                ESP_LOGW(TAG, "Dropped %u waterings, the writer fell behind", (unsigned)lost);
+            }
+            if (empty) break;
+            append(&entry);
+        }
+    }
+}
+
+void history_log(const history_entry_t *entry) {
+    if (history_task_handle == NULL) return;
+
+    portENTER_CRITICAL(&pending_lock);
+    bool full = pending_head - pending_tail >= HISTORY_PENDING;
+    if (full) {
+        dropped++;
+    } else {
+        pending[pending_head++ % HISTORY_PENDING] = *entry;
+    }
+    portEXIT_CRITICAL(&pending_lock);
+
+    if (!full) {
+        xTaskNotifyGive(history_task_handle);
+    }
+}
+
+void history_init(void) {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, HISTORY_PARTITION);
+    if (partition == NULL) {
+        ESP_LOGW(TAG, "No '%s' partition, history is off (flash the current partition table over USB)",
+                 HISTORY_PARTITION);
+        return;
+    }
+    num_sectors = partition->size / SECTOR_SIZE;
+    if (num_sectors > HISTORY_MAX_SECTORS) num_sectors = HISTORY_MAX_SECTORS;
+    if (num_sectors < 2) {
+        ESP_LOGE(TAG, "History partition too small");
+        partition = NULL;
+        return;
+    }
+
+    // One pass over the log builds the index and finds the newest sector
+    int64_t started = esp_timer_get_time();
+    uint32_t records = 0;
+    uint32_t newest = 0;
+    for (int s = 0; s < num_sectors; s++) {
+        index_sector(s);
+        records += sectors[s].used;
+        if (sectors[s].last_seq != SEQ_NONE && sectors[s].last_seq >= newest) {
+            newest = sectors[s].last_seq;
+            head_sector = s;
+        }
+    }
+    next_seq = newest + 1;
+    ESP_LOGI(TAG, "%u of %u records used, indexed in %lld us", (unsigned)records,
+             (unsigned)(num_sectors * RECORDS_PER_SECTOR), (long long)(esp_timer_get_time() - started));
+
+    if (xTaskCreate(history_task, "history_task", 2560, NULL, tskIDLE_PRIORITY + 1, &history_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create history task");
+        history_task_handle = NULL;
+    }
+}
+
+static void write_entry(json_writer_t *w, const history_record_t *rec) {
+    static const char *const sources[] = {"manual", "timed", "routine"};
+    static const char *const ends[] = {"off", "timer", "safety", "volume", "noflow", "leak"};
+    json_obj_begin(w);
+    json_kv_int(w, "zone", rec->zone);
+    json_kv_uint(w, "start", rec->start);
+    json_kv_uint(w, "duration", rec->duration);
+    json_kv_str(w, "source", rec->source < 3 ? sources[rec->source] : "unknown");
+    json_kv_str(w, "end", rec->end < sizeof(ends) / sizeof(ends[0]) ? ends[rec->end] : "unknown");
+    json_obj_end(w);
+}
+
+esp_err_t history_write_json(json_writer_t *w, uint32_t from, uint32_t to, int zone) {
+    if (partition == NULL) return ESP_ERR_NOT_SUPPORTED;
+
+    // Queries run on the web workers, possibly two at once
+    sector_index_t *idx = malloc(num_sectors * sizeof(sector_index_t));
+    if (idx == NULL) return ESP_ERR_NO_MEM;
+    portENTER_CRITICAL(&index_lock);
+    memcpy(idx, sectors, num_sectors * sizeof(sector_index_t));
+    int head = head_sector;
+    uint32_t last_seq = next_seq - 1;
+    portEXIT_CRITICAL(&index_lock);
+
+    json_arr_begin(w);
+    // Oldest sector first: the one after the head is the next to be erased
+    for (int n = 1; n <= num_sectors && !w->error; n++) {
+        int s = (head + n) % num_sectors;
+        const sector_index_t *x = &idx[s];
+        if (x->first_seq == SEQ_NONE || x->max_start < from || x->min_start >= to) continue;
+        if (zone >= 0 && !(x->zones & (1u << (zone & 7)))) continue;
+
+        history_record_t buf[READ_CHUNK];
+        for (size_t r = 0; r < x->used && !w->error; r += READ_CHUNK) {
+            if (esp_partition_read(partition, s * SECTOR_SIZE + r * sizeof(history_record_t), buf, sizeof(buf)) != ESP_OK) {
+                break;
+            }
+            for (size_t k = 0; k < READ_CHUNK && r + k < x->used; k++) {
+                const history_record_t *rec = &buf[k];
+                // Records outside the copied index were written after it
+                // was taken, possibly over an erased sector
+                if (!record_valid(rec) || rec->seq < x->first_seq || rec->seq > last_seq) continue;
+                if (rec->start < from || rec->start >= to) continue;
+                if (zone >= 0 && rec->zone != zone) continue;
+                write_entry(w, rec);
+            }
+        }
+    }
+    json_arr_end(w);
+    free(idx);
+    return ESP_OK;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+#include "json_writer.h"
+
+#define HISTORY_PARTITION "history"     // See partitions.csv
+#define HISTORY_MAX_SECTORS 64          // Indexed sectors (256 KB)
+#define HISTORY_PENDING 64              // Waterings queued for the writer task
+
+typedef enum {
+    HISTORY_SRC_MANUAL = 0,     // Switched on by hand
+    HISTORY_SRC_TIMED,          // Switched on for a set time
+    HISTORY_SRC_ROUTINE         // A routine step
+} history_source_t;
+
+typedef enum {
+    HISTORY_END_OFF = 0,        // Switched off (by hand, a skip or a stop)
+    HISTORY_END_TIMER,          // Its time ran out
+    HISTORY_END_SAFETY,         // The MAX_ON_TIME_SEC safety timeout on a manual relay
+    HISTORY_END_VOLUME,         // Its volume went through the flow meter
+    HISTORY_END_NO_FLOW,        // Closed by the flow meter for lack of flow
+    HISTORY_END_LEAK            // Closed by the flow meter for too much flow
+} history_end_t;
+
+// One watering: a relay's on period, logged when it switches off
+typedef struct {
+    uint32_t start;             // time() it switched on
+    uint16_t duration;          // Seconds it stayed on
+    uint8_t zone;               // Relay number
+    uint8_t source;             // history_source_t
+    uint8_t end;                // history_end_t
+} history_entry_t;
+
+// Finds and indexes the history partition and starts the writer task.
+// Without the partition (a board whose partition table predates it)
+// history stays off. Call before relay_init().
+void history_init(void);
+
+// Queues a watering for the writer task. Never blocks; when the queue is
+// full the entry is dropped and counted. Safe from any task.
+void history_log(const history_entry_t *entry);
+
+// Writes the waterings that started in [from, to), oldest first, as a JSON
+// array. zone < 0 matches every zone. Sectors whose index rules them out
+// are not read. Returns ESP_ERR_NOT_SUPPORTED while history is off and
+// ESP_ERR_NO_MEM without heap for a copy of the index, before writing
+// anything. Safe from more than one task at once.
+esp_err_t history_write_json(json_writer_t *w, uint32_t from, uint32_t to, int zone);
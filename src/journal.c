@@ -0,0 +1,266 @@
+#include "journal.h"
+#include "relay_controller.h"
+#include "routine_store.h"
+#include "nvs.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static const char *TAG = "JOURNAL";
+
+#define NVS_NAMESPACE "journal"
+
+// One state transition, stored under "r<seq % JOURNAL_SLOTS>". NVS appends
+// each write to its log and checksums every entry, so records cost no
+// erase of their own and one torn by a reset just reads back as missing.
+typedef struct {
+    uint32_t seq;           // 0 = none
+    uint32_t time;          // time() when written
+    uint16_t routine;       // routine_hash() of the running routine, 0 if none
+    step_mask_t done;
+    step_mask_t active;
+    uint8_t num_steps;
+    relay_mask_t on_mask;
+    relay_mask_t timed_mask;
+    uint16_t left[MAX_ROUTINE_STEPS];   // Seconds left of each active step
+} journal_record_t;
+
+// Newest record in NVS; only the journal task writes it after init
+static journal_record_t last;
+static TaskHandle_t journal_task_handle = NULL;
+
+// FNV-1a over the name and each step's relay, length and wait flag (only
+// when set, so routines without one hash as they always did), folded to
+// 16 bits. Never 0, which means "no routine".
+static uint16_t routine_hash(const char *name, const routine_step_t *steps, int num_steps) {
+    uint32_t h = 2166136261u;
+    for (const char *c = name; *c; c++) {
+        h = (h ^ (uint8_t)*c) * 16777619u;
+    }
+    for (int i = 0; i < num_steps; i++) {
+        h = (h ^ steps[i].relay_id) * 16777619u;
+        h = (h ^ (steps[i].duration_sec & 0xff)) * 16777619u;
+        h = (h ^ (steps[i].duration_sec >> 8)) * 16777619u;
+        if (steps[i].wait) h = (h ^ 0x80) * 16777619u;
+    }
+    uint16_t folded = (h >> 16) ^ (h & 0xffff);
+    return folded ? folded : 1;
+}
+
+static journal_record_t load_last(void) {
+    journal_record_t newest = {0};
+    nvs_handle_t nvs;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) return newest;
+    for (int i = 0; i < JOURNAL_SLOTS; i++) {
+        char key[8];
+        journal_record_t rec;
+        size_t len = sizeof(rec);
+        snprintf(key, sizeof(key), "r%d", i);
+        if (nvs_get_blob(nvs, key, &rec, &len) == ESP_OK && len == sizeof(rec) && rec.seq > newest.seq) {
+            newest = rec;
+        }
+    }
+    nvs_close(nvs);
+    return newest;
+}
+
+static void save(journal_record_t *rec) {
+    char key[8];
+    rec->seq = last.seq + 1;
+    snprintf(key, sizeof(key), "r%u", (unsigned)(rec->seq % JOURNAL_SLOTS));
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, key, rec, sizeof(*rec));
+        if (err == ESP_OK) err = nvs_commit(nvs);
+        nvs_close(nvs);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to write record %u (%s)", (unsigned)rec->seq, esp_err_to_name(err));
+        return;
+    }
+    last = *rec;
+}
+
+static void current_record(journal_record_t *rec) {
+    static routine_state_t rs;  // Only the journal task gets here
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, &rs);
+
+    memset(rec, 0, sizeof(*rec));
+    rec->time = (uint32_t)time(NULL);
+    rec->on_mask = snap.on_mask;
+    rec->timed_mask = snap.timed_mask;
+    if (snap.routine_running) {
+        rec->routine = routine_hash(rs.name, rs.steps, rs.num_steps);
+        rec->done = rs.done_steps;
+        rec->active = rs.active_steps;
+        rec->num_steps = rs.num_steps;
+        for (int i = 0; i < rs.num_steps; i++) {
+            if (rs.active_steps & STEP_BIT(i)) rec->left[i] = relay_snapshot_remaining(&snap, rs.steps[i].relay_id);
+        }
+    }
+}
+
+// Only transitions are recorded. Step deadlines are compared too, so a
+// routine restarted at the same steps is not mistaken for the old run; a
+// resumed one keeps its deadlines and writes nothing.
+static bool changed(const journal_record_t *rec) {
+    if (rec->routine != last.routine || rec->done != last.done || rec->active != last.active ||
+        rec->on_mask != last.on_mask || rec->timed_mask != last.timed_mask) {
+        return true;
+    }
+    for (int i = 0; i < rec->num_steps; i++) {
+        if (!(rec->active & STEP_BIT(i))) continue;
+        int64_t deadline = (int64_t)rec->time + rec->left[i];
+        int64_t last_deadline = (int64_t)last.time + last.left[i];
+        if (deadline > last_deadline + 2 || deadline < last_deadline - 2) return true;
+    }
+    return false;
+}
+
+static void journal_task(void *pvParameters) {
+    for (;;) {
+        journal_record_t rec;
+        current_record(&rec);
+        if (changed(&rec)) {
+            save(&rec);
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        // Let a step ending and the next one starting land in one record
+        vTaskDelay(pdMS_TO_TICKS(JOURNAL_SETTLE_MS));
+    }
+}
+
+static void on_relay_event(relay_event_t event, uint8_t relay_num) {
+    xTaskNotifyGive(journal_task_handle);
+}
+
+static const char *reset_reason_str(esp_reset_reason_t reason) {
+    switch (reason) {
+        case ESP_RST_POWERON: return "power-on";
+        case ESP_RST_BROWNOUT: return "brownout";
+        case ESP_RST_PANIC: return "panic";
+        case ESP_RST_INT_WDT:
+        case ESP_RST_TASK_WDT:
+        case ESP_RST_WDT: return "watchdog";
+        case ESP_RST_SW: return "restart";
+        default: return "other";
+    }
+}
+
+static journal_outcome_t replay(const journal_record_t *rec) {
+    if (rec->seq == 0) return JOURNAL_CLEAN;
+    const char *reason = reset_reason_str(esp_reset_reason());
+    if (rec->routine == 0) {
+        if (rec->on_mask) {
+            ESP_LOGW(TAG, "Reset (%s) with relay mask 0x%llx on; leaving them off", reason,
+                     (unsigned long long)rec->on_mask);
+        }
+        return JOURNAL_CLEAN;
+    }
+
+    static routine_step_t steps[MAX_ROUTINE_STEPS];
+    int index = -1;
+    int num_steps = 0;
+    for (int i = 0; i < routine_store_count() && index < 0; i++) {
+        num_steps = routine_store_steps(i, steps);
+        if (num_steps == rec->num_steps && routine_hash(routine_store_name(i), steps, num_steps) == rec->routine) {
+            index = i;
+        }
+    }
+    if (index < 0) {
+        ESP_LOGW(TAG, "Reset (%s) during a routine that has since changed; not resuming", reason);
+        return JOURNAL_ABORTED;
+    }
+
+    const char *name = routine_store_name(index);
+    int64_t now = time(NULL);
+    // The clock survives a panic, watchdog or software reset but starts
+    // over after a power loss, and then the downtime is unknown
+    if (now < rec->time) {
+        ESP_LOGW(TAG, "Reset (%s) during '%s'; downtime unknown, not resuming", reason, name);
+        return JOURNAL_ABORTED;
+    }
+    int64_t gap = now - rec->time;
+    if (gap > JOURNAL_RESUME_WINDOW_SEC) {
+        ESP_LOGW(TAG, "Reset (%s) during '%s'; down for %lld s, not resuming", reason, name, (long long)gap);
+        return JOURNAL_ABORTED;
+    }
+
+    // Skip what would have run while the device was down, packing the
+    // steps as the routine task would and giving each its full length
+    routine_limits_t limits;
+    relay_get_routine_limits(&limits);
+    routine_progress_t progress = { .done = rec->done };
+    step_mask_t running = rec->active & ~rec->done;
+    for (int i = 0; i < num_steps; i++) {
+        if (running & STEP_BIT(i)) progress.left[i] = rec->left[i];
+    }
+    int64_t t = gap;
+    for (;;) {
+        step_mask_t start = relay_routine_startable(steps, num_steps, progress.done, running, &limits);
+        for (int i = 0; i < num_steps; i++) {
+            if (start & STEP_BIT(i)) progress.left[i] = steps[i].duration_sec;
+        }
+        running |= start;
+        if (running == 0) break;
+        int64_t next = INT64_MAX;   // Until the first running step ends
+        for (int i = 0; i < num_steps; i++) {
+            if ((running & STEP_BIT(i)) && progress.left[i] < next) next = progress.left[i];
+        }
+        int64_t dt = next < t ? next : t;
+        for (int i = 0; i < num_steps; i++) {
+            if (!(running & STEP_BIT(i))) continue;
+            progress.left[i] -= dt;
+            if (progress.left[i] == 0) {
+                progress.done |= STEP_BIT(i);
+                running &= ~STEP_BIT(i);
+            }
+        }
+        t -= dt;
+        if (t == 0 && next > dt) break;
+    }
+    if (running == 0) {
+        ESP_LOGI(TAG, "Reset (%s) during '%s'; it would have finished by now", reason, name);
+        return JOURNAL_FINISHED;
+    }
+    if (routine_store_resume(index, &progress) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to resume '%s'", name);
+        return JOURNAL_ABORTED;
+    }
+    ESP_LOGW(TAG, "Reset (%s) during '%s'; resuming with %d of %d steps done",
+             reason, name, __builtin_popcountll(progress.done), num_steps);
+    return JOURNAL_RESUMED;
+}
+
+journal_outcome_t journal_recover(void) {
+    int64_t start = esp_timer_get_time();
+    last = load_last();
+    journal_outcome_t outcome = replay(&last);
+    int64_t took = esp_timer_get_time() - start;
+    if (took > JOURNAL_BOOT_BUDGET_US) {
+        ESP_LOGW(TAG, "Replay took %lld us (budget %d us)", (long long)took, JOURNAL_BOOT_BUDGET_US);
+    }
+    return outcome;
+}
+
+void journal_init(void) {
+    journal_recover();
+
+    // Below every other task: a record can wait, and NVS writes then never
+    // delay switching
+    if (xTaskCreate(journal_task, "journal_task", 3072, NULL, tskIDLE_PRIORITY + 1, &journal_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create journal task");
+        return;
+    }
+    if (!relay_add_listener(on_relay_event)) {
+        ESP_LOGE(TAG, "No room for the journal listener");
+    }
+}
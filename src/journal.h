@@ -0,0 +1,24 @@
+#pragma once
+#include <stdint.h>
+
+#define JOURNAL_SLOTS 8                 // Records kept in NVS, oldest overwritten
+#define JOURNAL_SETTLE_MS 50            // Changes this close together make one record
+#define JOURNAL_RESUME_WINDOW_SEC 600   // Older interruptions are abandoned
+#define JOURNAL_BOOT_BUDGET_US 20000    // journal_recover() should finish within this
+
+typedef enum {
+    JOURNAL_CLEAN = 0,      // No routine was running at reset
+    JOURNAL_RESUMED,        // Restarted at the step and time it was cut off
+    JOURNAL_FINISHED,       // Would have ended while the device was down
+    JOURNAL_ABORTED         // Downtime unknown or too long, or the routine changed
+} journal_outcome_t;
+
+// Replays the journal and resumes or abandons a routine cut short by a
+// reset, then starts recording relay and routine transitions. Call after
+// routine_store_init() and relay_init(), before anything can start a
+// routine.
+void journal_init(void);
+
+// The replay half of journal_init(); relays must all be off and no
+// routine running
+journal_outcome_t journal_recover(void);
@@ -0,0 +1,316 @@
+#include "json_reader.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    ST_VALUE = 0,   // Expecting a value
+    ST_ARR_FIRST,   // Just after '[': a value or ']'
+    ST_OBJ_FIRST,   // Just after '{': a member name or '}'
+    ST_KEY,         // After ',' in an object
+    ST_COLON,
+    ST_AFTER,       // After a value: ',' or a closing bracket
+    ST_STRING,
+    ST_NUMBER,
+    ST_LITERAL,
+    ST_DONE,
+    ST_ERROR
+};
+
+void json_reader_init(json_reader_t *r, json_event_fn on_event, void *ctx) {
+    memset(r, 0, sizeof(*r));
+    r->on_event = on_event;
+    r->ctx = ctx;
+    r->state = ST_VALUE;
+}
+
+static bool fail(json_reader_t *r, const char *why) {
+    if (r->error == NULL) r->error = why;
+    r->state = ST_ERROR;
+    return false;
+}
+
+static bool in_object(const json_reader_t *r) {
+    return r->depth > 0 && (r->obj_mask & (1u << (r->depth - 1)));
+}
+
+static bool emit(json_reader_t *r, json_event_t type) {
+    json_token_t tok = {
+        .type = type,
+        .depth = r->depth,
+        .key = (in_object(r) && r->has_key) ? r->key : NULL,
+        .str = r->str,
+        .len = r->str_len,
+        .truncated = r->truncated,
+        .boolean = (type == JSON_BOOL && r->literal[0] == 't'),
+    };
+    if (!r->on_event(r->ctx, &tok)) {
+        return fail(r, "aborted");
+    }
+    return true;
+}
+
+// A scalar or a closing bracket completed the current value
+static void value_done(json_reader_t *r) {
+    r->has_key = false;
+    r->state = (r->depth == 0) ? ST_DONE : ST_AFTER;
+}
+
+static bool push(json_reader_t *r, bool object) {
+    if (r->depth >= JSON_READER_MAX_DEPTH) return fail(r, "nested too deeply");
+    r->str_len = 0;
+    r->str[0] = '\0';
+    if (!emit(r, object ? JSON_OBJ_BEGIN : JSON_ARR_BEGIN)) return false;
+    if (object) {
+        r->obj_mask |= 1u << r->depth;
+    } else {
+        r->obj_mask &= ~(1u << r->depth);
+    }
+    r->depth++;
+    r->has_key = false;
+    r->state = object ? ST_OBJ_FIRST : ST_ARR_FIRST;
+    return true;
+}
+
+static bool pop(json_reader_t *r, bool object) {
+    if (r->depth == 0 || in_object(r) != object) return fail(r, "mismatched bracket");
+    r->depth--;
+    r->has_key = false;
+    if (!emit(r, object ? JSON_OBJ_END : JSON_ARR_END)) return false;
+    value_done(r);
+    return true;
+}
+
+static void start_string(json_reader_t *r, bool key) {
+    r->in_key = key;
+    r->str_len = 0;
+    r->truncated = false;
+    r->esc = 0;
+    r->state = ST_STRING;
+}
+
+static void append(json_reader_t *r, char c) {
+    if (r->str_len < JSON_READER_MAX_STR - 1) {
+        r->str[r->str_len++] = c;
+    } else {
+        r->truncated = true;
+    }
+}
+
+static void append_utf8(json_reader_t *r, uint16_t code) {
+    if (code < 0x80) {
+        append(r, code);
+    } else if (code < 0x800) {
+        append(r, 0xc0 | (code >> 6));
+        append(r, 0x80 | (code & 0x3f));
+    } else {
+        append(r, 0xe0 | (code >> 12));
+        append(r, 0x80 | ((code >> 6) & 0x3f));
+        append(r, 0x80 | (code & 0x3f));
+    }
+}
+
+static bool end_string(json_reader_t *r) {
+    r->str[r->str_len] = '\0';
+    if (r->in_key) {
+        size_t n = r->str_len < JSON_READER_MAX_KEY - 1 ? r->str_len : JSON_READER_MAX_KEY - 1;
+        memcpy(r->key, r->str, n);
+        r->key[n] = '\0';
+        r->has_key = true;
+        r->state = ST_COLON;
+        return true;
+    }
+    if (!emit(r, JSON_STRING)) return false;
+    value_done(r);
+    return true;
+}
+
+static bool string_char(json_reader_t *r, char c) {
+    if (r->esc == 1) {
+        r->esc = 0;
+        switch (c) {
+            case '"': case '\\': case '/': append(r, c); return true;
+            case 'b': append(r, '\b'); return true;
+            case 'f': append(r, '\f'); return true;
+            case 'n': append(r, '\n'); return true;
+            case 'r': append(r, '\r'); return true;
+            case 't': append(r, '\t'); return true;
+            case 'u': r->esc = 2; r->code = 0; return true;
+            default: return fail(r, "invalid escape");
+        }
+    }
+    if (r->esc >= 2) {
+        int v;
+        if (c >= '0' && c <= '9') v = c - '0';
+        else if (c >= 'a' && c <= 'f') v = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') v = c - 'A' + 10;
+        else return fail(r, "invalid \\u escape");
+        r->code = (r->code << 4) | v;
+        if (++r->esc == 6) {
+            r->esc = 0;
+            append_utf8(r, r->code);
+        }
+        return true;
+    }
+    if (c == '\\') {
+        r->esc = 1;
+        return true;
+    }
+    if (c == '"') return end_string(r);
+    if ((unsigned char)c < 0x20) return fail(r, "control character in string");
+    append(r, c);
+    return true;
+}
+
+// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+static bool valid_number(const char *s) {
+    if (*s == '-') s++;
+    if (*s == '0') {
+        s++;
+    } else if (*s >= '1' && *s <= '9') {
+        while (*s >= '0' && *s <= '9') s++;
+    } else {
+        return false;
+    }
+    if (*s == '.') {
+        s++;
+        if (!(*s >= '0' && *s <= '9')) return false;
+        while (*s >= '0' && *s <= '9') s++;
+    }
+    if (*s == 'e' || *s == 'E') {
+        s++;
+        if (*s == '+' || *s == '-') s++;
+        if (!(*s >= '0' && *s <= '9')) return false;
+        while (*s >= '0' && *s <= '9') s++;
+    }
+    return *s == '\0';
+}
+
+static bool end_number(json_reader_t *r) {
+    r->str[r->str_len] = '\0';
+    if (!valid_number(r->str)) return fail(r, "invalid number");
+    if (!emit(r, JSON_NUMBER)) return false;
+    value_done(r);
+    return true;
+}
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool start_value(json_reader_t *r, char c) {
+    switch (c) {
+        case '{': return push(r, true);
+        case '[': return push(r, false);
+        case '"': start_string(r, false); return true;
+        case 't': r->literal = "true"; break;
+        case 'f': r->literal = "false"; break;
+        case 'n': r->literal = "null"; break;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                r->str_len = 0;
+                r->truncated = false;
+                append(r, c);
+                r->state = ST_NUMBER;
+                return true;
+            }
+            return fail(r, "unexpected character");
+    }
+    r->lit_pos = 1;
+    r->state = ST_LITERAL;
+    return true;
+}
+
+static bool step(json_reader_t *r, char c) {
+    switch (r->state) {
+        case ST_STRING:
+            return string_char(r, c);
+
+        case ST_NUMBER:
+            if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+                if (r->str_len >= JSON_READER_MAX_STR - 1) return fail(r, "number too long");
+                append(r, c);
+                return true;
+            }
+            // The terminating character belongs to whatever follows
+            return end_number(r) && step(r, c);
+
+        case ST_LITERAL:
+            if (c != r->literal[r->lit_pos]) return fail(r, "invalid literal");
+            if (r->literal[++r->lit_pos] != '\0') return true;
+            r->str_len = 0;
+            r->str[0] = '\0';
+            if (!emit(r, r->literal[0] == 'n' ? JSON_NULL : JSON_BOOL)) return false;
+            value_done(r);
+            return true;
+
+        default:
+            break;
+    }
+
+    if (is_space(c)) return true;
+
+    switch (r->state) {
+        case ST_ARR_FIRST:
+            if (c == ']') return pop(r, false);
+            return start_value(r, c);
+        case ST_VALUE:
+            return start_value(r, c);
+        case ST_OBJ_FIRST:
+            if (c == '}') return pop(r, true);
+            // fall through
+        case ST_KEY:
+            if (c != '"') return fail(r, "expected member name");
+            start_string(r, true);
+            return true;
+        case ST_COLON:
+            if (c != ':') return fail(r, "expected ':'");
+            r->state = ST_VALUE;
+            return true;
+        case ST_AFTER:
+            if (c == ',') {
+                r->state = in_object(r) ? ST_KEY : ST_VALUE;
+                return true;
+            }
+            if (c == ']') return pop(r, false);
+            if (c == '}') return pop(r, true);
+            return fail(r, "expected ',' or closing bracket");
+        case ST_DONE:
+            return fail(r, "trailing characters");
+        default:
+            return false;
+    }
+}
+
+bool json_reader_feed(json_reader_t *r, const char *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (r->state == ST_ERROR || !step(r, data[i])) return false;
+        r->pos++;
+    }
+    return r->state != ST_ERROR;
+}
+
+bool json_reader_finish(json_reader_t *r) {
+    if (r->state == ST_ERROR) return false;
+    if (r->state == ST_NUMBER && r->depth == 0 && !end_number(r)) return false;
+    if (r->state != ST_DONE) return fail(r, "unexpected end of input");
+    return true;
+}
+
+bool json_token_int64(const json_token_t *tok, int64_t *out) {
+    if (tok->type != JSON_NUMBER) return false;
+    char *end;
+    errno = 0;
+    long long v = strtoll(tok->str, &end, 10);
+    if (end != tok->str + tok->len || errno == ERANGE) return false;
+    *out = v;
+    return true;
+}
+
+bool json_token_int(const json_token_t *tok, int32_t *out) {
+    int64_t v;
+    if (!json_token_int64(tok, &v) || v < INT32_MIN || v > INT32_MAX) return false;
+    *out = (int32_t)v;
+    return true;
+}
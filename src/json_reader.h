@@ -0,0 +1,68 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Incremental (push) JSON parser. Input can be fed in chunks of any size,
+// e.g. straight from httpd_req_recv(), and every value is reported to a
+// callback as soon as it is complete, so documents of any size are
+// validated in fixed memory without building a tree.
+
+#define JSON_READER_MAX_DEPTH 16
+#define JSON_READER_MAX_KEY 24  // longer member names are truncated
+#define JSON_READER_MAX_STR 64  // longer string values are truncated
+
+typedef enum {
+    JSON_OBJ_BEGIN = 0,
+    JSON_OBJ_END,
+    JSON_ARR_BEGIN,
+    JSON_ARR_END,
+    JSON_STRING,
+    JSON_NUMBER,
+    JSON_BOOL,
+    JSON_NULL
+} json_event_t;
+
+typedef struct {
+    json_event_t type;
+    uint8_t depth;      // Containers enclosing the value; the root is 0
+    const char *key;    // Member name inside an object, NULL in an array
+    const char *str;    // String value, or the text of a number
+    size_t len;
+    bool truncated;     // String was longer than JSON_READER_MAX_STR - 1
+    bool boolean;
+} json_token_t;
+
+// Returns false to abort parsing; set the reader's error first to say why
+typedef bool (*json_event_fn)(void *ctx, const json_token_t *tok);
+
+typedef struct {
+    json_event_fn on_event;
+    void *ctx;
+    uint8_t state;
+    uint8_t depth;
+    uint32_t obj_mask;  // Bit n set when level n is an object
+    bool in_key;
+    bool has_key;
+    uint8_t esc;        // 0, 1 after a backslash, 2-5 inside \uXXXX
+    uint16_t code;
+    uint8_t lit_pos;
+    const char *literal;
+    char key[JSON_READER_MAX_KEY];
+    char str[JSON_READER_MAX_STR];
+    size_t str_len;
+    bool truncated;
+    size_t pos;         // Bytes consumed so far
+    const char *error;  // Set once parsing failed
+} json_reader_t;
+
+void json_reader_init(json_reader_t *r, json_event_fn on_event, void *ctx);
+// Parses the next chunk. Returns false once the document is invalid or the
+// callback aborted; r->error and r->pos say why and where.
+bool json_reader_feed(json_reader_t *r, const char *data, size_t len);
+// Call at end of input. Fails unless exactly one complete value was read.
+bool json_reader_finish(json_reader_t *r);
+
+// Parse a JSON_NUMBER token as a whole number
+bool json_token_int(const json_token_t *tok, int32_t *out);
+bool json_token_int64(const json_token_t *tok, int64_t *out);
@@ -0,0 +1,161 @@
+#include "json_writer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void json_writer_init(json_writer_t *w, char *buf, size_t cap, json_flush_fn flush, void *ctx) {
+    w->buf = buf;
+    w->cap = cap;
+    w->len = 0;
+    w->flush = flush;
+    w->ctx = ctx;
+    w->need_comma = false;
+    w->flushed = false;
+    w->error = false;
+}
+
+bool json_writer_flush(json_writer_t *w) {
+    if (w->error) return false;
+    if (w->len == 0) return true;
+    if (w->flush == NULL || !w->flush(w->ctx, w->buf, w->len)) {
+        w->error = true;
+        return false;
+    }
+    w->len = 0;
+    w->flushed = true;
+    return true;
+}
+
+static void put(json_writer_t *w, const char *data, size_t n) {
+    while (n > 0 && !w->error) {
+        if (w->len == w->cap && !json_writer_flush(w)) return;
+        size_t room = w->cap - w->len;
+        size_t take = n < room ? n : room;
+        memcpy(w->buf + w->len, data, take);
+        w->len += take;
+        data += take;
+        n -= take;
+    }
+}
+
+static void put_char(json_writer_t *w, char c) {
+    put(w, &c, 1);
+}
+
+static void separator(json_writer_t *w) {
+    if (w->need_comma) put_char(w, ',');
+}
+
+// Same escaping rules as cJSON's print_string_ptr()
+static void put_string(json_writer_t *w, const char *s) {
+    put_char(w, '"');
+    const char *run = s;
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        const char *esc = NULL;
+        char hex[7];
+        switch (c) {
+            case '"': esc = "\\\""; break;
+            case '\\': esc = "\\\\"; break;
+            case '\b': esc = "\\b"; break;
+            case '\f': esc = "\\f"; break;
+            case '\n': esc = "\\n"; break;
+            case '\r': esc = "\\r"; break;
+            case '\t': esc = "\\t"; break;
+            default:
+                if (c < 32) {
+                    snprintf(hex, sizeof(hex), "\\u%04x", c);
+                    esc = hex;
+                }
+                break;
+        }
+        if (esc) {
+            put(w, run, s - run);
+            put(w, esc, strlen(esc));
+            run = s + 1;
+        }
+    }
+    put(w, run, s - run);
+    put_char(w, '"');
+}
+
+void json_obj_begin(json_writer_t *w) {
+    separator(w);
+    put_char(w, '{');
+    w->need_comma = false;
+}
+
+void json_obj_end(json_writer_t *w) {
+    put_char(w, '}');
+    w->need_comma = true;
+}
+
+void json_arr_begin(json_writer_t *w) {
+    separator(w);
+    put_char(w, '[');
+    w->need_comma = false;
+}
+
+void json_arr_end(json_writer_t *w) {
+    put_char(w, ']');
+    w->need_comma = true;
+}
+
+void json_key(json_writer_t *w, const char *key) {
+    separator(w);
+    put_string(w, key);
+    put_char(w, ':');
+    w->need_comma = false;
+}
+
+void json_str(json_writer_t *w, const char *value) {
+    separator(w);
+    put_string(w, value);
+    w->need_comma = true;
+}
+
+void json_int(json_writer_t *w, int32_t value) {
+    char num[12];
+    int n = snprintf(num, sizeof(num), "%ld", (long)value);
+    separator(w);
+    put(w, num, n);
+    w->need_comma = true;
+}
+
+void json_uint(json_writer_t *w, uint32_t value) {
+    char num[12];
+    int n = snprintf(num, sizeof(num), "%lu", (unsigned long)value);
+    separator(w);
+    put(w, num, n);
+    w->need_comma = true;
+}
+
+void json_bool(json_writer_t *w, bool value) {
+    separator(w);
+    if (value) {
+        put(w, "true", 4);
+    } else {
+        put(w, "false", 5);
+    }
+    w->need_comma = true;
+}
+
+void json_kv_str(json_writer_t *w, const char *key, const char *value) {
+    json_key(w, key);
+    json_str(w, value);
+}
+
+void json_kv_int(json_writer_t *w, const char *key, int32_t value) {
+    json_key(w, key);
+    json_int(w, value);
+}
+
+void json_kv_uint(json_writer_t *w, const char *key, uint32_t value) {
+    json_key(w, key);
+    json_uint(w, value);
+}
+
+void json_kv_bool(json_writer_t *w, const char *key, bool value) {
+    json_key(w, key);
+    json_bool(w, value);
+}
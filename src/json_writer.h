@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Allocation-free JSON writer. Output goes into a caller-owned buffer;
+// when a flush callback is given the buffer is handed to it whenever it
+// fills up, so documents of any size stream through fixed memory.
+// Output is byte-compatible with cJSON_PrintUnformatted().
+
+// Returns false to abort the document
+typedef bool (*json_flush_fn)(void *ctx, const char *buf, size_t len);
+
+typedef struct {
+    char *buf;
+    size_t cap;
+    size_t len;
+    json_flush_fn flush;
+    void *ctx;
+    bool need_comma;
+    bool flushed;       // At least one flush happened
+    bool error;         // Overflow without a flush callback, or flush failed
+} json_writer_t;
+
+void json_writer_init(json_writer_t *w, char *buf, size_t cap, json_flush_fn flush, void *ctx);
+// Hands any buffered output to the flush callback
+bool json_writer_flush(json_writer_t *w);
+
+void json_obj_begin(json_writer_t *w);
+void json_obj_end(json_writer_t *w);
+void json_arr_begin(json_writer_t *w);
+void json_arr_end(json_writer_t *w);
+
+void json_key(json_writer_t *w, const char *key);
+void json_str(json_writer_t *w, const char *value);
+void json_int(json_writer_t *w, int32_t value);
+void json_uint(json_writer_t *w, uint32_t value);
+void json_bool(json_writer_t *w, bool value);
+
+void json_kv_str(json_writer_t *w, const char *key, const char *value);
+void json_kv_int(json_writer_t *w, const char *key, int32_t value);
+void json_kv_uint(json_writer_t *w, const char *key, uint32_t value);
+void json_kv_bool(json_writer_t *w, const char *key, bool value);
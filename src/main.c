@@ -2,8 +2,16 @@
 #include "freertos/task.h"
 #include "esp_log.h"
 #include "relay_controller.h"
+#include "flow_meter.h"
+#include "moisture.h"
 #include "web_server.h"
+#include "routine_store.h"
+#include "scheduler.h"
+#include "journal.h"
+#include "history.h"
+#include "power_manager.h"
 #include "wifi_manager.h"
+#include "mqtt_bridge.h"
 #include "nvs_flash.h"
 #include "esp_ota_ops.h"
 
@@ -24,6 +32,9 @@ void app_main(void) {
         }
     }
 
+    // Frequency scaling and light sleep, before anything takes PM locks
+    power_init();
+
     // Initialize NVS (needed for Wi-Fi)
     nvs_flash_init();
 
@@ -35,15 +46,36 @@ void app_main(void) {
         ESP_LOGE("APP", "Failed to initialize SPIFFS");
     }
 
+    // Compile saved routines into RAM
+    routine_store_init();
+
+    // Watering log; relays report to it from their first switch
+    history_init();
+
     // Initialize relay GPIOs
     relay_init();
 
+    // Pulse counter on the supply line, if one is fitted; follows the
+    // relays from here on
+    flow_meter_init();
+
+    // Soil-moisture sensors, if any; routine steps consult them
+    moisture_init();
+
+    // Pick up a routine cut short by a reset, then record transitions
+    journal_init();
+
+    // Time-of-day triggers; time comes from SNTP once Wi-Fi is up
+    scheduler_init();
+
+    // Optional broker link; stays off until /api/mqtt sets a broker
+    mqtt_bridge_init();
+
     // Start HTTP server
     web_server_start();
 
     ESP_LOGI("APP", "Relay web server started!");
 
-    while(1) {
-        vTaskDelay(pdMS_TO_TICKS(1000));
-    }
+    // Everything runs in its own task or timer from here; returning ends
+    // the main task, so nothing wakes the CPU unless there is work
 }
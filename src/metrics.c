@@ -0,0 +1,264 @@
+#include "metrics.h"
+#include "relay_controller.h"
+#include "relay_safety.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+static const char *TAG = "METRICS";
+
+// Upper bounds of the latency buckets in microseconds
+static const uint32_t bucket_us[METRICS_BUCKETS] = {
+    1000, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000
+};
+static const char *const bucket_le[METRICS_BUCKETS + 1] = {
+    "0.001", "0.005", "0.01", "0.025", "0.05", "0.1", "0.25", "0.5", "1", "+Inf"
+};
+
+// Counters are bumped with relaxed atomics and never reset. Handlers run on
+// the httpd task and the web workers, so sum_us is atomic too.
+typedef struct {
+    const char *uri;
+    httpd_method_t method;
+    esp_err_t (*handler)(httpd_req_t *req);
+    void *user_ctx;
+    uint32_t requests;
+    uint32_t errors;
+    uint32_t buckets[METRICS_BUCKETS + 1];   // Not cumulative; summed on output
+    uint64_t sum_us;
+} endpoint_t;
+
+static endpoint_t endpoints[METRICS_MAX_ENDPOINTS];
+static int num_endpoints = 0;
+
+static uint32_t relay_switches[RELAY_MAX];
+static uint32_t wifi_reconnects;
+
+static esp_err_t wrapped_handler(httpd_req_t *req) {
+    endpoint_t *ep = req->user_ctx;
+    req->user_ctx = ep->user_ctx;
+
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = ep->handler(req);
+    uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+
+    int b = 0;
+    while (b < METRICS_BUCKETS && us > bucket_us[b]) b++;
+    __atomic_fetch_add(&ep->buckets[b], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ep->requests, 1, __ATOMIC_RELAXED);
+    if (ret != ESP_OK) __atomic_fetch_add(&ep->errors, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ep->sum_us, us, __ATOMIC_RELAXED);
+    return ret;
+}
+
+void metrics_instrument_uri(const httpd_uri_t *uri, httpd_uri_t *out) {
+    *out = *uri;
+    if (num_endpoints >= METRICS_MAX_ENDPOINTS) {
+        ESP_LOGW(TAG, "No room to instrument %s", uri->uri);
+        return;
+    }
+    endpoint_t *ep = &endpoints[num_endpoints++];
+    *ep = (endpoint_t){
+        .uri = uri->uri,
+        .method = uri->method,
+        .handler = uri->handler,
+        .user_ctx = uri->user_ctx,
+    };
+    out->handler = wrapped_handler;
+    out->user_ctx = ep;
+}
+
+esp_err_t metrics_register_uri(httpd_handle_t server, const httpd_uri_t *uri) {
+    httpd_uri_t wrapped;
+    metrics_instrument_uri(uri, &wrapped);
+    return httpd_register_uri_handler(server, &wrapped);
+}
+
+void metrics_relay_switched(uint8_t relay_num) {
+    if (relay_num < RELAY_MAX) __atomic_fetch_add(&relay_switches[relay_num], 1, __ATOMIC_RELAXED);
+}
+
+void metrics_wifi_reconnect(void) {
+    __atomic_fetch_add(&wifi_reconnects, 1, __ATOMIC_RELAXED);
+}
+
+// --- Text output ---------------------------------------------------------------
+
+// The page is formatted into this buffer and sent in chunks. Only used
+// from the httpd task.
+static char out_buf[1024];
+static size_t out_len;
+static bool out_failed;
+
+static void flush_out(httpd_req_t *req) {
+    if (out_len > 0 && !out_failed) {
+        out_failed = httpd_resp_send_chunk(req, out_buf, out_len) != ESP_OK;
+    }
+    out_len = 0;
+}
+
+static void emit(httpd_req_t *req, const char *fmt, ...) {
+    for (int attempt = 0; attempt < 2; attempt++) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(out_buf + out_len, sizeof(out_buf) - out_len, fmt, args);
+        va_end(args);
+        if (n >= 0 && out_len + n < sizeof(out_buf)) {
+            out_len += n;
+            return;
+        }
+        // Did not fit: send what is there and format again at the start
+        flush_out(req);
+    }
+}
+
+static const char *method_str(httpd_method_t method) {
+    switch (method) {
+        case HTTP_GET: return "GET";
+        case HTTP_POST: return "POST";
+        case HTTP_PUT: return "PUT";
+        case HTTP_DELETE: return "DELETE";
+        default: return "OTHER";
+    }
+}
+
+// Endpoints only show up once they have been used, to keep the page short
+static bool used(const endpoint_t *ep) {
+    return __atomic_load_n(&ep->requests, __ATOMIC_RELAXED) > 0;
+}
+
+static void emit_endpoints(httpd_req_t *req) {
+    emit(req, "# HELP autowater_http_requests_total Requests handled, by endpoint\n"
+              "# TYPE autowater_http_requests_total counter\n");
+    for (int i = 0; i < num_endpoints; i++) {
+        const endpoint_t *ep = &endpoints[i];
+        if (!used(ep)) continue;
+        emit(req, "autowater_http_requests_total{method=\"%s\",uri=\"%s\"} %u\n",
+             method_str(ep->method), ep->uri, (unsigned)__atomic_load_n(&ep->requests, __ATOMIC_RELAXED));
+    }
+    emit(req, "# HELP autowater_http_request_errors_total Requests whose handler failed\n"
+              "# TYPE autowater_http_request_errors_total counter\n");
+    for (int i = 0; i < num_endpoints; i++) {
+        const endpoint_t *ep = &endpoints[i];
+        if (!used(ep)) continue;
+        emit(req, "autowater_http_request_errors_total{method=\"%s\",uri=\"%s\"} %u\n",
+             method_str(ep->method), ep->uri, (unsigned)__atomic_load_n(&ep->errors, __ATOMIC_RELAXED));
+    }
+
+    emit(req, "# HELP autowater_http_request_duration_seconds Time spent in the handler\n"
+              "# TYPE autowater_http_request_duration_seconds histogram\n");
+    for (int i = 0; i < num_endpoints; i++) {
+        const endpoint_t *ep = &endpoints[i];
+        if (!used(ep)) continue;
+        const char *method = method_str(ep->method);
+        uint32_t count = 0;
+        for (int b = 0; b <= METRICS_BUCKETS; b++) {
+            count += __atomic_load_n(&ep->buckets[b], __ATOMIC_RELAXED);
+            emit(req, "autowater_http_request_duration_seconds_bucket{method=\"%s\",uri=\"%s\",le=\"%s\"} %u\n",
+                 method, ep->uri, bucket_le[b], (unsigned)count);
+        }
+        uint64_t sum_us = __atomic_load_n(&ep->sum_us, __ATOMIC_RELAXED);
+        emit(req, "autowater_http_request_duration_seconds_sum{method=\"%s\",uri=\"%s\"} %llu.%06llu\n",
+             method, ep->uri, (unsigned long long)(sum_us / 1000000), (unsigned long long)(sum_us % 1000000));
+        emit(req, "autowater_http_request_duration_seconds_count{method=\"%s\",uri=\"%s\"} %u\n",
+             method, ep->uri, (unsigned)count);
+    }
+}
+
+static void emit_resources(httpd_req_t *req) {
+    emit(req, "# HELP autowater_heap_free_bytes Free heap\n"
+              "# TYPE autowater_heap_free_bytes gauge\n"
+              "autowater_heap_free_bytes %u\n"
+              "# HELP autowater_heap_min_free_bytes Lowest free heap since boot\n"
+              "# TYPE autowater_heap_min_free_bytes gauge\n"
+              "autowater_heap_min_free_bytes %u\n"
+              "# HELP autowater_heap_largest_free_block_bytes Largest allocation that would succeed\n"
+              "# TYPE autowater_heap_largest_free_block_bytes gauge\n"
+              "autowater_heap_largest_free_block_bytes %u\n",
+         (unsigned)esp_get_free_heap_size(), (unsigned)esp_get_minimum_free_heap_size(),
+         (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+
+    // A handle of NULL would mean the calling task, so missing tasks are
+    // left out rather than reported as httpd
+    struct { const char *name; TaskHandle_t handle; } tasks[] = {
+        {"httpd", xTaskGetHandle("httpd")},
+        {"timer", xTimerGetTimerDaemonTaskHandle()},
+        {"routine_task", xTaskGetHandle("routine_task")},
+        {"scheduler_task", xTaskGetHandle("scheduler_task")},
+        {"journal_task", xTaskGetHandle("journal_task")},
+        {"history_task", xTaskGetHandle("history_task")},
+        {"web_worker_0", xTaskGetHandle("web_worker_0")},
+        {"web_worker_1", xTaskGetHandle("web_worker_1")},
+        {"mqtt_task", xTaskGetHandle("mqtt_task")},
+        {"safety_task", xTaskGetHandle("safety_task")},
+    };
+    emit(req, "# HELP autowater_task_stack_free_min_bytes Stack never used since the task started\n"
+              "# TYPE autowater_task_stack_free_min_bytes gauge\n");
+    for (size_t i = 0; i < sizeof(tasks) / sizeof(tasks[0]); i++) {
+        if (tasks[i].handle == NULL) continue;
+        emit(req, "autowater_task_stack_free_min_bytes{task=\"%s\"} %u\n",
+             tasks[i].name, (unsigned)uxTaskGetStackHighWaterMark(tasks[i].handle));
+    }
+
+    wifi_ap_record_t ap;
+    if (esp_wifi_sta_get_ap_info(&ap) == ESP_OK) {
+        emit(req, "# HELP autowater_wifi_rssi_dbm Signal strength of the access point\n"
+                  "# TYPE autowater_wifi_rssi_dbm gauge\n"
+                  "autowater_wifi_rssi_dbm %d\n", ap.rssi);
+    }
+    emit(req, "# HELP autowater_wifi_reconnects_total Reconnects after losing the access point\n"
+              "# TYPE autowater_wifi_reconnects_total counter\n"
+              "autowater_wifi_reconnects_total %u\n",
+         (unsigned)__atomic_load_n(&wifi_reconnects, __ATOMIC_RELAXED));
+
+    emit(req, "# HELP autowater_relay_switches_total Output changes, on or off\n"
+              "# TYPE autowater_relay_switches_total counter\n");
+    for (int i = 0; i < relay_count(); i++) {
+        emit(req, "autowater_relay_switches_total{relay=\"%d\"} %u\n",
+             i, (unsigned)__atomic_load_n(&relay_switches[i], __ATOMIC_RELAXED));
+    }
+
+    relay_safety_stats_t safety;
+    relay_safety_get_stats(&safety);
+    emit(req, "# HELP autowater_relay_cutoffs_total Relays the hardware timer switched off past their deadline\n"
+              "# TYPE autowater_relay_cutoffs_total counter\n"
+              "autowater_relay_cutoffs_total %u\n"
+              "# HELP autowater_relay_cutoff_late_max_seconds Longest a relay stayed on past its deadline before a cutoff\n"
+              "# TYPE autowater_relay_cutoff_late_max_seconds gauge\n"
+              "autowater_relay_cutoff_late_max_seconds %u.%06u\n"
+              "# HELP autowater_watchdog_cutoffs_total Task watchdog timeouts, each switching every relay off\n"
+              "# TYPE autowater_watchdog_cutoffs_total counter\n"
+              "autowater_watchdog_cutoffs_total %u\n"
+              "# HELP autowater_deadline_timer_retries_total Relay deadline timer commands the full timer queue refused\n"
+              "# TYPE autowater_deadline_timer_retries_total counter\n"
+              "autowater_deadline_timer_retries_total %u\n",
+         (unsigned)safety.cutoffs, (unsigned)(safety.max_late_us / 1000000), (unsigned)(safety.max_late_us % 1000000),
+         (unsigned)safety.watchdog_trips, (unsigned)safety.timer_retries);
+}
+
+static esp_err_t metrics_handler(httpd_req_t *req) {
+    httpd_resp_set_type(req, "text/plain; version=0.0.4");
+    out_len = 0;
+    out_failed = false;
+    emit_endpoints(req);
+    emit_resources(req);
+    flush_out(req);
+    if (out_failed) return ESP_FAIL;
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+esp_err_t metrics_register(httpd_handle_t server) {
+    httpd_uri_t metrics_uri = {
+        .uri = "/metrics",
+        .method = HTTP_GET,
+        .handler = metrics_handler
+    };
+    return metrics_register_uri(server, &metrics_uri);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+#define METRICS_MAX_ENDPOINTS 40    // Wrapped URI handlers
+#define METRICS_BUCKETS 9           // Latency buckets, plus +Inf
+
+// Drop-in for httpd_register_uri_handler(): counts the handler's requests,
+// failures and latency. Past METRICS_MAX_ENDPOINTS handlers are
+// registered unwrapped.
+esp_err_t metrics_register_uri(httpd_handle_t server, const httpd_uri_t *uri);
+
+// The wrapping alone, for a caller that registers the handler itself
+// (see web_workers.h). out is a copy of uri when there is no room.
+void metrics_instrument_uri(const httpd_uri_t *uri, httpd_uri_t *out);
+
+// Registers GET /metrics, everything below in Prometheus text format
+esp_err_t metrics_register(httpd_handle_t server);
+
+// Counters fed from elsewhere; lock-free, safe from any task
+void metrics_relay_switched(uint8_t relay_num);
+void metrics_wifi_reconnect(void);
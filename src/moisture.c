@@ -0,0 +1,362 @@
+#include "moisture.h"
+#include "relay_controller.h"
+
+#include <esp_log.h>
+#include <string.h>
+#include "nvs.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#ifdef MOISTURE_ADC_CHANNELS
+#include "esp_attr.h"
+#include "esp_adc/adc_continuous.h"
+#include "soc/soc_caps.h"
+#endif
+
+#ifdef MOISTURE_ADC_CHANNELS
+
+static const char *TAG = "MOISTURE";
+
+#define NVS_NAMESPACE "moisture"
+#define NVS_KEY_ZONES "zones"
+#define NO_SENSOR 0xff
+
+static const uint8_t channels[] = {MOISTURE_ADC_CHANNELS};
+#define NUM_SENSORS ((int)(sizeof(channels) / sizeof(channels[0])))
+_Static_assert(NUM_SENSORS <= MOISTURE_MAX_SENSORS, "More moisture sensors than ADC1 channels");
+
+#define FRAME_BYTES (MOISTURE_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)
+// A frame holds the pattern repeated, so a sensor gets at most this many
+#define SENSOR_SAMPLES (MOISTURE_FRAME_SAMPLES / NUM_SENSORS + 1)
+
+typedef struct {
+    uint8_t sensor;     // NO_SENSOR if the zone has none
+    uint8_t dry;        // Percent at or below which steps run in full
+    uint8_t wet;        // Percent at or above which steps are skipped
+} zone_config_t;
+
+typedef struct {
+    int32_t filtered;   // Raw reading in 1/16 LSB, averaged over bursts
+    uint16_t raw;       // The last burst's reading
+    bool valid;         // filtered holds a reading, taken at `at`
+    bool fault;         // The last burst was out of range
+    TickType_t at;
+} sensor_t;
+
+static adc_continuous_handle_t adc = NULL;
+static TaskHandle_t moisture_task_handle = NULL;
+
+// Written by the moisture task and the httpd task, read by the routine
+// task and the status encoders; all under moisture_lock
+static portMUX_TYPE moisture_lock = portMUX_INITIALIZER_UNLOCKED;
+static sensor_t sensors[NUM_SENSORS];
+static zone_config_t zones[RELAY_MAX];
+
+// Runs in the ADC's DMA interrupt once per frame
+static bool IRAM_ATTR on_conv_done(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata,
+                                   void *user_data) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(moisture_task_handle, &woken);
+    return woken == pdTRUE;
+}
+
+// Mean of the middle half of a burst's samples, in 1/16 LSB, so a few
+// spikes from the pump or a long cable cannot move it. Sorts s.
+static int32_t trimmed_mean(uint16_t *s, int n) {
+    for (int i = 1; i < n; i++) {
+        uint16_t v = s[i];
+        int j = i;
+        for (; j > 0 && s[j - 1] > v; j--) s[j] = s[j - 1];
+        s[j] = v;
+    }
+    int lo = n / 4, hi = n - n / 4;
+    int32_t sum = 0;
+    for (int i = lo; i < hi; i++) sum += s[i];
+    return (sum * 16 + (hi - lo) / 2) / (hi - lo);
+}
+
+// 0 (dry) to 100 (wet) from a filtered reading
+static int to_percent(int32_t filtered) {
+    const int32_t span = (MOISTURE_RAW_DRY - MOISTURE_RAW_WET) * 16;
+    int32_t p = ((MOISTURE_RAW_DRY * 16 - filtered) * 100 + span / 2) / span;
+    return p < 0 ? 0 : p > 100 ? 100 : (int)p;
+}
+
+// One frame of every channel, filtered into sensors[]
+static void burst(void) {
+    static uint8_t frame[FRAME_BYTES];
+    static uint16_t samples[NUM_SENSORS][SENSOR_SAMPLES];
+    uint32_t len = 0;
+
+    // Drop what a previous burst left in the pool, and its notifications
+    while (adc_continuous_read(adc, frame, FRAME_BYTES, &len, 0) == ESP_OK) {
+    }
+    ulTaskNotifyTake(pdTRUE, 0);
+    esp_err_t err = adc_continuous_start(adc);
+    if (err == ESP_OK) {
+        // A frame takes MOISTURE_FRAME_SAMPLES / MOISTURE_SAMPLE_HZ, 13 ms
+        err = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100)) ? ESP_OK : ESP_ERR_TIMEOUT;
+        if (err == ESP_OK) err = adc_continuous_read(adc, frame, FRAME_BYTES, &len, 0);
+        adc_continuous_stop(adc);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "No ADC frame (%s)", esp_err_to_name(err));
+        return;
+    }
+
+    int n[NUM_SENSORS] = {0};
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= len; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        adc_digi_output_data_t d;
+        memcpy(&d, &frame[i], sizeof(d));
+        for (int s = 0; s < NUM_SENSORS; s++) {
+            if (d.type2.channel == channels[s] && n[s] < SENSOR_SAMPLES) {
+                samples[s][n[s]++] = d.type2.data;
+                break;
+            }
+        }
+    }
+
+    TickType_t now = xTaskGetTickCount();
+    for (int s = 0; s < NUM_SENSORS; s++) {
+        if (n[s] == 0) continue;
+        int32_t mean = trimmed_mean(samples[s], n[s]);
+        bool fault = mean < MOISTURE_RAW_MIN * 16 || mean > MOISTURE_RAW_MAX * 16;
+        portENTER_CRITICAL(&moisture_lock);
+        sensor_t *sn = &sensors[s];
+        bool was_fault = sn->fault;
+        sn->raw = (mean + 8) / 16;
+        sn->fault = fault;
+        if (!fault) {
+            // Exponential average over bursts; a stale one starts over
+            if (!sn->valid || now - sn->at > pdMS_TO_TICKS(MOISTURE_STALE_SEC * 1000)) {
+                sn->filtered = mean;
+            } else {
+                sn->filtered += (mean - sn->filtered) / (1 << MOISTURE_EMA_SHIFT);
+            }
+            sn->valid = true;
+            sn->at = now;
+        }
+        portEXIT_CRITICAL(&moisture_lock);
+        if (fault && !was_fault) {
+            ESP_LOGW(TAG, "Sensor %d (channel %d) reads %d, check its cable", s, channels[s], (mean + 8) / 16);
+        }
+    }
+}
+
+// Sleeps between bursts, so it wakes twice per MOISTURE_PERIOD_SEC: once
+// to start the ADC and once when the frame is in
+static void moisture_task(void *pvParameters) {
+    for (;;) {
+        burst();
+        vTaskDelay(pdMS_TO_TICKS(MOISTURE_PERIOD_SEC * 1000));
+    }
+}
+
+static void load_zones(void) {
+    for (int i = 0; i < RELAY_MAX; i++) {
+        zones[i] = (zone_config_t){ .sensor = NO_SENSOR };
+    }
+    nvs_handle_t nvs;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+        zone_config_t saved[RELAY_MAX];
+        size_t len = sizeof(saved);
+        if (nvs_get_blob(nvs, NVS_KEY_ZONES, saved, &len) == ESP_OK && len == sizeof(saved)) {
+            for (int i = 0; i < RELAY_MAX; i++) {
+                if (saved[i].sensor < NUM_SENSORS && saved[i].dry < saved[i].wet && saved[i].wet <= 100) {
+                    zones[i] = saved[i];
+                }
+            }
+        }
+        nvs_close(nvs);
+    }
+}
+
+void moisture_init(void) {
+    load_zones();
+
+    adc_continuous_handle_cfg_t handle_config = {
+        .max_store_buf_size = FRAME_BYTES * 2,
+        .conv_frame_size = FRAME_BYTES,
+    };
+    adc_digi_pattern_config_t pattern[NUM_SENSORS];
+    for (int s = 0; s < NUM_SENSORS; s++) {
+        pattern[s] = (adc_digi_pattern_config_t){
+            .atten = ADC_ATTEN_DB_12,
+            .channel = channels[s],
+            .unit = ADC_UNIT_1,
+            .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+        };
+    }
+    adc_continuous_config_t config = {
+        .pattern_num = NUM_SENSORS,
+        .adc_pattern = pattern,
+        .sample_freq_hz = MOISTURE_SAMPLE_HZ,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+    };
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = on_conv_done,
+    };
+    esp_err_t err = adc_continuous_new_handle(&handle_config, &adc);
+    if (err == ESP_OK) err = adc_continuous_config(adc, &config);
+    if (err == ESP_OK) err = adc_continuous_register_event_callbacks(adc, &cbs, NULL);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set up the ADC (%s)", esp_err_to_name(err));
+        return;
+    }
+
+    if (xTaskCreate(moisture_task, "moisture_task", 3072, NULL, tskIDLE_PRIORITY + 1,
+                    &moisture_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create moisture task");
+        return;
+    }
+    ESP_LOGI(TAG, "%d moisture sensor(s), read every %d s", NUM_SENSORS, MOISTURE_PERIOD_SEC);
+}
+
+int moisture_sensors(void) {
+    return moisture_task_handle ? NUM_SENSORS : 0;
+}
+
+esp_err_t moisture_set_zone(uint8_t zone, int sensor, uint8_t dry, uint8_t wet) {
+    if (zone >= RELAY_MAX || sensor >= NUM_SENSORS || (sensor >= 0 && (dry >= wet || wet > 100))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    zone_config_t cfg = sensor < 0 ? (zone_config_t){ .sensor = NO_SENSOR }
+                                   : (zone_config_t){ .sensor = sensor, .dry = dry, .wet = wet };
+    zone_config_t saved[RELAY_MAX];
+    portENTER_CRITICAL(&moisture_lock);
+    zones[zone] = cfg;
+    memcpy(saved, zones, sizeof(saved));
+    portEXIT_CRITICAL(&moisture_lock);
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err != ESP_OK) return err;
+    err = nvs_set_blob(nvs, NVS_KEY_ZONES, saved, sizeof(saved));
+    if (err == ESP_OK) err = nvs_commit(nvs);
+    nvs_close(nvs);
+    return err;
+}
+
+// Call with moisture_lock held
+static bool sensor_ok(const sensor_t *sn, TickType_t now) {
+    return sn->valid && !sn->fault && now - sn->at <= pdMS_TO_TICKS(MOISTURE_STALE_SEC * 1000);
+}
+
+uint16_t moisture_step_share(uint8_t zone, int *percent) {
+    if (percent) *percent = -1;
+    if (zone >= RELAY_MAX) return 1000;
+    portENTER_CRITICAL(&moisture_lock);
+    zone_config_t cfg = zones[zone];
+    bool ok = cfg.sensor < NUM_SENSORS && sensor_ok(&sensors[cfg.sensor], xTaskGetTickCount());
+    int32_t filtered = ok ? sensors[cfg.sensor].filtered : 0;
+    portEXIT_CRITICAL(&moisture_lock);
+    if (!ok) return 1000;
+
+    int p = to_percent(filtered);
+    if (percent) *percent = p;
+    if (p <= cfg.dry) return 1000;
+    if (p >= cfg.wet) return 0;
+    return (uint32_t)(cfg.wet - p) * 1000 / (cfg.wet - cfg.dry);
+}
+
+static const char *sensor_state(const sensor_t *sn, TickType_t now) {
+    if (sn->fault) return "fault";
+    if (!sn->valid) return "none";
+    return sensor_ok(sn, now) ? "ok" : "stale";
+}
+
+// {"value":..,"raw":..,"state":..}; the value only with a usable reading
+static void write_sensor(json_writer_t *w, const sensor_t *sn, TickType_t now) {
+    const char *state = sensor_state(sn, now);
+    json_obj_begin(w);
+    if (sn->valid && !sn->fault) json_kv_int(w, "value", to_percent(sn->filtered));
+    if (sn->valid || sn->fault) json_kv_uint(w, "raw", sn->raw);
+    json_kv_str(w, "state", state);
+    json_obj_end(w);
+}
+
+void moisture_write_json(json_writer_t *w) {
+    if (moisture_sensors() == 0) return;
+    sensor_t copy[NUM_SENSORS];
+    portENTER_CRITICAL(&moisture_lock);
+    memcpy(copy, sensors, sizeof(copy));
+    portEXIT_CRITICAL(&moisture_lock);
+
+    TickType_t now = xTaskGetTickCount();
+    json_key(w, "moisture");
+    json_arr_begin(w);
+    for (int s = 0; s < NUM_SENSORS; s++) write_sensor(w, &copy[s], now);
+    json_arr_end(w);
+}
+
+void moisture_write_config_json(json_writer_t *w) {
+    sensor_t copy[NUM_SENSORS];
+    zone_config_t cfg[RELAY_MAX];
+    portENTER_CRITICAL(&moisture_lock);
+    memcpy(copy, sensors, sizeof(copy));
+    memcpy(cfg, zones, sizeof(cfg));
+    portEXIT_CRITICAL(&moisture_lock);
+
+    TickType_t now = xTaskGetTickCount();
+    json_obj_begin(w);
+    json_kv_int(w, "period", MOISTURE_PERIOD_SEC);
+    json_key(w, "sensors");
+    json_arr_begin(w);
+    for (int s = 0; s < moisture_sensors(); s++) {
+        json_obj_begin(w);
+        json_kv_int(w, "channel", channels[s]);
+        if (copy[s].valid) json_kv_uint(w, "age", pdTICKS_TO_MS(now - copy[s].at) / 1000);
+        json_key(w, "reading");
+        write_sensor(w, &copy[s], now);
+        json_obj_end(w);
+    }
+    json_arr_end(w);
+    json_key(w, "zones");
+    json_arr_begin(w);
+    for (int i = 0; i < RELAY_MAX; i++) {
+        if (cfg[i].sensor == NO_SENSOR) continue;
+        json_obj_begin(w);
+        json_kv_int(w, "zone", i);
+        json_kv_int(w, "sensor", cfg[i].sensor);
+        json_kv_int(w, "dry", cfg[i].dry);
+        json_kv_int(w, "wet", cfg[i].wet);
+        json_obj_end(w);
+    }
+    json_arr_end(w);
+    json_obj_end(w);
+}
+
+#else
+
+void moisture_init(void) {
+}
+
+int moisture_sensors(void) {
+    return 0;
+}
+
+esp_err_t moisture_set_zone(uint8_t zone, int sensor, uint8_t dry, uint8_t wet) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+uint16_t moisture_step_share(uint8_t zone, int *percent) {
+    if (percent) *percent = -1;
+    return 1000;
+}
+
+void moisture_write_json(json_writer_t *w) {
+}
+
+void moisture_write_config_json(json_writer_t *w) {
+    json_obj_begin(w);
+    json_kv_int(w, "period", MOISTURE_PERIOD_SEC);
+    json_key(w, "sensors");
+    json_arr_begin(w);
+    json_arr_end(w);
+    json_key(w, "zones");
+    json_arr_begin(w);
+    json_arr_end(w);
+    json_obj_end(w);
+}
+
+#endif
@@ -0,0 +1,58 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "json_writer.h"
+
+// Optional capacitive soil-moisture sensors on ADC1, for skipping or
+// shortening routine steps on wet soil. List the channels with
+// -D MOISTURE_ADC_CHANNELS=0,1 in platformio.ini (on the C6, channel n is
+// GPIO n; 5 and 6 drive relays). Without it every call below is a no-op
+// and steps run as planned.
+//
+// The ADC runs in continuous mode in short bursts: its DMA fills one frame
+// with conversions of every channel and interrupts once, so the CPU wakes
+// per burst rather than per sample. Between bursts the converter is
+// stopped and does not hold the chip out of light sleep.
+#ifndef MOISTURE_RAW_DRY
+#define MOISTURE_RAW_DRY 3000       // Raw reading in dry air (12 bit, 12 dB)
+#endif
+#ifndef MOISTURE_RAW_WET
+#define MOISTURE_RAW_WET 1400       // Raw reading in water
+#endif
+#ifndef MOISTURE_PERIOD_SEC
+#define MOISTURE_PERIOD_SEC 300     // Time between bursts
+#endif
+#define MOISTURE_SAMPLE_HZ 20000    // Conversion rate within a burst
+#define MOISTURE_FRAME_SAMPLES 256  // Conversions per burst, over all channels
+#define MOISTURE_EMA_SHIFT 2        // Bursts are averaged with weight 1/4
+#define MOISTURE_STALE_SEC (3 * MOISTURE_PERIOD_SEC)
+// Readings outside this mean an open or shorted sensor cable
+#define MOISTURE_RAW_MIN 200
+#define MOISTURE_RAW_MAX 3900
+#define MOISTURE_MAX_SENSORS 7      // ADC1 channels on the C6
+
+#ifdef MOISTURE_ADC_CHANNELS
+// "moisture":[..] in /api/status, one object of up to 40 bytes per sensor
+#define MOISTURE_JSON_MAX (MOISTURE_MAX_SENSORS * 40 + 16)
+#else
+#define MOISTURE_JSON_MAX 0
+#endif
+
+// Starts the sampling task and loads the zone settings. Call after
+// relay_init().
+void moisture_init(void);
+int moisture_sensors(void);
+// Ties a zone to a sensor: at or below `dry` percent its steps run in
+// full, at or above `wet` they are skipped, and in between they are
+// shortened in proportion. sensor -1 unties it. Saved to NVS.
+esp_err_t moisture_set_zone(uint8_t zone, int sensor, uint8_t dry, uint8_t wet);
+// Share of a step on this zone to water, in per mille, and the moisture
+// it was based on (-1 if none). A zone without a sensor, or whose sensor
+// has no recent valid reading, gets 1000: a broken sensor never stops
+// watering.
+uint16_t moisture_step_share(uint8_t zone, int *percent);
+// "moisture":[{"value":..,"raw":..,"state":..},..]; nothing without sensors
+void moisture_write_json(json_writer_t *w);
+// {"sensors":[..],"zones":[..]} for /api/moisture
+void moisture_write_config_json(json_writer_t *w);
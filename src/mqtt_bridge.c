@@ -0,0 +1,399 @@
+#include "mqtt_bridge.h"
+#include "json_reader.h"
+#include "status_json.h"
+#include "relay_controller.h"
+#include "routine_store.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "mqtt_client.h"
+#include "nvs.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "MQTT";
+
+#define NVS_NAMESPACE "mqtt"
+#define CONFIG_VERSION 1
+#define TOPIC_LEN (MQTT_PREFIX_LEN + 16)
+
+typedef struct {
+    uint8_t version;
+    char uri[MQTT_URI_LEN];         // Empty: MQTT off
+    char username[MQTT_USERNAME_LEN];
+    char password[MQTT_PASSWORD_LEN];
+    char prefix[MQTT_PREFIX_LEN];
+} mqtt_config_t;
+
+// Settings and topics are replaced by the httpd task while the client is
+// stopped; the client, once created, is kept for the lifetime of the
+// firmware so the timer and the client's task never see it go away.
+static mqtt_config_t config;
+static char status_topic[TOPIC_LEN];
+static char online_topic[TOPIC_LEN];
+static char relay_topic[TOPIC_LEN];     // <prefix>/relay/+/set
+static char routine_topic[TOPIC_LEN];
+static esp_mqtt_client_handle_t client = NULL;
+static uint32_t connected = 0;
+
+// Set by the relay listener, cleared by publish_status()
+static uint32_t publish_armed = 0;
+static esp_timer_handle_t publish_timer = NULL;
+
+// --- NVS ---------------------------------------------------------------------
+
+static void config_defaults(mqtt_config_t *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->version = CONFIG_VERSION;
+    strlcpy(cfg->prefix, MQTT_DEFAULT_PREFIX, sizeof(cfg->prefix));
+}
+
+static void load_config(void) {
+    nvs_handle_t nvs;
+    size_t len = sizeof(config);
+    bool ok = false;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+        ok = nvs_get_blob(nvs, "config", &config, &len) == ESP_OK && len == sizeof(config) &&
+             config.version == CONFIG_VERSION;
+        nvs_close(nvs);
+    }
+    if (!ok) {
+        config_defaults(&config);
+    }
+    config.uri[sizeof(config.uri) - 1] = '\0';
+    config.username[sizeof(config.username) - 1] = '\0';
+    config.password[sizeof(config.password) - 1] = '\0';
+    config.prefix[sizeof(config.prefix) - 1] = '\0';
+}
+
+static esp_err_t save_config(const mqtt_config_t *cfg) {
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err != ESP_OK) return err;
+    err = nvs_set_blob(nvs, "config", cfg, sizeof(*cfg));
+    if (err == ESP_OK) err = nvs_commit(nvs);
+    nvs_close(nvs);
+    return err;
+}
+
+// --- State publishing --------------------------------------------------------
+
+// Runs on the esp_timer task, the only user of the buffer
+static void publish_status(void *arg) {
+    static char buf[STATUS_JSON_MAX];
+    __atomic_store_n(&publish_armed, 0, __ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&connected, __ATOMIC_SEQ_CST)) return;
+
+    json_writer_t w;
+    json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    status_json_write(&w);
+    if (w.error) {
+        ESP_LOGW(TAG, "Status too large to publish");
+        return;
+    }
+    // Queued for the client's task, so the timer task never waits on the
+    // network
+    if (esp_mqtt_client_enqueue(client, status_topic, buf, w.len, 1, 1, true) < 0) {
+        ESP_LOGW(TAG, "Failed to queue status");
+    }
+}
+
+static void request_publish(void) {
+    if (publish_timer == NULL || !__atomic_load_n(&connected, __ATOMIC_SEQ_CST)) return;
+    if (__atomic_exchange_n(&publish_armed, 1, __ATOMIC_SEQ_CST) == 0) {
+        if (esp_timer_start_once(publish_timer, MQTT_COALESCE_MS * 1000) != ESP_OK) {
+            __atomic_store_n(&publish_armed, 0, __ATOMIC_SEQ_CST);
+        }
+    }
+}
+
+// Every change in a burst (a batch, a routine step, a stop switching
+// everything off) lands in the one pending publish
+static void on_relay_event(relay_event_t event, uint8_t relay_num) {
+    request_publish();
+}
+
+// --- Commands ----------------------------------------------------------------
+
+// <prefix>/relay/<id>/set: on, off, toggle or a number of seconds
+static void relay_command(int relay, const char *payload) {
+    if (strcmp(payload, "on") == 0) {
+        relay_on(relay);
+    } else if (strcmp(payload, "off") == 0) {
+        relay_off(relay);
+    } else if (strcmp(payload, "toggle") == 0) {
+        relay_toggle(relay);
+    } else {
+        char *end;
+        long sec = strtol(payload, &end, 10);
+        if (end == payload || *end != '\0' || sec < 1 || sec > MAX_ON_TIME_SEC) {
+            ESP_LOGW(TAG, "Relay %d: invalid command '%s'", relay, payload);
+            return;
+        }
+        relay_on_with_timer(relay, sec);
+    }
+    ESP_LOGI(TAG, "Relay %d: %s", relay, payload);
+}
+
+// <prefix>/routine/set: a routine index to start, stop or skip
+static void routine_command(const char *payload) {
+    if (strcmp(payload, "stop") == 0) {
+        relay_stop_routine();
+    } else if (strcmp(payload, "skip") == 0) {
+        relay_skip_routine_step();
+    } else {
+        char *end;
+        long index = strtol(payload, &end, 10);
+        if (end == payload || *end != '\0') {
+            ESP_LOGW(TAG, "Routine: invalid command '%s'", payload);
+            return;
+        }
+        esp_err_t err = routine_store_start(index);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Routine %ld not started: %s", index,
+                     err == ESP_ERR_NOT_FOUND       ? "no such routine"
+                     : err == ESP_ERR_INVALID_STATE ? "another one is running"
+                                                    : esp_err_to_name(err));
+            return;
+        }
+    }
+    ESP_LOGI(TAG, "Routine: %s", payload);
+}
+
+static void handle_message(const esp_mqtt_event_t *event) {
+    // A retained command would replay on every reconnect
+    if (event->retain) return;
+    // Commands are a few bytes, so always arrive in one piece
+    if (event->data_len != event->total_data_len) return;
+
+    char topic[TOPIC_LEN];
+    char payload[16];
+    if (event->topic_len >= (int)sizeof(topic) || event->data_len >= (int)sizeof(payload)) return;
+    memcpy(topic, event->topic, event->topic_len);
+    topic[event->topic_len] = '\0';
+    memcpy(payload, event->data, event->data_len);
+    payload[event->data_len] = '\0';
+
+    if (strcmp(topic, routine_topic) == 0) {
+        routine_command(payload);
+        return;
+    }
+    // <prefix>/relay/ is the relay topic up to its '+'
+    size_t base = strlen(relay_topic) - strlen("+/set");
+    if (strncmp(topic, relay_topic, base) == 0) {
+        char *end;
+        long relay = strtol(topic + base, &end, 10);
+        if (end != topic + base && strcmp(end, "/set") == 0 && relay >= 0 && relay < relay_count()) {
+            relay_command(relay, payload);
+        }
+    }
+}
+
+// Runs on the client's task
+static void mqtt_event_handler(void *arg, esp_event_base_t base, int32_t event_id, void *event_data) {
+    esp_mqtt_event_handle_t event = event_data;
+    switch ((esp_mqtt_event_id_t)event_id) {
+        case MQTT_EVENT_CONNECTED:
+            ESP_LOGI(TAG, "Connected to %s", config.uri);
+            __atomic_store_n(&connected, 1, __ATOMIC_SEQ_CST);
+            esp_mqtt_client_subscribe(client, relay_topic, 1);
+            esp_mqtt_client_subscribe(client, routine_topic, 1);
+            esp_mqtt_client_publish(client, online_topic, "online", 0, 1, 1);
+            // The broker may hold a status from before a reset
+            request_publish();
+            break;
+        case MQTT_EVENT_DISCONNECTED:
+            ESP_LOGW(TAG, "Disconnected");
+            __atomic_store_n(&connected, 0, __ATOMIC_SEQ_CST);
+            break;
+        case MQTT_EVENT_DATA:
+            handle_message(event);
+            break;
+        default:
+            break;
+    }
+}
+
+// --- Client ------------------------------------------------------------------
+
+// Call with the client stopped
+static void start_client(void) {
+    if (config.uri[0] == '\0') {
+        ESP_LOGI(TAG, "No broker set, MQTT off");
+        return;
+    }
+
+    snprintf(status_topic, sizeof(status_topic), "%s/status", config.prefix);
+    snprintf(online_topic, sizeof(online_topic), "%s/online", config.prefix);
+    snprintf(relay_topic, sizeof(relay_topic), "%s/relay/+/set", config.prefix);
+    snprintf(routine_topic, sizeof(routine_topic), "%s/routine/set", config.prefix);
+
+    esp_mqtt_client_config_t mqtt_cfg = {
+        .broker.address.uri = config.uri,
+        .credentials.username = config.username[0] ? config.username : NULL,
+        .credentials.authentication.password = config.password[0] ? config.password : NULL,
+        .session.last_will = {
+            .topic = online_topic,
+            .msg = "offline",
+            .qos = 1,
+            .retain = 1,
+        },
+    };
+    if (client == NULL) {
+        client = esp_mqtt_client_init(&mqtt_cfg);
+        if (client == NULL) {
+            ESP_LOGE(TAG, "Failed to create the client");
+            return;
+        }
+        esp_mqtt_client_register_event(client, MQTT_EVENT_ANY, mqtt_event_handler, NULL);
+    } else if (esp_mqtt_set_config(client, &mqtt_cfg) != ESP_OK) {
+        ESP_LOGE(TAG, "Invalid broker settings");
+        return;
+    }
+    if (esp_mqtt_client_start(client) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start the client");
+        return;
+    }
+    ESP_LOGI(TAG, "Connecting to %s as %s/...", config.uri, config.prefix);
+}
+
+void mqtt_bridge_init(void) {
+    load_config();
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = publish_status,
+        .name = "mqtt_publish"
+    };
+    if (esp_timer_create(&timer_args, &publish_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create the publish timer");
+        return;
+    }
+    if (!relay_add_listener(on_relay_event)) {
+        ESP_LOGE(TAG, "No room for the relay listener");
+        return;
+    }
+    start_client();
+}
+
+bool mqtt_bridge_connected(void) {
+    return __atomic_load_n(&connected, __ATOMIC_SEQ_CST) != 0;
+}
+
+// --- Settings upload ---------------------------------------------------------
+
+typedef struct {
+    json_reader_t reader;
+    mqtt_config_t cfg;
+    char err[64];
+} parser_t;
+
+// Only used from the httpd task
+static parser_t parser;
+static bool upload_open = false;
+
+static bool reject(parser_t *p, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(p->err, sizeof(p->err), fmt, args);
+    va_end(args);
+    return false;
+}
+
+static bool take_string(parser_t *p, const json_token_t *tok, char *out, size_t out_len) {
+    if (tok->type != JSON_STRING) return reject(p, "%s must be a string", tok->key);
+    if (tok->truncated || tok->len >= out_len) return reject(p, "%s is too long (max %u)", tok->key, (unsigned)out_len - 1);
+    memcpy(out, tok->str, tok->len + 1);
+    return true;
+}
+
+static bool on_token(void *ctx, const json_token_t *tok) {
+    parser_t *p = ctx;
+    if (tok->depth == 0) {
+        if (tok->type == JSON_OBJ_BEGIN || tok->type == JSON_OBJ_END) return true;
+        return reject(p, "Expected an object");
+    }
+    if (tok->depth > 1 || tok->key == NULL) return true;
+
+    if (strcmp(tok->key, "uri") == 0) {
+        if (!take_string(p, tok, p->cfg.uri, sizeof(p->cfg.uri))) return false;
+        static const char *const schemes[] = {"mqtt://", "mqtts://", "ws://", "wss://"};
+        bool known = p->cfg.uri[0] == '\0';
+        for (int i = 0; i < 4 && !known; i++) {
+            known = strncmp(p->cfg.uri, schemes[i], strlen(schemes[i])) == 0;
+        }
+        if (!known) return reject(p, "uri must start with mqtt://, mqtts://, ws:// or wss://");
+    } else if (strcmp(tok->key, "username") == 0) {
+        return take_string(p, tok, p->cfg.username, sizeof(p->cfg.username));
+    } else if (strcmp(tok->key, "password") == 0) {
+        return take_string(p, tok, p->cfg.password, sizeof(p->cfg.password));
+    } else if (strcmp(tok->key, "prefix") == 0) {
+        if (!take_string(p, tok, p->cfg.prefix, sizeof(p->cfg.prefix))) return false;
+        if (p->cfg.prefix[0] == '\0' || strpbrk(p->cfg.prefix, "+#") != NULL) {
+            return reject(p, "prefix must be a topic without wildcards");
+        }
+    }
+    return true;
+}
+
+static bool parser_feed(parser_t *p, const char *data, size_t len, bool last) {
+    bool ok = len == 0 || json_reader_feed(&p->reader, data, len);
+    if (ok && last) ok = json_reader_finish(&p->reader);
+    if (!ok && p->err[0] == '\0') {
+        snprintf(p->err, sizeof(p->err), "Invalid JSON at byte %u: %s",
+                 (unsigned)p->reader.pos, p->reader.error);
+    }
+    return ok;
+}
+
+esp_err_t mqtt_bridge_upload_begin(void) {
+    memset(&parser, 0, sizeof(parser));
+    json_reader_init(&parser.reader, on_token, &parser);
+    // Omitted members keep their current values
+    parser.cfg = config;
+    upload_open = true;
+    return ESP_OK;
+}
+
+esp_err_t mqtt_bridge_upload_write(const char *data, size_t len) {
+    if (!upload_open) return ESP_ERR_INVALID_STATE;
+    if (!parser_feed(&parser, data, len, false)) {
+        upload_open = false;
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+esp_err_t mqtt_bridge_upload_finish(void) {
+    if (!upload_open) return ESP_ERR_INVALID_STATE;
+    upload_open = false;
+    if (!parser_feed(&parser, NULL, 0, true)) return ESP_ERR_INVALID_ARG;
+
+    if (save_config(&parser.cfg) != ESP_OK) {
+        snprintf(parser.err, sizeof(parser.err), "Failed to save MQTT settings");
+        return ESP_FAIL;
+    }
+
+    if (client != NULL) {
+        __atomic_store_n(&connected, 0, __ATOMIC_SEQ_CST);
+        esp_mqtt_client_stop(client);
+    }
+    config = parser.cfg;
+    ESP_LOGI(TAG, "Saved MQTT settings");
+    start_client();
+    return ESP_OK;
+}
+
+const char *mqtt_bridge_upload_error(void) {
+    return parser.err;
+}
+
+void mqtt_bridge_write_json(json_writer_t *w) {
+    json_obj_begin(w);
+    json_kv_str(w, "uri", config.uri);
+    json_kv_str(w, "username", config.username);
+    json_kv_bool(w, "password", config.password[0] != '\0');
+    json_kv_str(w, "prefix", config.prefix);
+    json_kv_bool(w, "connected", mqtt_bridge_connected());
+    json_obj_end(w);
+}
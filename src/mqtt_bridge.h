@@ -0,0 +1,35 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "json_writer.h"
+
+#define MQTT_URI_LEN 64
+#define MQTT_USERNAME_LEN 32
+#define MQTT_PASSWORD_LEN 64
+#define MQTT_PREFIX_LEN 32
+#define MQTT_DEFAULT_PREFIX "autowater"
+#define MQTT_CONFIG_MAX_SIZE 512    // request body limit
+// State changes closer together than this go out as one message
+#define MQTT_COALESCE_MS 100
+
+// Optional link to an MQTT broker. While connected it keeps the retained
+// <prefix>/status topic equal to /api/status and takes commands on
+// <prefix>/relay/<id>/set and <prefix>/routine/set (see web/README.md).
+
+// Loads the broker settings from NVS and connects if a broker is set.
+// Call after wifi_init_sta(), routine_store_init() and relay_init().
+void mqtt_bridge_init(void);
+bool mqtt_bridge_connected(void);
+
+// Streaming replacement of the settings, like scheduler_upload_*().
+// Finish saves them to NVS and reconnects with them; an empty "uri"
+// disconnects. Returns ESP_ERR_INVALID_ARG for malformed input, with the
+// reason in mqtt_bridge_upload_error().
+esp_err_t mqtt_bridge_upload_begin(void);
+esp_err_t mqtt_bridge_upload_write(const char *data, size_t len);
+esp_err_t mqtt_bridge_upload_finish(void);
+const char *mqtt_bridge_upload_error(void);
+
+// Writes the settings, without the password, and the connection state
+void mqtt_bridge_write_json(json_writer_t *w);
@@ -0,0 +1,224 @@
+#include "ota_gzip.h"
+#include "ota_update.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "miniz.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "OTA_GZIP";
+
+// RFC 1952 header flags
+#define FHCRC 0x02
+#define FEXTRA 0x04
+#define FNAME 0x08
+#define FCOMMENT 0x10
+#define FRESERVED 0xE0
+
+typedef enum {
+    GZ_FIXED,                   // ID1 ID2 CM FLG MTIME(4) XFL OS
+    GZ_XLEN,
+    GZ_EXTRA,
+    GZ_NAME,
+    GZ_COMMENT,
+    GZ_HCRC,
+    GZ_DEFLATE,
+    GZ_TRAILER,                 // CRC32 ISIZE
+    GZ_DONE
+} gz_stage_t;
+
+struct ota_gzip {
+    tinfl_decompressor inflater;
+    uint8_t dict[TINFL_LZ_DICT_SIZE];   // tinfl's output wraps around in here
+    size_t dict_ofs;
+    gz_stage_t stage;
+    uint8_t hdr[10];            // The fixed header, later the trailer
+    size_t hdr_len;
+    uint8_t flags;
+    size_t skip;                // Bytes left of XLEN, EXTRA or HCRC
+    size_t xlen;
+    uint8_t *out;               // The update buffer being filled, or NULL
+    size_t out_len;
+    uint32_t crc;
+    size_t size;
+};
+
+ota_gzip_t *ota_gzip_new(void) {
+    // Not calloc: the dictionary needs no clearing
+    ota_gzip_t *gz = malloc(sizeof(*gz));
+    if (gz == NULL) return NULL;
+    tinfl_init(&gz->inflater);
+    gz->dict_ofs = 0;
+    gz->stage = GZ_FIXED;
+    gz->hdr_len = 0;
+    gz->flags = 0;
+    gz->skip = 0;
+    gz->xlen = 0;
+    gz->out = NULL;
+    gz->out_len = 0;
+    gz->crc = 0;
+    gz->size = 0;
+    return gz;
+}
+
+void ota_gzip_free(ota_gzip_t *gz) {
+    free(gz);
+}
+
+size_t ota_gzip_size(const ota_gzip_t *gz) {
+    return gz->size;
+}
+
+// Moves past the optional header field `done` to the next one FLG says is there
+static void header_after(ota_gzip_t *gz, gz_stage_t done) {
+    if (done < GZ_NAME && (gz->flags & FNAME)) {
+        gz->stage = GZ_NAME;
+    } else if (done < GZ_COMMENT && (gz->flags & FCOMMENT)) {
+        gz->stage = GZ_COMMENT;
+    } else if (done < GZ_HCRC && (gz->flags & FHCRC)) {
+        gz->stage = GZ_HCRC;
+        gz->skip = 2;
+    } else {
+        gz->stage = GZ_DEFLATE;
+    }
+}
+
+static esp_err_t header_byte(ota_gzip_t *gz, uint8_t b) {
+    switch (gz->stage) {
+        case GZ_FIXED:
+            gz->hdr[gz->hdr_len++] = b;
+            if (gz->hdr_len < sizeof(gz->hdr)) break;
+            if (gz->hdr[0] != 0x1f || gz->hdr[1] != 0x8b || gz->hdr[2] != 8 || (gz->hdr[3] & FRESERVED)) {
+                ESP_LOGE(TAG, "Not a gzip stream");
+                return ESP_ERR_INVALID_ARG;
+            }
+            gz->flags = gz->hdr[3];
+            gz->hdr_len = 0;
+            if (gz->flags & FEXTRA) {
+                gz->stage = GZ_XLEN;
+                gz->skip = 2;
+            } else {
+                header_after(gz, GZ_EXTRA);
+            }
+            break;
+        case GZ_XLEN:
+            gz->xlen |= (size_t)b << (gz->skip == 2 ? 0 : 8);
+            if (--gz->skip > 0) break;
+            gz->skip = gz->xlen;
+            if (gz->skip > 0) gz->stage = GZ_EXTRA;
+            else header_after(gz, GZ_EXTRA);
+            break;
+        case GZ_EXTRA:
+            if (--gz->skip == 0) header_after(gz, GZ_EXTRA);
+            break;
+        case GZ_NAME:
+        case GZ_COMMENT:
+            if (b == 0) header_after(gz, gz->stage);
+            break;
+        case GZ_HCRC:
+            if (--gz->skip == 0) gz->stage = GZ_DEFLATE;
+            break;
+        default:
+            break;
+    }
+    return ESP_OK;
+}
+
+// Copies inflated bytes into update buffers, handing each one over once full
+static esp_err_t emit(ota_gzip_t *gz, const uint8_t *data, size_t len) {
+    gz->crc = esp_rom_crc32_le(gz->crc, data, len);
+    gz->size += len;
+    while (len > 0) {
+        if (gz->out == NULL) {
+            gz->out = ota_update_buffer();
+            if (gz->out == NULL) return ESP_FAIL;
+            gz->out_len = 0;
+        }
+        size_t n = OTA_BUF_SIZE - gz->out_len < len ? OTA_BUF_SIZE - gz->out_len : len;
+        memcpy(gz->out + gz->out_len, data, n);
+        gz->out_len += n;
+        data += n;
+        len -= n;
+        if (gz->out_len == OTA_BUF_SIZE) {
+            ota_update_submit(gz->out, gz->out_len);
+            gz->out = NULL;
+        }
+    }
+    return ESP_OK;
+}
+
+// Inflates from *data until the input runs out or the deflate stream ends
+static esp_err_t inflate_some(ota_gzip_t *gz, const uint8_t **data, size_t *len) {
+    for (;;) {
+        size_t in_n = *len;
+        size_t out_n = sizeof(gz->dict) - gz->dict_ofs;
+        tinfl_status status = tinfl_decompress(&gz->inflater, *data, &in_n, gz->dict, gz->dict + gz->dict_ofs,
+                                               &out_n, TINFL_FLAG_HAS_MORE_INPUT);
+        *data += in_n;
+        *len -= in_n;
+        if (out_n > 0) {
+            esp_err_t err = emit(gz, gz->dict + gz->dict_ofs, out_n);
+            if (err != ESP_OK) return err;
+            gz->dict_ofs = (gz->dict_ofs + out_n) & (sizeof(gz->dict) - 1);
+        }
+        if (status < TINFL_STATUS_DONE) {
+            ESP_LOGE(TAG, "Corrupt deflate stream at %u bytes out (%d)", (unsigned)gz->size, (int)status);
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (status == TINFL_STATUS_DONE) {
+            gz->stage = GZ_TRAILER;
+            return ESP_OK;
+        }
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT && *len == 0) return ESP_OK;
+    }
+}
+
+esp_err_t ota_gzip_write(ota_gzip_t *gz, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        esp_err_t err = ESP_OK;
+        switch (gz->stage) {
+            case GZ_DEFLATE:
+                err = inflate_some(gz, &data, &len);
+                break;
+            case GZ_TRAILER: {
+                size_t n = 8 - gz->hdr_len < len ? 8 - gz->hdr_len : len;
+                memcpy(gz->hdr + gz->hdr_len, data, n);
+                gz->hdr_len += n;
+                data += n;
+                len -= n;
+                if (gz->hdr_len == 8) gz->stage = GZ_DONE;
+                break;
+            }
+            case GZ_DONE:
+                ESP_LOGE(TAG, "%u bytes after the end of the gzip stream", (unsigned)len);
+                return ESP_ERR_INVALID_ARG;
+            default:
+                err = header_byte(gz, *data++);
+                len--;
+                break;
+        }
+        if (err != ESP_OK) return err;
+    }
+    return ESP_OK;
+}
+
+static uint32_t get_le32(const uint8_t *p) {
+    return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+esp_err_t ota_gzip_finish(ota_gzip_t *gz) {
+    if (gz->stage != GZ_DONE) {
+        ESP_LOGE(TAG, "gzip stream cut short after %u bytes out", (unsigned)gz->size);
+        return ESP_ERR_NOT_FINISHED;
+    }
+    if (get_le32(gz->hdr) != gz->crc || get_le32(gz->hdr + 4) != (uint32_t)gz->size) {
+        ESP_LOGE(TAG, "gzip trailer does not match the %u bytes inflated", (unsigned)gz->size);
+        return ESP_ERR_INVALID_CRC;
+    }
+    if (gz->out != NULL) {
+        ota_update_submit(gz->out, gz->out_len);
+        gz->out = NULL;
+    }
+    return ESP_OK;
+}
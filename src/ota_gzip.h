@@ -0,0 +1,27 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+// Inflates a gzip image into the running update (ota_update.h) as it
+// arrives, through the ROM's tinfl with a 32 KB window. The window and the
+// inflater state take about 43 KB of heap while the update runs.
+typedef struct ota_gzip ota_gzip_t;
+
+// NULL without the memory
+ota_gzip_t *ota_gzip_new(void);
+
+// Feeds the next len bytes of the upload. ESP_ERR_INVALID_ARG if it is not
+// gzip or the stream is corrupt; ESP_FAIL once the update's writer has
+// failed (ota_update_finish() says why).
+esp_err_t ota_gzip_write(ota_gzip_t *gz, const uint8_t *data, size_t len);
+
+// Hands over the last buffer after checking the stream ended with a
+// matching CRC-32 and length. ESP_ERR_NOT_FINISHED if it was cut short,
+// ESP_ERR_INVALID_CRC if the trailer does not match.
+esp_err_t ota_gzip_finish(ota_gzip_t *gz);
+
+// Bytes inflated so far
+size_t ota_gzip_size(const ota_gzip_t *gz);
+
+void ota_gzip_free(ota_gzip_t *gz);
@@ -0,0 +1,308 @@
+#include "ota_update.h"
+#include "esp_log.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "mbedtls/sha256.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "OTA";
+
+#define PAGE_SIZE 256           // Programmed with one command
+#define SECTOR_SIZE 4096
+#define BLOCK_SIZE 0x10000      // Erased with one command where aligned
+#define APP_IMAGE_MAGIC 0xE9    // First byte of an app image
+
+typedef struct {
+    const esp_partition_t *partition;
+    ota_target_t target;
+    size_t size;                // 0 until the end for a compressed upload
+    size_t erase_end;           // What the update erases in the end
+    size_t written;
+    size_t erased;              // Flash below this offset is erased or written
+    bool check_digest;
+    uint8_t digest[32];
+    mbedtls_sha256_context sha;
+    uint8_t *bufs[OTA_NUM_BUFS];
+    size_t lens[OTA_NUM_BUFS];
+    uint32_t submitted;         // Buffers handed to the writer
+    uint32_t flashed;           // Buffers the writer is done with
+    bool ending;                // No more buffers: finish up
+    bool stop;                  // Give up on what is left
+    bool writer_done;
+    esp_err_t err;              // The writer's first failure
+    TaskHandle_t producer;
+    TaskHandle_t writer;
+} ota_state_t;
+
+// The counters, the flags and err are shared under the lock; the rest
+// belongs to the writer while it runs
+static portMUX_TYPE ota_lock = portMUX_INITIALIZER_UNLOCKED;
+static ota_state_t ota;
+// An update owns ota, from claiming it in ota_update_begin() to
+// release(). Kept apart and under the lock, as two web workers may start
+// an update at once.
+static bool active = false;
+
+// Erased flash reads as all ones
+static bool all_ones(const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+// A range that is already erased (the unused tail of the old image, the
+// free space of the old filesystem) is skipped: reading 64 KB takes a few
+// ms, erasing it about 150
+static bool blank(size_t offset, size_t len) {
+    uint8_t chunk[PAGE_SIZE];
+    for (size_t at = offset; at < offset + len; at += sizeof(chunk)) {
+        if (esp_partition_read(ota.partition, at, chunk, sizeof(chunk)) != ESP_OK ||
+            !all_ones(chunk, sizeof(chunk))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Erases up to end, a 64 KB block at a time where the flash address is
+// block aligned and the whole block is due to be erased, a sector otherwise
+static esp_err_t erase_ahead(size_t end) {
+    while (ota.erased < end) {
+        bool block = (ota.partition->address + ota.erased) % BLOCK_SIZE == 0 &&
+                     ota.erased + BLOCK_SIZE <= ota.erase_end;
+        size_t len = block ? BLOCK_SIZE : SECTOR_SIZE;
+        if (!blank(ota.erased, len)) {
+            esp_err_t err = esp_partition_erase_range(ota.partition, ota.erased, len);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to erase %s at 0x%x (%s)", ota.partition->label, (unsigned)ota.erased,
+                         esp_err_to_name(err));
+                return err;
+            }
+        }
+        ota.erased += len;
+    }
+    return ESP_OK;
+}
+
+// Programs buf at the write pointer, leaving out pages of all ones: they
+// already read that way, and most of a filesystem image is free space
+static esp_err_t write_pages(const uint8_t *buf, size_t len) {
+    size_t run = 0;     // Start of the pages still to program
+    for (size_t at = 0; at < len; at += PAGE_SIZE) {
+        size_t n = len - at < PAGE_SIZE ? len - at : PAGE_SIZE;
+        if (!all_ones(buf + at, n)) continue;
+        if (at > run) {
+            esp_err_t err = esp_partition_write(ota.partition, ota.written + run, buf + run, at - run);
+            if (err != ESP_OK) return err;
+        }
+        run = at + n;
+    }
+    return len > run ? esp_partition_write(ota.partition, ota.written + run, buf + run, len - run) : ESP_OK;
+}
+
+static esp_err_t flash_buffer(uint8_t *buf, size_t len) {
+    if (ota.written + len > ota.partition->size) {
+        ESP_LOGE(TAG, "Image is larger than %s", ota.partition->label);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (ota.written == 0 && ota.target == OTA_TARGET_APP && buf[0] != APP_IMAGE_MAGIC) {
+        ESP_LOGE(TAG, "Not an app image (first byte 0x%02x)", buf[0]);
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    esp_err_t err = erase_ahead(ota.written + len);
+    if (err != ESP_OK) return err;
+    err = write_pages(buf, len);
+    // Hash what the flash now holds rather than what arrived, so a bad
+    // write fails the digest check too
+    if (err == ESP_OK) err = esp_partition_read(ota.partition, ota.written, buf, len);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write %s at 0x%x (%s)", ota.partition->label, (unsigned)ota.written,
+                 esp_err_to_name(err));
+        return err;
+    }
+    mbedtls_sha256_update(&ota.sha, buf, len);
+    ota.written += len;
+    return ESP_OK;
+}
+
+static void writer_task(void *pvParameters) {
+    esp_err_t err = ESP_OK;
+    bool stop = false;
+    while (err == ESP_OK) {
+        portENTER_CRITICAL(&ota_lock);
+        stop = ota.stop;
+        bool ending = ota.ending;
+        bool ready = ota.flashed != ota.submitted;
+        uint32_t slot = ota.flashed % OTA_NUM_BUFS;
+        portEXIT_CRITICAL(&ota_lock);
+        if (stop) break;
+        if (!ready) {
+            if (ending) break;
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        err = flash_buffer(ota.bufs[slot], ota.lens[slot]);
+        portENTER_CRITICAL(&ota_lock);
+        ota.flashed++;
+        if (err != ESP_OK) ota.err = err;
+        portEXIT_CRITICAL(&ota_lock);
+        xTaskNotifyGive(ota.producer);
+    }
+
+    // Leftovers from an older, larger filesystem image would confuse SPIFFS
+    if (err == ESP_OK && !stop) {
+        err = erase_ahead(ota.erase_end);
+    }
+
+    portENTER_CRITICAL(&ota_lock);
+    if (ota.err == ESP_OK) ota.err = err;
+    ota.writer_done = true;
+    portEXIT_CRITICAL(&ota_lock);
+    xTaskNotifyGive(ota.producer);
+    vTaskDelete(NULL);
+}
+
+static void wait_writer(void) {
+    for (;;) {
+        portENTER_CRITICAL(&ota_lock);
+        bool done = ota.writer_done;
+        portEXIT_CRITICAL(&ota_lock);
+        if (done) return;
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+static void release(void) {
+    mbedtls_sha256_free(&ota.sha);
+    for (int i = 0; i < OTA_NUM_BUFS; i++) {
+        free(ota.bufs[i]);
+        ota.bufs[i] = NULL;
+    }
+    portENTER_CRITICAL(&ota_lock);
+    active = false;
+    portEXIT_CRITICAL(&ota_lock);
+}
+
+esp_err_t ota_update_begin(ota_target_t target, size_t image_size, const uint8_t *sha256) {
+    const esp_partition_t *partition = target == OTA_TARGET_APP
+        ? esp_ota_get_next_update_partition(NULL)
+        : esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, "storage");
+    if (partition == NULL) return ESP_ERR_NOT_FOUND;
+    if (image_size > partition->size) {
+        ESP_LOGE(TAG, "Image of %u bytes does not fit %s (%u bytes)", (unsigned)image_size, partition->label,
+                 (unsigned)partition->size);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    portENTER_CRITICAL(&ota_lock);
+    bool busy = active;
+    active = true;
+    portEXIT_CRITICAL(&ota_lock);
+    if (busy) return ESP_ERR_INVALID_STATE;
+
+    // Ours now; nothing else touches ota until release()
+    ota = (ota_state_t){
+        .partition = partition,
+        .target = target,
+        .size = image_size,
+        // The rest of an app slot is never read; a filesystem is read whole
+        .erase_end = target == OTA_TARGET_APP && image_size > 0
+            ? (image_size + SECTOR_SIZE - 1) / SECTOR_SIZE * SECTOR_SIZE : partition->size,
+        .check_digest = sha256 != NULL,
+        .producer = xTaskGetCurrentTaskHandle(),
+    };
+    if (sha256) memcpy(ota.digest, sha256, sizeof(ota.digest));
+    mbedtls_sha256_init(&ota.sha);
+    mbedtls_sha256_starts(&ota.sha, 0);
+    for (int i = 0; i < OTA_NUM_BUFS; i++) {
+        ota.bufs[i] = malloc(OTA_BUF_SIZE);
+        if (ota.bufs[i] == NULL) {
+            release();
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    if (xTaskCreate(writer_task, "ota_writer", 3072, NULL, 5, &ota.writer) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create writer task");
+        release();
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (image_size > 0) {
+        ESP_LOGI(TAG, "Updating %s with %u bytes%s", partition->label, (unsigned)image_size,
+                 sha256 ? "" : " (no digest to check)");
+    } else {
+        ESP_LOGI(TAG, "Updating %s%s", partition->label, sha256 ? "" : " (no digest to check)");
+    }
+    return ESP_OK;
+}
+
+uint8_t *ota_update_buffer(void) {
+    for (;;) {
+        portENTER_CRITICAL(&ota_lock);
+        bool failed = ota.err != ESP_OK || ota.writer_done;
+        bool free_slot = ota.submitted - ota.flashed < OTA_NUM_BUFS;
+        uint32_t slot = ota.submitted % OTA_NUM_BUFS;
+        portEXIT_CRITICAL(&ota_lock);
+        if (failed) return NULL;
+        if (free_slot) return ota.bufs[slot];
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+void ota_update_submit(uint8_t *buf, size_t len) {
+    portENTER_CRITICAL(&ota_lock);
+    ota.lens[ota.submitted % OTA_NUM_BUFS] = len;
+    ota.submitted++;
+    portEXIT_CRITICAL(&ota_lock);
+    xTaskNotifyGive(ota.writer);
+}
+
+esp_err_t ota_update_finish(void) {
+    portENTER_CRITICAL(&ota_lock);
+    ota.ending = true;
+    portEXIT_CRITICAL(&ota_lock);
+    xTaskNotifyGive(ota.writer);
+    wait_writer();
+    esp_err_t err = ota.err;
+    if (err == ESP_OK && (ota.written == 0 || (ota.size > 0 && ota.written != ota.size))) {
+        ESP_LOGE(TAG, "Image ended after %u bytes", (unsigned)ota.written);
+        err = ESP_ERR_NOT_FINISHED;
+    }
+
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&ota.sha, digest);
+    if (err == ESP_OK && ota.check_digest && memcmp(digest, ota.digest, sizeof(digest)) != 0) {
+        ESP_LOGE(TAG, "SHA-256 of %s does not match the upload", ota.partition->label);
+        err = ESP_ERR_INVALID_CRC;
+    }
+    // Also validates the image, including its own appended hash
+    if (err == ESP_OK && ota.target == OTA_TARGET_APP) {
+        err = esp_ota_set_boot_partition(ota.partition);
+    }
+
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Wrote %u bytes to %s", (unsigned)ota.written, ota.partition->label);
+    } else {
+        ESP_LOGE(TAG, "Update of %s failed (%s)", ota.partition->label, esp_err_to_name(err));
+    }
+    release();
+    return err;
+}
+
+void ota_update_abort(void) {
+    portENTER_CRITICAL(&ota_lock);
+    bool running = active;
+    if (running) ota.stop = true;
+    portEXIT_CRITICAL(&ota_lock);
+    if (!running) return;
+    xTaskNotifyGive(ota.writer);
+    wait_writer();
+    ESP_LOGW(TAG, "Update of %s abandoned after %u bytes", ota.partition->label, (unsigned)ota.written);
+    release();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#define OTA_BUF_SIZE 4096       // Bytes per receive buffer
+#define OTA_NUM_BUFS 2          // One being received while the other is flashed
+
+typedef enum {
+    OTA_TARGET_APP = 0,         // The next OTA app slot
+    OTA_TARGET_SPIFFS           // The "storage" partition, as one image
+} ota_target_t;
+
+// An update is a producer/consumer pair: the caller (the httpd task)
+// fills buffers from the network while a writer task flashes the previous
+// one, erasing just ahead of what it writes and hashing what it wrote.
+// Only one update runs at a time.
+
+// Starts an update of image_size bytes, or 0 if the size is not known
+// until the end (a compressed upload). sha256 is the expected digest of
+// the image, or NULL to skip the check. Returns ESP_ERR_INVALID_SIZE if
+// the image does not fit, ESP_ERR_NOT_FOUND without the partition and
+// ESP_ERR_INVALID_STATE while another update runs.
+esp_err_t ota_update_begin(ota_target_t target, size_t image_size, const uint8_t *sha256);
+
+// A free buffer of OTA_BUF_SIZE bytes to receive into; blocks while the
+// writer holds both. NULL once the writer has failed (see ota_update_finish()).
+uint8_t *ota_update_buffer(void);
+
+// Hands the buffer from ota_update_buffer() with len bytes to the writer
+void ota_update_submit(uint8_t *buf, size_t len);
+
+// Waits for the writer to flash what was submitted, then checks the size
+// and the digest and, for the app, makes it the boot partition.
+// ESP_ERR_INVALID_SIZE means the image did not fit the partition,
+// ESP_ERR_NOT_FINISHED that it was empty or shorter than the size given
+// to ota_update_begin(). ESP_ERR_INVALID_CRC means the digest did not match;
+// the app slot is left alone, but the filesystem has been overwritten.
+// ESP_ERR_OTA_VALIDATE_FAILED means it is not a valid app image.
+esp_err_t ota_update_finish(void);
+
+// Stops an update that will not be finished, e.g. the upload broke off
+void ota_update_abort(void);
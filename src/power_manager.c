@@ -0,0 +1,63 @@
+#include "power_manager.h"
+#include "esp_log.h"
+#include "esp_pm.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "POWER";
+
+typedef struct {
+    const char *name;
+    int max_freq_mhz;
+    int min_freq_mhz;           // Below max enables DFS
+    bool light_sleep;
+    wifi_ps_type_t wifi_ps;
+    uint16_t listen_interval;   // Beacons between wakeups, WIFI_PS_MAX_MODEM only
+} power_profile_t;
+
+static const power_profile_t profiles[] = {
+    [POWER_PROFILE_PERFORMANCE] = {"performance", 160, 160, false, WIFI_PS_NONE, 0},
+    [POWER_PROFILE_BALANCED]    = {"balanced", 160, 40, false, WIFI_PS_MIN_MODEM, 0},
+    [POWER_PROFILE_LOW_POWER]   = {"low_power", 160, 40, true, WIFI_PS_MAX_MODEM, 3},
+};
+
+_Static_assert(POWER_PROFILE >= 0 && POWER_PROFILE < sizeof(profiles) / sizeof(profiles[0]),
+               "Unknown POWER_PROFILE");
+
+static const power_profile_t *profile = &profiles[POWER_PROFILE];
+
+void power_init(void) {
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = profile->max_freq_mhz,
+        .min_freq_mhz = profile->min_freq_mhz,
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+        .light_sleep_enable = profile->light_sleep,
+#endif
+    };
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to configure power management (%s)", esp_err_to_name(err));
+        return;
+    }
+#if !CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    if (profile->light_sleep) {
+        ESP_LOGW(TAG, "Light sleep needs CONFIG_FREERTOS_USE_TICKLESS_IDLE");
+    }
+#endif
+#else
+    if (POWER_PROFILE != POWER_PROFILE_PERFORMANCE) {
+        ESP_LOGW(TAG, "CONFIG_PM_ENABLE is off, CPU stays at full speed");
+    }
+#endif
+    ESP_LOGI(TAG, "Power profile: %s", profile->name);
+}
+
+void power_configure_wifi(wifi_config_t *config) {
+    if (profile->listen_interval) {
+        config->sta.listen_interval = profile->listen_interval;
+    }
+    esp_err_t err = esp_wifi_set_ps(profile->wifi_ps);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set Wi-Fi power save (%s)", esp_err_to_name(err));
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "esp_wifi.h"
+
+// Power profiles, see POWER_README.md for the tradeoffs. Select one with
+// -D POWER_PROFILE=<n> in platformio.ini.
+#define POWER_PROFILE_PERFORMANCE 0 // 160 MHz, radio always on
+#define POWER_PROFILE_BALANCED    1 // DFS 40-160 MHz, modem sleep at every DTIM
+#define POWER_PROFILE_LOW_POWER   2 // DFS, automatic light sleep, modem sleep every 3rd beacon
+
+#ifndef POWER_PROFILE
+#define POWER_PROFILE POWER_PROFILE_BALANCED
+#endif
+
+// Sets up frequency scaling and light sleep. Call early in app_main.
+void power_init(void);
+
+// Applies the profile's Wi-Fi power save mode and listen interval. Call
+// after esp_wifi_init() and before esp_wifi_set_config().
+void power_configure_wifi(wifi_config_t *config);
@@ -1,221 +1,881 @@
 #include "relay_controller.h"
+#include "relay_output.h"
+#include "relay_safety.h"
+#include "flow_meter.h"
+#include "moisture.h"
+#include "history.h"
+#include "metrics.h"
 
 #include <esp_log.h>
 #include <string.h>
-#include "driver/gpio.h"
+#include <time.h>
+#include "esp_random.h"
+#include "nvs.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/timers.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 
-static const gpio_num_t relay_pins[NUM_RELAYS] = {(gpio_num_t) 6, (gpio_num_t) 7, (gpio_num_t) 5, (gpio_num_t) 10};
-// Adjust your GPIOs
-static relay_mode_t relay_modes[NUM_RELAYS] = {RELAY_MODE_OFF};
-static TimerHandle_t relay_timers[NUM_RELAYS] = {0};
+#define NVS_NAMESPACE "relay"
+#define NVS_KEY_ZONES "zones"
+#define NVS_KEY_LIMITS "limits"
+
+// Relays the output backend drives, from relay_output_init()
+static int channels = 0;
+// One timer for every relay, armed for the earliest expiry of those on
+static TimerHandle_t deadline_timer = NULL;
+// Callers of output_sync() in flight; the first one writes for all of them
+static uint32_t output_requests = 0;
+
+// Held by whatever changes the relays (on_mask, timed_mask, expires), from
+// reading them to arming the timers, so two writers on different cores
+// cannot interleave. A mutex rather than state_lock, as the timer and
+// safety calls must not be made in a critical section.
+static SemaphoreHandle_t writer_lock = NULL;
+
+// State shared by the httpd, timer service and routine tasks. Writers hold
+// state_lock and keep state_seq odd while they change it; readers copy it
+// without locking and retry if state_seq moved (see relay_snapshot()).
+static portMUX_TYPE state_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t state_seq = 0;
+static relay_snapshot_t state = {0};
+// The running routine; only replaced while none runs
+static char routine_name[32];
+static routine_step_t routine_steps[MAX_ROUTINE_STEPS];
+static uint16_t routine_left[MAX_ROUTINE_STEPS];    // Resumed steps' time left
+// Also under state_lock
+static routine_limits_t limits = { .parallel = 1 };
+// Relays driving the running steps; update() marks their history entries
+// as the routine's, and announce() tells the routine task when one goes
+// off (timer expiry or switched off by hand)
+static relay_mask_t routine_relays = 0;
+// Bumped by each start, so the routine task can tell its run was stopped
+// and another started in the meantime
+static uint32_t routine_generation = 0;
 
-static routine_state_t routine_state = {0};
 static TaskHandle_t routine_task_handle = NULL;
-static bool skip_step_requested = false;
 
-static void routine_task(void* pvParameters) {
-    ESP_LOGI("ROUTINE", "Routine '%s' started with %d steps", routine_state.name, routine_state.num_steps);
-    
-    for (int i = 0; i < routine_state.num_steps; i++) {
-        routine_state.current_step = i;
-        routine_step_t* step = &routine_state.steps[i];
-        
+// Start of each relay's current on period, for its history entry. Only
+// update() touches these, under writer_lock.
+static TickType_t on_since[RELAY_MAX];
+static uint32_t on_start[RELAY_MAX];
+static uint8_t on_source[RELAY_MAX];
+
+// Notification bits posted to routine_task
+#define ROUTINE_EVT_START     (1u << 0)
+#define ROUTINE_EVT_STEP_DONE (1u << 1)
+#define ROUTINE_EVT_SKIP      (1u << 2)
+#define ROUTINE_EVT_STOP      (1u << 3)
+
+// Iterates over the relays in a mask, lowest first
+#define FOR_EACH_RELAY(i, mask) \
+    for (relay_mask_t m_ = (mask); m_; m_ &= m_ - 1) \
+        for (int i = __builtin_ctzll(m_), once_ = 1; once_; once_ = 0)
+
+// Relays 0 to count - 1
+static relay_mask_t zone_mask(int count) {
+    return count >= RELAY_MAX ? ~(relay_mask_t)0 : RELAY_BIT(count) - 1;
+}
+
+static relay_mask_t update(relay_mask_t touched, const uint8_t *next, const uint16_t *seconds, uint8_t end);
+static void announce(relay_mask_t touched, relay_mask_t switched, const uint8_t *next, const uint16_t *seconds);
+static relay_mask_t plan(const relay_command_t* cmds, int count, uint8_t *next, uint16_t *seconds);
+
+// Call with state_lock held
+static void state_begin(void) {
+    __atomic_store_n(&state_seq, state_seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+// The version state_end() will publish, to stamp what changed
+static uint32_t state_next_version(void) {
+    return state_seq + 1;
+}
+
+static void state_end(void) {
+    __atomic_store_n(&state_seq, state_seq + 1, __ATOMIC_RELEASE);
+}
+
+static relay_listener_t listeners[MAX_RELAY_LISTENERS] = {0};
+static int num_listeners = 0;
+
+static void notify_listeners(relay_event_t event, uint8_t relay_num) {
+    for (int i = 0; i < num_listeners; i++) {
+        listeners[i](event, relay_num);
+    }
+}
+
+bool relay_add_listener(relay_listener_t listener) {
+    if (num_listeners >= MAX_RELAY_LISTENERS) return false;
+    listeners[num_listeners++] = listener;
+    return true;
+}
+
+step_mask_t relay_routine_startable(const routine_step_t* steps, int num_steps, step_mask_t done,
+                                    step_mask_t running, const routine_limits_t* limits) {
+    int open = 0;
+    uint32_t load = 0;
+    for (int i = 0; i < num_steps; i++) {
+        if ((running & STEP_BIT(i)) && steps[i].relay_id < RELAY_MAX) {
+            open++;
+            load += limits->cost[steps[i].relay_id];
+        }
+    }
+    step_mask_t start = 0;
+    relay_mask_t taken = 0;     // Zones of earlier steps not done
+    for (int i = 0; i < num_steps; i++) {
+        step_mask_t bit = STEP_BIT(i);
+        if (steps[i].wait && (done & (bit - 1)) != bit - 1) break;
+        if (done & bit) continue;
+        relay_mask_t zone = steps[i].relay_id < RELAY_MAX ? RELAY_BIT(steps[i].relay_id) : 0;
+        uint32_t cost = zone ? limits->cost[steps[i].relay_id] : 0;
+        if (!(running & bit) && !(taken & zone) && open < limits->parallel &&
+            (limits->capacity == 0 || open == 0 || load + cost <= limits->capacity)) {
+            start |= bit;
+            open++;
+            load += cost;
+        }
+        taken |= zone;
+    }
+    return start;
+}
+
+// True if run is still the routine running, rather than stopped, or
+// stopped and another started since. Call with state_lock held.
+static bool routine_current(uint32_t run) {
+    return state.routine_running && routine_generation == run;
+}
+
+// False, changing nothing, if run is no longer the routine running
+static bool publish_steps(uint32_t run, step_mask_t active, step_mask_t done) {
+    portENTER_CRITICAL(&state_lock);
+    bool current = routine_current(run);
+    if (current) {
+        state_begin();
+        state.active_steps = active;
+        state.done_steps = done;
+        state.routine_changed = state_next_version();
+        state_end();
+    }
+    portEXIT_CRITICAL(&state_lock);
+    return current;
+}
+
+// Readies step i to start. False if it is to be left out.
+static bool prepare_step(int i, routine_step_t* step, uint16_t left) {
+    if (step->relay_id >= relay_count()) {
+        ESP_LOGW("ROUTINE", "Step %d: zone %d is not in use, skipped", i + 1, step->relay_id + 1);
+        return false;
+    }
+    if (left > 0) step->duration_sec = left;
+    // Wet soil skips the step or shortens it, time and volume alike
+    int moisture;
+    uint16_t share = moisture_step_share(step->relay_id, &moisture);
+    if (share == 0) {
+        ESP_LOGI("ROUTINE", "Step %d: zone %d is at %d%% moisture, skipped", i + 1, step->relay_id + 1,
+                 moisture);
+        return false;
+    }
+    if (share < 1000) {
+        step->duration_sec = (step->duration_sec * share + 999) / 1000;
+        step->litres = (step->litres * share + 999) / 1000;
+        ESP_LOGI("ROUTINE", "Step %d: zone %d is at %d%% moisture, shortened to %d.%d%%", i + 1,
+                 step->relay_id + 1, moisture, share / 10, share % 10);
+    }
+    if (step->litres && flow_meter_present()) {
+        // A resumed step gets its whole volume again, as how much went
+        // through before the reset is not known; the time left caps it
+        ESP_LOGI("ROUTINE", "Step %d: Watering %s with %d litres, at most %d seconds", i + 1, step->name,
+                 step->litres, step->duration_sec);
+    } else {
+        if (step->litres) {
+            ESP_LOGW("ROUTINE", "Step %d: no flow meter, watering by time", i + 1);
+        }
         ESP_LOGI("ROUTINE", "Step %d: Watering %s for %d seconds", i + 1, step->name, step->duration_sec);
-        
-        relay_on_with_timer(step->relay_id, step->duration_sec);
-        
-        // Wait for step to complete or be skipped/stopped
-        uint32_t wait_time_ms = (step->duration_sec + 2) * 1000; // Add 2s buffer
-        uint32_t elapsed = 0;
-        
-        while (elapsed < wait_time_ms) {
-            if (skip_step_requested) {
-                ESP_LOGI("ROUTINE", "Step %d skipped", i + 1);
-                skip_step_requested = false;
-                relay_off(step->relay_id);
-                break;
+    }
+    return true;
+}
+
+// relay_apply() for the routine task: switches the relays of cmds on and
+// those in off off, only if run is still the routine running. That is
+// checked under writer_lock, so a stop (and a start, or a user switching
+// a zone) cannot land between the check and the switch.
+static bool apply_steps(uint32_t run, const relay_command_t* cmds, int count, relay_mask_t off) {
+    uint8_t next[RELAY_MAX];    // relay_mode_t
+    uint16_t seconds[RELAY_MAX];
+    relay_mask_t on = 0, touched = 0, switched = 0;
+    for (int c = 0; c < count; c++) on |= RELAY_BIT(cmds[c].relay_num);
+
+    xSemaphoreTake(writer_lock, portMAX_DELAY);
+    portENTER_CRITICAL(&state_lock);
+    bool current = routine_current(run);
+    if (current) routine_relays = (routine_relays | on) & ~off;
+    portEXIT_CRITICAL(&state_lock);
+    if (current) {
+        touched = plan(cmds, count, next, seconds);
+        relay_mask_t ending = off & state.on_mask & ~touched;
+        FOR_EACH_RELAY(i, ending) next[i] = RELAY_MODE_OFF;
+        touched |= ending;
+        switched = update(touched, next, seconds, HISTORY_END_OFF);
+    }
+    xSemaphoreGive(writer_lock);
+    if (current) announce(touched, switched, next, seconds);
+    return current;
+}
+
+// Runs the steps of the started routine, as many side by side as the
+// limits allow. Returns 0 when the routine finished, or the pending events
+// if it was stopped (a restart may be among them).
+static uint32_t run_routine(void) {
+    // Private copy, so a stop and restart mid-step cannot change the steps
+    // under this task
+    static routine_state_t rs;
+    static uint16_t left[MAX_ROUTINE_STEPS];
+    // Static as well, being a step per zone; only this task runs here
+    static TickType_t ends[MAX_ROUTINE_STEPS];
+    static relay_command_t cmds[MAX_ROUTINE_STEPS];
+    routine_limits_t lim;
+    relay_snapshot_t snap;
+    uint32_t run;
+    portENTER_CRITICAL(&state_lock);
+    memcpy(left, routine_left, sizeof(left));
+    lim = limits;
+    run = routine_generation;
+    portEXIT_CRITICAL(&state_lock);
+    relay_snapshot(&snap, &rs);
+
+    step_mask_t done = rs.done_steps;
+    step_mask_t running = 0;
+    // Steps running at the reset go first, whatever the limits say now
+    step_mask_t resumed = 0;
+    for (int i = 0; i < rs.num_steps; i++) {
+        if (left[i] > 0 && !(done & STEP_BIT(i))) resumed |= STEP_BIT(i);
+    }
+    if (done || resumed) {
+        ESP_LOGI("ROUTINE", "Routine '%s' resumed with %d of %d steps done", rs.name, __builtin_popcountll(done),
+                 rs.num_steps);
+    } else {
+        ESP_LOGI("ROUTINE", "Routine '%s' started with %d steps", rs.name, rs.num_steps);
+    }
+    step_mask_t shown_active = 0, shown_done = done;
+
+    for (;;) {
+        // Start what fits; a step left out counts as done at once and may
+        // make room for more
+        relay_mask_t relays = 0;
+        step_mask_t started = 0;
+        int n = 0;
+        step_mask_t start = resumed;
+        resumed = 0;
+        if (start == 0) start = relay_routine_startable(rs.steps, rs.num_steps, done, running, &lim);
+        while (start) {
+            for (step_mask_t m = start; m; m &= m - 1) {
+                int i = __builtin_ctzll(m);
+                routine_step_t* step = &rs.steps[i];
+                if (!prepare_step(i, step, left[i])) {
+                    done |= STEP_BIT(i);
+                    continue;
+                }
+                started |= STEP_BIT(i);
+                running |= STEP_BIT(i);
+                relays |= RELAY_BIT(step->relay_id);
+                cmds[n++] = (relay_command_t){
+                    .relay_num = step->relay_id, .action = RELAY_CMD_TIMED, .seconds = step->duration_sec,
+                };
+                flow_meter_set_target(step->relay_id, step->litres * 1000u);
+            }
+            start = relay_routine_startable(rs.steps, rs.num_steps, done, running, &lim);
+        }
+        if (running == 0) break;
+
+        // A stop since the run started leaves everything as it is; its
+        // event is pending
+        if (n > 0) {
+            // All of them in one change, on the same tick
+            if (!apply_steps(run, cmds, n, 0)) {
+                for (relay_mask_t m = relays; m; m &= m - 1) flow_meter_set_target(__builtin_ctzll(m), 0);
+                return 0;
+            }
+            TickType_t now = xTaskGetTickCount();
+            for (step_mask_t m = started; m; m &= m - 1) {
+                int i = __builtin_ctzll(m);
+                ends[i] = now + pdMS_TO_TICKS(rs.steps[i].duration_sec * 1000);
             }
-            
-            if (relay_get_mode(step->relay_id) == RELAY_MODE_OFF) {
-                // Timer finished naturally or relay was turned off externally
-                break;
+        }
+        if (running != shown_active || done != shown_done) {
+            if (!publish_steps(run, running, done)) return 0;
+            shown_active = running;
+            shown_done = done;
+            notify_listeners(RELAY_EVENT_ROUTINE, n > 0 ? cmds[0].relay_num : 0);
+        }
+
+        // Block until a relay timer, a skip or a stop fires. The timeout
+        // is only a backstop in case a step-done event never arrives.
+        TickType_t now = xTaskGetTickCount();
+        int32_t wait = INT32_MAX;
+        for (step_mask_t m = running; m; m &= m - 1) {
+            int32_t t = (int32_t)(ends[__builtin_ctzll(m)] - now) + pdMS_TO_TICKS(2000);
+            if (t < wait) wait = t;
+        }
+        uint32_t events = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &events, wait > 0 ? wait : 0);
+
+        if (events & ROUTINE_EVT_STOP) {
+            // relay_stop_routine() already switched the outputs off
+            return events;
+        }
+        relay_snapshot(&snap, NULL);
+        now = xTaskGetTickCount();
+        step_mask_t ended = 0;
+        relay_mask_t off = 0;
+        for (step_mask_t m = running; m; m &= m - 1) {
+            int i = __builtin_ctzll(m);
+            uint8_t relay = rs.steps[i].relay_id;
+            bool over = (int32_t)(now - ends[i]) >= (int32_t)pdMS_TO_TICKS(2000);
+            if ((events & ROUTINE_EVT_SKIP) || over || relay_snapshot_mode(&snap, relay) == RELAY_MODE_OFF) {
+                if (events & ROUTINE_EVT_SKIP) {
+                    ESP_LOGI("ROUTINE", "Step %d skipped", i + 1);
+                }
+                ended |= STEP_BIT(i);
+                off |= RELAY_BIT(relay);
             }
-            
-            vTaskDelay(pdMS_TO_TICKS(100));
-            elapsed += 100;
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(500)); // Small gap between steps
+        running &= ~ended;
+        done |= ended;
+        if (!apply_steps(run, NULL, 0, off)) return 0;
+    }
+
+    ESP_LOGI("ROUTINE", "Routine '%s' finished", rs.name);
+    portENTER_CRITICAL(&state_lock);
+    bool current = routine_current(run);
+    if (current) {
+        state_begin();
+        state.active_steps = 0;
+        state.done_steps = done;
+        state.routine_running = false;
+        state.routine_changed = state_next_version();
+        state_end();
     }
-    
-    ESP_LOGI("ROUTINE", "Routine '%s' finished", routine_state.name);
-    routine_state.is_running = false;
-    routine_task_handle = NULL;
-    vTaskDelete(NULL);
+    portEXIT_CRITICAL(&state_lock);
+    if (current) notify_listeners(RELAY_EVENT_ROUTINE, 0);
+    return 0;
 }
 
-bool relay_start_routine(const char* name, routine_step_t* steps, uint8_t num_steps) {
-    if (routine_state.is_running) {
-        return false;
+static bool routine_running(void) {
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    return snap.routine_running;
+}
+
+// Lives for the lifetime of the firmware and sleeps on its notification
+// value, so it costs no CPU between events
+static void routine_task(void* pvParameters) {
+    for (;;) {
+        uint32_t events = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &events, portMAX_DELAY);
+        while ((events & ROUTINE_EVT_START) && routine_running()) {
+            events = run_routine();
+        }
+    }
+}
+
+bool relay_start_routine(const char* name, const routine_step_t* steps, uint8_t num_steps) {
+    static const routine_progress_t from_start = {0};
+    return relay_resume_routine(name, steps, num_steps, &from_start);
+}
+
+bool relay_resume_routine(const char* name, const routine_step_t* steps, uint8_t num_steps,
+                          const routine_progress_t* progress) {
+    if (routine_task_handle == NULL) return false;
+    uint8_t n = num_steps > MAX_ROUTINE_STEPS ? MAX_ROUTINE_STEPS : num_steps;
+    step_mask_t all = n >= MAX_ROUTINE_STEPS ? ~(step_mask_t)0 : STEP_BIT(n) - 1;
+    if (n > 0 && (progress->done & all) == all) return false;
+
+    // Checked and claimed under the lock, so two starts cannot both win
+    portENTER_CRITICAL(&state_lock);
+    bool busy = state.routine_running;
+    if (!busy) {
+        state_begin();
+        strncpy(routine_name, name, sizeof(routine_name) - 1);
+        routine_name[sizeof(routine_name) - 1] = '\0';
+        memcpy(routine_steps, steps, n * sizeof(routine_step_t));
+        for (int i = 0; i < MAX_ROUTINE_STEPS; i++) {
+            routine_left[i] = i < n ? progress->left[i] : 0;
+        }
+        routine_relays = 0;
+        routine_generation++;
+        state.num_steps = n;
+        state.active_steps = 0;
+        state.done_steps = progress->done & all;
+        state.routine_running = true;
+        state.routine_changed = state_next_version();
+        state_end();
     }
-    
-    memset(&routine_state, 0, sizeof(routine_state_t));
-    strncpy(routine_state.name, name, sizeof(routine_state.name) - 1);
-    routine_state.num_steps = num_steps > MAX_ROUTINE_STEPS ? MAX_ROUTINE_STEPS : num_steps;
-    routine_state.is_running = true;
-    memcpy(routine_state.steps, steps, routine_state.num_steps * sizeof(routine_step_t));
-    
-    skip_step_requested = false;
-    xTaskCreate(routine_task, "routine_task", 4096, NULL, 5, &routine_task_handle);
+    portEXIT_CRITICAL(&state_lock);
+    if (busy) return false;
+
+    xTaskNotify(routine_task_handle, ROUTINE_EVT_START, eSetBits);
     return true;
 }
 
 void relay_stop_routine(void) {
-    if (!routine_state.is_running) return;
-    
-    ESP_LOGI("ROUTINE", "Stopping routine '%s'", routine_state.name);
-    
-    if (routine_task_handle) {
-        vTaskDelete(routine_task_handle);
-        routine_task_handle = NULL;
+    char name[sizeof(routine_name)];
+    portENTER_CRITICAL(&state_lock);
+    bool running = state.routine_running;
+    if (running) {
+        state_begin();
+        state.routine_running = false;
+        state.active_steps = 0;
+        state.routine_changed = state_next_version();
+        state_end();
+        routine_relays = 0;
+        memcpy(name, routine_name, sizeof(name));
     }
-    
-    // Turn off all relays
-    for (int i = 0; i < NUM_RELAYS; i++) {
-        relay_off(i);
-    }
-    
-    routine_state.is_running = false;
+    portEXIT_CRITICAL(&state_lock);
+    if (!running) return;
+
+    ESP_LOGI("ROUTINE", "Stopping routine '%s'", name);
+
+    // Outputs go off here rather than in the task so stop takes effect
+    // before this returns
+    uint8_t next[RELAY_MAX];
+    uint16_t seconds[RELAY_MAX];
+    xSemaphoreTake(writer_lock, portMAX_DELAY);
+    relay_mask_t touched = state.on_mask;
+    FOR_EACH_RELAY(i, touched) next[i] = RELAY_MODE_OFF;
+    relay_mask_t switched = update(touched, next, seconds, HISTORY_END_OFF);
+    xSemaphoreGive(writer_lock);
+    announce(touched, switched, next, seconds);
+
+    notify_listeners(RELAY_EVENT_ROUTINE, 0);
+    xTaskNotify(routine_task_handle, ROUTINE_EVT_STOP, eSetBits);
 }
 
 void relay_skip_routine_step(void) {
-    if (routine_state.is_running) {
-        skip_step_requested = true;
+    if (routine_running()) {
+        xTaskNotify(routine_task_handle, ROUTINE_EVT_SKIP, eSetBits);
     }
 }
 
-routine_state_t* relay_get_routine_status(void) {
-    return &routine_state;
+// Brings the outputs in line with state.on_mask. Tasks switching relays
+// at the same time (httpd, timer service, routine task) would interleave
+// on the bus, so only the first caller writes, and it keeps writing until
+// no caller has come in since its last write. The others return at once;
+// the state they set goes out with that next write.
+static void output_sync(void) {
+    if (__atomic_fetch_add(&output_requests, 1, __ATOMIC_ACQ_REL) != 0) return;
+    uint32_t seen;
+    do {
+        seen = __atomic_load_n(&output_requests, __ATOMIC_ACQUIRE);
+        portENTER_CRITICAL(&state_lock);
+        relay_mask_t on = state.on_mask;
+        portEXIT_CRITICAL(&state_lock);
+        esp_err_t err = relay_output_write(on);
+        if (err != ESP_OK) {
+            ESP_LOGE("RELAY", "Output write failed (%s)", esp_err_to_name(err));
+        }
+    } while (__atomic_sub_fetch(&output_requests, seen, __ATOMIC_ACQ_REL) != 0);
 }
 
-static void relay_timer_callback(TimerHandle_t xTimer) {
-    uint32_t relay_num = (uint32_t)pvTimerGetTimerID(xTimer);
-    ESP_LOGI("RELAY", "Relay %d safety timeout reached", (int)relay_num + 1);
-    relay_off(relay_num);
+// Arms the deadline timer for the first relay due to switch off, or stops
+// it if none is on. Call with writer_lock held. The command cannot wait
+// for room in the timer queue (the timer service calls this too), so if
+// the queue is full the safety task sends it again.
+static void arm_deadline(TickType_t now) {
+    BaseType_t sent;
+    if (state.on_mask == 0) {
+        sent = xTimerStop(deadline_timer, 0);
+    } else {
+        int32_t soonest = INT32_MAX;
+        FOR_EACH_RELAY(i, state.on_mask) {
+            int32_t left = (int32_t)(state.expires[i] - now);
+            if (left < soonest) soonest = left;
+        }
+        // Also starts a dormant timer
+        sent = xTimerChangePeriod(deadline_timer, soonest > 0 ? soonest : 1, 0);
+    }
+    if (sent != pdPASS) relay_safety_retry();
+}
+
+// relay_safety_retry() landing, on the safety task
+static void rearm_deadline(void) {
+    xSemaphoreTake(writer_lock, portMAX_DELAY);
+    arm_deadline(xTaskGetTickCount());
+    xSemaphoreGive(writer_lock);
+}
+
+static void deadline_callback(TimerHandle_t xTimer) {
+    // All off, and nothing goes on
+    uint8_t next[RELAY_MAX] = {0};
+    uint16_t seconds[RELAY_MAX] = {0};
+    xSemaphoreTake(writer_lock, portMAX_DELAY);
+    TickType_t now = xTaskGetTickCount();
+    relay_mask_t due = 0;
+    FOR_EACH_RELAY(i, state.on_mask) {
+        if ((int32_t)(state.expires[i] - now) <= 0) {
+            due |= RELAY_BIT(i);
+            next[i] = RELAY_MODE_OFF;
+        }
+    }
+    relay_mask_t switched = update(due, next, seconds, HISTORY_END_TIMER);
+    xSemaphoreGive(writer_lock);
+
+    FOR_EACH_RELAY(i, due) {
+        ESP_LOGI("RELAY", "Relay %d safety timeout reached", i + 1);
+    }
+    announce(due, switched, next, seconds);
+}
+
+// Relays the safety cutoff switched off at the outputs (relay_safety.h).
+// The outputs are written even if the state has them off already, as a
+// cut can take other relays down with it (74HC595 OE).
+static void safety_tripped(relay_mask_t relays) {
+    uint8_t next[RELAY_MAX] = {0};     // RELAY_MODE_OFF
+    uint16_t seconds[RELAY_MAX] = {0};
+    xSemaphoreTake(writer_lock, portMAX_DELAY);
+    relay_mask_t touched = relays & state.on_mask;
+    relay_mask_t switched = update(touched, next, seconds, HISTORY_END_TIMER);
+    xSemaphoreGive(writer_lock);
+    announce(touched, switched, next, seconds);
+    if (!switched) output_sync();
 }
 
 void relay_init(void) {
-    gpio_config_t io_conf = {
-        .pin_bit_mask = 0,
-        .mode = GPIO_MODE_OUTPUT,
-        .pull_up_en = GPIO_PULLUP_DISABLE,
-        .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_DISABLE
-    };
+    channels = relay_output_init();
+    int count = channels;
+    for (int i = 0; i < RELAY_MAX; i++) limits.cost[i] = 1;
+    nvs_handle_t nvs;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+        uint8_t saved = 0;
+        size_t len = sizeof(saved);
+        if (nvs_get_blob(nvs, NVS_KEY_ZONES, &saved, &len) == ESP_OK && len == sizeof(saved) &&
+            saved >= 1 && saved < count) {
+            count = saved;
+        }
+        routine_limits_t lim;
+        len = sizeof(lim);
+        if (nvs_get_blob(nvs, NVS_KEY_LIMITS, &lim, &len) == ESP_OK && len == sizeof(lim) &&
+            lim.parallel >= 1 && lim.parallel <= MAX_ROUTINE_STEPS) {
+            limits = lim;
+        }
+        nvs_close(nvs);
+    }
+
+    // Even, as no update is in progress; everything counts as changed at boot
+    state_seq = esp_random() & ~1u;
+    state.count = count;
+    for (int i = 0; i < RELAY_MAX; i++) {
+        state.changed[i] = state_seq;
+    }
+    state.routine_changed = state_seq;
 
-    for (int i = 0; i < NUM_RELAYS; i++) {
-        io_conf.pin_bit_mask |= (1ULL << relay_pins[i]);
-        gpio_set_level(relay_pins[i], 1); // Start with HIGH = OFF for active-low relays
-        relay_modes[i] = RELAY_MODE_OFF;
+    writer_lock = xSemaphoreCreateMutex();
+    deadline_timer = xTimerCreate("relay_deadline", 1, pdFALSE, NULL, deadline_callback);
+    relay_safety_init(safety_tripped, rearm_deadline);
 
-        // Create timers but don't start them
-        char timer_name[16];
-        snprintf(timer_name, sizeof(timer_name), "relay_t%d", i);
-        relay_timers[i] = xTimerCreate(timer_name, pdMS_TO_TICKS(1000), pdFALSE, (void*)(uintptr_t)i, relay_timer_callback);
+    if (xTaskCreate(routine_task, "routine_task", 4096, NULL, 5, &routine_task_handle) != pdPASS) {
+        ESP_LOGE("RELAY", "Failed to create routine task");
+        routine_task_handle = NULL;
     }
+    ESP_LOGI("RELAY", "Relay controller initialized: %d of %d %s outputs", count, channels, relay_output_name());
+}
 
-    gpio_config(&io_conf);
-    ESP_LOGI("RELAY", "Relay controller initialized");
+int relay_count(void) {
+    return __atomic_load_n(&state.count, __ATOMIC_RELAXED);
 }
 
-void relay_on(const uint8_t relay_num) {
-    if (relay_num >= NUM_RELAYS) return;
+int relay_channels(void) {
+    return channels;
+}
+
+esp_err_t relay_set_count(int count) {
+    if (count < 1 || count > channels) return ESP_ERR_INVALID_ARG;
+
+    uint8_t next[RELAY_MAX];
+    uint16_t seconds[RELAY_MAX];
+    xSemaphoreTake(writer_lock, portMAX_DELAY);
+    int old = state.count;
+    // Zones leaving switch off while they still count; both the leaving
+    // and the new ones are stamped, so listeners and deltas pick them up
+    relay_mask_t touched = zone_mask(old > count ? old : count) & ~zone_mask(old < count ? old : count);
+    FOR_EACH_RELAY(i, touched) next[i] = RELAY_MODE_OFF;
+    portENTER_CRITICAL(&state_lock);
+    state_begin();
+    state.count = old > count ? old : count;
+    state_end();
+    portEXIT_CRITICAL(&state_lock);
+    relay_mask_t switched = update(touched, next, seconds, HISTORY_END_OFF);
+    portENTER_CRITICAL(&state_lock);
+    state_begin();
+    state.count = count;
+    state_end();
+    portEXIT_CRITICAL(&state_lock);
+    xSemaphoreGive(writer_lock);
+    announce(touched, switched, next, seconds);
+    if (old == count) return ESP_OK;
+
+    ESP_LOGI("RELAY", "Zones: %d -> %d", old, count);
+    uint8_t saved = count;
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, NVS_KEY_ZONES, &saved, sizeof(saved));
+        if (err == ESP_OK) err = nvs_commit(nvs);
+        nvs_close(nvs);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW("RELAY", "Failed to save the zone count (%s)", esp_err_to_name(err));
+    }
+    return ESP_OK;
+}
 
-    // Turn on
-    gpio_set_level(relay_pins[relay_num], 0); // LOW = ON for active-low relays
-    relay_modes[relay_num] = RELAY_MODE_MANUAL;
+void relay_get_routine_limits(routine_limits_t *out) {
+    portENTER_CRITICAL(&state_lock);
+    *out = limits;
+    portEXIT_CRITICAL(&state_lock);
+}
 
-    // Start safety timer (20 minutes)
-    if (relay_timers[relay_num]) {
-        xTimerChangePeriod(relay_timers[relay_num], pdMS_TO_TICKS(MAX_ON_TIME_SEC * 1000), 0);
-        xTimerStart(relay_timers[relay_num], 0);
+// A running routine keeps the limits it started with
+static esp_err_t save_limits(void) {
+    routine_limits_t saved;
+    relay_get_routine_limits(&saved);
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, NVS_KEY_LIMITS, &saved, sizeof(saved));
+        if (err == ESP_OK) err = nvs_commit(nvs);
+        nvs_close(nvs);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW("RELAY", "Failed to save the routine limits (%s)", esp_err_to_name(err));
     }
+    return ESP_OK;
+}
 
-    ESP_LOGI("RELAY", "Relay %d turned ON (Manual, 20m safety)", relay_num + 1);
+esp_err_t relay_set_routine_limits(int parallel, uint32_t capacity) {
+    if (parallel < 1 || parallel > MAX_ROUTINE_STEPS || capacity > UINT16_MAX) return ESP_ERR_INVALID_ARG;
+    portENTER_CRITICAL(&state_lock);
+    limits.parallel = parallel;
+    limits.capacity = capacity;
+    portEXIT_CRITICAL(&state_lock);
+    ESP_LOGI("RELAY", "Routine steps: %d at a time, capacity %u", parallel, (unsigned int)capacity);
+    return save_limits();
 }
 
-void relay_off(const uint8_t relay_num) {
-    if (relay_num >= NUM_RELAYS) return;
+esp_err_t relay_set_zone_cost(uint8_t relay_num, uint32_t cost) {
+    if (relay_num >= channels || cost > UINT16_MAX) return ESP_ERR_INVALID_ARG;
+    portENTER_CRITICAL(&state_lock);
+    limits.cost[relay_num] = cost;
+    portEXIT_CRITICAL(&state_lock);
+    ESP_LOGI("RELAY", "Zone %d costs %u", relay_num + 1, (unsigned int)cost);
+    return save_limits();
+}
 
-    // Stop timer if running
-    if (relay_timers[relay_num]) {
-        xTimerStop(relay_timers[relay_num], 0);
+void relay_apply(const relay_command_t* cmds, int count) {
+    uint8_t next[RELAY_MAX];    // relay_mode_t
+    uint16_t seconds[RELAY_MAX];
+
+    // Under writer_lock no other change lands inside the batch, and every
+    // timer is armed against the same tick count
+    xSemaphoreTake(writer_lock, portMAX_DELAY);
+    relay_mask_t touched = plan(cmds, count, next, seconds);
+    relay_mask_t switched = update(touched, next, seconds, HISTORY_END_OFF);
+    xSemaphoreGive(writer_lock);
+    announce(touched, switched, next, seconds);
+}
+
+// Works out the next mode of each relay cmds touch, and returns those.
+// Call with writer_lock held: every writer of the relay fields holds it,
+// so they can be read here without state_lock.
+static relay_mask_t plan(const relay_command_t* cmds, int count, uint8_t *next, uint16_t *seconds) {
+    relay_mask_t touched = 0;
+    for (int c = 0; c < count; c++) {
+        uint8_t n = cmds[c].relay_num;
+        if (n >= state.count) continue;
+        if (!(touched & RELAY_BIT(n))) {
+            next[n] = relay_snapshot_mode(&state, n);
+            touched |= RELAY_BIT(n);
+        }
+
+        uint8_t action = cmds[c].action;
+        if (action == RELAY_CMD_TOGGLE) {
+            action = (next[n] != RELAY_MODE_OFF) ? RELAY_CMD_OFF : RELAY_CMD_ON;
+        }
+        if (action == RELAY_CMD_ON) {
+            next[n] = RELAY_MODE_MANUAL;
+            seconds[n] = MAX_ON_TIME_SEC;   // Safety timer
+        } else if (action == RELAY_CMD_TIMED && cmds[c].seconds > 0) {
+            next[n] = RELAY_MODE_TIMED;
+            seconds[n] = cmds[c].seconds > MAX_ON_TIME_SEC ? MAX_ON_TIME_SEC : cmds[c].seconds;
+        } else {
+            next[n] = RELAY_MODE_OFF;
+        }
     }
+    return touched;
+}
 
-    gpio_set_level(relay_pins[relay_num], 1); // HIGH = OFF for active-low relays
-    relay_modes[relay_num] = RELAY_MODE_OFF;
-    ESP_LOGI("RELAY", "Relay %d turned OFF", relay_num + 1);
+void relay_off_mask(relay_mask_t relays, uint8_t end) {
+    uint8_t next[RELAY_MAX] = {0};     // RELAY_MODE_OFF
+    uint16_t seconds[RELAY_MAX] = {0};
+    xSemaphoreTake(writer_lock, portMAX_DELAY);
+    relay_mask_t touched = relays & state.on_mask;
+    relay_mask_t switched = update(touched, next, seconds, end);
+    xSemaphoreGive(writer_lock);
+    announce(touched, switched, next, seconds);
 }
 
-void relay_on_with_timer(const uint8_t relay_num, uint32_t seconds) {
-    if (relay_num >= NUM_RELAYS) return;
-    
-    // Cap at maximum on time
-    if (seconds > MAX_ON_TIME_SEC) {
-        seconds = MAX_ON_TIME_SEC;
+// Moves the relays in `touched` to next[i], with seconds[i] for those
+// going on, and returns the ones that switched. end says why relays going
+// off did (a history_end_t); HISTORY_END_TIMER means their time ran out,
+// which is the safety timeout for a manual relay. Call with writer_lock
+// held, which is also what makes reading the state here unlocked safe.
+static relay_mask_t update(relay_mask_t touched, const uint8_t *next, const uint16_t *seconds, uint8_t end) {
+    TickType_t now = xTaskGetTickCount();
+    relay_mask_t on_mask = state.on_mask;
+    relay_mask_t timed_mask = state.timed_mask;
+    relay_mask_t switched = 0;
+    portENTER_CRITICAL(&state_lock);
+    relay_mask_t routine = routine_relays;
+    portEXIT_CRITICAL(&state_lock);
+    FOR_EACH_RELAY(i, touched) {
+        relay_mask_t bit = RELAY_BIT(i);
+        bool was_on = on_mask & bit;
+        bool on = next[i] != RELAY_MODE_OFF;
+        if (was_on != on) switched |= bit;
+        if (!was_on && on) {
+            on_since[i] = now;
+            on_start[i] = (uint32_t)time(NULL);
+            on_source[i] = next[i] == RELAY_MODE_MANUAL ? HISTORY_SRC_MANUAL
+                         : (routine & bit) ? HISTORY_SRC_ROUTINE : HISTORY_SRC_TIMED;
+        } else if (was_on && !on) {
+            uint32_t sec = (now - on_since[i] + configTICK_RATE_HZ / 2) / configTICK_RATE_HZ;
+            history_entry_t entry = {
+                .start = on_start[i],
+                .duration = sec > UINT16_MAX ? UINT16_MAX : sec,
+                .zone = i,
+                .source = on_source[i],
+                .end = (end == HISTORY_END_TIMER && !(timed_mask & bit)) ? HISTORY_END_SAFETY : end,
+            };
+            history_log(&entry);
+        }
+        on_mask = on ? (on_mask | bit) : (on_mask & ~bit);
+        timed_mask = (next[i] == RELAY_MODE_TIMED) ? (timed_mask | bit) : (timed_mask & ~bit);
     }
 
-    if (seconds == 0) {
-        relay_off(relay_num);
-        return;
+    portENTER_CRITICAL(&state_lock);
+    state_begin();
+    state.on_mask = on_mask;
+    state.timed_mask = timed_mask;
+    FOR_EACH_RELAY(i, touched) {
+        state.expires[i] = now + (next[i] != RELAY_MODE_OFF ? pdMS_TO_TICKS(seconds[i] * 1000) : 0);
+        state.changed[i] = state_next_version();
     }
+    state_end();
+    portEXIT_CRITICAL(&state_lock);
+    arm_deadline(now);
+    relay_safety_arm(touched & on_mask, touched & ~on_mask, seconds);
+    return switched;
+}
 
-    // Turn on
-    gpio_set_level(relay_pins[relay_num], 0);
-    relay_modes[relay_num] = RELAY_MODE_TIMED;
+// The rest of a change, once writer_lock is given back: outputs first, then
+// metrics, log and listeners
+static void announce(relay_mask_t touched, relay_mask_t switched, const uint8_t *next, const uint16_t *seconds) {
+    if (switched) output_sync();
+    portENTER_CRITICAL(&state_lock);
+    relay_mask_t routine = routine_relays;
+    portEXIT_CRITICAL(&state_lock);
+    FOR_EACH_RELAY(i, switched) {
+        metrics_relay_switched(i);
+    }
+    FOR_EACH_RELAY(i, touched) {
+        if (next[i] == RELAY_MODE_MANUAL) {
+            ESP_LOGI("RELAY", "Relay %d turned ON (Manual, 20m safety)", i + 1);
+        } else if (next[i] == RELAY_MODE_TIMED) {
+            ESP_LOGI("RELAY", "Relay %d turned ON for %u seconds", i + 1, (unsigned int)seconds[i]);
+        } else if (switched & RELAY_BIT(i)) {
+            ESP_LOGI("RELAY", "Relay %d turned OFF", i + 1);
+        }
+        notify_listeners(RELAY_EVENT_RELAY, i);
 
-    // Start/Restart timer
-    if (relay_timers[relay_num]) {
-        xTimerChangePeriod(relay_timers[relay_num], pdMS_TO_TICKS(seconds * 1000), 0);
-        xTimerStart(relay_timers[relay_num], 0);
+        if (next[i] == RELAY_MODE_OFF && (routine & RELAY_BIT(i))) {
+            xTaskNotify(routine_task_handle, ROUTINE_EVT_STEP_DONE, eSetBits);
+        }
     }
+}
+
+void relay_on(const uint8_t relay_num) {
+    relay_command_t cmd = { .relay_num = relay_num, .action = RELAY_CMD_ON };
+    relay_apply(&cmd, 1);
+}
+
+void relay_off(const uint8_t relay_num) {
+    relay_command_t cmd = { .relay_num = relay_num, .action = RELAY_CMD_OFF };
+    relay_apply(&cmd, 1);
+}
 
-    ESP_LOGI("RELAY", "Relay %d turned ON for %u seconds", relay_num + 1, (unsigned int)seconds);
+void relay_on_with_timer(const uint8_t relay_num, uint32_t seconds) {
+    relay_command_t cmd = { .relay_num = relay_num, .action = RELAY_CMD_TIMED, .seconds = seconds };
+    relay_apply(&cmd, 1);
+}
+
+void relay_snapshot(relay_snapshot_t *snap, routine_state_t *routine) {
+    uint32_t seq;
+    do {
+        // Only odd while a writer on another core is mid-update
+        while ((seq = __atomic_load_n(&state_seq, __ATOMIC_ACQUIRE)) & 1) {
+        }
+        *snap = state;
+        if (routine != NULL) {
+            routine->is_running = snap->routine_running;
+            routine->active_steps = snap->active_steps;
+            routine->done_steps = snap->done_steps;
+            routine->num_steps = snap->num_steps;
+            if (snap->routine_running) {
+                memcpy(routine->name, routine_name, sizeof(routine->name));
+                memcpy(routine->steps, routine_steps, snap->num_steps * sizeof(routine_step_t));
+            }
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&state_seq, __ATOMIC_RELAXED) != seq);
+    snap->version = seq;
+}
+
+relay_mode_t relay_snapshot_mode(const relay_snapshot_t *snap, const uint8_t relay_num) {
+    if (relay_num >= snap->count || !(snap->on_mask & RELAY_BIT(relay_num))) return RELAY_MODE_OFF;
+    return (snap->timed_mask & RELAY_BIT(relay_num)) ? RELAY_MODE_TIMED : RELAY_MODE_MANUAL;
+}
+
+uint32_t relay_snapshot_remaining(const relay_snapshot_t *snap, const uint8_t relay_num) {
+    if (relay_snapshot_mode(snap, relay_num) == RELAY_MODE_OFF) return 0;
+    int32_t left = (int32_t)(snap->expires[relay_num] - xTaskGetTickCount());
+    return left > 0 ? left / configTICK_RATE_HZ : 0;
 }
 
 relay_mode_t relay_get_mode(const uint8_t relay_num) {
-    if (relay_num < NUM_RELAYS) return relay_modes[relay_num];
-    return RELAY_MODE_OFF;
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    return relay_snapshot_mode(&snap, relay_num);
+}
+
+const char* relay_mode_to_str(const relay_mode_t mode) {
+    switch (mode) {
+        case RELAY_MODE_MANUAL: return "manual";
+        case RELAY_MODE_TIMED: return "timed";
+        default: return "off";
+    }
 }
 
 bool relay_get_state(const uint8_t relay_num) {
-    if (relay_num < NUM_RELAYS) return relay_modes[relay_num] != RELAY_MODE_OFF;
-    return false;
+    return relay_get_mode(relay_num) != RELAY_MODE_OFF;
 }
 
 uint32_t relay_get_remaining_time(const uint8_t relay_num) {
-    if (relay_num >= NUM_RELAYS || !relay_timers[relay_num]) return 0;
-    
-    if (xTimerIsTimerActive(relay_timers[relay_num]) == pdFALSE) return 0;
-
-    TickType_t expiry = xTimerGetExpiryTime(relay_timers[relay_num]);
-    TickType_t now = xTaskGetTickCount();
-    
-    if (expiry > now) {
-        return (expiry - now) / configTICK_RATE_HZ;
-    }
-    return 0;
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    return relay_snapshot_remaining(&snap, relay_num);
 }
 
 void relay_toggle(const uint8_t relay_num) {
-    if (relay_num >= NUM_RELAYS) return;
-
-    if (relay_modes[relay_num] != RELAY_MODE_OFF) {
-        relay_off(relay_num);
-    } else {
-        relay_on(relay_num);
-    }
+    relay_command_t cmd = { .relay_num = relay_num, .action = RELAY_CMD_TOGGLE };
+    relay_apply(&cmd, 1);
 }
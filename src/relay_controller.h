@@ -1,10 +1,17 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
+#include "esp_err.h"
 
-#define NUM_RELAYS 4
+#define RELAY_MAX 64     // Most zones any output backend can drive
 #define MAX_ON_TIME_SEC 1200 // 20 minutes fallback
-#define MAX_ROUTINE_STEPS 16
+#define MAX_ROUTINE_STEPS RELAY_MAX  // A step for every zone
+#define MAX_RELAY_LISTENERS 4
+#define MAX_RELAY_COMMANDS 16
+
+// Relays as bits, relay n in bit n
+typedef uint64_t relay_mask_t;
+#define RELAY_BIT(n) ((relay_mask_t)1 << (n))
 
 typedef enum {
     RELAY_MODE_OFF = 0,
@@ -14,30 +21,141 @@ typedef enum {
 
 typedef struct {
     uint8_t relay_id;
-    uint16_t duration_sec;
+    uint16_t duration_sec;      // With litres, only the upper limit
+    uint16_t litres;            // 0 for a step on time alone, see flow_meter.h
+    bool wait;                  // Starts only once every step before it is done
     char name[32];
 } routine_step_t;
 
+// Steps as bits, step n in bit n
+typedef uint64_t step_mask_t;
+#define STEP_BIT(n) ((step_mask_t)1 << (n))
+
 typedef struct {
     char name[32];
-    uint8_t current_step;
+    step_mask_t active_steps;   // Watering now
+    step_mask_t done_steps;     // Finished, skipped or cut short
     uint8_t num_steps;
     bool is_running;
     routine_step_t steps[MAX_ROUTINE_STEPS];
 } routine_state_t;
 
-// Turn relay on/off
+// How far a routine cut short had got, to resume it
+typedef struct {
+    step_mask_t done;
+    uint16_t left[MAX_ROUTINE_STEPS];   // Seconds left of those that were running
+} routine_progress_t;
+
+// Routine steps run side by side, at most `parallel` at a time, and with
+// a capacity only while the costs of their zones add up to at most that.
+// A step costing more than the capacity runs alone.
+typedef struct {
+    uint8_t parallel;               // 1 runs the steps one after another
+    uint16_t capacity;              // 0 for no budget
+    uint16_t cost[RELAY_MAX];       // E.g. each zone's flow in L/min
+} routine_limits_t;
+
+// Relay and routine state in one block, copied out whole by
+// relay_snapshot() so a reader never sees half of a change
+typedef struct {
+    uint32_t version;       // Changes with every update
+    uint8_t count;          // Zones in use, relays 0 to count - 1
+    uint8_t num_steps;
+    step_mask_t active_steps;
+    step_mask_t done_steps;
+    bool routine_running;
+    relay_mask_t on_mask;           // Bit n set while relay n is on
+    relay_mask_t timed_mask;        // ... and was switched on for a set time
+    uint32_t routine_changed;       // Version of the routine's last change
+    uint32_t expires[RELAY_MAX];    // Tick the relay switches off at, if on
+    uint32_t changed[RELAY_MAX];    // Version of each relay's last change
+} relay_snapshot_t;
+
+typedef enum {
+    RELAY_CMD_OFF = 0,
+    RELAY_CMD_ON,       // Manual, with the MAX_ON_TIME_SEC safety timer
+    RELAY_CMD_TIMED,    // On for `seconds`; 0 switches off
+    RELAY_CMD_TOGGLE
+} relay_cmd_action_t;
+
+typedef struct {
+    uint8_t relay_num;
+    uint8_t action;     // relay_cmd_action_t
+    uint32_t seconds;
+} relay_command_t;
+
+typedef enum {
+    RELAY_EVENT_RELAY = 0,  // relay_num changed state
+    RELAY_EVENT_ROUTINE     // routine started, advanced a step or ended
+} relay_event_t;
+
+// Called from whichever task changed the state (httpd, timer service,
+// routine task). Listeners must be short and must not block.
+typedef void (*relay_listener_t)(relay_event_t event, uint8_t relay_num);
+
+// Sets up the outputs (see relay_output.h) and the zone count saved by
+// relay_set_count(), all relays off
 void relay_init(void);
+// Zones in use; relay numbers from it up are rejected
+int relay_count(void);
+// Relays the output backend can drive, the limit for relay_set_count()
+int relay_channels(void);
+// Changes the zone count at once and saves it to NVS. Zones dropped by it
+// are switched off first. ESP_ERR_INVALID_ARG outside 1..relay_channels().
+esp_err_t relay_set_count(int count);
+
+// Turn relay on/off
 void relay_on(uint8_t relay_num);
 void relay_off(uint8_t relay_num);
 void relay_on_with_timer(uint8_t relay_num, uint32_t seconds);
 void relay_toggle(uint8_t relay_num);
+// Applies the commands as one change: the outputs switch in a single
+// register write or bus transaction and all timers start on the same tick. A later
+// command for the same relay overrides an earlier one; bad relay numbers
+// are ignored.
+void relay_apply(const relay_command_t* cmds, int count);
+// Switches off those of `relays` that are on, in one change like
+// relay_apply(), with `end` (a history_end_t) as the reason in the history
+void relay_off_mask(relay_mask_t relays, uint8_t end);
+// Consistent copy of the state without blocking any writer. routine may
+// be NULL; its name and steps are only filled in while a routine runs.
+// Safe from any task. Versions start at a random value each boot, so one
+// from before a reset is very unlikely to match; compare them with
+// relay_version_newer().
+void relay_snapshot(relay_snapshot_t *snap, routine_state_t *routine);
+// True if version a is later than b, across wrap-around
+static inline bool relay_version_newer(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
+relay_mode_t relay_snapshot_mode(const relay_snapshot_t *snap, uint8_t relay_num);
+uint32_t relay_snapshot_remaining(const relay_snapshot_t *snap, uint8_t relay_num);
+// Single-relay shortcuts, each from a fresh snapshot
 relay_mode_t relay_get_mode(uint8_t relay_num);
 bool relay_get_state(uint8_t relay_num);
 uint32_t relay_get_remaining_time(uint8_t relay_num);
+bool relay_add_listener(relay_listener_t listener);
+const char* relay_mode_to_str(relay_mode_t mode);
 
 // Routine management
-bool relay_start_routine(const char* name, routine_step_t* steps, uint8_t num_steps);
+bool relay_start_routine(const char* name, const routine_step_t* steps, uint8_t num_steps);
+// Like relay_start_routine(), but with the steps in progress->done left
+// out and those with time in progress->left started first with that
+// time, e.g. to pick up a routine cut short by a reset
+bool relay_resume_routine(const char* name, const routine_step_t* steps, uint8_t num_steps,
+                          const routine_progress_t* progress);
 void relay_stop_routine(void);
+// Ends the steps watering now; the next ones start
 void relay_skip_routine_step(void);
-routine_state_t* relay_get_routine_status(void);
+
+// The limits routine steps are packed under; parallel 1 and no capacity
+// unless set. Saved to NVS.
+void relay_get_routine_limits(routine_limits_t *limits);
+// ESP_ERR_INVALID_ARG for parallel outside 1..MAX_ROUTINE_STEPS
+esp_err_t relay_set_routine_limits(int parallel, uint32_t capacity);
+esp_err_t relay_set_zone_cost(uint8_t relay_num, uint32_t cost);
+// Steps that may start now, given those done and running: in list order,
+// none before every step ahead of a `wait` step is done, none on a zone an
+// earlier unfinished step uses, and as many as the limits allow. A later
+// step may start ahead of one that does not fit.
+step_mask_t relay_routine_startable(const routine_step_t* steps, int num_steps, step_mask_t done,
+                                    step_mask_t running, const routine_limits_t* limits);
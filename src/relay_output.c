@@ -0,0 +1,325 @@
+#include "relay_output.h"
+
+#include <esp_log.h>
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+#if RELAY_OUTPUT == RELAY_OUTPUT_GPIO
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#elif RELAY_OUTPUT == RELAY_OUTPUT_74HC595
+#include "driver/spi_master.h"
+#include "esp_heap_caps.h"
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#elif RELAY_OUTPUT == RELAY_OUTPUT_PCF8574 || RELAY_OUTPUT == RELAY_OUTPUT_MCP23017
+#include "driver/i2c_master.h"
+#else
+#error "Unknown RELAY_OUTPUT"
+#endif
+
+static const char *TAG = "RELAY_OUT";
+
+// Levels on the outputs, so a write only sends what changed
+static relay_mask_t written = 0;
+// Relays relay_output_cut() holds off. It runs in an interrupt, so this
+// and `written` are under output_lock.
+static portMUX_TYPE output_lock = portMUX_INITIALIZER_UNLOCKED;
+static relay_mask_t held_off = 0;
+
+void relay_output_release(relay_mask_t relays) {
+    portENTER_CRITICAL(&output_lock);
+    held_off &= ~relays;
+    portEXIT_CRITICAL(&output_lock);
+}
+
+#if RELAY_OUTPUT == RELAY_OUTPUT_GPIO
+
+// Adjust your GPIOs. In DRAM for relay_output_cut(), which runs with the
+// flash cache off.
+static const DRAM_ATTR gpio_num_t relay_pins[] = {(gpio_num_t) 6, (gpio_num_t) 7, (gpio_num_t) 5, (gpio_num_t) 10};
+#define CHANNELS (int)(sizeof(relay_pins) / sizeof(relay_pins[0]))
+
+int relay_output_init(void) {
+    gpio_config_t io_conf = {
+        .pin_bit_mask = 0,
+        .mode = GPIO_MODE_OUTPUT,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_DISABLE
+    };
+    for (int i = 0; i < CHANNELS; i++) {
+        // A write drives all relays through the one OUT register
+        configASSERT(relay_pins[i] < 32);
+        io_conf.pin_bit_mask |= (1ULL << relay_pins[i]);
+        gpio_set_level(relay_pins[i], RELAY_ACTIVE_LOW);
+    }
+    gpio_config(&io_conf);
+
+    // Keep driving the outputs during automatic light sleep instead of
+    // switching to the sleep pin configuration, so no relay changes state
+    // while the CPU sleeps
+    for (int i = 0; i < CHANNELS; i++) {
+        gpio_sleep_sel_dis(relay_pins[i]);
+    }
+    ESP_LOGI(TAG, "%d relays on GPIO", CHANNELS);
+    return CHANNELS;
+}
+
+esp_err_t relay_output_write(relay_mask_t on) {
+    // Two register writes: locked, so no cut lands between reading
+    // held_off and switching a relay on
+    portENTER_CRITICAL(&output_lock);
+    on &= ~held_off;
+    relay_mask_t diff = on ^ written;
+    uint32_t on_pins = 0, off_pins = 0;
+    for (int i = 0; i < CHANNELS; i++) {
+        if (!(diff & RELAY_BIT(i))) continue;
+        if (on & RELAY_BIT(i)) {
+            on_pins |= 1u << relay_pins[i];
+        } else {
+            off_pins |= 1u << relay_pins[i];
+        }
+    }
+    // One register write per level switches all of them at once
+    if (on_pins) REG_WRITE(RELAY_ACTIVE_LOW ? GPIO_OUT_W1TC_REG : GPIO_OUT_W1TS_REG, on_pins);
+    if (off_pins) REG_WRITE(RELAY_ACTIVE_LOW ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, off_pins);
+    written = on;
+    portEXIT_CRITICAL(&output_lock);
+    return ESP_OK;
+}
+
+relay_mask_t IRAM_ATTR relay_output_cut(relay_mask_t relays) {
+    portENTER_CRITICAL_ISR(&output_lock);
+    relay_mask_t cut = relays & written;
+    uint32_t pins = 0;
+    for (int i = 0; i < CHANNELS; i++) {
+        if (cut & RELAY_BIT(i)) pins |= 1u << relay_pins[i];
+    }
+    if (pins) REG_WRITE(RELAY_ACTIVE_LOW ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, pins);
+    written &= ~cut;
+    held_off |= relays;
+    portEXIT_CRITICAL_ISR(&output_lock);
+    return cut;
+}
+
+const char *relay_output_name(void) {
+    return "gpio";
+}
+
+#elif RELAY_OUTPUT == RELAY_OUTPUT_74HC595
+
+#define CHANNELS (RELAY_SR_CHIPS * 8)
+_Static_assert(RELAY_SR_CHIPS >= 1 && CHANNELS <= RELAY_MAX, "RELAY_SR_CHIPS out of range");
+
+static spi_device_handle_t chain = NULL;
+static uint8_t *frame = NULL;   // DMA-capable, one byte per chip
+// Under output_lock: OE pulled high by relay_output_cut(), and a count of
+// cuts, so a write can tell one came in while it was shifting
+static bool oe_cut = false;
+static uint32_t cuts = 0;
+
+// Shifts the whole chain out in one DMA transaction; the latch (chip
+// select) rises at its end and every output changes together
+static esp_err_t shift_out(relay_mask_t on) {
+    for (int c = 0; c < RELAY_SR_CHIPS; c++) {
+        // The chip farthest down the chain goes first, Q7 first
+        uint8_t bits = on >> ((RELAY_SR_CHIPS - 1 - c) * 8);
+        frame[c] = RELAY_ACTIVE_LOW ? ~bits : bits;
+    }
+    spi_transaction_t t = {
+        .length = RELAY_SR_CHIPS * 8,
+        .tx_buffer = frame,
+    };
+    // A few bytes take tens of microseconds, less than a context switch
+    return spi_device_polling_transmit(chain, &t);
+}
+
+int relay_output_init(void) {
+    spi_bus_config_t bus = {
+        .mosi_io_num = RELAY_SPI_MOSI_PIN,
+        .miso_io_num = -1,
+        .sclk_io_num = RELAY_SPI_SCLK_PIN,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = RELAY_SR_CHIPS,
+    };
+    spi_device_interface_config_t dev = {
+        .clock_speed_hz = RELAY_SPI_CLOCK_HZ,
+        .mode = 0,
+        .spics_io_num = RELAY_SPI_LATCH_PIN,
+        .queue_size = 1,
+    };
+    frame = heap_caps_calloc(1, RELAY_SR_CHIPS, MALLOC_CAP_DMA);
+    esp_err_t err = frame ? ESP_OK : ESP_ERR_NO_MEM;
+    if (err == ESP_OK) err = spi_bus_initialize(SPI2_HOST, &bus, SPI_DMA_CH_AUTO);
+    if (err == ESP_OK) err = spi_bus_add_device(SPI2_HOST, &dev, &chain);
+    if (err == ESP_OK) err = shift_out(0);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "74HC595 chain setup failed (%s)", esp_err_to_name(err));
+        return 0;
+    }
+
+    if (RELAY_SPI_OE_PIN >= 0) {
+        // Enabled only now that every chip holds "off"
+        gpio_config_t io_conf = {
+            .pin_bit_mask = 1ULL << RELAY_SPI_OE_PIN,
+            .mode = GPIO_MODE_OUTPUT,
+        };
+        gpio_config(&io_conf);
+        gpio_set_level(RELAY_SPI_OE_PIN, 0);
+        gpio_sleep_sel_dis(RELAY_SPI_OE_PIN);
+    }
+    ESP_LOGI(TAG, "74HC595 chain of %d on SPI2 (DMA)", RELAY_SR_CHIPS);
+    return CHANNELS;
+}
+
+esp_err_t relay_output_write(relay_mask_t on) {
+    for (;;) {
+        portENTER_CRITICAL(&output_lock);
+        relay_mask_t want = on & ~held_off;
+        bool same = want == written && !oe_cut;
+        uint32_t seen = cuts;
+        portEXIT_CRITICAL(&output_lock);
+        if (same) return ESP_OK;
+
+        esp_err_t err = shift_out(want);
+        if (err != ESP_OK) return err;
+        portENTER_CRITICAL(&output_lock);
+        bool clean = cuts == seen;
+        if (clean) {
+            written = want;
+#if RELAY_SPI_OE_PIN >= 0
+            // The chain holds nothing cut, so the outputs can come back
+            if (oe_cut) REG_WRITE(GPIO_OUT_W1TC_REG, 1u << RELAY_SPI_OE_PIN);
+#endif
+            oe_cut = false;
+        }
+        portEXIT_CRITICAL(&output_lock);
+        if (clean) return ESP_OK;
+        // A cut came in while shifting, and the frame may have a relay on
+        // that it holds off: shift again
+    }
+}
+
+relay_mask_t IRAM_ATTR relay_output_cut(relay_mask_t relays) {
+    relay_mask_t cut = 0;
+    portENTER_CRITICAL_ISR(&output_lock);
+    held_off |= relays;
+    cuts++;
+#if RELAY_SPI_OE_PIN >= 0
+    // Disables every output; the next write brings the others back
+    if (!oe_cut) {
+        REG_WRITE(GPIO_OUT_W1TS_REG, 1u << RELAY_SPI_OE_PIN);
+        oe_cut = true;
+        cut = written;
+    }
+#endif
+    portEXIT_CRITICAL_ISR(&output_lock);
+    return cut;
+}
+
+const char *relay_output_name(void) {
+    return "74hc595";
+}
+
+#else   // I2C expanders
+
+#if RELAY_OUTPUT == RELAY_OUTPUT_MCP23017
+#define PINS_PER_CHIP 16
+#define MCP23017_IODIRA 0x00
+#define MCP23017_OLATA  0x14    // OLATB follows with IOCON.BANK = 0
+#else
+#define PINS_PER_CHIP 8
+#endif
+#define CHANNELS (RELAY_I2C_CHIPS * PINS_PER_CHIP)
+_Static_assert(RELAY_I2C_CHIPS >= 1 && RELAY_I2C_CHIPS <= 8 && CHANNELS <= RELAY_MAX,
+               "RELAY_I2C_CHIPS out of range");
+
+static i2c_master_dev_handle_t chips[RELAY_I2C_CHIPS];
+
+static esp_err_t chip_write(int chip, uint16_t bits) {
+    if (RELAY_ACTIVE_LOW) bits = ~bits;
+#if RELAY_OUTPUT == RELAY_OUTPUT_MCP23017
+    uint8_t buf[] = {MCP23017_OLATA, bits & 0xff, bits >> 8};
+#else
+    uint8_t buf[] = {bits & 0xff};
+#endif
+    return i2c_master_transmit(chips[chip], buf, sizeof(buf), RELAY_I2C_TIMEOUT_MS);
+}
+
+int relay_output_init(void) {
+    i2c_master_bus_config_t bus_conf = {
+        .i2c_port = -1,
+        .sda_io_num = RELAY_I2C_SDA_PIN,
+        .scl_io_num = RELAY_I2C_SCL_PIN,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .glitch_ignore_cnt = 7,
+        .flags.enable_internal_pullup = true,
+    };
+    i2c_master_bus_handle_t bus;
+    esp_err_t err = i2c_new_master_bus(&bus_conf, &bus);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "I2C bus setup failed (%s)", esp_err_to_name(err));
+        return 0;
+    }
+
+    for (int c = 0; c < RELAY_I2C_CHIPS; c++) {
+        i2c_device_config_t dev = {
+            .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+            .device_address = RELAY_I2C_ADDR + c,
+            .scl_speed_hz = RELAY_I2C_CLOCK_HZ,
+        };
+        err = i2c_master_bus_add_device(bus, &dev, &chips[c]);
+        // Latches first, so the pins come up off when they become outputs
+        if (err == ESP_OK) err = chip_write(c, 0);
+#if RELAY_OUTPUT == RELAY_OUTPUT_MCP23017
+        if (err == ESP_OK) {
+            uint8_t iodir[] = {MCP23017_IODIRA, 0x00, 0x00};
+            err = i2c_master_transmit(chips[c], iodir, sizeof(iodir), RELAY_I2C_TIMEOUT_MS);
+        }
+#endif
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "No expander at 0x%02x (%s); %d relays usable", RELAY_I2C_ADDR + c,
+                     esp_err_to_name(err), c * PINS_PER_CHIP);
+            return c * PINS_PER_CHIP;
+        }
+    }
+    ESP_LOGI(TAG, "%d %s at 0x%02x", RELAY_I2C_CHIPS, relay_output_name(), RELAY_I2C_ADDR);
+    return CHANNELS;
+}
+
+esp_err_t relay_output_write(relay_mask_t on) {
+    portENTER_CRITICAL(&output_lock);
+    on &= ~held_off;
+    portEXIT_CRITICAL(&output_lock);
+    relay_mask_t diff = on ^ written;
+    esp_err_t result = ESP_OK;
+    // Each chip has its own address, so one transaction per changed chip
+    for (int c = 0; c < RELAY_I2C_CHIPS && diff; c++) {
+        int shift = c * PINS_PER_CHIP;
+        relay_mask_t mask = (((relay_mask_t)1 << PINS_PER_CHIP) - 1) << shift;
+        if (!(diff & mask)) continue;
+        esp_err_t err = chip_write(c, (uint16_t)(on >> shift));
+        if (err == ESP_OK) {
+            written = (written & ~mask) | (on & mask);
+        } else {
+            result = err;
+        }
+    }
+    return result;
+}
+
+// The bus is not for interrupts; the next write does it
+relay_mask_t IRAM_ATTR relay_output_cut(relay_mask_t relays) {
+    portENTER_CRITICAL_ISR(&output_lock);
+    held_off |= relays;
+    portEXIT_CRITICAL_ISR(&output_lock);
+    return 0;
+}
+
+const char *relay_output_name(void) {
+    return RELAY_OUTPUT == RELAY_OUTPUT_MCP23017 ? "mcp23017" : "pcf8574";
+}
+
+#endif
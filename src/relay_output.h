@@ -0,0 +1,75 @@
+#pragma once
+#include "esp_err.h"
+#include "relay_controller.h"
+
+// How the relays are wired, picked at build time with -DRELAY_OUTPUT=<n>
+// in platformio.ini. The pins and chip counts below can be overridden the
+// same way.
+#define RELAY_OUTPUT_GPIO     0     // One GPIO per relay, the board's 4
+#define RELAY_OUTPUT_74HC595  1     // Chained shift registers on SPI, 8 relays per chip
+#define RELAY_OUTPUT_PCF8574  2     // I2C expanders, 8 relays per chip
+#define RELAY_OUTPUT_MCP23017 3     // I2C expanders, 16 relays per chip
+
+#ifndef RELAY_OUTPUT
+#define RELAY_OUTPUT RELAY_OUTPUT_GPIO
+#endif
+
+// Most relay modules switch on with a low input
+#ifndef RELAY_ACTIVE_LOW
+#define RELAY_ACTIVE_LOW 1
+#endif
+
+// 74HC595: data, clock and latch (RCLK, driven as the SPI chip select) on
+// the board's relay header. OE is optional (-1); when wired, the outputs
+// stay disabled until the first all-off frame has been latched.
+#ifndef RELAY_SR_CHIPS
+#define RELAY_SR_CHIPS 2
+#endif
+#ifndef RELAY_SPI_MOSI_PIN
+#define RELAY_SPI_MOSI_PIN 7
+#endif
+#ifndef RELAY_SPI_SCLK_PIN
+#define RELAY_SPI_SCLK_PIN 6
+#endif
+#ifndef RELAY_SPI_LATCH_PIN
+#define RELAY_SPI_LATCH_PIN 5
+#endif
+#ifndef RELAY_SPI_OE_PIN
+#define RELAY_SPI_OE_PIN 10
+#endif
+#define RELAY_SPI_CLOCK_HZ 1000000
+
+// PCF8574 / MCP23017: chips at consecutive addresses from RELAY_I2C_ADDR
+#ifndef RELAY_I2C_CHIPS
+#define RELAY_I2C_CHIPS 2
+#endif
+#ifndef RELAY_I2C_ADDR
+#define RELAY_I2C_ADDR 0x20
+#endif
+#ifndef RELAY_I2C_SDA_PIN
+#define RELAY_I2C_SDA_PIN 6
+#endif
+#ifndef RELAY_I2C_SCL_PIN
+#define RELAY_I2C_SCL_PIN 7
+#endif
+#define RELAY_I2C_CLOCK_HZ 400000
+#define RELAY_I2C_TIMEOUT_MS 20
+
+// Sets up the outputs with every relay off. Returns the number of relays
+// it can drive: 0 if the bus failed, or fewer than configured when an
+// expander does not answer (the zones stop before it).
+int relay_output_init(void);
+// Drives every output to `on` (bit n = relay n), in one bus transaction
+// per chip that changed and none if nothing did. Relays held off by
+// relay_output_cut() stay off. Not reentrant; the relay controller calls
+// it from one task at a time.
+esp_err_t relay_output_write(relay_mask_t on);
+// For interrupts (see relay_safety.h): holds `relays` off, whatever
+// relay_output_write() is asked for, until relay_output_release(). Returns
+// the relays it switched off there and then: those of `relays` that were
+// on with GPIO, and every relay that was on with a 74HC595 chain, whose
+// OE it pulls high. Where only a bus transaction can do it (74HC595
+// without OE, I2C) it returns 0 and the next write leaves them off.
+relay_mask_t relay_output_cut(relay_mask_t relays);
+void relay_output_release(relay_mask_t relays);
+const char *relay_output_name(void);
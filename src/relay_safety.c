@@ -0,0 +1,209 @@
+#include "relay_safety.h"
+#include "relay_output.h"
+
+#include <esp_log.h>
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "esp_task_wdt.h"
+#include "driver/gptimer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "SAFETY";
+
+#define GRACE_US ((int64_t)RELAY_SAFETY_GRACE_MS * 1000)
+// An alarm set closer than this could be passed before it is armed
+#define MIN_LEAD_US 100
+// Above lwIP (18), the web server and the routine task
+#define SAFETY_TASK_PRIORITY 19
+
+// Iterates over the relays in a mask, lowest first
+#define FOR_EACH_RELAY(i, mask) \
+    for (relay_mask_t m_ = (mask); m_; m_ &= m_ - 1) \
+        for (int i = __builtin_ctzll(m_), once_ = 1; once_; once_ = 0)
+
+static gptimer_handle_t timer = NULL;
+static TaskHandle_t safety_task_handle = NULL;
+static void (*trip_handler)(relay_mask_t relays) = NULL;
+static void (*retry_handler)(void) = NULL;
+// The timer runs; only relay_safety_arm() starts and stops it, and the
+// relay controller calls that holding its writer lock, one at a time
+static bool running = false;
+// esp_timer time at count 0
+static int64_t started_us = 0;
+
+// Shared with the interrupts, under safety_lock
+static portMUX_TYPE safety_lock = portMUX_INITIALIZER_UNLOCKED;
+static relay_mask_t armed = 0;          // Relays on, with a deadline
+static relay_mask_t tripped = 0;        // Cut, for the task to pass on
+static bool retry_pending = false;      // relay_safety_retry() called
+static int64_t deadline_us[RELAY_MAX];
+static relay_safety_stats_t stats = {0};
+
+// Points the alarm at the first armed deadline plus the grace. Call under
+// safety_lock with something armed. Plain loops here and in the
+// interrupts: nothing they call may be in flash, libgcc included.
+static void IRAM_ATTR set_alarm(int64_t now) {
+    int64_t soonest = INT64_MAX;
+    for (int i = 0; i < RELAY_MAX; i++) {
+        if ((armed & RELAY_BIT(i)) && deadline_us[i] < soonest) soonest = deadline_us[i];
+    }
+    int64_t at = soonest + GRACE_US;
+    if (at < now + MIN_LEAD_US) at = now + MIN_LEAD_US;
+    gptimer_alarm_config_t alarm = { .alarm_count = (uint64_t)(at - started_us) };
+    gptimer_set_alarm_action(timer, &alarm);
+}
+
+static bool IRAM_ATTR on_alarm(gptimer_handle_t t, const gptimer_alarm_event_data_t *edata, void *ctx) {
+    int64_t now = started_us + (int64_t)edata->count_value;
+    relay_mask_t due = 0;
+    portENTER_CRITICAL_ISR(&safety_lock);
+    for (int i = 0; i < RELAY_MAX; i++) {
+        if (!(armed & RELAY_BIT(i)) || deadline_us[i] + GRACE_US > now) continue;
+        due |= RELAY_BIT(i);
+        uint32_t late = (uint32_t)(now - deadline_us[i]);
+        if (late > stats.max_late_us) stats.max_late_us = late;
+        stats.cutoffs++;
+    }
+    armed &= ~due;
+    tripped |= due;
+    // Without anything armed the alarm stays off; the next
+    // relay_safety_arm() stops the timer
+    if (armed) set_alarm(now);
+    portEXIT_CRITICAL_ISR(&safety_lock);
+    if (due == 0) return false;
+
+    relay_output_cut(due);
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(safety_task_handle, &woken);
+    return woken == pdTRUE;
+}
+
+// Runs in the task watchdog's interrupt when a watched task (the idle
+// task) has not run for CONFIG_ESP_TASK_WDT_TIMEOUT_S: something hogs the
+// CPU, and nothing can be trusted to switch a relay off on time
+void IRAM_ATTR esp_task_wdt_isr_user_handler(void) {
+    if (safety_task_handle == NULL) return;
+    relay_output_cut(~(relay_mask_t)0);
+    portENTER_CRITICAL_ISR(&safety_lock);
+    armed = 0;
+    tripped = ~(relay_mask_t)0;
+    stats.watchdog_trips++;
+    portEXIT_CRITICAL_ISR(&safety_lock);
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(safety_task_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void safety_task(void *pvParameters) {
+    uint32_t trips_seen = 0;
+    bool retry = false;
+    TickType_t retry_at = 0;
+    for (;;) {
+        // A retry waits a tick, for the timer service to drain its queue
+        TickType_t wait = portMAX_DELAY;
+        if (retry) {
+            int32_t left = (int32_t)(retry_at - xTaskGetTickCount());
+            wait = left > 0 ? left : 0;
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+        portENTER_CRITICAL(&safety_lock);
+        relay_mask_t relays = tripped;
+        tripped = 0;
+        uint32_t trips = stats.watchdog_trips;
+        if (retry_pending && !retry) {
+            retry = true;
+            retry_at = xTaskGetTickCount() + 1;
+        }
+        retry_pending = false;
+        portEXIT_CRITICAL(&safety_lock);
+        if (trips != trips_seen) {
+            ESP_LOGE(TAG, "Task watchdog timed out; all relays cut off");
+            trips_seen = trips;
+        } else {
+            FOR_EACH_RELAY(i, relays) {
+                ESP_LOGE(TAG, "Relay %d still on %d ms past its deadline; cut off", i + 1, RELAY_SAFETY_GRACE_MS);
+            }
+        }
+        if (relays) trip_handler(relays);
+        if (retry && (int32_t)(xTaskGetTickCount() - retry_at) >= 0) {
+            retry = false;
+            retry_handler();
+        }
+    }
+}
+
+void relay_safety_init(void (*on_trip)(relay_mask_t relays), void (*on_retry)(void)) {
+    trip_handler = on_trip;
+    retry_handler = on_retry;
+    gptimer_config_t config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = 1000000,   // Counts in microseconds
+    };
+    gptimer_event_callbacks_t cbs = { .on_alarm = on_alarm };
+    esp_err_t err = gptimer_new_timer(&config, &timer);
+    if (err == ESP_OK) err = gptimer_register_event_callbacks(timer, &cbs, NULL);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "No timer for the relay cutoff (%s)", esp_err_to_name(err));
+        timer = NULL;
+        return;
+    }
+    if (xTaskCreate(safety_task, "safety_task", 3072, NULL, SAFETY_TASK_PRIORITY, &safety_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create safety task");
+        gptimer_del_timer(timer);
+        timer = NULL;
+        return;
+    }
+    ESP_LOGI(TAG, "Relay cutoff %d ms past each deadline", RELAY_SAFETY_GRACE_MS);
+}
+
+void relay_safety_arm(relay_mask_t on, relay_mask_t off, const uint16_t *seconds) {
+    if (timer == NULL) return;
+    // A relay switched on again, even one cut before, is the user's call
+    relay_output_release(on);
+    int64_t now = esp_timer_get_time();
+    if (on && !running) {
+        // Enabled only while needed: a running timer keeps the APB clock
+        // up and blocks light sleep
+        gptimer_enable(timer);
+        gptimer_set_raw_count(timer, 0);
+        started_us = esp_timer_get_time();
+        gptimer_start(timer);
+        running = true;
+    }
+
+    portENTER_CRITICAL(&safety_lock);
+    FOR_EACH_RELAY(i, on) {
+        deadline_us[i] = now + (int64_t)seconds[i] * 1000000;
+    }
+    armed = (armed | on) & ~off;
+    tripped &= ~on;
+    bool idle = armed == 0;
+    if (!idle) set_alarm(now);
+    portEXIT_CRITICAL(&safety_lock);
+
+    if (idle && running) {
+        gptimer_stop(timer);
+        gptimer_disable(timer);
+        running = false;
+    }
+}
+
+void relay_safety_retry(void) {
+    portENTER_CRITICAL(&safety_lock);
+    stats.timer_retries++;
+    retry_pending = true;
+    portEXIT_CRITICAL(&safety_lock);
+    if (safety_task_handle == NULL) {
+        ESP_LOGE(TAG, "Timer queue full and no safety task; a relay deadline is lost");
+        return;
+    }
+    xTaskNotifyGive(safety_task_handle);
+}
+
+void relay_safety_get_stats(relay_safety_stats_t *out) {
+    portENTER_CRITICAL(&safety_lock);
+    *out = stats;
+    portEXIT_CRITICAL(&safety_lock);
+}
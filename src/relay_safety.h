@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include "relay_controller.h"
+
+// Backstop for the relay deadlines that does not depend on the timer
+// service task, which runs the normal ones at priority 1 and from flash: a
+// hardware timer interrupt, cache safe, switches the output of a relay
+// still on RELAY_SAFETY_GRACE_MS past its deadline off and tells the
+// relay controller from a high priority task. The task watchdog's
+// interrupt switches every relay off. How much the interrupt can switch
+// depends on the outputs, see relay_output_cut().
+//
+// The grace is longer than any flash operation holds the CPU (a 64 KB
+// erase, about 150 ms), so the interrupt only acts when the timer service
+// is stuck or starved, never racing a normal switch-off.
+#ifndef RELAY_SAFETY_GRACE_MS
+#define RELAY_SAFETY_GRACE_MS 250
+#endif
+
+typedef struct {
+    uint32_t cutoffs;           // Relays the timer interrupt switched off
+    uint32_t max_late_us;       // Longest a relay stayed on past its deadline before that
+    uint32_t watchdog_trips;    // Task watchdog timeouts; each switches all relays off
+    uint32_t timer_retries;     // Deadline timer commands the full timer queue refused
+} relay_safety_stats_t;
+
+// Takes the timer and starts the task. on_trip gets the relays switched
+// off at the outputs, to switch them off in the state too, and on_retry is
+// called for relay_safety_retry(); both run on the safety task. The timer
+// only runs while a relay is on.
+void relay_safety_init(void (*on_trip)(relay_mask_t relays), void (*on_retry)(void));
+// Sets the deadline of each relay in `on` to seconds[i] from now and
+// drops those in `off`. The relay controller calls it with every change.
+void relay_safety_arm(relay_mask_t on, relay_mask_t off, const uint16_t *seconds);
+// Counts a deadline timer command the timer queue refused and has the
+// safety task call on_retry a tick later, to send it again. A retry that
+// fails as well calls this again.
+void relay_safety_retry(void);
+void relay_safety_get_stats(relay_safety_stats_t *stats);
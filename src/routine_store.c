@@ -0,0 +1,439 @@
+#include "routine_store.h"
+#include "json_reader.h"
+#include "flow_meter.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static const char *TAG = "ROUTINES";
+
+#define ROUTINES_TMP ROUTINES_FILE ".tmp"
+#define ROUTINES_BAK ROUTINES_FILE ".bak"
+#define LOAD_CHUNK 256
+
+// 6 bytes per step; names are shared since steps repeat the zone names
+typedef struct {
+    uint8_t relay_id;
+    uint8_t name_idx : 7;
+    uint8_t wait : 1;
+    uint16_t duration_sec;
+    uint16_t litres;
+} packed_step_t;
+
+typedef struct {
+    char name[32];
+    uint16_t first_step;
+    uint8_t num_steps;
+} routine_entry_t;
+
+typedef struct {
+    routine_entry_t routines[MAX_ROUTINES];
+    packed_step_t steps[MAX_STORED_STEPS];
+    char names[MAX_STEP_NAMES][32];
+    uint16_t num_routines;
+    uint16_t num_steps;
+    uint8_t num_names;
+} routine_table_t;
+
+// Compiles a routines document from json_reader events
+typedef struct {
+    json_reader_t reader;
+    routine_table_t *t;
+    int zones;          // Relay ids accepted, 0 to zones - 1
+    bool in_steps;      // Inside a routine's "steps" array
+    bool in_step;       // Inside one step object
+    bool has_name;
+    bool has_steps;
+    int step_no;
+    // Fields of the step being read
+    bool has_id;
+    bool has_duration;
+    bool enabled;
+    bool wait;
+    int32_t id;
+    int32_t duration;
+    int32_t litres;
+    char step_name[32];
+    char err[64];
+} compiler_t;
+
+// New uploads are compiled into the inactive table and swapped in once
+// they are on flash. Everything here is only touched from the httpd task
+// (and from app_main before the server starts), except for
+// routine_store_start(), which the scheduler task also calls; table_lock
+// covers the swap and that one read.
+static routine_table_t tables[2];
+static routine_table_t *active = &tables[0];
+static portMUX_TYPE table_lock = portMUX_INITIALIZER_UNLOCKED;
+static compiler_t compiler;
+static FILE *upload_file = NULL;
+
+static routine_table_t *inactive_table(void) {
+    return (active == &tables[0]) ? &tables[1] : &tables[0];
+}
+
+static bool reject(compiler_t *c, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(c->err, sizeof(c->err), fmt, args);
+    va_end(args);
+    return false;
+}
+
+static int intern_name(routine_table_t *t, const char *name) {
+    for (int i = 0; i < t->num_names; i++) {
+        if (strcmp(t->names[i], name) == 0) return i;
+    }
+    if (t->num_names >= MAX_STEP_NAMES) return -1;
+    strlcpy(t->names[t->num_names], name, sizeof(t->names[0]));
+    return t->num_names++;
+}
+
+static bool finish_step(compiler_t *c) {
+    routine_table_t *t = c->t;
+    routine_entry_t *entry = &t->routines[t->num_routines];
+    int r = t->num_routines + 1;
+
+    if (!c->has_id) return reject(c, "Routine %d step %d: invalid relay id", r, c->step_no);
+    if (!c->has_duration) return reject(c, "Routine %d step %d: duration out of range", r, c->step_no);
+    if (!c->enabled) return true;
+    if (entry->num_steps >= MAX_ROUTINE_STEPS) {
+        return reject(c, "Routine %d: too many enabled steps (max %d)", r, MAX_ROUTINE_STEPS);
+    }
+    if (t->num_steps >= MAX_STORED_STEPS) {
+        return reject(c, "Too many steps in total (max %d)", MAX_STORED_STEPS);
+    }
+    int name_idx = intern_name(t, c->step_name);
+    if (name_idx < 0) return reject(c, "Too many distinct step names (max %d)", MAX_STEP_NAMES);
+
+    packed_step_t *step = &t->steps[t->num_steps++];
+    step->relay_id = c->id;
+    step->name_idx = name_idx;
+    step->duration_sec = c->duration * 60;
+    step->litres = c->litres;
+    step->wait = c->wait;
+    entry->num_steps++;
+    return true;
+}
+
+static bool is_key(const json_token_t *tok, const char *key) {
+    return tok->key != NULL && strcmp(tok->key, key) == 0;
+}
+
+// Depth 0 is the routines array, 1 a routine, 2 its members, 3 a step and
+// 4 the step's members. Unknown members (e.g. "order") are skipped.
+static bool on_token(void *ctx, const json_token_t *tok) {
+    compiler_t *c = (compiler_t *)ctx;
+    routine_table_t *t = c->t;
+    routine_entry_t *entry = &t->routines[t->num_routines];
+    int r = t->num_routines + 1;
+    int32_t v;
+
+    switch (tok->depth) {
+        case 0:
+            if (tok->type == JSON_ARR_BEGIN || tok->type == JSON_ARR_END) return true;
+            return reject(c, "Expected an array of routines");
+
+        case 1:
+            if (tok->type == JSON_OBJ_BEGIN) {
+                if (t->num_routines >= MAX_ROUTINES) return reject(c, "Too many routines (max %d)", MAX_ROUTINES);
+                memset(entry, 0, sizeof(*entry));
+                entry->first_step = t->num_steps;
+                c->has_name = false;
+                c->has_steps = false;
+                c->step_no = 0;
+                return true;
+            }
+            if (tok->type == JSON_OBJ_END) {
+                if (!c->has_name || !c->has_steps) {
+                    return reject(c, "Routine %d: needs a name and a steps array", r);
+                }
+                t->num_routines++;
+                return true;
+            }
+            return reject(c, "Routine %d: not an object", r);
+
+        case 2:
+            if (tok->type == JSON_ARR_END || tok->type == JSON_OBJ_END) {
+                c->in_steps = false;
+            } else if (is_key(tok, "name")) {
+                if (tok->type != JSON_STRING) return reject(c, "Routine %d: name must be a string", r);
+                strlcpy(entry->name, tok->str, sizeof(entry->name));
+                c->has_name = true;
+            } else if (is_key(tok, "steps")) {
+                if (tok->type != JSON_ARR_BEGIN) return reject(c, "Routine %d: steps must be an array", r);
+                c->in_steps = true;
+                c->has_steps = true;
+            }
+            return true;
+
+        case 3:
+            if (!c->in_steps) return true;
+            if (tok->type == JSON_OBJ_BEGIN) {
+                c->step_no++;
+                c->in_step = true;
+                c->has_id = false;
+                c->has_duration = false;
+                c->enabled = true;
+                c->wait = false;
+                c->litres = 0;
+                c->step_name[0] = '\0';
+                return true;
+            }
+            if (tok->type == JSON_OBJ_END) {
+                c->in_step = false;
+                return finish_step(c);
+            }
+            return reject(c, "Routine %d step %d: not an object", r, c->step_no + 1);
+
+        case 4:
+            if (!c->in_step) return true;
+            if (is_key(tok, "id")) {
+                if (!json_token_int(tok, &v) || v < 0 || v >= c->zones) {
+                    return reject(c, "Routine %d step %d: invalid relay id", r, c->step_no);
+                }
+                c->id = v;
+                c->has_id = true;
+            } else if (is_key(tok, "duration")) {
+                if (!json_token_int(tok, &v) || v < 1 || v > MAX_ON_TIME_SEC / 60) {
+                    return reject(c, "Routine %d step %d: duration out of range", r, c->step_no);
+                }
+                c->duration = v;
+                c->has_duration = true;
+            } else if (is_key(tok, "litres")) {
+                if (!json_token_int(tok, &v) || v < 0 || v > FLOW_MAX_STEP_LITRES) {
+                    return reject(c, "Routine %d step %d: litres out of range", r, c->step_no);
+                }
+                c->litres = v;
+            } else if (is_key(tok, "enabled")) {
+                if (tok->type != JSON_BOOL) {
+                    return reject(c, "Routine %d step %d: enabled must be true or false", r, c->step_no);
+                }
+                c->enabled = tok->boolean;
+            } else if (is_key(tok, "wait")) {
+                if (tok->type != JSON_BOOL) {
+                    return reject(c, "Routine %d step %d: wait must be true or false", r, c->step_no);
+                }
+                c->wait = tok->boolean;
+            } else if (is_key(tok, "name")) {
+                if (tok->type != JSON_STRING) {
+                    return reject(c, "Routine %d step %d: name must be a string", r, c->step_no);
+                }
+                strlcpy(c->step_name, tok->str, sizeof(c->step_name));
+            }
+            return true;
+
+        default:
+            return true;
+    }
+}
+
+static void compiler_init(compiler_t *c, routine_table_t *t, int zones) {
+    memset(c, 0, sizeof(*c));
+    memset(t, 0, sizeof(*t));
+    c->t = t;
+    c->zones = zones;
+    json_reader_init(&c->reader, on_token, c);
+}
+
+// Syntax errors come from the reader, semantic ones from on_token()
+static bool compiler_feed(compiler_t *c, const char *data, size_t len, bool last) {
+    bool ok = len == 0 || json_reader_feed(&c->reader, data, len);
+    if (ok && last) ok = json_reader_finish(&c->reader);
+    if (!ok && c->err[0] == '\0') {
+        snprintf(c->err, sizeof(c->err), "Invalid JSON at byte %u: %s",
+                 (unsigned)c->reader.pos, c->reader.error);
+    }
+    return ok;
+}
+
+static bool file_exists(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0;
+}
+
+// A reset can interrupt routine_store_upload_finish() between its renames.
+// Until the new file is in place the old one is still the valid copy.
+static void recover_files(void) {
+    if (!file_exists(ROUTINES_FILE) && file_exists(ROUTINES_BAK)) {
+        ESP_LOGW(TAG, "Restoring %s after an interrupted save", ROUTINES_BAK);
+        rename(ROUTINES_BAK, ROUTINES_FILE);
+    }
+    remove(ROUTINES_BAK);
+    remove(ROUTINES_TMP);
+}
+
+esp_err_t routine_store_init(void) {
+    recover_files();
+
+    FILE *f = fopen(ROUTINES_FILE, "r");
+    if (f == NULL) {
+        ESP_LOGI(TAG, "No routines file, starting empty");
+        return ESP_OK;
+    }
+
+    routine_table_t *staging = inactive_table();
+    // The saved file stays valid if the zone count was lowered since; the
+    // steps on zones no longer in use are skipped when they run
+    compiler_init(&compiler, staging, RELAY_MAX);
+    char buf[LOAD_CHUNK];
+    size_t len;
+    bool ok = true;
+    while (ok && (len = fread(buf, 1, sizeof(buf), f)) > 0) {
+        ok = compiler_feed(&compiler, buf, len, false);
+    }
+    fclose(f);
+    if (ok) ok = compiler_feed(&compiler, NULL, 0, true);
+
+    if (!ok) {
+        ESP_LOGE(TAG, "Ignoring %s: %s", ROUTINES_FILE, compiler.err);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&table_lock);
+    active = staging;
+    portEXIT_CRITICAL(&table_lock);
+    ESP_LOGI(TAG, "Loaded %d routines (%d steps)", active->num_routines, active->num_steps);
+    return ESP_OK;
+}
+
+static void discard_upload(void) {
+    if (upload_file) {
+        fclose(upload_file);
+        upload_file = NULL;
+    }
+    remove(ROUTINES_TMP);
+}
+
+esp_err_t routine_store_upload_begin(void) {
+    discard_upload();
+    compiler_init(&compiler, inactive_table(), relay_count());
+
+    upload_file = fopen(ROUTINES_TMP, "w");
+    if (upload_file == NULL) {
+        snprintf(compiler.err, sizeof(compiler.err), "Failed to open file for writing");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t routine_store_upload_write(const char *data, size_t len) {
+    if (upload_file == NULL) return ESP_ERR_INVALID_STATE;
+
+    if (!compiler_feed(&compiler, data, len, false)) {
+        discard_upload();
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (fwrite(data, 1, len, upload_file) != len) {
+        snprintf(compiler.err, sizeof(compiler.err), "Failed to write routines file");
+        discard_upload();
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t routine_store_upload_finish(void) {
+    if (upload_file == NULL) return ESP_ERR_INVALID_STATE;
+
+    if (!compiler_feed(&compiler, NULL, 0, true)) {
+        discard_upload();
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int closed = fclose(upload_file);
+    upload_file = NULL;
+    if (closed != 0) {
+        snprintf(compiler.err, sizeof(compiler.err), "Failed to write routines file");
+        remove(ROUTINES_TMP);
+        return ESP_FAIL;
+    }
+
+    // SPIFFS rename() will not replace an existing file, so the old copy
+    // is moved aside first; recover_files() handles a reset in between
+    bool had_old = file_exists(ROUTINES_FILE);
+    if (had_old && rename(ROUTINES_FILE, ROUTINES_BAK) != 0) {
+        snprintf(compiler.err, sizeof(compiler.err), "Failed to replace routines file");
+        remove(ROUTINES_TMP);
+        return ESP_FAIL;
+    }
+    if (rename(ROUTINES_TMP, ROUTINES_FILE) != 0) {
+        if (had_old) rename(ROUTINES_BAK, ROUTINES_FILE);
+        snprintf(compiler.err, sizeof(compiler.err), "Failed to replace routines file");
+        remove(ROUTINES_TMP);
+        return ESP_FAIL;
+    }
+    remove(ROUTINES_BAK);
+
+    portENTER_CRITICAL(&table_lock);
+    active = compiler.t;
+    portEXIT_CRITICAL(&table_lock);
+    ESP_LOGI(TAG, "Saved %d routines (%d steps)", active->num_routines, active->num_steps);
+    return ESP_OK;
+}
+
+void routine_store_upload_abort(void) {
+    discard_upload();
+}
+
+const char *routine_store_upload_error(void) {
+    return compiler.err;
+}
+
+int routine_store_count(void) {
+    return active->num_routines;
+}
+
+const char *routine_store_name(int index) {
+    if (index < 0 || index >= active->num_routines) return NULL;
+    return active->routines[index].name;
+}
+
+static int copy_steps(const routine_table_t *t, int index, routine_step_t *steps) {
+    if (index < 0 || index >= t->num_routines) return -1;
+
+    const routine_entry_t *entry = &t->routines[index];
+    for (int i = 0; i < entry->num_steps; i++) {
+        const packed_step_t *p = &t->steps[entry->first_step + i];
+        steps[i].relay_id = p->relay_id;
+        steps[i].duration_sec = p->duration_sec;
+        steps[i].litres = p->litres;
+        steps[i].wait = p->wait;
+        strlcpy(steps[i].name, t->names[p->name_idx], sizeof(steps[i].name));
+    }
+    return entry->num_steps;
+}
+
+int routine_store_steps(int index, routine_step_t *steps) {
+    return copy_steps(active, index, steps);
+}
+
+esp_err_t routine_store_start(int index) {
+    static const routine_progress_t from_start = {0};
+    return routine_store_resume(index, &from_start);
+}
+
+esp_err_t routine_store_resume(int index, const routine_progress_t *progress) {
+    char name[32] = {0};
+    // A step per zone is too big for the callers' stacks
+    routine_step_t *steps = malloc(MAX_ROUTINE_STEPS * sizeof(routine_step_t));
+    if (steps == NULL) return ESP_ERR_NO_MEM;
+
+    portENTER_CRITICAL(&table_lock);
+    int num_steps = copy_steps(active, index, steps);
+    if (num_steps >= 0) {
+        strlcpy(name, active->routines[index].name, sizeof(name));
+    }
+    portEXIT_CRITICAL(&table_lock);
+
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    if (num_steps >= 0 &&
+        (num_steps == 0 || num_steps >= MAX_ROUTINE_STEPS || (progress->done >> num_steps) == 0)) {
+        err = relay_resume_routine(name, steps, num_steps, progress) ? ESP_OK : ESP_ERR_INVALID_STATE;
+    }
+    free(steps);
+    return err;
+}
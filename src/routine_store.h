@@ -0,0 +1,42 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "relay_controller.h"
+
+#define ROUTINES_FILE "/spiffs/routines.json"
+#define ROUTINES_MAX_SIZE (64 * 1024) // sanity cap, uploads are streamed
+#define MAX_ROUTINES 32
+#define MAX_STORED_STEPS 256          // shared by all routines
+#define MAX_STEP_NAMES RELAY_MAX      // distinct step names, one per zone
+
+// Compiles routines.json into the RAM table, first finishing any file swap
+// interrupted by a reset. A missing file leaves the table empty; a
+// malformed one is logged and also leaves it empty.
+esp_err_t routine_store_init(void);
+
+// Streaming upload of a new routines.json. Chunks are validated and
+// compiled as they arrive and written to a temp file; finish swaps both
+// the file and the table in only if the whole document was valid.
+// Returns ESP_ERR_INVALID_ARG for malformed input, with the reason in
+// routine_store_upload_error(); nothing changes until finish succeeds.
+esp_err_t routine_store_upload_begin(void);
+esp_err_t routine_store_upload_write(const char *data, size_t len);
+esp_err_t routine_store_upload_finish(void);
+void routine_store_upload_abort(void);
+const char *routine_store_upload_error(void);
+
+int routine_store_count(void);
+// NULL if index is out of range
+const char *routine_store_name(int index);
+// Fills steps (room for MAX_ROUTINE_STEPS) with the enabled steps of a
+// routine, in run order. Returns the step count, or -1 if out of range.
+int routine_store_steps(int index, routine_step_t *steps);
+// Starts a routine by index. Safe to call from any task. Returns
+// ESP_ERR_NOT_FOUND for a bad index, ESP_ERR_INVALID_STATE if a routine
+// is already running and ESP_ERR_NO_MEM without memory for the steps.
+esp_err_t routine_store_start(int index);
+// Starts a routine where `progress` says it had got to, see
+// relay_resume_routine(). Returns ESP_ERR_NOT_FOUND for a bad index or
+// steps it does not have.
+esp_err_t routine_store_resume(int index, const routine_progress_t *progress);
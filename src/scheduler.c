@@ -0,0 +1,671 @@
+#include "scheduler.h"
+#include "json_reader.h"
+#include "routine_store.h"
+#include "esp_log.h"
+#include "esp_netif_sntp.h"
+#include "nvs.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *TAG = "SCHED";
+
+#define SNTP_SERVER "pool.ntp.org"
+#define NVS_NAMESPACE "sched"
+#define CONFIG_VERSION 1
+// The RTC counts from 1970 until SNTP sets it; nothing runs before this
+#define CLOCK_VALID_AFTER 1704067200    // 2024-01-01
+// Re-read the clock at least this often so RTC drift or an SNTP step
+// can never hold a run back for long
+#define MAX_SLEEP_SEC 3600
+// An on-time run may start this late even with catch-up disabled
+#define ON_TIME_SLACK_SEC 60
+
+// Notification bits posted to scheduler_task
+#define SCHED_EVT_CHANGED  (1u << 0)
+#define SCHED_EVT_TIME_SET (1u << 1)
+
+typedef struct {
+    uint8_t version;
+    uint8_t count;
+    uint16_t catchup_min;   // Missed runs older than this are dropped
+    char tz[SCHEDULE_TZ_LEN];
+    schedule_t items[MAX_SCHEDULES];
+} schedule_config_t;
+
+static const char *const type_names[] = {"daily", "weekly", "interval", "once"};
+
+// The configuration is replaced by the httpd task and copied by the
+// scheduler task, which in turn publishes the run times; all of it is
+// guarded by state_lock.
+static schedule_config_t config;
+static int64_t next_run[MAX_SCHEDULES];
+static int64_t last_run[MAX_SCHEDULES];
+static bool time_synced = false;
+static portMUX_TYPE state_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t scheduler_task_handle = NULL;
+
+// --- Run times ---------------------------------------------------------------
+
+// `minute` past local midnight, `day` days after the local date of t.
+// mktime() settles DST: a skipped local time is moved forward and a
+// repeated one resolves to a single instant.
+static int64_t local_time(int64_t t, int day, uint16_t minute, int *wday) {
+    time_t tt = (time_t)t;
+    struct tm tm;
+    localtime_r(&tt, &tm);
+    tm.tm_mday += day;
+    tm.tm_hour = minute / 60;
+    tm.tm_min = minute % 60;
+    tm.tm_sec = 0;
+    tm.tm_isdst = -1;
+    time_t result = mktime(&tm);
+    *wday = tm.tm_wday;
+    return result;
+}
+
+static bool runs_on(const schedule_t *s, int wday) {
+    return s->type == SCHEDULE_DAILY || (s->days & (1u << wday));
+}
+
+// First run strictly after `after`, or 0 if there is none
+static int64_t next_run_after(const schedule_t *s, int64_t after) {
+    int64_t period = (int64_t)s->interval_min * 60;
+    int wday;
+
+    switch (s->type) {
+        case SCHEDULE_DAILY:
+        case SCHEDULE_WEEKLY:
+            for (int day = 0; day <= 7; day++) {
+                int64_t t = local_time(after, day, s->minute, &wday);
+                if (t > after && runs_on(s, wday)) return t;
+            }
+            return 0;
+        case SCHEDULE_INTERVAL:
+            if (after < s->at) return s->at;
+            return s->at + ((after - s->at) / period + 1) * period;
+        case SCHEDULE_ONCE:
+            return s->at > after ? s->at : 0;
+        default:
+            return 0;
+    }
+}
+
+// Latest run in (after, now], or 0 if there is none
+static int64_t last_run_between(const schedule_t *s, int64_t after, int64_t now) {
+    int64_t period = (int64_t)s->interval_min * 60;
+    int64_t t = 0;
+    int wday;
+
+    switch (s->type) {
+        case SCHEDULE_DAILY:
+        case SCHEDULE_WEEKLY:
+            for (int day = 0; day >= -7; day--) {
+                int64_t candidate = local_time(now, day, s->minute, &wday);
+                if (candidate <= now && runs_on(s, wday)) {
+                    t = candidate;
+                    break;
+                }
+            }
+            break;
+        case SCHEDULE_INTERVAL:
+            if (now >= s->at) t = s->at + ((now - s->at) / period) * period;
+            break;
+        case SCHEDULE_ONCE:
+            if (s->at <= now) t = s->at;
+            break;
+    }
+    return t > after ? t : 0;
+}
+
+// --- Min-heap of upcoming runs ---------------------------------------------
+
+// One entry per enabled schedule, owned by the scheduler task. Ties go
+// to the lower index so runs due together always start in list order.
+typedef struct {
+    int64_t due;
+    uint8_t idx;
+} heap_entry_t;
+
+static heap_entry_t heap[MAX_SCHEDULES];
+static int heap_len = 0;
+
+static bool heap_before(const heap_entry_t *a, const heap_entry_t *b) {
+    return a->due < b->due || (a->due == b->due && a->idx < b->idx);
+}
+
+static void heap_swap(int a, int b) {
+    heap_entry_t tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+}
+
+static void heap_push(int64_t due, uint8_t idx) {
+    int i = heap_len++;
+    heap[i].due = due;
+    heap[i].idx = idx;
+    while (i > 0 && heap_before(&heap[i], &heap[(i - 1) / 2])) {
+        heap_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static heap_entry_t heap_pop(void) {
+    heap_entry_t top = heap[0];
+    heap[0] = heap[--heap_len];
+    int i = 0;
+    for (;;) {
+        int left = 2 * i + 1;
+        int right = left + 1;
+        int min = i;
+        if (left < heap_len && heap_before(&heap[left], &heap[min])) min = left;
+        if (right < heap_len && heap_before(&heap[right], &heap[min])) min = right;
+        if (min == i) break;
+        heap_swap(i, min);
+        i = min;
+    }
+    return top;
+}
+
+// --- NVS ---------------------------------------------------------------------
+
+static void config_defaults(schedule_config_t *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->version = CONFIG_VERSION;
+    cfg->catchup_min = SCHEDULE_DEFAULT_CATCHUP;
+    strlcpy(cfg->tz, SCHEDULE_DEFAULT_TZ, sizeof(cfg->tz));
+}
+
+static void load_config(void) {
+    nvs_handle_t nvs;
+    size_t len = sizeof(config);
+    bool ok = false;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+        ok = nvs_get_blob(nvs, "config", &config, &len) == ESP_OK && len == sizeof(config) &&
+             config.version == CONFIG_VERSION && config.count <= MAX_SCHEDULES;
+        nvs_close(nvs);
+    }
+    if (!ok) {
+        config_defaults(&config);
+    }
+    config.tz[sizeof(config.tz) - 1] = '\0';
+}
+
+static esp_err_t save_config(const schedule_config_t *cfg) {
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err != ESP_OK) return err;
+    err = nvs_set_blob(nvs, "config", cfg, sizeof(*cfg));
+    if (err == ESP_OK) err = nvs_commit(nvs);
+    nvs_close(nvs);
+    return err;
+}
+
+// Everything scheduled up to this time has been handled. Only written
+// when a run was due or the schedules changed, so a few times a day.
+static int64_t load_seen(void) {
+    nvs_handle_t nvs;
+    int64_t seen = 0;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+        nvs_get_i64(nvs, "seen", &seen);
+        nvs_close(nvs);
+    }
+    return seen;
+}
+
+static void save_seen(int64_t seen) {
+    nvs_handle_t nvs;
+    if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK) return;
+    if (nvs_set_i64(nvs, "seen", seen) != ESP_OK || nvs_commit(nvs) != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to save the last scheduler pass");
+    }
+    nvs_close(nvs);
+}
+
+// --- Scheduler task ----------------------------------------------------------
+
+static void rebuild(const schedule_config_t *sched, int64_t from) {
+    int64_t next[MAX_SCHEDULES] = {0};
+    heap_len = 0;
+    for (int i = 0; i < sched->count; i++) {
+        if (!sched->items[i].enabled) continue;
+        next[i] = next_run_after(&sched->items[i], from);
+        if (next[i] != 0) heap_push(next[i], i);
+    }
+    portENTER_CRITICAL(&state_lock);
+    memcpy(next_run, next, sizeof(next_run));
+    portEXIT_CRITICAL(&state_lock);
+}
+
+static void start_run(const schedule_config_t *sched, int idx, int64_t now) {
+    const schedule_t *s = &sched->items[idx];
+    esp_err_t err = routine_store_start(s->routine);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Schedule %d started routine %d", idx + 1, s->routine);
+        portENTER_CRITICAL(&state_lock);
+        last_run[idx] = now;
+        portEXIT_CRITICAL(&state_lock);
+    } else if (err == ESP_ERR_INVALID_STATE) {
+        // Not queued: a late start would shift every later step
+        ESP_LOGW(TAG, "Schedule %d skipped, a routine is already running", idx + 1);
+    } else if (err == ESP_ERR_NOT_FOUND) {
+        ESP_LOGE(TAG, "Schedule %d: routine %d does not exist", idx + 1, s->routine);
+    } else {
+        ESP_LOGE(TAG, "Schedule %d: routine %d not started (%s)", idx + 1, s->routine, esp_err_to_name(err));
+    }
+}
+
+// Starts everything due by now. However many runs of a schedule were
+// missed (powered off, or the clock stepped forward), only the latest one
+// is considered, and it is dropped if it is older than the catch-up
+// window. Returns true if any run was due.
+static bool run_due(const schedule_config_t *sched, int64_t now) {
+    int64_t window = (int64_t)sched->catchup_min * 60;
+    if (window < ON_TIME_SLACK_SEC) window = ON_TIME_SLACK_SEC;
+
+    bool any = false;
+    while (heap_len > 0 && heap[0].due <= now) {
+        heap_entry_t e = heap_pop();
+        const schedule_t *s = &sched->items[e.idx];
+        int64_t run = last_run_between(s, e.due - 1, now);
+        if (now - run <= window) {
+            start_run(sched, e.idx, now);
+        } else {
+            ESP_LOGW(TAG, "Schedule %d: run missed by %lld min, dropped",
+                     e.idx + 1, (long long)(now - run) / 60);
+        }
+
+        int64_t next = next_run_after(s, now);
+        if (next != 0) heap_push(next, e.idx);
+        portENTER_CRITICAL(&state_lock);
+        next_run[e.idx] = next;
+        portEXIT_CRITICAL(&state_lock);
+        any = true;
+    }
+    return any;
+}
+
+// Sleeps on its notification value until the earliest run is due, so it
+// wakes a handful of times a day instead of polling the clock
+static void scheduler_task(void *pvParameters) {
+    static schedule_config_t sched;     // This task's copy of config
+    int64_t seen = load_seen();
+    bool built = false;
+    uint32_t events = SCHED_EVT_CHANGED;
+
+    for (;;) {
+        int64_t now = time(NULL);
+        if (now < CLOCK_VALID_AFTER) {
+            // Nothing can be scheduled until SNTP has set the clock
+            uint32_t more = 0;
+            xTaskNotifyWait(0, UINT32_MAX, &more, portMAX_DELAY);
+            events |= more;
+            continue;
+        }
+        if (seen == 0 || seen > now) {
+            // First boot, or the clock went back: there is nothing to catch up
+            seen = now;
+        }
+
+        bool changed = events & SCHED_EVT_CHANGED;
+        if (changed || (events & SCHED_EVT_TIME_SET)) {
+            if (changed) {
+                portENTER_CRITICAL(&state_lock);
+                sched = config;
+                portEXIT_CRITICAL(&state_lock);
+                setenv("TZ", sched.tz, 1);
+                tzset();
+            }
+            // Edited schedules start from now. At boot and after a clock
+            // step, runs since the last pass go through the catch-up rule.
+            rebuild(&sched, (changed && built) ? now : seen);
+            built = true;
+        }
+
+        if (run_due(&sched, now) || changed) {
+            seen = now;
+            save_seen(seen);
+        }
+
+        int64_t sleep_sec = heap_len > 0 ? heap[0].due - now : MAX_SLEEP_SEC;
+        if (sleep_sec > MAX_SLEEP_SEC) sleep_sec = MAX_SLEEP_SEC;
+        if (sleep_sec < 1) sleep_sec = 1;
+        events = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &events, pdMS_TO_TICKS(sleep_sec * 1000));
+    }
+}
+
+static void on_time_sync(struct timeval *tv) {
+    ESP_LOGI(TAG, "Clock set by SNTP");
+    time_synced = true;
+    xTaskNotify(scheduler_task_handle, SCHED_EVT_TIME_SET, eSetBits);
+}
+
+void scheduler_init(void) {
+    load_config();
+
+    if (xTaskCreate(scheduler_task, "scheduler_task", 4096, NULL, 4, &scheduler_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create scheduler task");
+        return;
+    }
+
+    esp_sntp_config_t sntp_config = ESP_NETIF_SNTP_DEFAULT_CONFIG(SNTP_SERVER);
+    sntp_config.sync_cb = on_time_sync;
+    if (esp_netif_sntp_init(&sntp_config) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start SNTP");
+    }
+    ESP_LOGI(TAG, "Scheduler started with %d schedules (TZ %s)", config.count, config.tz);
+}
+
+// --- Upload ------------------------------------------------------------------
+
+typedef struct {
+    json_reader_t reader;
+    schedule_config_t cfg;
+    bool has_list;
+    bool in_list;       // Inside the "schedules" array
+    bool in_item;       // Inside one schedule object
+    bool in_days;
+    bool has_type;
+    bool has_routine;
+    bool has_time;
+    bool has_every;
+    bool has_at;
+    char err[64];
+} parser_t;
+
+// Only used from the httpd task
+static parser_t parser;
+static bool upload_open = false;
+
+static bool reject(parser_t *p, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(p->err, sizeof(p->err), fmt, args);
+    va_end(args);
+    return false;
+}
+
+static bool is_key(const json_token_t *tok, const char *key) {
+    return tok->key != NULL && strcmp(tok->key, key) == 0;
+}
+
+static bool parse_hhmm(const char *s, uint16_t *minute) {
+    if (strlen(s) != 5 || s[2] != ':') return false;
+    for (int i = 0; i < 5; i++) {
+        if (i != 2 && (s[i] < '0' || s[i] > '9')) return false;
+    }
+    int h = (s[0] - '0') * 10 + (s[1] - '0');
+    int m = (s[3] - '0') * 10 + (s[4] - '0');
+    if (h > 23 || m > 59) return false;
+    *minute = h * 60 + m;
+    return true;
+}
+
+static bool finish_item(parser_t *p) {
+    schedule_t *s = &p->cfg.items[p->cfg.count];
+    int n = p->cfg.count + 1;
+
+    if (!p->has_type || !p->has_routine) return reject(p, "Schedule %d: needs a type and a routine", n);
+    switch (s->type) {
+        case SCHEDULE_WEEKLY:
+            if (s->days == 0) return reject(p, "Schedule %d: needs at least one day", n);
+            // fall through
+        case SCHEDULE_DAILY:
+            if (!p->has_time) return reject(p, "Schedule %d: needs a time", n);
+            break;
+        case SCHEDULE_INTERVAL:
+            if (!p->has_every) return reject(p, "Schedule %d: needs every (minutes)", n);
+            if (!p->has_at) {
+                s->at = time(NULL);
+                if (s->at < CLOCK_VALID_AFTER) return reject(p, "Schedule %d: needs a start until the clock is set", n);
+            }
+            break;
+        case SCHEDULE_ONCE:
+            if (!p->has_at) return reject(p, "Schedule %d: needs at (UTC seconds)", n);
+            break;
+    }
+    p->cfg.count++;
+    return true;
+}
+
+// Depth 0 is the document, 1 its members, 2 a schedule, 3 the schedule's
+// members and 4 a day number. Unknown members (e.g. "next") are skipped,
+// so a GET response can be posted back.
+static bool on_token(void *ctx, const json_token_t *tok) {
+    parser_t *p = (parser_t *)ctx;
+    schedule_t *s = &p->cfg.items[p->cfg.count];
+    int n = p->cfg.count + 1;
+    int32_t v;
+    int64_t v64;
+
+    switch (tok->depth) {
+        case 0:
+            if (tok->type == JSON_OBJ_BEGIN || tok->type == JSON_OBJ_END) return true;
+            return reject(p, "Expected an object");
+
+        case 1:
+            if (tok->type == JSON_ARR_END || tok->type == JSON_OBJ_END) {
+                p->in_list = false;
+            } else if (is_key(tok, "timezone")) {
+                if (tok->type != JSON_STRING || tok->len == 0 || tok->truncated || tok->len >= SCHEDULE_TZ_LEN) {
+                    return reject(p, "timezone must be a POSIX TZ string");
+                }
+                strlcpy(p->cfg.tz, tok->str, sizeof(p->cfg.tz));
+            } else if (is_key(tok, "catchup")) {
+                if (!json_token_int(tok, &v) || v < 0 || v > 24 * 60) {
+                    return reject(p, "catchup must be 0 to 1440 minutes");
+                }
+                p->cfg.catchup_min = v;
+            } else if (is_key(tok, "schedules")) {
+                if (tok->type != JSON_ARR_BEGIN) return reject(p, "schedules must be an array");
+                p->has_list = true;
+                p->in_list = true;
+            }
+            return true;
+
+        case 2:
+            if (!p->in_list) return true;
+            if (tok->type == JSON_OBJ_BEGIN) {
+                if (p->cfg.count >= MAX_SCHEDULES) return reject(p, "Too many schedules (max %d)", MAX_SCHEDULES);
+                memset(s, 0, sizeof(*s));
+                s->enabled = true;
+                p->in_item = true;
+                p->has_type = false;
+                p->has_routine = false;
+                p->has_time = false;
+                p->has_every = false;
+                p->has_at = false;
+                return true;
+            }
+            if (tok->type == JSON_OBJ_END) {
+                p->in_item = false;
+                return finish_item(p);
+            }
+            return reject(p, "Schedule %d: not an object", n);
+
+        case 3:
+            if (!p->in_item) return true;
+            if (tok->type == JSON_ARR_END || tok->type == JSON_OBJ_END) {
+                p->in_days = false;
+            } else if (is_key(tok, "type")) {
+                int type = -1;
+                for (int i = 0; i < 4 && tok->type == JSON_STRING; i++) {
+                    if (strcmp(tok->str, type_names[i]) == 0) type = i;
+                }
+                if (type < 0) return reject(p, "Schedule %d: unknown type", n);
+                s->type = type;
+                p->has_type = true;
+            } else if (is_key(tok, "routine")) {
+                if (!json_token_int(tok, &v) || v < 0 || v >= routine_store_count()) {
+                    return reject(p, "Schedule %d: no such routine", n);
+                }
+                s->routine = v;
+                p->has_routine = true;
+            } else if (is_key(tok, "time")) {
+                if (tok->type != JSON_STRING || !parse_hhmm(tok->str, &s->minute)) {
+                    return reject(p, "Schedule %d: time must be HH:MM", n);
+                }
+                p->has_time = true;
+            } else if (is_key(tok, "days")) {
+                if (tok->type != JSON_ARR_BEGIN) return reject(p, "Schedule %d: days must be an array", n);
+                s->days = 0;
+                p->in_days = true;
+            } else if (is_key(tok, "every")) {
+                if (!json_token_int(tok, &v) || v < 1 || v > MAX_INTERVAL_MIN) {
+                    return reject(p, "Schedule %d: every must be 1 to %d minutes", n, MAX_INTERVAL_MIN);
+                }
+                s->interval_min = v;
+                p->has_every = true;
+            } else if (is_key(tok, "start") || is_key(tok, "at")) {
+                if (!json_token_int64(tok, &v64) || v64 <= 0) {
+                    return reject(p, "Schedule %d: %s must be UTC seconds", n, tok->key);
+                }
+                s->at = v64;
+                p->has_at = true;
+            } else if (is_key(tok, "enabled")) {
+                if (tok->type != JSON_BOOL) return reject(p, "Schedule %d: enabled must be true or false", n);
+                s->enabled = tok->boolean;
+            }
+            return true;
+
+        case 4:
+            if (!p->in_days) return true;
+            if (!json_token_int(tok, &v) || v < 0 || v > 6) {
+                return reject(p, "Schedule %d: days are 0 (Sunday) to 6", n);
+            }
+            s->days |= 1u << v;
+            return true;
+
+        default:
+            return true;
+    }
+}
+
+// Syntax errors come from the reader, semantic ones from on_token()
+static bool parser_feed(parser_t *p, const char *data, size_t len, bool last) {
+    bool ok = len == 0 || json_reader_feed(&p->reader, data, len);
+    if (ok && last) ok = json_reader_finish(&p->reader);
+    if (!ok && p->err[0] == '\0') {
+        snprintf(p->err, sizeof(p->err), "Invalid JSON at byte %u: %s",
+                 (unsigned)p->reader.pos, p->reader.error);
+    }
+    return ok;
+}
+
+esp_err_t scheduler_upload_begin(void) {
+    memset(&parser, 0, sizeof(parser));
+    json_reader_init(&parser.reader, on_token, &parser);
+
+    // Omitted members keep their current values
+    portENTER_CRITICAL(&state_lock);
+    parser.cfg.version = CONFIG_VERSION;
+    parser.cfg.catchup_min = config.catchup_min;
+    memcpy(parser.cfg.tz, config.tz, sizeof(parser.cfg.tz));
+    portEXIT_CRITICAL(&state_lock);
+    upload_open = true;
+    return ESP_OK;
+}
+
+esp_err_t scheduler_upload_write(const char *data, size_t len) {
+    if (!upload_open) return ESP_ERR_INVALID_STATE;
+    if (!parser_feed(&parser, data, len, false)) {
+        upload_open = false;
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+esp_err_t scheduler_upload_finish(void) {
+    if (!upload_open) return ESP_ERR_INVALID_STATE;
+    upload_open = false;
+    if (!parser_feed(&parser, NULL, 0, true)) return ESP_ERR_INVALID_ARG;
+
+    if (!parser.has_list) {
+        portENTER_CRITICAL(&state_lock);
+        parser.cfg.count = config.count;
+        memcpy(parser.cfg.items, config.items, sizeof(parser.cfg.items));
+        portEXIT_CRITICAL(&state_lock);
+    }
+
+    if (save_config(&parser.cfg) != ESP_OK) {
+        snprintf(parser.err, sizeof(parser.err), "Failed to save schedules");
+        return ESP_FAIL;
+    }
+
+    portENTER_CRITICAL(&state_lock);
+    config = parser.cfg;
+    memset(last_run, 0, sizeof(last_run));
+    memset(next_run, 0, sizeof(next_run));
+    portEXIT_CRITICAL(&state_lock);
+
+    ESP_LOGI(TAG, "Saved %d schedules (TZ %s)", parser.cfg.count, parser.cfg.tz);
+    if (scheduler_task_handle) {
+        xTaskNotify(scheduler_task_handle, SCHED_EVT_CHANGED, eSetBits);
+    }
+    return ESP_OK;
+}
+
+const char *scheduler_upload_error(void) {
+    return parser.err;
+}
+
+// --- Status ------------------------------------------------------------------
+
+void scheduler_write_json(json_writer_t *w) {
+    // Only called from the httpd task
+    static schedule_config_t cfg;
+    int64_t next[MAX_SCHEDULES];
+    int64_t last[MAX_SCHEDULES];
+
+    portENTER_CRITICAL(&state_lock);
+    cfg = config;
+    memcpy(next, next_run, sizeof(next));
+    memcpy(last, last_run, sizeof(last));
+    bool synced = time_synced;
+    portEXIT_CRITICAL(&state_lock);
+
+    json_obj_begin(w);
+    json_kv_str(w, "timezone", cfg.tz);
+    json_kv_uint(w, "catchup", cfg.catchup_min);
+    json_kv_uint(w, "time", (uint32_t)time(NULL));
+    json_kv_bool(w, "synced", synced);
+    json_key(w, "schedules");
+    json_arr_begin(w);
+    for (int i = 0; i < cfg.count; i++) {
+        const schedule_t *s = &cfg.items[i];
+        json_obj_begin(w);
+        json_kv_str(w, "type", type_names[s->type]);
+        json_kv_uint(w, "routine", s->routine);
+        json_kv_bool(w, "enabled", s->enabled);
+        if (s->type == SCHEDULE_DAILY || s->type == SCHEDULE_WEEKLY) {
+            char hhmm[8];
+            snprintf(hhmm, sizeof(hhmm), "%02u:%02u", s->minute / 60, s->minute % 60);
+            json_kv_str(w, "time", hhmm);
+        }
+        if (s->type == SCHEDULE_WEEKLY) {
+            json_key(w, "days");
+            json_arr_begin(w);
+            for (int d = 0; d < 7; d++) {
+                if (s->days & (1u << d)) json_uint(w, d);
+            }
+            json_arr_end(w);
+        }
+        if (s->type == SCHEDULE_INTERVAL) {
+            json_kv_uint(w, "every", s->interval_min);
+            json_kv_uint(w, "start", (uint32_t)s->at);
+        }
+        if (s->type == SCHEDULE_ONCE) {
+            json_kv_uint(w, "at", (uint32_t)s->at);
+        }
+        if (next[i] != 0) json_kv_uint(w, "next", (uint32_t)next[i]);
+        if (last[i] != 0) json_kv_uint(w, "last", (uint32_t)last[i]);
+        json_obj_end(w);
+    }
+    json_arr_end(w);
+    json_obj_end(w);
+}
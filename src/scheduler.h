@@ -0,0 +1,48 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "json_writer.h"
+
+#define MAX_SCHEDULES 16
+#define SCHEDULE_TZ_LEN 48          // POSIX TZ, e.g. "CET-1CEST,M3.5.0,M10.5.0/3"
+#define SCHEDULE_DEFAULT_TZ "UTC0"
+#define SCHEDULE_DEFAULT_CATCHUP 60 // minutes
+#define SCHEDULES_MAX_SIZE 4096     // request body limit
+#define MAX_INTERVAL_MIN (7 * 24 * 60)
+
+typedef enum {
+    SCHEDULE_DAILY = 0,     // Every day at `minute` (local time)
+    SCHEDULE_WEEKLY,        // On the `days` at `minute` (local time)
+    SCHEDULE_INTERVAL,      // Every `interval_min` minutes from `at`
+    SCHEDULE_ONCE           // At `at`
+} schedule_type_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t routine;        // routine_store index
+    uint8_t days;           // Weekly: bit 0 = Sunday ... bit 6 = Saturday
+    bool enabled;
+    uint16_t minute;        // Minutes after local midnight
+    uint16_t interval_min;
+    int64_t at;             // UTC seconds: the one-shot time or the first interval run
+} schedule_t;
+
+// Loads the schedules and timezone from NVS, starts SNTP and the
+// scheduler task. Call after wifi_init_sta() (for the network interface),
+// routine_store_init() and relay_init().
+void scheduler_init(void);
+
+// Streaming replacement of the whole configuration (see web/README.md for
+// the document). Chunks are validated as they arrive; finish saves the
+// result to NVS and applies it. Returns ESP_ERR_INVALID_ARG for malformed
+// input, with the reason in scheduler_upload_error().
+esp_err_t scheduler_upload_begin(void);
+esp_err_t scheduler_upload_write(const char *data, size_t len);
+esp_err_t scheduler_upload_finish(void);
+const char *scheduler_upload_error(void);
+
+// Writes the configuration plus the clock state and each schedule's last
+// and next run
+void scheduler_write_json(json_writer_t *w);
@@ -0,0 +1,79 @@
+#include "status_cbor.h"
+#include <stdlib.h>
+
+void status_cbor_relay(cbor_writer_t *w, const relay_snapshot_t *snap, uint8_t relay_num) {
+    relay_mode_t mode = relay_snapshot_mode(snap, relay_num);
+
+    cbor_map(w, 4);
+    cbor_kv_int(w, "id", relay_num);
+    cbor_kv_str(w, "state", (mode != RELAY_MODE_OFF) ? "on" : "off");
+    cbor_kv_str(w, "mode", relay_mode_to_str(mode));
+    cbor_kv_uint(w, "rem", relay_snapshot_remaining(snap, relay_num));
+}
+
+void status_cbor_routine(cbor_writer_t *w, const routine_state_t *rs) {
+    cbor_str(w, "routine");
+    if (!rs->is_running) {
+        cbor_map(w, 1);
+        cbor_kv_bool(w, "running", false);
+        return;
+    }
+    cbor_map(w, 6);
+    cbor_kv_bool(w, "running", true);
+    cbor_kv_str(w, "name", rs->name);
+    cbor_str(w, "activeSteps");
+    cbor_array(w, __builtin_popcountll(rs->active_steps));
+    for (int i = 0; i < rs->num_steps; i++) {
+        if (rs->active_steps & STEP_BIT(i)) cbor_uint(w, i);
+    }
+    cbor_str(w, "doneSteps");
+    cbor_array(w, __builtin_popcountll(rs->done_steps));
+    for (int i = 0; i < rs->num_steps; i++) {
+        if (rs->done_steps & STEP_BIT(i)) cbor_uint(w, i);
+    }
+    cbor_kv_int(w, "numSteps", rs->num_steps);
+    cbor_str(w, "steps");
+    cbor_array(w, rs->num_steps);
+    for (int i = 0; i < rs->num_steps; i++) {
+        cbor_map(w, 3 + (rs->steps[i].litres > 0) + rs->steps[i].wait);
+        cbor_kv_str(w, "name", rs->steps[i].name);
+        cbor_kv_int(w, "id", rs->steps[i].relay_id);
+        cbor_kv_int(w, "duration", rs->steps[i].duration_sec / 60);
+        if (rs->steps[i].litres) cbor_kv_int(w, "litres", rs->steps[i].litres);
+        if (rs->steps[i].wait) cbor_kv_bool(w, "wait", true);
+    }
+}
+
+void status_cbor_write(cbor_writer_t *w, bool delta, uint32_t since) {
+    // Off the stack, as in status_json_write()
+    routine_state_t *rs = malloc(sizeof(*rs));
+    if (rs == NULL) {
+        w->error = true;
+        return;
+    }
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, rs);
+
+    if (delta && relay_version_newer(since, snap.version)) {
+        delta = false;
+    }
+    relay_mask_t relays = 0;
+    for (int i = 0; i < snap.count; i++) {
+        if (!delta || relay_version_newer(snap.changed[i], since)) relays |= RELAY_BIT(i);
+    }
+    bool routine = !delta || relay_version_newer(snap.routine_changed, since);
+
+    cbor_map(w, 1 + (relays != 0) + routine);
+    cbor_kv_uint(w, "version", snap.version);
+    if (relays) {
+        cbor_str(w, "relays");
+        cbor_array(w, __builtin_popcountll(relays));
+        for (int i = 0; i < snap.count; i++) {
+            if (relays & RELAY_BIT(i)) status_cbor_relay(w, &snap, i);
+        }
+    }
+    if (routine) {
+        status_cbor_routine(w, rs);
+    }
+    free(rs);
+}
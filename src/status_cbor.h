@@ -0,0 +1,20 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "cbor_writer.h"
+#include "relay_controller.h"
+
+// CBOR versions of the status_json encoders, for /api/v2 and clients that
+// send Accept: application/cbor. Keys and values are the same as in the
+// JSON, so a generic CBOR decoder yields the same document.
+
+// {"id":..,"state":..,"mode":..,"rem":..}
+void status_cbor_relay(cbor_writer_t *w, const relay_snapshot_t *snap, uint8_t relay_num);
+// "routine":{"running":..,"name":..,"activeSteps":[..],"doneSteps":[..],"numSteps":..,"steps":[..]}
+void status_cbor_routine(cbor_writer_t *w, const routine_state_t *rs);
+// The /api/status document plus its "version", from a fresh snapshot.
+// With delta set, only the relays and routine that changed after version
+// `since` are included, and "relays"/"routine" are left out if none did.
+// A `since` later than the current version (e.g. from before a reset)
+// gets the full document.
+void status_cbor_write(cbor_writer_t *w, bool delta, uint32_t since);
@@ -0,0 +1,78 @@
+#include "status_json.h"
+#include "flow_meter.h"
+#include "moisture.h"
+#include <stdlib.h>
+
+void status_json_relay(json_writer_t *w, const relay_snapshot_t *snap, uint8_t relay_num) {
+    relay_mode_t mode = relay_snapshot_mode(snap, relay_num);
+
+    json_obj_begin(w);
+    json_kv_int(w, "id", relay_num);
+    json_kv_str(w, "state", (mode != RELAY_MODE_OFF) ? "on" : "off");
+    json_kv_str(w, "mode", relay_mode_to_str(mode));
+    json_kv_uint(w, "rem", relay_snapshot_remaining(snap, relay_num));
+    if (mode != RELAY_MODE_OFF && flow_meter_present()) {
+        json_kv_uint(w, "ml", flow_meter_zone_ml(relay_num));
+    }
+    json_obj_end(w);
+}
+
+void status_json_routine(json_writer_t *w, const routine_state_t *rs) {
+    json_key(w, "routine");
+    json_obj_begin(w);
+    json_kv_bool(w, "running", rs->is_running);
+    if (rs->is_running) {
+        json_kv_str(w, "name", rs->name);
+        json_key(w, "activeSteps");
+        json_arr_begin(w);
+        for (int i = 0; i < rs->num_steps; i++) {
+            if (rs->active_steps & STEP_BIT(i)) json_int(w, i);
+        }
+        json_arr_end(w);
+        json_key(w, "doneSteps");
+        json_arr_begin(w);
+        for (int i = 0; i < rs->num_steps; i++) {
+            if (rs->done_steps & STEP_BIT(i)) json_int(w, i);
+        }
+        json_arr_end(w);
+        json_kv_int(w, "numSteps", rs->num_steps);
+        json_key(w, "steps");
+        json_arr_begin(w);
+        for (int i = 0; i < rs->num_steps; i++) {
+            json_obj_begin(w);
+            json_kv_str(w, "name", rs->steps[i].name);
+            json_kv_int(w, "id", rs->steps[i].relay_id);
+            json_kv_int(w, "duration", rs->steps[i].duration_sec / 60);
+            if (rs->steps[i].litres) json_kv_int(w, "litres", rs->steps[i].litres);
+            if (rs->steps[i].wait) json_kv_bool(w, "wait", true);
+            json_obj_end(w);
+        }
+        json_arr_end(w);
+    }
+    json_obj_end(w);
+}
+
+void status_json_write(json_writer_t *w) {
+    // A routine with a step per zone is too big for the callers' stacks
+    // (the esp_timer task among them)
+    routine_state_t *rs = malloc(sizeof(*rs));
+    if (rs == NULL) {
+        w->error = true;
+        return;
+    }
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, rs);
+
+    json_obj_begin(w);
+    json_key(w, "relays");
+    json_arr_begin(w);
+    for (int i = 0; i < snap.count; i++) {
+        status_json_relay(w, &snap, i);
+    }
+    json_arr_end(w);
+    status_json_routine(w, rs);
+    flow_meter_write_json(w);
+    moisture_write_json(w);
+    json_obj_end(w);
+    free(rs);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <stdint.h>
+#include "json_writer.h"
+#include "relay_controller.h"
+#include "flow_meter.h"
+#include "moisture.h"
+
+// Shared encoders for the relay/routine objects used by /api/status,
+// /api/relay and the /api/events stream. They encode from a snapshot so
+// one document never mixes two states.
+
+// Room for the largest /api/status document: RELAY_MAX relays of up to
+// 52 bytes (69 with the millilitres of a flow meter), a routine of
+// MAX_ROUTINE_STEPS steps of up to 98 bytes, each in both step lists,
+// the flow and the moisture readings
+#define STATUS_ROUTINE_MAX (MAX_ROUTINE_STEPS * (98 + 2 * 3) + 128)
+#if FLOW_METER_GPIO >= 0
+#define STATUS_JSON_MAX (RELAY_MAX * 69 + STATUS_ROUTINE_MAX + 256 + MOISTURE_JSON_MAX)
+#else
+#define STATUS_JSON_MAX (RELAY_MAX * 52 + STATUS_ROUTINE_MAX + 256 + MOISTURE_JSON_MAX)
+#endif
+
+// {"id":..,"state":..,"mode":..,"rem":..[,"ml":..]}
+void status_json_relay(json_writer_t *w, const relay_snapshot_t *snap, uint8_t relay_num);
+// "routine":{"running":..,"name":..,"activeSteps":[..],"doneSteps":[..],"numSteps":..,"steps":[..]}
+void status_json_routine(json_writer_t *w, const routine_state_t *rs);
+// The full /api/status document, from a fresh snapshot. Sets w->error
+// if there is no memory for the routine's copy.
+void status_json_write(json_writer_t *w);
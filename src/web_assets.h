@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Build with -D WEB_EMBED_ASSETS=1 to serve the UI from the firmware image
+#ifndef WEB_EMBED_ASSETS
+#define WEB_EMBED_ASSETS 0
+#endif
+
+typedef struct {
+    const char *uri;        // Canonical path, e.g. "/app.js"
+    const char *mime;
+    const char *hash;       // Same hash as data/etags.txt
+    const uint8_t *data;    // Flash-resident, sent without copying
+    uint32_t len;
+    bool gzip;
+} web_asset_t;
+
+#if WEB_EMBED_ASSETS
+extern const web_asset_t web_assets[];
+extern const size_t web_assets_count;
+#endif
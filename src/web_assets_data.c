@@ -0,0 +1,811 @@
+// Generated by pack_web.js - do not edit.
+#include "web_assets.h"
+
+#if WEB_EMBED_ASSETS
+
+static const uint8_t asset_app_min_js[2889] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x59, 0x6d, 0x6f, 0xdb, 0x38,
+    0x12, 0xfe, 0x2b, 0x2c, 0x2f, 0xa7, 0x8a, 0x1b, 0x59, 0xb1, 0xd3, 0x5c, 0x6f, 0x61, 0x87, 0x0e,
+    0xba, 0x69, 0x8b, 0xed, 0xa1, 0x6d, 0x16, 0xcd, 0xde, 0xa7, 0xbd, 0x05, 0xcc, 0x4a, 0x63, 0x9b,
+    0x1b, 0x9a, 0xd4, 0x52, 0x23, 0x27, 0x5e, 0x47, 0xff, 0xfd, 0x40, 0x4a, 0xb2, 0x65, 0xc7, 0x8e,
+    0xdd, 0xbd, 0xc3, 0x01, 0x57, 0x14, 0x4d, 0x4a, 0x91, 0xc3, 0x79, 0xe3, 0xf3, 0x0c, 0x87, 0x89,
+    0xd1, 0x39, 0x92, 0x0f, 0xd7, 0x37, 0x9f, 0x6f, 0xf9, 0x12, 0xe5, 0x0c, 0x6c, 0xff, 0xe5, 0x65,
+    0x3e, 0x9f, 0x90, 0x44, 0x89, 0x3c, 0xe7, 0x34, 0x47, 0x81, 0x45, 0xde, 0x91, 0x89, 0xd1, 0x94,
+    0xcc, 0x25, 0xdc, 0xff, 0x60, 0x1e, 0x38, 0xed, 0x92, 0x2e, 0x39, 0xbf, 0x20, 0xe7, 0x17, 0x94,
+    0xdc, 0xcb, 0x14, 0xa7, 0x9c, 0xf6, 0x2e, 0x28, 0x99, 0x82, 0x9c, 0x4c, 0xb1, 0xfa, 0x7d, 0x2c,
+    0x95, 0xe2, 0x54, 0x1b, 0x0d, 0x94, 0xe4, 0x68, 0xcd, 0x1d, 0x70, 0x9a, 0x14, 0xd6, 0x82, 0xc6,
+    0x6b, 0xa3, 0x8c, 0x6d, 0x46, 0x3b, 0xf5, 0xfa, 0x57, 0xab, 0x01, 0x25, 0x35, 0x24, 0x22, 0xe3,
+    0xd4, 0x9a, 0x42, 0xa7, 0x1b, 0xc3, 0xbf, 0x19, 0xa9, 0x9b, 0xf1, 0xe1, 0x65, 0x22, 0x6d, 0xa2,
+    0x80, 0x24, 0x0f, 0x9c, 0xf6, 0xce, 0x29, 0x49, 0x16, 0xd5, 0x4f, 0xcb, 0x69, 0xaf, 0x4b, 0x87,
+    0x97, 0x67, 0xd5, 0xf7, 0xe1, 0x65, 0x66, 0xd4, 0xc2, 0xad, 0x26, 0x99, 0x91, 0x1a, 0x73, 0x37,
+    0x8b, 0xbc, 0x26, 0xbd, 0x73, 0xff, 0xf7, 0x35, 0xe9, 0x5d, 0xb8, 0xc9, 0xcd, 0xa4, 0xe1, 0xe5,
+    0x59, 0x3e, 0x9f, 0x0c, 0x5f, 0x46, 0x33, 0xa1, 0x0b, 0xa1, 0xfe, 0x6f, 0x9c, 0x91, 0x09, 0x9c,
+    0x92, 0x94, 0xd3, 0x4f, 0xe7, 0x5d, 0x72, 0xde, 0x9b, 0x77, 0xce, 0xc5, 0x05, 0xb9, 0x20, 0x4e,
+    0xb5, 0x6e, 0xe7, 0xa2, 0x73, 0xf1, 0xe3, 0xf7, 0xed, 0xff, 0x93, 0x8b, 0xf9, 0xb9, 0x37, 0x5a,
+    0xe0, 0x74, 0xa7, 0x1f, 0xff, 0xee, 0xdd, 0x78, 0xd1, 0xf6, 0x62, 0xe5, 0x96, 0x72, 0x20, 0xf2,
+    0x85, 0x4e, 0xc8, 0xb8, 0xd0, 0x09, 0x4a, 0xa3, 0x09, 0x9a, 0xc9, 0x44, 0xc1, 0x17, 0x50, 0x62,
+    0x11, 0x62, 0x04, 0x91, 0x66, 0xcb, 0xc4, 0xa7, 0x94, 0xe1, 0xa9, 0x49, 0x8a, 0x19, 0x68, 0x8c,
+    0x27, 0x80, 0xef, 0x14, 0xb8, 0x5f, 0x7f, 0x58, 0x7c, 0x48, 0x43, 0x6a, 0xdd, 0xec, 0x0e, 0x3d,
+    0x45, 0x16, 0x09, 0x1e, 0xee, 0x9d, 0x56, 0x7b, 0xdb, 0xcf, 0x33, 0xf1, 0xef, 0x05, 0xd8, 0xc5,
+    0x2d, 0x28, 0x48, 0xd0, 0xd8, 0x37, 0x4a, 0x85, 0xf4, 0x6b, 0x81, 0x68, 0x34, 0x65, 0x6c, 0x20,
+    0xe2, 0xb1, 0xb1, 0xef, 0x44, 0x32, 0x0d, 0x91, 0x0f, 0x97, 0x18, 0xa7, 0x32, 0x17, 0x5f, 0x15,
+    0xa4, 0xfc, 0x45, 0x37, 0xc2, 0xd8, 0x07, 0xef, 0xa3, 0xcc, 0x31, 0x16, 0x69, 0x1a, 0x52, 0x65,
+    0x44, 0x2a, 0xf5, 0x84, 0xb2, 0x92, 0x0d, 0xd0, 0x2e, 0x96, 0x0a, 0x9c, 0xb2, 0xa3, 0x33, 0x91,
+    0xc9, 0x33, 0xaf, 0xd9, 0x95, 0x4c, 0xf9, 0xc9, 0x12, 0xcb, 0x40, 0x78, 0x13, 0xf9, 0xc9, 0x12,
+    0xca, 0xd1, 0x40, 0x07, 0x41, 0x68, 0x4e, 0x39, 0x0d, 0xd2, 0xc2, 0x0a, 0x3f, 0x4e, 0x4f, 0x5f,
+    0x77, 0xbf, 0xd3, 0x91, 0x32, 0x89, 0x50, 0xb7, 0x68, 0xac, 0x98, 0x40, 0x9c, 0x03, 0x7e, 0x40,
+    0x98, 0x85, 0x54, 0x89, 0x1c, 0xdf, 0xd6, 0x33, 0x3f, 0x49, 0x5d, 0x20, 0xe4, 0x34, 0xd2, 0x8c,
+    0x0d, 0x2a, 0xef, 0x08, 0x2e, 0xee, 0x85, 0x44, 0x32, 0x06, 0x4c, 0xa6, 0xa1, 0x61, 0x91, 0xac,
+    0x07, 0x44, 0xfc, 0x5b, 0x6e, 0x74, 0xc8, 0x06, 0x72, 0x1c, 0xca, 0x38, 0x2f, 0x92, 0x04, 0xf2,
+    0x9c, 0x2d, 0xe5, 0x38, 0xa4, 0xee, 0x74, 0xa6, 0x94, 0x73, 0x2e, 0xe3, 0x99, 0x49, 0x21, 0x08,
+    0x64, 0x6c, 0x61, 0x36, 0xec, 0x36, 0x1e, 0x07, 0xfe, 0x56, 0x20, 0xc4, 0xda, 0xdc, 0x87, 0xec,
+    0xb4, 0x07, 0xaf, 0xbe, 0xf3, 0xdf, 0x07, 0x3b, 0xf5, 0x1b, 0xc1, 0x43, 0x26, 0x2d, 0x74, 0x9c,
+    0x9d, 0xa3, 0x08, 0x58, 0x09, 0x2a, 0x07, 0xb2, 0x31, 0xd5, 0xc2, 0xcc, 0xcc, 0xe1, 0xe9, 0x6c,
+    0x36, 0x28, 0xb2, 0x54, 0x60, 0x15, 0xf3, 0x7f, 0x7e, 0x08, 0x31, 0x92, 0xb1, 0x0b, 0x15, 0x44,
+    0x95, 0x5e, 0x91, 0xdf, 0x96, 0x95, 0x65, 0x22, 0x9c, 0x6d, 0x58, 0xa9, 0x67, 0x14, 0xc4, 0x60,
+    0xad, 0xb1, 0x21, 0x7d, 0xe7, 0x7e, 0xf4, 0x69, 0x84, 0x2c, 0xca, 0xa7, 0xe6, 0xfe, 0x67, 0x23,
+    0x72, 0x0c, 0xe9, 0x7b, 0x21, 0x15, 0xa4, 0x04, 0x0d, 0x49, 0x8c, 0x46, 0x6b, 0x14, 0xf1, 0xc1,
+    0x88, 0xc9, 0x4f, 0x0a, 0x44, 0x0e, 0x04, 0xed, 0x82, 0x88, 0x89, 0x90, 0x3a, 0xa6, 0xac, 0x1c,
+    0x4b, 0x2d, 0x94, 0x5a, 0x2c, 0xf7, 0x07, 0xbe, 0xb7, 0x11, 0xf8, 0xca, 0x96, 0x8d, 0xd8, 0x47,
+    0x89, 0x32, 0x39, 0x7c, 0x32, 0xa9, 0x50, 0x21, 0xb2, 0xb2, 0x5c, 0x65, 0xf4, 0xb6, 0x75, 0x10,
+    0xe9, 0xc8, 0x34, 0x3e, 0x16, 0xfc, 0x98, 0x74, 0x75, 0xc1, 0x7b, 0x21, 0x98, 0x05, 0x2c, 0xac,
+    0xae, 0x23, 0x2e, 0x39, 0x35, 0xda, 0x45, 0x0f, 0x06, 0x2e, 0xe3, 0x72, 0x4e, 0x69, 0xa4, 0x38,
+    0xa5, 0x3e, 0xd0, 0x6c, 0x23, 0xbe, 0x9a, 0x2d, 0x73, 0xee, 0x21, 0x39, 0xf6, 0x88, 0xec, 0x17,
+    0x00, 0x37, 0x6e, 0xaa, 0x2e, 0x94, 0xe2, 0x1c, 0x1a, 0x7d, 0x34, 0xdf, 0x88, 0xd9, 0x64, 0x57,
+    0x78, 0x99, 0xcf, 0x5d, 0xe0, 0x9f, 0x04, 0x4e, 0xe3, 0x99, 0x78, 0x08, 0xbb, 0x91, 0xff, 0x75,
+    0xac, 0x8c, 0xb1, 0x61, 0xa8, 0x3b, 0xeb, 0xb4, 0x61, 0x67, 0x3d, 0x78, 0xc5, 0x18, 0x2b, 0x61,
+    0xd8, 0xbd, 0x52, 0x7c, 0x44, 0xc2, 0x93, 0x65, 0x6b, 0x2e, 0x9c, 0xbd, 0xee, 0xb2, 0xb2, 0x7f,
+    0xb2, 0x0c, 0xe1, 0xaf, 0xaf, 0xbb, 0x2c, 0x46, 0x73, 0x8b, 0x56, 0xea, 0x49, 0xc8, 0xe2, 0x4c,
+    0xa4, 0xb7, 0x28, 0x2c, 0x86, 0xe7, 0x11, 0xed, 0x3a, 0xff, 0x8e, 0xfa, 0x5d, 0x67, 0x6c, 0x10,
+    0xb4, 0xec, 0x0a, 0x82, 0xe3, 0x32, 0xac, 0xca, 0xc6, 0xc6, 0x07, 0x15, 0x12, 0x47, 0x47, 0x26,
+    0xe7, 0xb7, 0x24, 0xb2, 0x88, 0xa5, 0xd6, 0x60, 0x7f, 0xfc, 0xf9, 0xd3, 0x47, 0x1e, 0xca, 0x2b,
+    0x7a, 0xf3, 0x99, 0xf6, 0xe9, 0xcd, 0xfb, 0xf7, 0x94, 0x9d, 0xe6, 0xa7, 0x2a, 0x12, 0x55, 0x06,
+    0x7d, 0x16, 0x33, 0xe0, 0xf2, 0xaa, 0x0e, 0x30, 0x31, 0x9a, 0xf6, 0x57, 0xbf, 0x8f, 0xc7, 0xb4,
+    0x8e, 0x6f, 0xb2, 0x3f, 0x33, 0x66, 0x2e, 0xc9, 0x3a, 0x16, 0x66, 0x55, 0x72, 0x24, 0x41, 0x10,
+    0x26, 0x31, 0xc2, 0x03, 0x5e, 0x1b, 0x8d, 0xa0, 0x91, 0xab, 0xab, 0xd1, 0x17, 0x98, 0x09, 0xa9,
+    0xa5, 0x9e, 0xf4, 0xc9, 0xc9, 0x52, 0xc5, 0x68, 0xe5, 0x2c, 0x64, 0xe5, 0xa8, 0x4f, 0x5d, 0xb6,
+    0x37, 0xa9, 0xe9, 0x8e, 0x4b, 0x93, 0xb1, 0xcb, 0x03, 0xdb, 0xb9, 0xad, 0xe2, 0x1c, 0x17, 0x0a,
+    0xdc, 0xa9, 0xc8, 0x94, 0x58, 0x70, 0x3a, 0x56, 0xf0, 0x40, 0xd7, 0xe2, 0x36, 0x4e, 0xc0, 0x9f,
+    0x91, 0xe7, 0x19, 0x6d, 0x2d, 0xcf, 0x07, 0xba, 0xa6, 0x82, 0x35, 0x28, 0xed, 0x95, 0xdb, 0x00,
+    0x69, 0x85, 0xf0, 0x9a, 0x67, 0xc2, 0xe6, 0xf0, 0x41, 0x63, 0x08, 0xf1, 0x5c, 0xa8, 0x02, 0xd8,
+    0x40, 0x0f, 0xbb, 0x57, 0x9b, 0x04, 0x53, 0x27, 0x53, 0xa4, 0x59, 0xbf, 0x85, 0x1d, 0x35, 0x44,
+    0x80, 0x46, 0xb0, 0x44, 0x90, 0xb9, 0x50, 0x32, 0x25, 0x8d, 0x78, 0x22, 0x35, 0x99, 0x55, 0x08,
+    0x1c, 0xb7, 0x9d, 0x29, 0xd2, 0xdf, 0x8a, 0x1c, 0x7f, 0x76, 0x07, 0xac, 0x01, 0x6a, 0x77, 0xda,
+    0xd7, 0x27, 0xeb, 0x38, 0xc5, 0xfd, 0xa1, 0x6c, 0x16, 0xe1, 0xfa, 0x90, 0xf5, 0xaa, 0x43, 0x36,
+    0x93, 0x3a, 0x3c, 0xef, 0x46, 0xe1, 0xca, 0x38, 0x5d, 0x1b, 0xf7, 0xf8, 0xd8, 0x65, 0xa7, 0xc0,
+    0xd8, 0xa0, 0x1e, 0xe0, 0x58, 0x96, 0x5b, 0xdc, 0x5a, 0x21, 0xd1, 0xad, 0x4f, 0xb5, 0x90, 0x2d,
+    0x1d, 0x59, 0x35, 0xdb, 0xb4, 0xd9, 0x83, 0x7a, 0xea, 0xaa, 0x32, 0x92, 0xb2, 0x81, 0xc8, 0x32,
+    0xb5, 0xa8, 0x17, 0x55, 0xd3, 0xb0, 0xe6, 0x14, 0xb6, 0x17, 0x92, 0xab, 0xe9, 0xf5, 0x86, 0x04,
+    0x56, 0x00, 0xdd, 0x82, 0xc5, 0xb6, 0x58, 0xf0, 0x84, 0x94, 0x58, 0x68, 0x80, 0xf2, 0x5a, 0xd8,
+    0x34, 0x0f, 0xdd, 0x51, 0x53, 0x62, 0x91, 0xc7, 0x16, 0xd2, 0x22, 0x81, 0x30, 0xc4, 0x48, 0x33,
+    0x3e, 0x5c, 0xb9, 0x04, 0x23, 0x1d, 0xcb, 0xf4, 0xb4, 0xc7, 0x22, 0x3f, 0xef, 0xda, 0x14, 0x1a,
+    0x19, 0x8b, 0x56, 0xcb, 0xda, 0x58, 0xbe, 0x01, 0x88, 0x58, 0x13, 0x1e, 0x1e, 0x20, 0x3c, 0x3c,
+    0x8a, 0xf0, 0x62, 0x99, 0x56, 0x9c, 0xb7, 0x85, 0xf4, 0xb1, 0x4c, 0x23, 0xac, 0xa9, 0xac, 0xda,
+    0x31, 0xc2, 0x8a, 0xca, 0xbc, 0x8e, 0xa6, 0x40, 0xa9, 0x61, 0x1d, 0x69, 0x87, 0xc4, 0x2f, 0x38,
+    0x77, 0x45, 0xc2, 0x1c, 0xbe, 0x54, 0x5f, 0x3f, 0xa4, 0x91, 0xe6, 0xab, 0xb9, 0xb1, 0x2d, 0xb4,
+    0x3b, 0xd2, 0x91, 0xe1, 0xf5, 0x48, 0x1e, 0x8f, 0xa5, 0x4e, 0x3f, 0xe8, 0x14, 0x1e, 0x9c, 0x95,
+    0x18, 0x6b, 0x87, 0x2d, 0xbc, 0xb5, 0xc4, 0x0d, 0xf8, 0x9c, 0xda, 0x92, 0xcb, 0xf5, 0x95, 0xe9,
+    0xbb, 0x2d, 0x23, 0x0c, 0x82, 0x17, 0x3a, 0x08, 0x5a, 0xe9, 0x5f, 0x4f, 0x22, 0x89, 0x99, 0x65,
+    0x0a, 0x10, 0xd2, 0x17, 0x34, 0xa2, 0x75, 0xe9, 0x40, 0x9d, 0xb3, 0x75, 0x0a, 0xb6, 0x9e, 0x94,
+    0x87, 0x2c, 0xd2, 0x41, 0xd0, 0xe9, 0xbd, 0xe0, 0xdc, 0xac, 0x8d, 0xd9, 0x97, 0xeb, 0xa3, 0x5a,
+    0xaf, 0x4e, 0xcd, 0x6e, 0x27, 0x4b, 0xe3, 0x80, 0x53, 0x8e, 0xd7, 0x27, 0xbc, 0x6d, 0x70, 0xa5,
+    0xf4, 0x2d, 0x42, 0x96, 0x3f, 0x3e, 0xfe, 0xf2, 0x6b, 0x64, 0x5b, 0xdf, 0x52, 0xa3, 0x5b, 0x5f,
+    0x4c, 0xeb, 0x4b, 0xee, 0x46, 0x23, 0xc1, 0x75, 0x3c, 0x13, 0x99, 0xf3, 0x8b, 0xf9, 0x05, 0x7f,
+    0xbd, 0x72, 0xff, 0x78, 0x77, 0xf4, 0xe9, 0x15, 0x65, 0xb1, 0x2b, 0x77, 0x43, 0x1a, 0x11, 0xca,
+    0x1e, 0x1f, 0x69, 0x87, 0x0e, 0xb0, 0x85, 0xdd, 0xa3, 0x7f, 0x69, 0xb2, 0xe7, 0xcf, 0x65, 0x2a,
+    0xe7, 0x4d, 0xf9, 0xde, 0xd8, 0x92, 0x59, 0x33, 0xb1, 0xce, 0x37, 0xc3, 0xfd, 0xeb, 0xfc, 0xda,
+    0x3c, 0x13, 0x7a, 0x5d, 0xfb, 0x43, 0xd6, 0xa9, 0xec, 0xa3, 0xc3, 0x37, 0xfe, 0xa7, 0x83, 0x6a,
+    0x51, 0x3a, 0x8e, 0xb4, 0xb1, 0x02, 0x3d, 0xc1, 0x69, 0x79, 0x76, 0xb2, 0x6c, 0xc5, 0xb2, 0x98,
+    0x79, 0x83, 0x4b, 0xe2, 0x6c, 0x67, 0x97, 0x67, 0x4e, 0xde, 0xa1, 0x3d, 0x5b, 0xfa, 0xfa, 0x2d,
+    0x95, 0xcc, 0xb1, 0x33, 0x93, 0x5a, 0x1e, 0xd2, 0xd6, 0xfd, 0x39, 0x59, 0x1a, 0xef, 0x43, 0x0f,
+    0x64, 0x7c, 0x38, 0x3a, 0xbc, 0x62, 0xb7, 0x9d, 0xa9, 0x41, 0xe2, 0xac, 0x92, 0x3a, 0x51, 0x45,
+    0x0a, 0xee, 0xc4, 0x5f, 0x51, 0x67, 0x04, 0xed, 0xeb, 0xcd, 0xc1, 0xaf, 0x45, 0xbe, 0xa0, 0x7d,
+    0x8a, 0x26, 0x35, 0xb4, 0xa4, 0x04, 0x25, 0x2a, 0xe0, 0xd4, 0x9d, 0x32, 0x17, 0xba, 0xd2, 0xdd,
+    0x20, 0x8e, 0xb0, 0xda, 0xfd, 0x19, 0x35, 0x31, 0xa6, 0xac, 0x3c, 0xe0, 0xa3, 0xb3, 0x54, 0xce,
+    0x9f, 0x91, 0xf8, 0xdc, 0xf7, 0x51, 0x59, 0x96, 0xa5, 0xab, 0xa7, 0x32, 0xa3, 0x94, 0x07, 0x7f,
+    0x7f, 0x90, 0x07, 0x6b, 0x8e, 0x75, 0x55, 0xcc, 0x4f, 0x46, 0x29, 0x5f, 0xd7, 0x2c, 0x57, 0xd3,
+    0x1e, 0x1f, 0xc3, 0xf5, 0x12, 0x87, 0x2a, 0x8e, 0x6c, 0xe6, 0x42, 0x85, 0x6d, 0x94, 0x8e, 0x7a,
+    0x70, 0xc1, 0xda, 0x84, 0x8d, 0x26, 0xdb, 0x21, 0xcb, 0x15, 0x00, 0x0a, 0x84, 0x5d, 0xc9, 0x58,
+    0x7d, 0x61, 0xd1, 0xa6, 0x5e, 0x2d, 0x59, 0x89, 0xd1, 0x1a, 0x12, 0x7c, 0x37, 0x07, 0x8d, 0x8e,
+    0x0e, 0x5c, 0x8d, 0x79, 0x2f, 0x75, 0x6a, 0xee, 0x63, 0x3f, 0x76, 0x6b, 0x0a, 0x9b, 0x40, 0x5d,
+    0x74, 0x92, 0xb9, 0x91, 0xe9, 0x96, 0x2d, 0x83, 0x15, 0x72, 0xc1, 0x3d, 0x69, 0x2d, 0xa9, 0x09,
+    0x04, 0xbc, 0x60, 0xca, 0x06, 0x18, 0x1b, 0x6d, 0x32, 0xd0, 0x3c, 0x64, 0x7c, 0xb8, 0x61, 0x41,
+    0xe4, 0xaf, 0x50, 0x7e, 0xa9, 0x2b, 0xab, 0x41, 0x83, 0xad, 0xea, 0x5e, 0xa0, 0x11, 0xf2, 0x61,
+    0x9b, 0x22, 0xfe, 0x71, 0x7b, 0xf3, 0x39, 0xf6, 0xa4, 0x17, 0x62, 0x9c, 0x0a, 0x14, 0x8c, 0xed,
+    0x5e, 0x6e, 0xc1, 0x91, 0x1e, 0x8d, 0xdc, 0x66, 0x9b, 0x84, 0xe7, 0xe6, 0x1b, 0xed, 0xc9, 0xc8,
+    0xab, 0xb2, 0xdc, 0x34, 0xc7, 0x83, 0xb3, 0x48, 0xfd, 0x86, 0x0e, 0x43, 0x5b, 0x16, 0xc5, 0xd7,
+    0x1f, 0x6f, 0x6e, 0xdf, 0xbd, 0x0d, 0x82, 0x1c, 0x3c, 0xc1, 0x9b, 0x02, 0xc3, 0x0d, 0xf7, 0xf9,
+    0x38, 0x55, 0x79, 0xd0, 0x20, 0x33, 0xff, 0xe5, 0xd7, 0xe8, 0x09, 0xe6, 0x3a, 0xbc, 0x75, 0x1e,
+    0xf8, 0x02, 0xbf, 0x17, 0x90, 0x63, 0x75, 0xb1, 0xc8, 0xef, 0xe4, 0xc6, 0xc0, 0xf6, 0x95, 0xd8,
+    0xb3, 0xf2, 0x1a, 0x6e, 0x0f, 0xf0, 0x76, 0xb3, 0x7f, 0xe5, 0xf8, 0xbb, 0x20, 0x08, 0x57, 0x1a,
+    0x6d, 0xb2, 0xf7, 0x13, 0x1c, 0xdf, 0x4f, 0xe7, 0xeb, 0xbb, 0x94, 0xdf, 0x69, 0x65, 0xe3, 0x16,
+    0xa5, 0x6f, 0x0b, 0x3c, 0xc8, 0x06, 0xb4, 0xa5, 0x6c, 0x45, 0x01, 0xee, 0xdf, 0x16, 0x10, 0x53,
+    0x1a, 0xad, 0x98, 0xae, 0x42, 0xc4, 0x36, 0x5b, 0xaf, 0xc4, 0x56, 0x95, 0x43, 0x2d, 0x39, 0xa4,
+    0xd3, 0x73, 0xca, 0x06, 0xb0, 0x51, 0x11, 0x37, 0x9c, 0x96, 0xd3, 0x08, 0xea, 0xaa, 0x33, 0x71,
+    0x9d, 0x12, 0x4e, 0xff, 0x02, 0x09, 0x8c, 0xc7, 0xbd, 0xf5, 0xf8, 0xd8, 0x68, 0xbc, 0x95, 0x7f,
+    0x00, 0xa7, 0xe7, 0xdd, 0xec, 0x61, 0x3d, 0x3e, 0x13, 0x76, 0x22, 0xf5, 0x0f, 0x06, 0xd1, 0xcc,
+    0x38, 0xed, 0xfd, 0xcd, 0x7d, 0xc3, 0x58, 0x64, 0x19, 0xe8, 0xf4, 0x7a, 0x2a, 0x55, 0x1a, 0x02,
+    0x2b, 0xd7, 0xbc, 0x5c, 0xd7, 0x1e, 0x21, 0xf8, 0x9a, 0xe5, 0x69, 0x13, 0x63, 0x4b, 0xe7, 0x54,
+    0xce, 0x29, 0x1b, 0x98, 0xd6, 0x0d, 0x61, 0x4d, 0x2f, 0x52, 0x29, 0xfa, 0x24, 0x97, 0xfc, 0xf5,
+    0xc7, 0x6c, 0x37, 0x23, 0x6a, 0x42, 0x69, 0xb5, 0x05, 0x9e, 0x2e, 0x1b, 0x98, 0xfd, 0x54, 0xb7,
+    0x93, 0xde, 0xa4, 0x52, 0x9d, 0xa4, 0x72, 0x24, 0x25, 0x46, 0x27, 0x4a, 0x26, 0x77, 0x0e, 0x93,
+    0xc5, 0x15, 0xa5, 0xfd, 0x91, 0x2d, 0x74, 0x2d, 0x3e, 0x3c, 0x59, 0xea, 0x92, 0x8d, 0xca, 0x5d,
+    0xcc, 0xb2, 0xc1, 0x09, 0x1b, 0x92, 0x1d, 0xae, 0xd3, 0xa1, 0xe3, 0x39, 0x8f, 0xf0, 0x7b, 0xf1,
+    0x7d, 0xbf, 0x84, 0xba, 0x54, 0x25, 0x32, 0x5d, 0x7f, 0x58, 0xd5, 0x17, 0xba, 0xdc, 0x47, 0x74,
+    0xde, 0x80, 0x2f, 0x55, 0x49, 0x15, 0xc7, 0x31, 0xed, 0x53, 0x7f, 0xe3, 0xa4, 0x3b, 0xd8, 0x62,
+    0xa7, 0x52, 0xbb, 0x68, 0xc1, 0xc9, 0x7c, 0xb9, 0x63, 0xfd, 0x3e, 0xb7, 0x56, 0x2d, 0xa1, 0xbd,
+    0x95, 0xc3, 0x65, 0xd5, 0x93, 0x6a, 0x96, 0x7e, 0x45, 0xdd, 0x71, 0x68, 0xd1, 0xa9, 0x65, 0xb4,
+    0xa2, 0xe1, 0x86, 0x5d, 0x71, 0x10, 0x7a, 0xd8, 0x65, 0x74, 0x78, 0x7b, 0x27, 0xb3, 0xcb, 0xb3,
+    0x6a, 0xfd, 0x37, 0x48, 0x47, 0xb3, 0x53, 0x3a, 0x9a, 0xec, 0x4d, 0x3b, 0x93, 0xd6, 0xdb, 0xa0,
+    0x79, 0x6e, 0x9b, 0x5d, 0x3e, 0x7a, 0xd9, 0xa7, 0x6d, 0x1f, 0x8f, 0xb6, 0x4e, 0x91, 0x61, 0x25,
+    0x7b, 0x72, 0x75, 0x79, 0xaa, 0x00, 0xb2, 0x25, 0xba, 0x0a, 0xde, 0x13, 0x8a, 0x35, 0x99, 0x98,
+    0x54, 0x57, 0xae, 0xaa, 0x09, 0xb7, 0x17, 0x17, 0xcf, 0xea, 0x6e, 0xd0, 0x55, 0xdd, 0x8c, 0x73,
+    0xcb, 0x29, 0x8b, 0xaa, 0xf9, 0x9b, 0x7c, 0x71, 0x04, 0x1c, 0xba, 0xd5, 0x0d, 0x1a, 0x56, 0x60,
+    0xb8, 0xad, 0x77, 0x13, 0x96, 0xff, 0x96, 0xba, 0x77, 0xf2, 0x3f, 0x51, 0xf7, 0x4e, 0x66, 0xc4,
+    0x15, 0x64, 0x3b, 0x75, 0x6d, 0x1d, 0x64, 0x6c, 0xb3, 0x0c, 0x6c, 0xb0, 0xcc, 0xe8, 0x79, 0x6f,
+    0x0a, 0x8b, 0x81, 0x74, 0xf7, 0x11, 0x5e, 0xf7, 0x44, 0x5c, 0x59, 0x01, 0xb1, 0xb9, 0x63, 0x5b,
+    0x9c, 0x55, 0xe1, 0x73, 0xc8, 0x06, 0x1b, 0x05, 0xc6, 0xea, 0x12, 0x82, 0x8f, 0x8f, 0xf4, 0x4d,
+    0xe3, 0x5a, 0x22, 0x73, 0x22, 0x94, 0x67, 0x67, 0x52, 0xdf, 0x81, 0x28, 0x2b, 0xc3, 0x46, 0x50,
+    0x7d, 0x1b, 0x6d, 0xba, 0x9b, 0x41, 0xf0, 0xa7, 0xa3, 0x29, 0x2c, 0xb6, 0xc3, 0xb9, 0xbb, 0x9f,
+    0xb8, 0x39, 0xad, 0xa1, 0xfd, 0xd5, 0x0d, 0x94, 0x77, 0xd7, 0xc5, 0xdf, 0x93, 0x2b, 0x6d, 0x7e,
+    0x0c, 0x29, 0xfa, 0xdb, 0x2b, 0x65, 0x11, 0xec, 0x6e, 0xc6, 0xed, 0xec, 0x05, 0xb3, 0xc7, 0xc7,
+    0x5e, 0x77, 0x30, 0x36, 0x36, 0x1c, 0xac, 0x55, 0xb9, 0xcc, 0x5b, 0xff, 0x39, 0x3d, 0x5d, 0xdf,
+    0xb0, 0xd6, 0xa3, 0xd1, 0x37, 0x51, 0x52, 0x22, 0x6c, 0x4a, 0x23, 0x13, 0x7b, 0xa4, 0xad, 0xbb,
+    0xee, 0x3a, 0x3a, 0x96, 0x4f, 0xfc, 0x82, 0x29, 0x88, 0x14, 0xec, 0x61, 0x8a, 0xf0, 0x93, 0x1b,
+    0x6e, 0xf8, 0xc3, 0x68, 0x70, 0x1a, 0x84, 0x9a, 0x3d, 0x43, 0x10, 0x1b, 0x57, 0x1d, 0x0f, 0xff,
+    0x13, 0x6b, 0x8a, 0xec, 0x1b, 0xc0, 0xd5, 0xb7, 0x47, 0x3b, 0x68, 0xe5, 0x64, 0x02, 0xb6, 0x8d,
+    0x7f, 0xab, 0x46, 0x99, 0xa7, 0xb8, 0xd5, 0xbd, 0xc4, 0x15, 0x83, 0x29, 0xb9, 0xf9, 0xfc, 0xdc,
+    0x5d, 0xca, 0x3f, 0xf8, 0x3c, 0xf7, 0xb8, 0xf3, 0x7d, 0xeb, 0x71, 0xe7, 0xfb, 0x6f, 0x7f, 0xdc,
+    0x39, 0x3f, 0x78, 0xed, 0x3c, 0xf2, 0x61, 0xeb, 0x80, 0x94, 0x6f, 0x7b, 0xf6, 0x7a, 0xee, 0x36,
+    0xe5, 0x5e, 0x7e, 0xf6, 0x84, 0xe4, 0x00, 0x61, 0x6d, 0x5e, 0x2c, 0x57, 0x2d, 0x53, 0xcf, 0xfc,
+    0x1b, 0x8c, 0x7f, 0xf3, 0xfe, 0xfd, 0xfe, 0x3c, 0xd9, 0xc1, 0x49, 0x3b, 0xc7, 0x5a, 0xf9, 0xe4,
+    0x92, 0x63, 0x6f, 0x32, 0xed, 0x48, 0x24, 0xf7, 0xa0, 0xb7, 0xca, 0x9e, 0x76, 0xcb, 0xd1, 0xa9,
+    0x17, 0x91, 0x97, 0x46, 0xbf, 0x64, 0x74, 0xf8, 0xb3, 0x03, 0xbe, 0x1b, 0xfd, 0x1c, 0x7f, 0xee,
+    0x10, 0xed, 0x0c, 0x7e, 0x56, 0xf6, 0x78, 0xbc, 0x16, 0x3e, 0x1e, 0x3f, 0x23, 0xfd, 0x48, 0x1f,
+    0x38, 0xef, 0x56, 0x4d, 0x5b, 0xef, 0xdc, 0x46, 0x99, 0x6a, 0xc8, 0xcc, 0xc1, 0x2a, 0xb1, 0x68,
+    0xa9, 0x24, 0xc7, 0x55, 0x75, 0x10, 0xa3, 0xb0, 0x13, 0x40, 0xd7, 0x6f, 0x9b, 0xca, 0x9c, 0xb5,
+    0xba, 0xc3, 0xd5, 0x21, 0x3a, 0x70, 0x84, 0xbd, 0xf8, 0xbd, 0x67, 0x77, 0xfa, 0x6a, 0x78, 0x0b,
+    0x48, 0xfc, 0xcd, 0x96, 0x84, 0x33, 0xa9, 0xd9, 0xe5, 0xd9, 0xf4, 0xd5, 0xbe, 0xd9, 0xdb, 0x4d,
+    0x10, 0x8f, 0x2b, 0xc4, 0xd7, 0xf5, 0x9c, 0x56, 0x85, 0x7d, 0xe7, 0xab, 0xaf, 0xec, 0xfb, 0xa4,
+    0xd7, 0xcd, 0x1e, 0x06, 0x4f, 0x41, 0x67, 0x7f, 0x0b, 0x60, 0xcb, 0x47, 0xae, 0x2f, 0xbf, 0xc3,
+    0x4f, 0xb6, 0x69, 0xc8, 0xbb, 0x63, 0x72, 0x40, 0x58, 0x5b, 0xd5, 0x9a, 0x61, 0xf3, 0x95, 0xba,
+    0xae, 0xcb, 0x2c, 0xc7, 0x8b, 0xa6, 0x22, 0xef, 0x93, 0xc4, 0xf7, 0xa9, 0x07, 0x64, 0xcb, 0x8e,
+    0xf3, 0xca, 0x8e, 0x67, 0x0e, 0xe2, 0xae, 0xf2, 0xcf, 0x35, 0xa5, 0x7c, 0x23, 0xbb, 0x15, 0xd0,
+    0x5d, 0x9d, 0xed, 0x2a, 0xd7, 0x3a, 0x3d, 0x46, 0x87, 0x9d, 0x03, 0xa7, 0xd6, 0xef, 0x25, 0x75,
+    0x56, 0x20, 0xc1, 0x45, 0x06, 0x9c, 0xea, 0x62, 0xf6, 0xd5, 0xc1, 0xab, 0xf3, 0xd9, 0xaa, 0xf7,
+    0x5d, 0xb9, 0xac, 0x6a, 0x5d, 0x53, 0xf7, 0x44, 0x4a, 0x5d, 0x97, 0x9d, 0xd3, 0x1e, 0x25, 0x33,
+    0xf1, 0xe0, 0x2e, 0x63, 0xfb, 0x02, 0xd6, 0x1d, 0x54, 0x50, 0xda, 0x27, 0xaf, 0xff, 0x07, 0x26,
+    0x3b, 0x8b, 0x4f, 0x0f, 0xe1, 0xd4, 0x91, 0x01, 0xae, 0x32, 0xe3, 0x2b, 0xea, 0xfc, 0x1b, 0x95,
+    0x4e, 0x84, 0x4e, 0x40, 0xb5, 0xf4, 0x7d, 0x7a, 0xb8, 0xae, 0xfd, 0x94, 0x63, 0x42, 0xb3, 0x9b,
+    0x06, 0xd3, 0x36, 0xc8, 0xac, 0x1f, 0x62, 0x6a, 0xe9, 0xfe, 0xa6, 0xf4, 0x27, 0xbd, 0x70, 0x0c,
+    0xfe, 0xee, 0xb8, 0x14, 0x94, 0xab, 0x3a, 0xe5, 0x69, 0xd3, 0xe7, 0xed, 0xcd, 0xa7, 0xfa, 0xa6,
+    0xff, 0xd1, 0x88, 0xd4, 0x3d, 0xe8, 0xf8, 0x06, 0xcf, 0x66, 0x05, 0x18, 0x6d, 0x35, 0x52, 0xa2,
+    0xad, 0x0e, 0x58, 0xd4, 0xee, 0xc2, 0xf9, 0xf5, 0xae, 0x9c, 0x72, 0xc5, 0x9d, 0xab, 0xe9, 0xf0,
+    0x72, 0x5d, 0x34, 0x0d, 0x5a, 0xc5, 0x14, 0x1c, 0xf7, 0x82, 0x0b, 0x41, 0x00, 0xad, 0xcb, 0xba,
+    0x3b, 0xbc, 0x42, 0xea, 0x3c, 0x74, 0x8f, 0xb8, 0x6c, 0xeb, 0x1d, 0x73, 0xf7, 0xab, 0x6b, 0x10,
+    0x6c, 0xbf, 0x24, 0xbb, 0xb5, 0xcd, 0x0b, 0x16, 0x2b, 0xcb, 0xc8, 0xbd, 0xb5, 0x96, 0x6c, 0xf0,
+    0x6f, 0xe3, 0xa5, 0x81, 0xaf, 0x83, 0x23, 0x00, 0x00,
+};
+
+static const uint8_t asset_helpers_min_js[306] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x90, 0xd1, 0x6a, 0xc2, 0x40,
+    0x10, 0x45, 0x7f, 0x25, 0x2c, 0x3e, 0xec, 0xd2, 0x35, 0x58, 0xa4, 0x4f, 0x21, 0x05, 0x2b, 0xb6,
+    0x14, 0xac, 0x48, 0xeb, 0x4b, 0x2b, 0xd2, 0x6c, 0xb3, 0x63, 0x5d, 0x48, 0x66, 0x64, 0x77, 0xa2,
+    0xb5, 0x31, 0xff, 0x5e, 0x22, 0x56, 0x2c, 0x42, 0x9f, 0x66, 0x06, 0xe6, 0x9c, 0x0b, 0x37, 0x27,
+    0x0c, 0x1c, 0x3d, 0x8f, 0xc6, 0x83, 0xd7, 0xf7, 0xc9, 0xe0, 0x69, 0xf4, 0x92, 0xce, 0xc5, 0xb4,
+    0x30, 0xc8, 0x41, 0x68, 0xf1, 0xe0, 0x4d, 0x68, 0xe7, 0xd4, 0xb0, 0xa3, 0xe8, 0xf7, 0xba, 0xf7,
+    0x84, 0x1c, 0x8d, 0xcd, 0x16, 0xc5, 0x22, 0x59, 0x56, 0x98, 0xb3, 0x23, 0x8c, 0xbe, 0x09, 0x61,
+    0x62, 0x4a, 0x90, 0xac, 0x6a, 0x0f, 0x5c, 0x79, 0x3c, 0xb7, 0xce, 0x79, 0xb1, 0xdf, 0x67, 0x6f,
+    0x84, 0x10, 0x75, 0x6a, 0xbe, 0xba, 0x6e, 0xb2, 0xe6, 0x44, 0x86, 0x15, 0x6d, 0x67, 0x64, 0x02,
+    0x4b, 0xd6, 0x90, 0x0a, 0xf0, 0x9e, 0xbc, 0x50, 0x75, 0x01, 0x1c, 0x51, 0x6a, 0x29, 0xaf, 0x4a,
+    0x40, 0x8e, 0x3f, 0x81, 0x47, 0x05, 0xb4, 0xeb, 0xdd, 0xee, 0xd1, 0x4a, 0xc1, 0x2d, 0xd1, 0xcd,
+    0x09, 0xd9, 0x38, 0x04, 0x2f, 0x54, 0x42, 0xfb, 0xbd, 0x3c, 0x03, 0x72, 0x0f, 0x86, 0xe1, 0xc8,
+    0x48, 0x61, 0xdd, 0x46, 0x28, 0x4d, 0xb1, 0xb3, 0xe9, 0x05, 0xab, 0x4f, 0xd0, 0x07, 0xd9, 0x5d,
+    0x6c, 0xd6, 0x6b, 0x40, 0x3b, 0x5c, 0xb9, 0xc2, 0x4a, 0x52, 0x2a, 0xc9, 0x0f, 0x1d, 0xe1, 0xff,
+    0xea, 0x04, 0xe3, 0xbc, 0x30, 0x21, 0xb4, 0x1d, 0xa4, 0xd9, 0x21, 0x21, 0xea, 0xd4, 0xd0, 0x64,
+    0x1a, 0x63, 0x86, 0x2f, 0x1e, 0x12, 0x32, 0x20, 0xa7, 0xac, 0xe9, 0x4f, 0x00, 0x2a, 0x1d, 0x80,
+    0x67, 0xae, 0x04, 0xaa, 0x58, 0x4a, 0x95, 0xde, 0xd6, 0x47, 0xd3, 0xd8, 0x05, 0x8e, 0x8d, 0xb5,
+    0x52, 0x2c, 0x8d, 0x85, 0x2e, 0x55, 0x2c, 0x2e, 0x7e, 0x31, 0xf6, 0x50, 0xd2, 0x06, 0xa4, 0xd2,
+    0x37, 0xbd, 0x9e, 0x6a, 0x74, 0x1f, 0xfa, 0xaa, 0xf9, 0x01, 0xe4, 0xbd, 0x45, 0x38, 0xd5, 0x01,
+    0x00, 0x00,
+};
+
+static const uint8_t asset_index_min_html[527] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x94, 0xc1, 0x8e, 0xdb, 0x20,
+    0x10, 0x86, 0x5f, 0x65, 0xea, 0x5e, 0xeb, 0x38, 0xb0, 0x71, 0x37, 0xc9, 0x02, 0x87, 0xee, 0xa5,
+    0x97, 0x5e, 0x2a, 0x55, 0x3d, 0x53, 0x33, 0xb6, 0xc9, 0x12, 0x40, 0x40, 0xbc, 0xf1, 0xdb, 0x57,
+    0x98, 0x64, 0x37, 0xd1, 0xf6, 0x05, 0x2a, 0x59, 0x88, 0xf9, 0xf9, 0x19, 0xc6, 0x1f, 0x1a, 0xd8,
+    0x27, 0xe5, 0xba, 0x34, 0x7b, 0x84, 0x31, 0x1d, 0x8d, 0x60, 0x97, 0x11, 0xa5, 0x12, 0xec, 0x88,
+    0x49, 0x82, 0x95, 0x47, 0xe4, 0x93, 0xc6, 0x57, 0xef, 0x42, 0x82, 0xce, 0xd9, 0x84, 0x36, 0xf1,
+    0xea, 0x55, 0xab, 0x34, 0x72, 0x85, 0x93, 0xee, 0xb0, 0x5e, 0x82, 0x2f, 0xda, 0xea, 0xa4, 0xa5,
+    0xa9, 0x63, 0x27, 0x0d, 0x72, 0x52, 0x09, 0x96, 0x74, 0x32, 0x28, 0x7e, 0xcb, 0x84, 0x41, 0xdb,
+    0x01, 0x9e, 0x9d, 0x4d, 0xc1, 0x19, 0xd6, 0x14, 0x9d, 0x19, 0x6d, 0x5f, 0x20, 0xa0, 0xe1, 0x31,
+    0xcd, 0x06, 0xe3, 0x88, 0x98, 0x60, 0x0c, 0xd8, 0x97, 0x78, 0x75, 0xd4, 0x76, 0xd5, 0xc5, 0x28,
+    0x58, 0x53, 0xca, 0xf9, 0xe3, 0xd4, 0x2c, 0x98, 0xd2, 0x13, 0x74, 0x46, 0xc6, 0xc8, 0x73, 0x2d,
+    0x52, 0x5b, 0x0c, 0xb7, 0xa2, 0x95, 0x13, 0x2c, 0xdb, 0xf9, 0xe1, 0x14, 0x93, 0xee, 0xe7, 0xfa,
+    0x52, 0xf2, 0xbe, 0x37, 0x78, 0xae, 0xd1, 0xaa, 0xa7, 0x41, 0xfa, 0x3d, 0x69, 0xfd, 0x59, 0x30,
+    0x59, 0x8e, 0x6b, 0x4e, 0x5e, 0xc9, 0x84, 0xef, 0x19, 0xea, 0xa5, 0xb2, 0x92, 0xa6, 0x73, 0xc6,
+    0x85, 0xfd, 0xe7, 0xbe, 0xdf, 0x6d, 0xd7, 0x6b, 0xf1, 0xab, 0x38, 0x59, 0x9c, 0x06, 0xc8, 0x50,
+    0xbe, 0xb9, 0x33, 0xaf, 0xd6, 0xb0, 0x06, 0xba, 0x01, 0xba, 0xa9, 0xa0, 0x60, 0x21, 0x5f, 0x61,
+    0x44, 0x3d, 0x8c, 0x29, 0xcf, 0x7a, 0x6d, 0x0c, 0xb7, 0xce, 0x22, 0xc4, 0x14, 0xdc, 0x0b, 0xf2,
+    0xee, 0x14, 0x02, 0xda, 0xf4, 0x9c, 0x13, 0x5f, 0xb4, 0x42, 0x90, 0xd3, 0x55, 0x7b, 0x15, 0x8c,
+    0xb6, 0xd8, 0x49, 0xcf, 0x83, 0x3b, 0x59, 0x75, 0x2b, 0x1e, 0x9c, 0xb6, 0x6f, 0x6a, 0x2e, 0x70,
+    0xc2, 0x90, 0x74, 0x27, 0x4d, 0x2d, 0x8d, 0x1e, 0xec, 0xfe, 0xa8, 0x95, 0x32, 0xf8, 0x74, 0x94,
+    0x61, 0xd0, 0xb6, 0x36, 0xd8, 0xa7, 0x3d, 0xcd, 0xff, 0xea, 0x65, 0x1a, 0x41, 0xf1, 0xea, 0x07,
+    0x25, 0x40, 0xda, 0x69, 0x23, 0x29, 0x50, 0xc8, 0x95, 0x93, 0x9a, 0x02, 0xfd, 0xde, 0xde, 0xc6,
+    0x35, 0x9d, 0xea, 0x4d, 0x25, 0x58, 0x93, 0x37, 0x09, 0xe6, 0x9d, 0x99, 0xf3, 0xd1, 0xe0, 0x9d,
+    0xb6, 0x29, 0xf2, 0x8a, 0x3c, 0xc2, 0x16, 0x08, 0x85, 0x07, 0x78, 0x84, 0xed, 0xe2, 0xbb, 0x38,
+    0x96, 0x3b, 0x45, 0x38, 0x13, 0x4e, 0x28, 0xcc, 0x84, 0x3f, 0xc0, 0x99, 0x2e, 0x53, 0xca, 0x49,
+    0x2b, 0x58, 0x53, 0x3c, 0x4d, 0x9c, 0x06, 0x01, 0xac, 0x91, 0xef, 0x37, 0x10, 0xdc, 0x29, 0xe5,
+    0x9d, 0xf7, 0x57, 0x20, 0x7e, 0x16, 0x39, 0xfe, 0x8f, 0xc0, 0xaf, 0x24, 0xda, 0x0c, 0x82, 0xd0,
+    0x85, 0xc4, 0x6e, 0x21, 0x41, 0xdf, 0x48, 0x7c, 0x24, 0x4b, 0xa1, 0x05, 0xb2, 0xcb, 0x70, 0xf3,
+    0xb7, 0xbb, 0x87, 0xbb, 0x80, 0x5b, 0xb8, 0x35, 0x4a, 0x4f, 0x82, 0x8d, 0xe4, 0x1f, 0xcd, 0x35,
+    0x92, 0xd2, 0x0f, 0x5a, 0xf1, 0x80, 0x46, 0xce, 0xf1, 0xea, 0xbe, 0x8a, 0x57, 0xa6, 0x85, 0xf5,
+    0x35, 0xac, 0x6f, 0xda, 0xa9, 0xf8, 0xcb, 0x18, 0xbb, 0xa0, 0x7d, 0x82, 0x18, 0x3a, 0x3e, 0xa2,
+    0xf1, 0x18, 0xe2, 0xd2, 0x98, 0x87, 0x9c, 0xb6, 0xac, 0xdd, 0x79, 0xa4, 0xf7, 0x1f, 0xd7, 0x9b,
+    0xd2, 0xba, 0xcd, 0xf2, 0xb8, 0xfc, 0x05, 0xa4, 0xdd, 0xe7, 0x03, 0x72, 0x04, 0x00, 0x00,
+};
+
+static const uint8_t asset_routine_min_html[750] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x55, 0xdb, 0x6e, 0xe4, 0x28,
+    0x10, 0xfd, 0x95, 0x1a, 0x3f, 0x8c, 0x12, 0xed, 0x3a, 0x8e, 0x3d, 0xc9, 0x4a, 0x93, 0x01, 0xa4,
+    0x99, 0xcc, 0xeb, 0x46, 0xab, 0xc9, 0x17, 0x54, 0x43, 0xc5, 0x66, 0x1a, 0x83, 0x05, 0xd5, 0xee,
+    0xf8, 0xef, 0x57, 0xd8, 0xee, 0x5b, 0x12, 0xed, 0xbe, 0xd0, 0x50, 0x75, 0x38, 0x9c, 0x3a, 0x94,
+    0x69, 0xf1, 0xc9, 0x04, 0xcd, 0xd3, 0x40, 0xd0, 0x71, 0xef, 0x94, 0x58, 0x47, 0x42, 0xa3, 0x44,
+    0x4f, 0x8c, 0xe0, 0xb1, 0x27, 0x39, 0x5a, 0xda, 0x0f, 0x21, 0x32, 0xe8, 0xe0, 0x99, 0x3c, 0xcb,
+    0x62, 0x6f, 0x0d, 0x77, 0xd2, 0xd0, 0x68, 0x35, 0x95, 0xf3, 0xe2, 0x4f, 0xeb, 0x2d, 0x5b, 0x74,
+    0x65, 0xd2, 0xe8, 0x48, 0xd6, 0x85, 0x12, 0x6c, 0xd9, 0x91, 0xfa, 0x15, 0x76, 0x6c, 0x3d, 0xc1,
+    0xdf, 0xe8, 0xb1, 0xa5, 0x9e, 0x3c, 0x8b, 0x6a, 0xc9, 0x08, 0x67, 0xfd, 0x16, 0x22, 0x39, 0x99,
+    0x78, 0x72, 0x94, 0x3a, 0x22, 0x86, 0x2e, 0xd2, 0xcb, 0xb2, 0xbe, 0xe9, 0xad, 0xbf, 0xd1, 0x29,
+    0x29, 0x51, 0x2d, 0x82, 0x36, 0xc1, 0x4c, 0x4a, 0x18, 0x3b, 0x82, 0x76, 0x98, 0x92, 0xcc, 0x6a,
+    0xd0, 0x7a, 0x8a, 0xe7, 0x41, 0x8f, 0xa3, 0x12, 0xb8, 0xd0, 0x54, 0xa7, 0x58, 0x99, 0xcf, 0x52,
+    0x22, 0x8d, 0x2d, 0xe4, 0x6a, 0x7e, 0x84, 0x57, 0x59, 0xdc, 0xc2, 0x2d, 0x34, 0x77, 0xd0, 0xdc,
+    0x15, 0xb0, 0xd4, 0x53, 0xff, 0x05, 0x1d, 0xd9, 0xb6, 0xe3, 0x3c, 0x7b, 0xb1, 0xce, 0x49, 0x1f,
+    0x3c, 0x41, 0xe2, 0x18, 0xb6, 0x24, 0xf5, 0x2e, 0x46, 0xf2, 0xfc, 0x18, 0x5c, 0x88, 0x6b, 0x6c,
+    0x29, 0x5d, 0x36, 0x37, 0xf7, 0x87, 0x80, 0xb3, 0x9e, 0x34, 0x0e, 0x32, 0x86, 0x9d, 0x37, 0xe7,
+    0xc1, 0xdf, 0xc1, 0xfa, 0x63, 0x74, 0x72, 0x24, 0x47, 0x8a, 0x6c, 0x35, 0xba, 0x12, 0x9d, 0x6d,
+    0xfd, 0x43, 0x6f, 0x8d, 0x71, 0xf4, 0xad, 0xc7, 0xd8, 0x5a, 0x5f, 0xc6, 0xac, 0xe2, 0xe1, 0x6e,
+    0x78, 0x9d, 0x4d, 0x22, 0x78, 0xad, 0x65, 0xfd, 0x15, 0xa6, 0x5a, 0xd6, 0x0d, 0xbc, 0x36, 0xf2,
+    0x1e, 0xa6, 0x46, 0xd6, 0x8d, 0x12, 0x55, 0xce, 0x2a, 0x31, 0x04, 0x37, 0xcd, 0xb8, 0x21, 0x58,
+    0xcf, 0x49, 0x16, 0x75, 0x03, 0xf5, 0x57, 0xb8, 0x87, 0xfc, 0xdb, 0xc0, 0x7d, 0xa1, 0x44, 0x75,
+    0xc0, 0x28, 0x51, 0xa5, 0xb1, 0x55, 0xf0, 0x03, 0xf5, 0x16, 0x38, 0xc0, 0x4f, 0x4c, 0xdd, 0x26,
+    0x60, 0x34, 0xa2, 0x42, 0x25, 0x2a, 0x63, 0x47, 0x25, 0xba, 0xfa, 0xc3, 0x6b, 0xeb, 0xea, 0x73,
+    0xa7, 0xe3, 0x82, 0x28, 0x13, 0x39, 0xd2, 0x1c, 0xa2, 0x12, 0xcb, 0x0c, 0xac, 0x39, 0xe6, 0x9c,
+    0x4d, 0x0c, 0xc1, 0xeb, 0x0e, 0x7d, 0x4b, 0xd2, 0x05, 0x34, 0xcf, 0x33, 0x86, 0xcc, 0xca, 0x7f,
+    0x75, 0xad, 0x44, 0x18, 0xd8, 0x06, 0x0f, 0x23, 0xba, 0x1d, 0xc9, 0xa2, 0x50, 0x65, 0x09, 0x0b,
+    0x0a, 0x42, 0x84, 0xc7, 0x48, 0xc8, 0x04, 0x07, 0x39, 0x65, 0x29, 0xaa, 0x05, 0x9f, 0xeb, 0x98,
+    0x51, 0x1f, 0x69, 0x42, 0x9d, 0x21, 0x49, 0x89, 0xcd, 0x8e, 0x39, 0xf8, 0x35, 0xbb, 0x61, 0x5f,
+    0xa6, 0x1e, 0x9d, 0xcb, 0x92, 0x9c, 0xd5, 0x5b, 0xa9, 0x67, 0xf6, 0x27, 0xda, 0x9f, 0xe4, 0x3c,
+    0xd1, 0x5e, 0x54, 0xcb, 0x36, 0x05, 0x97, 0xfb, 0x8b, 0x13, 0x41, 0x9e, 0x85, 0x97, 0x97, 0xe2,
+    0xc8, 0x64, 0xc8, 0x11, 0xd3, 0x89, 0xe6, 0xe7, 0xbc, 0x3e, 0x32, 0xad, 0xc6, 0x2e, 0x63, 0xd6,
+    0x7b, 0x66, 0x12, 0x19, 0xcb, 0x73, 0x4b, 0xe5, 0xb6, 0x30, 0x36, 0x0d, 0x0e, 0xa7, 0x87, 0xdc,
+    0x79, 0x17, 0xcd, 0x8e, 0xd1, 0x5c, 0x54, 0x4a, 0x0e, 0xa7, 0x32, 0x7f, 0x18, 0xb9, 0xff, 0xad,
+    0x1f, 0x76, 0x17, 0xc6, 0xe7, 0xef, 0xf6, 0x8d, 0x27, 0x39, 0x54, 0x2e, 0xc0, 0xc1, 0xa1, 0xa6,
+    0x2e, 0x38, 0x43, 0x51, 0x16, 0x07, 0x6b, 0x9f, 0xb0, 0xa7, 0xe2, 0xff, 0x4a, 0xf6, 0xa7, 0x8a,
+    0x13, 0x8e, 0x87, 0x7a, 0xd3, 0xd5, 0xb5, 0x7a, 0xc6, 0x91, 0xe0, 0xbb, 0x73, 0x6f, 0x4b, 0x7e,
+    0x53, 0x6c, 0x62, 0x1a, 0xd2, 0x21, 0xf7, 0xee, 0x76, 0xd0, 0x98, 0x19, 0x71, 0x3a, 0xa4, 0x0b,
+    0xfb, 0x67, 0xc6, 0x7c, 0x9b, 0xff, 0x58, 0xbd, 0xa5, 0x78, 0x75, 0xad, 0xfe, 0xf8, 0x4f, 0x57,
+    0xd3, 0x82, 0x2e, 0xfb, 0x60, 0xd0, 0xad, 0xd4, 0xf3, 0xbc, 0x0c, 0x23, 0x45, 0x87, 0xd3, 0x91,
+    0xbb, 0xa0, 0x91, 0x3c, 0xdf, 0x30, 0xc6, 0x96, 0x58, 0x4a, 0xc9, 0x9d, 0x4d, 0x9f, 0x3f, 0x6b,
+    0x17, 0x12, 0xbd, 0x39, 0xb2, 0x38, 0x77, 0x7e, 0x26, 0x53, 0xa2, 0xfb, 0xa2, 0xbe, 0x1b, 0x03,
+    0x2b, 0x52, 0x54, 0xdd, 0x97, 0x77, 0x12, 0x96, 0x46, 0x4d, 0xeb, 0xbe, 0x43, 0xb4, 0x8d, 0xd6,
+    0x9c, 0x6b, 0x3e, 0x97, 0xb8, 0x61, 0x9f, 0xd6, 0x46, 0x58, 0x5f, 0x02, 0x0e, 0xc3, 0x43, 0x73,
+    0x9b, 0x1f, 0x82, 0x77, 0x66, 0x69, 0xf4, 0x9a, 0xce, 0x7a, 0xf9, 0x03, 0xe1, 0xea, 0x71, 0xc6,
+    0x7c, 0x6c, 0xd8, 0xf9, 0x98, 0x74, 0xb4, 0x03, 0x43, 0x8a, 0x5a, 0x76, 0xe4, 0x06, 0x8a, 0x69,
+    0x7e, 0x7e, 0x7f, 0xe7, 0xab, 0x5a, 0x72, 0x17, 0x98, 0xf5, 0x36, 0xdf, 0x63, 0xaa, 0xe5, 0x91,
+    0xae, 0xe6, 0x3f, 0x92, 0x7f, 0x01, 0x80, 0xd9, 0x88, 0x38, 0x5e, 0x06, 0x00, 0x00,
+};
+
+static const uint8_t asset_routine_min_js[2154] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x18, 0x0b, 0x6f, 0xdb, 0x36,
+    0xfa, 0xaf, 0xb0, 0x44, 0x91, 0x8a, 0x08, 0xad, 0x58, 0x6e, 0x9a, 0xad, 0x76, 0xe8, 0xa2, 0x4d,
+    0x33, 0xb4, 0x43, 0x1f, 0x43, 0x13, 0x0c, 0xd8, 0x72, 0xc1, 0x95, 0x91, 0x3e, 0xc7, 0x6c, 0x65,
+    0x52, 0x23, 0x29, 0x27, 0x9e, 0xa3, 0xff, 0x3e, 0x90, 0x92, 0x25, 0xd9, 0x51, 0x52, 0x37, 0x77,
+    0x3d, 0xe0, 0x8a, 0xa0, 0x92, 0xa9, 0x8f, 0xdf, 0xfb, 0x9d, 0x82, 0x45, 0x5a, 0xe5, 0x56, 0x48,
+    0x30, 0xec, 0xec, 0x9c, 0xc6, 0xb9, 0xd6, 0x20, 0xed, 0xa7, 0xf2, 0xe8, 0xad, 0x4c, 0xe0, 0x9a,
+    0xf5, 0xa2, 0x51, 0xac, 0xa4, 0xb1, 0xe8, 0xed, 0xd1, 0xc7, 0x0f, 0x27, 0x6c, 0x99, 0x67, 0xc3,
+    0x27, 0x87, 0x66, 0x7e, 0x89, 0xe6, 0x02, 0xae, 0x5e, 0xa9, 0x6b, 0x86, 0xfb, 0xa8, 0x8f, 0x06,
+    0xfb, 0x68, 0xb0, 0x8f, 0xd1, 0x95, 0x48, 0xec, 0x94, 0xe1, 0xe8, 0x00, 0xa3, 0x29, 0x88, 0xcb,
+    0xa9, 0x2d, 0xdf, 0x27, 0x22, 0x4d, 0x19, 0x96, 0x4a, 0x02, 0x46, 0xc6, 0x6a, 0xf5, 0x15, 0x18,
+    0xae, 0x68, 0x1d, 0xa9, 0x54, 0xe9, 0xd5, 0x69, 0xaf, 0xba, 0xff, 0xb4, 0x3e, 0x48, 0x85, 0x84,
+    0x98, 0x67, 0x0c, 0x6b, 0x95, 0xcb, 0x64, 0xed, 0xf8, 0x8b, 0x12, 0x72, 0x75, 0x3e, 0x3e, 0xcc,
+    0x54, 0xba, 0x70, 0xa7, 0x28, 0x53, 0x42, 0x5a, 0xc3, 0x70, 0xf4, 0x33, 0x8a, 0x9e, 0xa1, 0x68,
+    0x80, 0x9e, 0xa3, 0x03, 0x14, 0x3d, 0xc3, 0xe3, 0xc3, 0xbd, 0x15, 0xcc, 0xf8, 0x70, 0xcf, 0xcc,
+    0x2f, 0xc7, 0x4f, 0x68, 0xa2, 0xae, 0xe4, 0xff, 0x87, 0x34, 0x07, 0xe8, 0xb9, 0x93, 0xc5, 0x49,
+    0xf4, 0x33, 0x7a, 0xde, 0x29, 0x8c, 0xd5, 0xdc, 0x4c, 0x7f, 0xbc, 0x34, 0x83, 0xff, 0x82, 0x34,
+    0x4f, 0xd1, 0x01, 0x7a, 0x86, 0x0e, 0xd0, 0x20, 0x42, 0x07, 0xeb, 0xb2, 0x64, 0xdc, 0x4e, 0x51,
+    0xc2, 0xf0, 0xfb, 0xe8, 0x39, 0x3a, 0x98, 0x47, 0xfb, 0x7c, 0x80, 0x06, 0xc8, 0x09, 0x11, 0xf5,
+    0x06, 0x68, 0xf0, 0xe6, 0xa7, 0xf6, 0xef, 0xde, 0xe0, 0xf7, 0x83, 0xd9, 0x53, 0xd4, 0xff, 0xbd,
+    0x05, 0x85, 0x06, 0xbd, 0xc1, 0x74, 0xed, 0x37, 0x1a, 0xcc, 0x07, 0x9e, 0x06, 0xb7, 0xd3, 0xf1,
+    0xa1, 0x67, 0xe3, 0x3a, 0x62, 0x38, 0xea, 0x63, 0xb4, 0x70, 0xcf, 0x08, 0xa3, 0xeb, 0x41, 0xf5,
+    0xdb, 0x3d, 0x7f, 0x72, 0xc0, 0x25, 0x33, 0x0d, 0xf0, 0xfe, 0x06, 0xf0, 0xfe, 0x6d, 0xe0, 0xd2,
+    0x0a, 0xc5, 0x28, 0x05, 0x8b, 0xfe, 0x56, 0x12, 0x8e, 0x54, 0x2e, 0x2d, 0xfb, 0x74, 0xfc, 0xee,
+    0xe5, 0x1f, 0xff, 0xfe, 0xf0, 0xf2, 0xfd, 0xf1, 0x49, 0x98, 0x82, 0xbc, 0xb4, 0xd3, 0x11, 0x37,
+    0x0b, 0x19, 0xa3, 0x49, 0x2e, 0x63, 0x2b, 0x94, 0x44, 0x13, 0xb0, 0xf1, 0xf4, 0xcf, 0xd5, 0x85,
+    0x80, 0x2c, 0xad, 0x5e, 0x2c, 0xcb, 0x88, 0x03, 0xc6, 0xaf, 0xb8, 0xb0, 0x25, 0x48, 0x80, 0xf7,
+    0x78, 0x26, 0xf6, 0x1c, 0x6a, 0x83, 0xc9, 0x08, 0x42, 0xf5, 0x75, 0x67, 0x27, 0x68, 0x28, 0x05,
+    0x25, 0x2c, 0x84, 0x5f, 0x8c, 0x92, 0x01, 0x21, 0x61, 0xec, 0x8e, 0x49, 0x11, 0x73, 0x77, 0x19,
+    0x88, 0xc7, 0xa9, 0x52, 0x08, 0x41, 0x6b, 0xa5, 0x03, 0xfc, 0x0b, 0x17, 0x29, 0x24, 0xc8, 0xaa,
+    0x12, 0x3d, 0x2a, 0x11, 0x53, 0x20, 0x45, 0xd1, 0xc5, 0x61, 0x95, 0x13, 0xcc, 0x37, 0x19, 0x5c,
+    0xe5, 0x93, 0x86, 0xc7, 0x3a, 0xc3, 0xac, 0x73, 0x48, 0x5f, 0x6a, 0xcd, 0x17, 0xa1, 0x30, 0xfe,
+    0x59, 0x43, 0x91, 0x9b, 0x9b, 0xa0, 0x95, 0x93, 0x08, 0xcd, 0xb3, 0x84, 0x5b, 0xa8, 0xe8, 0xbf,
+    0x13, 0xc6, 0x06, 0x64, 0x7b, 0xa9, 0x6a, 0x6e, 0x28, 0x10, 0xda, 0x4e, 0x75, 0x1d, 0x58, 0x8b,
+    0xa2, 0x16, 0xb9, 0xe3, 0x6b, 0x2d, 0x72, 0xa2, 0xe2, 0x7c, 0x06, 0xd2, 0x86, 0x97, 0x60, 0x8f,
+    0x53, 0x70, 0xaf, 0xaf, 0x16, 0x6f, 0x93, 0x00, 0x57, 0xe8, 0x7b, 0xa9, 0x30, 0x16, 0x13, 0x6a,
+    0x19, 0x84, 0x73, 0x9e, 0xe6, 0x30, 0x82, 0x50, 0x48, 0x09, 0xfa, 0xcd, 0xe9, 0xfb, 0x77, 0xec,
+    0xc9, 0xa1, 0xca, 0x3c, 0x09, 0xff, 0x89, 0x61, 0x3c, 0xee, 0xf5, 0xd0, 0x09, 0xa4, 0x10, 0x5b,
+    0xa4, 0x34, 0x3a, 0xd2, 0xc0, 0x2d, 0xa0, 0x8a, 0x32, 0xea, 0xf5, 0x0e, 0xf7, 0x4a, 0xf8, 0xf1,
+    0x93, 0x9a, 0xfd, 0x70, 0xa2, 0xf4, 0x31, 0x8f, 0xa7, 0x41, 0x60, 0xa9, 0x24, 0x6c, 0x5c, 0x71,
+    0xa6, 0x1a, 0xce, 0x62, 0x8f, 0xa5, 0x62, 0x2e, 0xc0, 0x25, 0x06, 0x4c, 0x46, 0xaa, 0x64, 0x88,
+    0x49, 0xaa, 0x42, 0x0b, 0xd7, 0xf6, 0x48, 0x49, 0x0b, 0xd2, 0x32, 0x1b, 0x4a, 0x3e, 0x03, 0x0a,
+    0x21, 0xcf, 0x32, 0x90, 0xc9, 0xd1, 0x54, 0xa4, 0x49, 0xa0, 0x48, 0x41, 0x68, 0x25, 0x02, 0xb3,
+    0x8d, 0x6e, 0x4a, 0xe4, 0x1f, 0xe0, 0xaa, 0x62, 0xb2, 0xa5, 0x9a, 0xcf, 0x2b, 0xbe, 0x1f, 0x2f,
+    0x6b, 0x66, 0x4b, 0xaf, 0xdf, 0x8d, 0x8a, 0xcf, 0xa3, 0xfa, 0x2c, 0xcb, 0xcd, 0x34, 0x58, 0x3a,
+    0x9a, 0x43, 0xa0, 0xc6, 0x42, 0x66, 0x86, 0x67, 0xe7, 0x45, 0xa7, 0xa9, 0xe9, 0x96, 0xea, 0xae,
+    0xf8, 0xdc, 0x20, 0xdb, 0x8b, 0x68, 0xaa, 0x78, 0x52, 0xea, 0x17, 0x92, 0x9a, 0x63, 0x6a, 0xc0,
+    0x9e, 0x8a, 0x19, 0xa8, 0xdc, 0x06, 0x41, 0xa3, 0xc2, 0x2d, 0x8c, 0xeb, 0x98, 0x76, 0xae, 0xbd,
+    0xb3, 0x13, 0x40, 0x38, 0x51, 0x71, 0x6e, 0x02, 0xa7, 0x25, 0xe3, 0x29, 0x38, 0xcf, 0xa4, 0x51,
+    0x9f, 0x34, 0xca, 0x4a, 0x20, 0x85, 0x5a, 0xa2, 0x80, 0x2c, 0x7b, 0xd1, 0x23, 0xc6, 0x3a, 0xca,
+    0xec, 0xce, 0x4e, 0xac, 0xe4, 0x44, 0xe8, 0x59, 0x80, 0x5f, 0xfb, 0x2b, 0xc8, 0x4e, 0x85, 0x59,
+    0xb9, 0xef, 0x0b, 0x4c, 0x5a, 0x71, 0x14, 0x9a, 0x2c, 0x15, 0x31, 0x04, 0x1d, 0x68, 0x68, 0x44,
+    0xee, 0x28, 0xe2, 0x0f, 0xd3, 0x2d, 0x24, 0xc2, 0x2a, 0x8d, 0x49, 0x68, 0xec, 0x22, 0x85, 0x30,
+    0x11, 0x26, 0x4b, 0xf9, 0xa2, 0x2a, 0x17, 0x2d, 0x31, 0x3b, 0x95, 0xfc, 0xbd, 0x11, 0x53, 0x45,
+    0x8b, 0x98, 0x04, 0x18, 0x33, 0xc6, 0x80, 0x68, 0xb0, 0xb9, 0x96, 0xe8, 0x3f, 0xe3, 0x92, 0xce,
+    0x95, 0x48, 0x82, 0x6e, 0xa5, 0x90, 0x51, 0xd7, 0x79, 0xc6, 0xb5, 0x81, 0xb7, 0xd2, 0x06, 0x40,
+    0xaa, 0xd6, 0xc7, 0xd6, 0x7e, 0x75, 0xd6, 0x71, 0xe1, 0x7c, 0xb4, 0xa5, 0xd7, 0xac, 0x62, 0xa9,
+    0x8c, 0xb6, 0x07, 0x8b, 0x75, 0x91, 0xaa, 0xf8, 0x2b, 0xa6, 0x1a, 0x64, 0x02, 0xfa, 0xc4, 0x45,
+    0x4f, 0xd0, 0x32, 0xc5, 0xda, 0xf1, 0xf6, 0x26, 0xf0, 0x51, 0xe8, 0x73, 0x76, 0x93, 0xab, 0x30,
+    0xae, 0xe5, 0x3f, 0x0b, 0xc3, 0xf0, 0x5e, 0x1d, 0x84, 0x1e, 0xc1, 0x79, 0x68, 0x94, 0xb6, 0x41,
+    0x00, 0xd4, 0x12, 0x36, 0x86, 0x50, 0xe9, 0x04, 0x74, 0xcf, 0x96, 0x4f, 0x32, 0xb2, 0x4d, 0xea,
+    0x92, 0x54, 0x35, 0x71, 0xa7, 0xef, 0x4c, 0x5d, 0x89, 0x98, 0x63, 0x32, 0xd2, 0x61, 0x9c, 0x72,
+    0x63, 0x3e, 0xf0, 0x19, 0xb0, 0x35, 0x8e, 0x7b, 0x31, 0xd7, 0x09, 0xa6, 0x3a, 0x4c, 0xb8, 0xe5,
+    0x06, 0x2a, 0x42, 0x4c, 0x96, 0x4f, 0xaa, 0x5b, 0xc2, 0x7c, 0xfe, 0x97, 0x44, 0xad, 0x7f, 0x87,
+    0x89, 0x98, 0x23, 0x8f, 0x95, 0x61, 0x8f, 0x49, 0xc8, 0x89, 0xc2, 0xe3, 0x75, 0x20, 0x0f, 0x68,
+    0x32, 0x2e, 0xd7, 0x20, 0xbd, 0x31, 0xc7, 0x8f, 0x97, 0xd2, 0xdb, 0xb1, 0x38, 0xdc, 0x73, 0x10,
+    0x5d, 0x37, 0x37, 0x49, 0xc4, 0x4a, 0x5a, 0xad, 0x52, 0xd3, 0x45, 0xc6, 0x5f, 0xb8, 0xc8, 0xad,
+    0x55, 0x35, 0xb1, 0x0b, 0x2b, 0x4b, 0x21, 0x79, 0xf2, 0x25, 0x37, 0x16, 0x23, 0x25, 0xe3, 0x54,
+    0xc4, 0x5f, 0x19, 0x2e, 0x0f, 0x5e, 0xe7, 0x9a, 0x3b, 0x93, 0x07, 0x8e, 0x15, 0x2f, 0x70, 0x41,
+    0x51, 0x2f, 0x22, 0x78, 0xdc, 0x3b, 0xdc, 0x2b, 0x51, 0xdd, 0x45, 0x48, 0xc8, 0x2c, 0xb7, 0xc8,
+    0x2e, 0x32, 0x60, 0x58, 0xe6, 0xb3, 0x0b, 0xd0, 0x78, 0x55, 0x90, 0x1c, 0xb2, 0xa4, 0xc2, 0x5c,
+    0x60, 0x34, 0x73, 0x8d, 0x5c, 0x84, 0xd1, 0x8c, 0x5f, 0x33, 0x3c, 0xe8, 0x7b, 0x26, 0xa6, 0x5c,
+    0x5e, 0x02, 0xc3, 0x65, 0x46, 0x71, 0x9e, 0xd6, 0xc9, 0x89, 0x4b, 0x60, 0xa5, 0xc7, 0x93, 0x1f,
+    0x29, 0xb0, 0x93, 0x77, 0xf7, 0x5b, 0xf2, 0x7a, 0x0b, 0xcd, 0x84, 0xcc, 0x2d, 0x98, 0xbb, 0xed,
+    0xb5, 0x97, 0x88, 0xf9, 0xc6, 0x79, 0xe7, 0xd9, 0xa6, 0x5d, 0xb9, 0x8f, 0xbc, 0x4e, 0xb3, 0x76,
+    0x48, 0x28, 0x62, 0x25, 0x5b, 0xa2, 0xcd, 0xd4, 0xdc, 0xeb, 0xf0, 0x96, 0x15, 0xd1, 0xe3, 0x65,
+    0x9f, 0x31, 0xa6, 0x5e, 0xe0, 0x44, 0x18, 0x7e, 0x91, 0x42, 0x82, 0x87, 0x18, 0x17, 0xe3, 0xc7,
+    0x4b, 0x3f, 0x89, 0x85, 0x79, 0x56, 0xdc, 0x23, 0xf6, 0x03, 0x09, 0x97, 0x74, 0x15, 0x63, 0xcc,
+    0xd6, 0x25, 0xf4, 0x2e, 0x06, 0xdc, 0xf4, 0xf4, 0x9d, 0x2c, 0x68, 0x70, 0x54, 0xbd, 0x91, 0x5b,
+    0x9c, 0x94, 0xa7, 0x1b, 0xbc, 0x10, 0x8c, 0xac, 0xb0, 0x29, 0x30, 0xfc, 0xc9, 0x7f, 0x46, 0xee,
+    0x3b, 0xae, 0x89, 0xfb, 0x69, 0xe7, 0x2e, 0xea, 0x9b, 0x56, 0xfb, 0xbc, 0xd1, 0xda, 0x68, 0x52,
+    0x90, 0xcd, 0x66, 0x6f, 0xcd, 0x8f, 0x5d, 0xfe, 0xaa, 0x72, 0x93, 0x64, 0x5b, 0xe4, 0xbd, 0x70,
+    0x22, 0x64, 0x12, 0x58, 0x36, 0x5e, 0x65, 0x20, 0x57, 0xbe, 0x5c, 0x25, 0x93, 0xa4, 0xee, 0xce,
+    0xde, 0x73, 0x3b, 0x0d, 0x67, 0xfc, 0x3a, 0x88, 0x68, 0xf9, 0x2a, 0x64, 0x30, 0xe8, 0xd3, 0xba,
+    0xda, 0x58, 0x72, 0x73, 0x13, 0x11, 0x32, 0x6a, 0xc2, 0x8f, 0xa9, 0xd1, 0xad, 0xfc, 0xf8, 0x8d,
+    0xfc, 0x4d, 0x0d, 0x2b, 0xdb, 0xea, 0x89, 0x56, 0xb3, 0x40, 0x87, 0x7f, 0xe5, 0xa0, 0x17, 0x65,
+    0x65, 0x56, 0xfa, 0x65, 0x9a, 0x06, 0x38, 0xbc, 0x9d, 0x3f, 0x09, 0xa9, 0xf9, 0x6f, 0xb8, 0x59,
+    0x4f, 0xa9, 0xa4, 0x96, 0xc8, 0x34, 0x45, 0xc5, 0xac, 0xa3, 0x0f, 0xb0, 0x4f, 0x2b, 0x65, 0x77,
+    0x54, 0x35, 0x8e, 0x8f, 0x98, 0xf2, 0x9d, 0x52, 0x99, 0x5c, 0x14, 0x29, 0x5a, 0x4d, 0xf6, 0x46,
+    0x50, 0xff, 0x0f, 0x75, 0xde, 0xa8, 0x78, 0xd7, 0x12, 0x7f, 0x47, 0x3d, 0x62, 0xac, 0x39, 0x25,
+    0xcb, 0x0e, 0x23, 0xd8, 0xed, 0x8d, 0xa0, 0xdb, 0x46, 0xb0, 0x3f, 0xc0, 0x08, 0xba, 0x31, 0x82,
+    0xbe, 0xc7, 0x08, 0xeb, 0x8a, 0x6f, 0x34, 0x6f, 0xa6, 0xea, 0xea, 0xc4, 0x7a, 0xf1, 0x7e, 0x13,
+    0xf1, 0x57, 0xd0, 0xdb, 0x74, 0x0a, 0xa6, 0xbc, 0xd0, 0x2b, 0xa7, 0x89, 0x8e, 0x5e, 0x61, 0xa2,
+    0x74, 0xe0, 0xa6, 0x5f, 0xc9, 0xfa, 0x23, 0x79, 0x58, 0x4f, 0xa6, 0x23, 0xb9, 0xbb, 0xbb, 0x42,
+    0x6f, 0x99, 0x3b, 0x76, 0x75, 0x3c, 0x90, 0x84, 0xaa, 0x6f, 0x94, 0x7d, 0xd5, 0x2e, 0xfb, 0xeb,
+    0xe4, 0xf1, 0xe6, 0x04, 0x43, 0x55, 0xb8, 0xca, 0x27, 0xae, 0xa1, 0xe7, 0x49, 0xe2, 0xf3, 0x89,
+    0xa4, 0x96, 0xdc, 0x9e, 0x6b, 0xbe, 0x29, 0xe3, 0x4c, 0x25, 0x3c, 0xbd, 0xdd, 0x79, 0x4d, 0x52,
+    0xb8, 0xc6, 0xad, 0x49, 0x28, 0x55, 0x06, 0x36, 0xf5, 0xf8, 0x50, 0xdc, 0xbe, 0x59, 0x6d, 0x07,
+    0x47, 0x29, 0xc0, 0xf6, 0x51, 0x41, 0x15, 0x93, 0x55, 0x64, 0x94, 0x99, 0x7b, 0xdc, 0x7f, 0x51,
+    0xfb, 0x7f, 0x18, 0x86, 0xab, 0x8f, 0x33, 0x9e, 0x05, 0x50, 0x37, 0x67, 0x84, 0xec, 0x46, 0xc3,
+    0xfe, 0x68, 0xf5, 0xb1, 0x9c, 0xcc, 0x44, 0x32, 0x04, 0xea, 0xc7, 0x33, 0x4b, 0x57, 0x71, 0x30,
+    0x7c, 0x46, 0x41, 0xfa, 0x2a, 0x30, 0x7c, 0xd4, 0xa7, 0xfe, 0xee, 0x50, 0x15, 0x84, 0x76, 0x29,
+    0xe1, 0xee, 0xde, 0xb4, 0x4e, 0xf4, 0xd0, 0xb8, 0xc4, 0xfd, 0x52, 0x49, 0x66, 0x5b, 0xf1, 0xee,
+    0x0f, 0x6f, 0x05, 0xbd, 0x9f, 0xaa, 0xe4, 0xce, 0x4e, 0xb0, 0x02, 0xad, 0x26, 0x24, 0xe9, 0xe6,
+    0xa1, 0xfa, 0xec, 0x9e, 0xce, 0xb4, 0xe9, 0x4b, 0xd7, 0xbe, 0x33, 0xbb, 0x21, 0x4a, 0x67, 0xd5,
+    0x70, 0x77, 0x68, 0x2b, 0xe9, 0x3c, 0x38, 0x77, 0xe1, 0x95, 0xae, 0xdd, 0xf8, 0x63, 0x77, 0x76,
+    0x02, 0xd9, 0xcc, 0x22, 0x92, 0x10, 0xaa, 0xce, 0xec, 0x39, 0x93, 0x9b, 0xeb, 0x99, 0x46, 0xa5,
+    0xdf, 0x99, 0x40, 0xbd, 0xc3, 0xdc, 0xa9, 0x54, 0xaa, 0x19, 0xec, 0x5a, 0x6a, 0xd6, 0x60, 0x1a,
+    0xbf, 0x61, 0x8c, 0x69, 0x9f, 0x8a, 0xbc, 0xee, 0xcd, 0xf7, 0x4f, 0x1a, 0xd4, 0xb6, 0x93, 0x24,
+    0x6c, 0x9d, 0x24, 0x2b, 0xf7, 0x0d, 0x96, 0x90, 0x0e, 0xa1, 0xf2, 0xc3, 0x66, 0x62, 0xdb, 0x48,
+    0x98, 0x54, 0x43, 0x6c, 0x87, 0xe0, 0x78, 0x79, 0xe5, 0x96, 0x91, 0x42, 0x5e, 0x1e, 0xa5, 0xc2,
+    0xa9, 0xc3, 0x4f, 0xeb, 0x05, 0x71, 0x62, 0xca, 0x33, 0x75, 0x5e, 0xc2, 0x8f, 0x9a, 0x57, 0x26,
+    0xcf, 0x4c, 0xf5, 0x4a, 0x9b, 0x57, 0xa6, 0xa9, 0xbc, 0xd7, 0x91, 0xd6, 0xdd, 0x85, 0x3e, 0x48,
+    0xc2, 0x95, 0x2f, 0x42, 0x3d, 0x1f, 0xb5, 0xfc, 0xe0, 0x96, 0x84, 0x8a, 0xd9, 0xd2, 0x9b, 0xd6,
+    0x6c, 0x23, 0xcb, 0xaa, 0xd6, 0x04, 0xd9, 0x9d, 0x3a, 0xa0, 0x92, 0xa9, 0xd0, 0xa9, 0x29, 0xb4,
+    0x2a, 0xeb, 0xf9, 0xff, 0x47, 0xfd, 0x2a, 0x9c, 0xa0, 0x4a, 0x52, 0x56, 0x73, 0x69, 0x84, 0xaf,
+    0x86, 0xd5, 0x50, 0xbd, 0xf6, 0x65, 0xa2, 0xf4, 0x8c, 0x7d, 0xf6, 0xaf, 0x29, 0xb7, 0xf0, 0x87,
+    0xeb, 0xe2, 0x8a, 0xec, 0x9a, 0xb8, 0xb6, 0x4b, 0x4d, 0x26, 0x06, 0xec, 0x1b, 0xbf, 0x70, 0xa6,
+    0x1a, 0xfe, 0xca, 0xc1, 0xd8, 0x97, 0x52, 0xcc, 0xbc, 0x9f, 0xff, 0xa2, 0x5d, 0x25, 0xf0, 0x0b,
+    0x98, 0x2e, 0x52, 0x35, 0x72, 0xd4, 0x0f, 0xf7, 0x0d, 0x8a, 0xf3, 0x0b, 0x11, 0xf7, 0x2e, 0xe0,
+    0x6f, 0x01, 0x3a, 0xe8, 0x87, 0x03, 0x8a, 0xfa, 0xfe, 0x2f, 0x22, 0x5d, 0xfc, 0x60, 0x77, 0xe8,
+    0xeb, 0x87, 0x5b, 0x76, 0x84, 0x3c, 0x49, 0x02, 0xd7, 0xf2, 0x0a, 0x79, 0x89, 0x6f, 0xaf, 0x7f,
+    0xba, 0xa8, 0xaf, 0xdf, 0x2f, 0x53, 0x57, 0x83, 0xa2, 0xa0, 0xfb, 0xfd, 0xbe, 0x73, 0xa0, 0xa2,
+    0xb8, 0xbd, 0x31, 0x35, 0x7c, 0x0e, 0xad, 0x85, 0xe9, 0xfd, 0xb1, 0xe8, 0xf2, 0x2c, 0xfb, 0xae,
+    0x0d, 0x42, 0xd7, 0x2e, 0x67, 0xb4, 0xe5, 0x56, 0x96, 0x2e, 0x67, 0x60, 0xa7, 0x2a, 0x19, 0xe2,
+    0xdf, 0x3e, 0x9e, 0x9c, 0x62, 0x3a, 0x05, 0x9e, 0x80, 0x36, 0xc3, 0x25, 0xae, 0x4a, 0x69, 0xef,
+    0x74, 0x91, 0x01, 0x1e, 0x62, 0x9e, 0xb9, 0x1c, 0xea, 0xcd, 0xb4, 0xe7, 0x16, 0xb6, 0xb8, 0xa0,
+    0x17, 0x2a, 0x59, 0x0c, 0x7f, 0x3d, 0xf9, 0xf8, 0x21, 0x34, 0x56, 0x0b, 0x79, 0x29, 0x26, 0xad,
+    0xb5, 0x6d, 0x51, 0xee, 0x7b, 0x5f, 0xb8, 0xde, 0xe2, 0x54, 0x71, 0x63, 0x03, 0xbc, 0x52, 0x81,
+    0xd7, 0x47, 0x82, 0x29, 0x36, 0x79, 0x1c, 0x83, 0x31, 0x98, 0x0c, 0x5b, 0x50, 0xcd, 0xca, 0xd6,
+    0x81, 0xd5, 0x1b, 0xdb, 0x21, 0xc2, 0xbb, 0xf5, 0x4e, 0xdb, 0x95, 0xfa, 0x80, 0xdc, 0xdc, 0x38,
+    0x3b, 0x71, 0x9b, 0x9b, 0x53, 0xb8, 0xb6, 0xed, 0x2d, 0x70, 0x0b, 0xdd, 0xb1, 0x5b, 0x04, 0x3b,
+    0x54, 0x42, 0x5e, 0xae, 0x21, 0x83, 0x70, 0x06, 0xc6, 0xf0, 0x4b, 0xb7, 0xe1, 0xae, 0xd5, 0xcd,
+    0x93, 0xe4, 0x78, 0x0e, 0xd2, 0x3a, 0x25, 0x82, 0x04, 0x1d, 0xe0, 0xd7, 0x1f, 0xdf, 0x57, 0x9a,
+    0x78, 0xa7, 0x78, 0xe2, 0xd8, 0xf6, 0x1e, 0xb2, 0xb9, 0xa6, 0xa7, 0x1b, 0x5b, 0xf1, 0x82, 0x8c,
+    0xfe, 0x01, 0x37, 0xf5, 0x46, 0xb9, 0x4e, 0x1b, 0x00, 0x00,
+};
+
+static const uint8_t asset_style_min_css[2729] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x5a, 0xdd, 0x8f, 0xa3, 0xba,
+    0x15, 0xff, 0x57, 0x90, 0x46, 0xab, 0x99, 0x54, 0x10, 0x99, 0xcf, 0x10, 0xf2, 0x72, 0xdb, 0x4a,
+    0x55, 0xef, 0x43, 0xfb, 0xd0, 0xab, 0x95, 0xda, 0x47, 0x03, 0x26, 0xe3, 0x0e, 0xb1, 0x91, 0xed,
+    0xcc, 0x64, 0x16, 0xe5, 0x7f, 0xaf, 0x6c, 0x30, 0xd8, 0x86, 0x24, 0x73, 0xf7, 0x56, 0xa3, 0xdd,
+    0x19, 0xc0, 0x3e, 0x9c, 0xef, 0xf3, 0x3b, 0xc7, 0xfc, 0xa9, 0x3f, 0x41, 0x76, 0xc4, 0xa4, 0x00,
+    0x87, 0x0e, 0xd6, 0x35, 0x26, 0xc7, 0x02, 0x1c, 0x4a, 0x7a, 0x09, 0x38, 0xfe, 0x21, 0x2f, 0x4a,
+    0xca, 0x6a, 0xc4, 0x82, 0x92, 0x5e, 0xae, 0x25, 0xad, 0x3f, 0xfb, 0x86, 0x12, 0x11, 0x34, 0xf0,
+    0x84, 0xdb, 0xcf, 0x22, 0x80, 0x5d, 0xd7, 0xa2, 0x80, 0x7f, 0x72, 0x81, 0x4e, 0xfe, 0x5f, 0x5a,
+    0x4c, 0xde, 0xfe, 0x01, 0xab, 0xdf, 0xd4, 0xe5, 0xdf, 0x28, 0x11, 0xfe, 0xf3, 0x6f, 0xe8, 0x48,
+    0x91, 0xf7, 0xfd, 0xd7, 0x67, 0xff, 0x5f, 0xb4, 0xa4, 0x82, 0xfa, 0xcf, 0x7f, 0x47, 0xed, 0x3b,
+    0x12, 0xb8, 0x82, 0xde, 0x3f, 0xd1, 0x19, 0x3d, 0xfb, 0x7f, 0x66, 0x18, 0xb6, 0x3e, 0x87, 0x84,
+    0x07, 0x1c, 0x31, 0xdc, 0x1c, 0x4a, 0x58, 0xbd, 0x1d, 0x19, 0x3d, 0x93, 0xba, 0x68, 0x31, 0x41,
+    0x90, 0x05, 0x47, 0x06, 0x6b, 0x8c, 0x88, 0x78, 0x09, 0xe3, 0xb4, 0x46, 0x47, 0xff, 0x09, 0x34,
+    0x11, 0x88, 0x76, 0x1e, 0xf0, 0x9f, 0x22, 0x10, 0xc3, 0x24, 0xf6, 0x52, 0xf0, 0xcd, 0x7f, 0x8a,
+    0xaa, 0x34, 0xce, 0x12, 0x2f, 0x04, 0xe0, 0xdb, 0xe6, 0x70, 0xc2, 0x24, 0x78, 0x45, 0xf8, 0xf8,
+    0x2a, 0x8a, 0x10, 0x80, 0xf7, 0xd7, 0x49, 0xb8, 0x08, 0x74, 0x97, 0xeb, 0xb6, 0xa2, 0x44, 0x40,
+    0x4c, 0x10, 0xeb, 0x4f, 0xf0, 0x12, 0x7c, 0xe0, 0x5a, 0xbc, 0x16, 0x19, 0x00, 0xdd, 0xe5, 0xa0,
+    0xb5, 0xe1, 0xc1, 0xb3, 0xa0, 0xd7, 0xd7, 0xb0, 0xaf, 0x68, 0x4b, 0x59, 0xf1, 0x84, 0xf2, 0x26,
+    0x45, 0xfb, 0x83, 0x40, 0x17, 0x11, 0xc0, 0x16, 0x1f, 0x49, 0x51, 0x21, 0x22, 0x10, 0x1b, 0x37,
+    0x04, 0x25, 0x15, 0x82, 0x9e, 0x8a, 0x38, 0xed, 0x2e, 0x07, 0xa5, 0x23, 0x8e, 0x7f, 0xa0, 0x22,
+    0x8e, 0xf4, 0xe5, 0xc7, 0xc0, 0x4c, 0x06, 0xc0, 0x40, 0x83, 0xbf, 0xc2, 0x9a, 0x7e, 0x14, 0xc0,
+    0x8b, 0xba, 0x8b, 0x97, 0x77, 0x17, 0x8f, 0x1d, 0x4b, 0xf8, 0x02, 0x7c, 0xf9, 0xb3, 0x4d, 0x36,
+    0x87, 0x16, 0x09, 0x81, 0x58, 0xc0, 0x3b, 0x58, 0x49, 0xb6, 0x83, 0x6d, 0xaa, 0xf8, 0x86, 0xac,
+    0xee, 0x0d, 0x0d, 0x3d, 0xc5, 0xbb, 0x64, 0x97, 0x34, 0x87, 0xc1, 0x4a, 0x45, 0xd8, 0x5d, 0x3c,
+    0x4e, 0x5b, 0x5c, 0x7b, 0x4f, 0x69, 0x92, 0xa1, 0x1d, 0x1c, 0x1f, 0x04, 0x52, 0x83, 0x67, 0x5e,
+    0x84, 0x49, 0x77, 0x99, 0x35, 0x91, 0x4c, 0xe2, 0x6a, 0xee, 0xc3, 0xac, 0xbb, 0x0c, 0xc6, 0xd7,
+    0xdc, 0x25, 0xdd, 0xc5, 0x0b, 0x23, 0x87, 0xbd, 0x78, 0x33, 0x70, 0x52, 0xbc, 0xd2, 0x77, 0xc4,
+    0x7a, 0x6b, 0x83, 0x14, 0x45, 0xea, 0xd8, 0x91, 0xe7, 0xba, 0x65, 0xa8, 0x85, 0x9f, 0xc1, 0x2b,
+    0x82, 0x35, 0x62, 0x7d, 0x8d, 0x79, 0xd7, 0xc2, 0xcf, 0xa2, 0x69, 0xd1, 0xe5, 0xf0, 0xdf, 0x33,
+    0x17, 0xb8, 0xf9, 0x0c, 0xa4, 0x51, 0x10, 0x11, 0x85, 0x94, 0x19, 0x05, 0x25, 0x12, 0x1f, 0x08,
+    0x91, 0x83, 0x52, 0x76, 0x80, 0x05, 0x3a, 0xf1, 0x75, 0x95, 0x87, 0xb9, 0xd4, 0x0c, 0x17, 0x50,
+    0x9c, 0x79, 0x20, 0xf5, 0xd2, 0xd9, 0xe4, 0x57, 0x08, 0x1c, 0x61, 0x57, 0xa8, 0x5d, 0x03, 0x53,
+    0x04, 0x9e, 0x50, 0x3f, 0x1b, 0x4d, 0xb2, 0xbf, 0x30, 0x9a, 0x76, 0x83, 0x0a, 0x35, 0x4d, 0xb8,
+    0xb4, 0x4e, 0x3c, 0xf3, 0x30, 0xbd, 0x1d, 0x13, 0xe9, 0xc0, 0xc1, 0x2d, 0x26, 0xb4, 0x1d, 0xb2,
+    0x51, 0xc5, 0x8e, 0xad, 0x66, 0x2e, 0x14, 0x53, 0x61, 0xe8, 0x30, 0xb5, 0x03, 0xc0, 0x65, 0x63,
+    0x9b, 0x77, 0x97, 0x83, 0x60, 0x90, 0x70, 0x2c, 0x30, 0x25, 0xc5, 0x36, 0xe6, 0x83, 0xb3, 0xa9,
+    0x7b, 0x0d, 0x65, 0xa7, 0xe2, 0xdc, 0x75, 0x88, 0x55, 0x90, 0x23, 0xa5, 0x83, 0xcc, 0xd0, 0x1c,
+    0xae, 0x28, 0xe9, 0x25, 0xaf, 0x01, 0x7f, 0x65, 0x98, 0xbc, 0x15, 0x40, 0xeb, 0x59, 0xd0, 0xae,
+    0x08, 0xc2, 0x79, 0x69, 0x51, 0x94, 0xa8, 0xa1, 0x0c, 0xf5, 0xda, 0x60, 0xcf, 0xcf, 0x87, 0x21,
+    0x84, 0x76, 0xdd, 0xe5, 0x30, 0x46, 0xdd, 0x6e, 0x21, 0x50, 0x0a, 0xbe, 0x69, 0x8a, 0x4c, 0x2f,
+    0xd1, 0x24, 0xb7, 0x94, 0x58, 0x6e, 0x1d, 0xa1, 0x5d, 0x1d, 0x47, 0x5a, 0xe9, 0x30, 0xad, 0x33,
+    0xb8, 0x5b, 0x71, 0xf2, 0x24, 0x86, 0x20, 0xd9, 0x19, 0x44, 0x26, 0xd6, 0x4c, 0x62, 0x59, 0x56,
+    0x96, 0x19, 0xb4, 0xfd, 0x7a, 0x70, 0x54, 0xfd, 0x08, 0x12, 0x7c, 0x82, 0x4a, 0x65, 0x11, 0xf7,
+    0x30, 0x69, 0x30, 0xc1, 0x02, 0x79, 0xdd, 0xb9, 0xe5, 0x68, 0x26, 0xde, 0x34, 0x16, 0xd5, 0x24,
+    0x4d, 0x61, 0x96, 0x68, 0x16, 0x4b, 0x50, 0xa2, 0x2a, 0x5d, 0x61, 0x31, 0x03, 0xbb, 0x3a, 0x2f,
+    0x4d, 0x2a, 0xab, 0x3c, 0xee, 0xf2, 0x3d, 0xd8, 0x57, 0xd7, 0x6d, 0x29, 0xc8, 0x9a, 0x0f, 0x4b,
+    0x63, 0x49, 0x1f, 0xb9, 0x96, 0x67, 0x21, 0x46, 0x3b, 0x15, 0xe1, 0xe4, 0x42, 0x32, 0xae, 0x55,
+    0xd4, 0x69, 0x06, 0xa2, 0x89, 0x01, 0x65, 0xfa, 0x0e, 0x32, 0x44, 0x84, 0x9b, 0x0c, 0x1c, 0x07,
+    0x4b, 0x56, 0x1c, 0xac, 0x3a, 0x33, 0x4e, 0x59, 0xd1, 0x51, 0xac, 0x5c, 0xd6, 0xf4, 0xad, 0xe8,
+    0x8e, 0x6f, 0xad, 0xf9, 0x65, 0x47, 0xc7, 0x9d, 0x32, 0xe6, 0x04, 0x7e, 0x47, 0x87, 0x47, 0x51,
+    0xea, 0xe6, 0x85, 0xe1, 0xf6, 0xa8, 0x82, 0xa2, 0xc6, 0x1c, 0x96, 0x2d, 0xaa, 0x7b, 0x2a, 0xdf,
+    0x22, 0x3e, 0x8b, 0x6d, 0xaa, 0xd9, 0x25, 0x54, 0xe6, 0xe8, 0x96, 0x7e, 0xa0, 0x5a, 0xaf, 0x86,
+    0x95, 0x7c, 0xa5, 0x7c, 0xf2, 0x32, 0xed, 0xdc, 0xf4, 0x33, 0xef, 0xbc, 0x82, 0x2d, 0x7a, 0xd9,
+    0xee, 0xb3, 0xcd, 0x60, 0x03, 0xc7, 0x1f, 0xe3, 0x3c, 0x47, 0x71, 0x75, 0xb0, 0x6b, 0x81, 0xe5,
+    0x50, 0xb1, 0x99, 0xc6, 0xd3, 0xcc, 0x0f, 0x93, 0xc8, 0xcf, 0xc6, 0xd4, 0x37, 0x10, 0x1c, 0xb2,
+    0xa5, 0xcb, 0x82, 0xe5, 0x52, 0xca, 0x9d, 0x6d, 0xba, 0xa9, 0xcc, 0x0e, 0xa9, 0x26, 0x9c, 0xed,
+    0xfc, 0x30, 0x03, 0xfe, 0x2e, 0xf4, 0xb7, 0xe9, 0xe6, 0x30, 0xb3, 0xaf, 0xfe, 0x6a, 0xa1, 0x40,
+    0xff, 0x79, 0x09, 0xa2, 0xee, 0xa2, 0xdf, 0xe9, 0xb8, 0x2c, 0x4a, 0xe3, 0x7d, 0x9c, 0x6a, 0x29,
+    0x9a, 0x06, 0x95, 0x08, 0xdd, 0x91, 0x22, 0x8a, 0xf6, 0x7e, 0xba, 0xf3, 0xd3, 0xd8, 0x90, 0xa2,
+    0x69, 0x1e, 0x8b, 0x81, 0x9a, 0x34, 0x4e, 0xc1, 0x3d, 0x31, 0xa2, 0x78, 0xef, 0xe7, 0xb1, 0x9f,
+    0x83, 0x2f, 0x89, 0xc1, 0x4f, 0xb0, 0x6d, 0xfb, 0x45, 0xba, 0x74, 0x72, 0xa3, 0xed, 0xdc, 0xb2,
+    0x90, 0xa9, 0x20, 0x21, 0x94, 0xa0, 0x81, 0xcc, 0x94, 0xe0, 0xd4, 0xbd, 0x31, 0x63, 0xa9, 0x02,
+    0x3d, 0xa6, 0x2c, 0xf5, 0xf7, 0x0c, 0x82, 0x0c, 0xfa, 0xd2, 0x7f, 0x6f, 0xc7, 0xfe, 0x50, 0x13,
+    0xe6, 0x97, 0x3c, 0xd6, 0xd0, 0x50, 0x9c, 0x87, 0x1d, 0x02, 0x9f, 0x10, 0x0b, 0x04, 0xc3, 0xc7,
+    0xa3, 0xac, 0xa5, 0xc6, 0x2a, 0x10, 0xe5, 0x79, 0x1d, 0x4e, 0x6f, 0x09, 0x9b, 0xb4, 0x41, 0x83,
+    0x50, 0x32, 0x7f, 0x25, 0x06, 0xe7, 0xd1, 0xde, 0xe2, 0xdc, 0x56, 0x45, 0x6e, 0xe4, 0x05, 0x23,
+    0x31, 0x81, 0x68, 0xb7, 0x2b, 0xeb, 0x15, 0x1e, 0x1e, 0xb3, 0x0f, 0xe2, 0x7d, 0x89, 0xd2, 0x7b,
+    0x06, 0x8e, 0xfd, 0x30, 0x4d, 0x7d, 0xe9, 0x40, 0x8f, 0x0c, 0x4c, 0xe0, 0xfb, 0x7d, 0x34, 0x30,
+    0x94, 0x24, 0x01, 0x99, 0x70, 0xea, 0xfe, 0x80, 0xe4, 0x08, 0x7c, 0x0f, 0x24, 0xf0, 0xd4, 0x38,
+    0x2d, 0x0f, 0xeb, 0xa4, 0x81, 0x43, 0x6a, 0xaa, 0x51, 0x45, 0xd9, 0x90, 0xd7, 0x95, 0xc9, 0xef,
+    0x24, 0xbb, 0x0c, 0x80, 0x99, 0xd6, 0x88, 0x6b, 0x5c, 0x1a, 0x67, 0x52, 0x23, 0x26, 0x4b, 0xfa,
+    0xc1, 0xcd, 0x1b, 0xe1, 0x36, 0xd4, 0x62, 0x4e, 0x95, 0xf7, 0xba, 0x65, 0xf4, 0x2c, 0x24, 0x00,
+    0xe0, 0xa8, 0x45, 0x95, 0xa0, 0x6c, 0x3d, 0xa5, 0xaf, 0x49, 0xf5, 0xa4, 0xb7, 0xb6, 0x98, 0x0b,
+    0x9d, 0xec, 0xad, 0xfa, 0x98, 0xc5, 0x51, 0x9c, 0x3b, 0xa0, 0xe4, 0xab, 0x20, 0x10, 0x18, 0xce,
+    0xa2, 0x2e, 0xe8, 0x59, 0x48, 0xb1, 0x0a, 0x30, 0xf3, 0x2c, 0xf3, 0x25, 0x25, 0x7c, 0xc9, 0xf2,
+    0x00, 0x9b, 0xc6, 0x55, 0x12, 0x38, 0x05, 0x98, 0x74, 0x67, 0x61, 0xfa, 0x07, 0xf0, 0xb4, 0x0b,
+    0x0e, 0x6a, 0x9f, 0x5a, 0x88, 0x01, 0xae, 0x2d, 0xd8, 0xb3, 0xa5, 0x78, 0x80, 0xc3, 0x34, 0xe3,
+    0x89, 0x0e, 0xf0, 0xd0, 0x06, 0x15, 0xd2, 0x07, 0xd7, 0x04, 0x9a, 0x59, 0x2d, 0x1a, 0x5a, 0x9d,
+    0x79, 0x6f, 0x71, 0x15, 0x58, 0xde, 0x63, 0x98, 0x4e, 0xa0, 0x2e, 0xf8, 0xbf, 0x82, 0x6e, 0xf0,
+    0xf3, 0xa0, 0xfb, 0xf0, 0xc7, 0x50, 0xb3, 0xe1, 0x9e, 0x93, 0xff, 0x7a, 0xdb, 0x98, 0xfb, 0x63,
+    0x01, 0x55, 0x7f, 0xcf, 0x7c, 0xc8, 0x4b, 0x03, 0x18, 0x6d, 0x63, 0xee, 0x21, 0xc8, 0x51, 0x40,
+    0xcf, 0xc2, 0xe3, 0x2d, 0xae, 0xd1, 0xaf, 0x64, 0x45, 0x4f, 0xdb, 0x13, 0x7d, 0xc7, 0xe4, 0xd8,
+    0xff, 0x08, 0x30, 0xa9, 0xa5, 0x75, 0x9c, 0x3a, 0xb0, 0xda, 0x1e, 0xa4, 0x9b, 0xeb, 0x2f, 0x6f,
+    0xe8, 0xb3, 0x61, 0xf0, 0x84, 0xb8, 0x26, 0xde, 0x37, 0x8c, 0x9e, 0xa6, 0xe2, 0x0e, 0xd6, 0x93,
+    0x88, 0x74, 0xdf, 0xcd, 0x55, 0xd0, 0x69, 0x5d, 0xb8, 0xbe, 0x0e, 0x6c, 0xae, 0x12, 0x82, 0xa1,
+    0x2e, 0xc0, 0xa4, 0xa1, 0xb6, 0x57, 0xab, 0x04, 0x53, 0x63, 0x86, 0x94, 0xcb, 0x17, 0x15, 0x6d,
+    0xcf, 0x27, 0x32, 0xfb, 0xba, 0xda, 0xe5, 0x74, 0x08, 0xaa, 0x20, 0xdc, 0xed, 0x10, 0xc6, 0x7d,
+    0xd2, 0x38, 0x8c, 0xb6, 0xfc, 0xab, 0x1d, 0x89, 0x9b, 0xa2, 0x2c, 0x74, 0xe9, 0xd0, 0xf4, 0x86,
+    0xc0, 0x1b, 0xea, 0x58, 0x92, 0xda, 0x25, 0xca, 0x8d, 0x41, 0x3b, 0xc6, 0xb4, 0x37, 0x4a, 0x6b,
+    0x80, 0x95, 0x9e, 0xd6, 0x15, 0xcd, 0xe0, 0x4a, 0x3a, 0x6b, 0x70, 0xa2, 0x3f, 0x64, 0xef, 0x8f,
+    0x20, 0x83, 0xa4, 0x42, 0x85, 0x24, 0xd0, 0x60, 0xd4, 0xd6, 0xab, 0x1c, 0x16, 0x45, 0xf0, 0x81,
+    0xca, 0x37, 0x2c, 0x02, 0x4c, 0x88, 0x42, 0x85, 0xd2, 0xf7, 0x15, 0x2c, 0xf3, 0xef, 0xaf, 0xa7,
+    0x67, 0x61, 0xaf, 0xef, 0xf5, 0x13, 0xe3, 0xe5, 0x4a, 0x3c, 0xdd, 0xb5, 0x8f, 0x80, 0x41, 0x12,
+    0x85, 0xb5, 0x8c, 0x90, 0x35, 0xc8, 0x7e, 0x33, 0x6e, 0x6d, 0x25, 0x0d, 0x8a, 0x8d, 0x72, 0xa3,
+    0xcc, 0xe6, 0x56, 0x99, 0xfd, 0x39, 0xfc, 0xba, 0x02, 0x54, 0x1c, 0x94, 0x7d, 0xc7, 0xcf, 0x24,
+    0x26, 0x9f, 0x21, 0x8c, 0x11, 0xd1, 0x11, 0x5f, 0x88, 0xae, 0xbb, 0xf3, 0x15, 0xdc, 0x31, 0xac,
+    0xba, 0x95, 0xe2, 0x43, 0x55, 0x58, 0x25, 0x35, 0x58, 0xd7, 0x8a, 0x62, 0x3f, 0x81, 0x77, 0x2e,
+    0x70, 0xf5, 0xf6, 0x79, 0x30, 0x8a, 0xd5, 0xa1, 0x45, 0x8d, 0x50, 0xcd, 0xdd, 0x4a, 0xe4, 0xfd,
+    0xfb, 0x25, 0x48, 0xe5, 0x38, 0x66, 0xd0, 0x65, 0x9a, 0xcd, 0xba, 0x4c, 0xb3, 0x65, 0xc7, 0xeb,
+    0xc2, 0x2c, 0xbb, 0x0b, 0x6c, 0x9a, 0xc6, 0x2c, 0x0e, 0xc9, 0x6a, 0xd6, 0x4c, 0x97, 0x93, 0x94,
+    0x39, 0x15, 0xe9, 0x8e, 0x56, 0xf1, 0x3d, 0x0c, 0x78, 0x2c, 0x31, 0x57, 0x34, 0x36, 0x02, 0xff,
+    0xdb, 0xa2, 0x79, 0xeb, 0x98, 0x95, 0xa1, 0x13, 0x7d, 0x1f, 0xf2, 0xa2, 0x45, 0xaf, 0xca, 0xa2,
+    0x3c, 0xca, 0x4d, 0x91, 0x1e, 0xe2, 0x50, 0x07, 0xcd, 0x75, 0x97, 0x9f, 0x75, 0x3c, 0x03, 0x0f,
+    0xcb, 0x6e, 0x14, 0x53, 0xd9, 0x6a, 0xe2, 0x7a, 0x72, 0x00, 0x79, 0x71, 0x90, 0xff, 0x05, 0x02,
+    0x9d, 0x3a, 0x29, 0x52, 0x30, 0x24, 0x43, 0x5e, 0x84, 0x0d, 0xf3, 0xc2, 0x86, 0x2d, 0x40, 0x8b,
+    0x1c, 0x0d, 0x84, 0xa9, 0xee, 0xe3, 0x25, 0x45, 0xda, 0xc9, 0x5f, 0x6b, 0x61, 0x37, 0x41, 0x8e,
+    0x74, 0x61, 0x79, 0x85, 0x42, 0x96, 0x69, 0x68, 0x2d, 0x2e, 0x6e, 0x8e, 0x64, 0x8c, 0x60, 0x98,
+    0x5f, 0xee, 0x6d, 0x65, 0x60, 0xd8, 0xbc, 0xdd, 0x89, 0x8b, 0xb1, 0x9c, 0xf1, 0xc0, 0x9c, 0x0f,
+    0x4e, 0x82, 0x1a, 0x0d, 0xf6, 0x20, 0xf8, 0x22, 0x81, 0x8c, 0x22, 0x4e, 0xab, 0xe7, 0x02, 0xd9,
+    0xe1, 0xb6, 0xbd, 0x03, 0xee, 0xa5, 0x23, 0x4c, 0xfa, 0x89, 0xec, 0x66, 0xde, 0xc2, 0x11, 0x0e,
+    0x74, 0x00, 0xae, 0x37, 0xfc, 0x6e, 0x54, 0xe0, 0xe8, 0x78, 0x19, 0x51, 0x6e, 0xb1, 0x8e, 0x36,
+    0xee, 0x18, 0x40, 0x39, 0x45, 0xea, 0x4a, 0xab, 0x41, 0xf4, 0x02, 0x2a, 0x83, 0x68, 0x73, 0x58,
+    0x76, 0x13, 0xf6, 0xe6, 0xed, 0xd0, 0xaf, 0xaf, 0xcd, 0x84, 0xee, 0xcc, 0x6a, 0xb4, 0x30, 0x35,
+    0x6a, 0xe0, 0xb9, 0x15, 0x36, 0x49, 0xad, 0x92, 0xaf, 0x14, 0xff, 0x01, 0x58, 0x3a, 0xfb, 0x67,
+    0x0c, 0x60, 0xf6, 0x0c, 0xd6, 0x92, 0x71, 0x00, 0x68, 0x24, 0xf0, 0x68, 0x25, 0x81, 0xdf, 0x1a,
+    0x9b, 0x18, 0xc4, 0x18, 0x3d, 0x32, 0xc4, 0xf9, 0x57, 0x81, 0x4a, 0x3a, 0x01, 0x95, 0x51, 0x6f,
+    0x06, 0x07, 0xf1, 0x1d, 0xa8, 0xa2, 0x5a, 0xca, 0x71, 0xa7, 0x6c, 0x35, 0x82, 0x13, 0x26, 0x78,
+    0x59, 0x10, 0x92, 0x89, 0x7c, 0x4d, 0x35, 0xe0, 0x30, 0xca, 0x62, 0xbe, 0x3a, 0xea, 0x33, 0x4c,
+    0x37, 0xf4, 0xfc, 0xb2, 0x21, 0x1c, 0xff, 0x6d, 0xa3, 0xcd, 0x4c, 0x70, 0x5b, 0x53, 0x62, 0x5b,
+    0x3a, 0x0f, 0xab, 0x5d, 0x9e, 0x18, 0x2b, 0xca, 0x33, 0xff, 0xb4, 0x56, 0xc8, 0xd9, 0x45, 0x5c,
+    0xba, 0x23, 0x3d, 0x99, 0xfc, 0xc7, 0x47, 0xc6, 0x66, 0x41, 0x6b, 0xda, 0xdf, 0xe5, 0x46, 0x4f,
+    0x37, 0xf8, 0x1b, 0xee, 0x82, 0xd1, 0x06, 0xfe, 0x58, 0x4e, 0xe9, 0x74, 0xe7, 0xee, 0x28, 0xa5,
+    0xb1, 0xd0, 0xd6, 0x83, 0xd1, 0x6e, 0xf8, 0x85, 0xd1, 0xae, 0x3b, 0x79, 0xbb, 0x35, 0x6a, 0x73,
+    0x62, 0x71, 0x06, 0x07, 0x96, 0x6e, 0x64, 0x4a, 0x49, 0x1f, 0x34, 0x14, 0x2b, 0xc9, 0xc1, 0xc0,
+    0x3d, 0x4b, 0x0d, 0xd9, 0x06, 0x49, 0x77, 0xd5, 0x54, 0x5f, 0xc7, 0x56, 0x2c, 0x99, 0x76, 0x19,
+    0x5a, 0x5c, 0xc9, 0xbe, 0x4d, 0x92, 0xc4, 0x71, 0xb6, 0xd2, 0x54, 0x83, 0x74, 0xc5, 0x30, 0x6b,
+    0x04, 0x9a, 0x7d, 0x0e, 0xc0, 0x2d, 0x02, 0x56, 0x84, 0xae, 0x82, 0x9e, 0xa5, 0xe4, 0xd7, 0x27,
+    0x41, 0x21, 0x17, 0x46, 0x1d, 0x98, 0x10, 0x50, 0x83, 0x2f, 0xa8, 0xfe, 0xdd, 0x00, 0x48, 0x83,
+    0x90, 0xfd, 0x7e, 0xbf, 0xbf, 0x6e, 0x15, 0x71, 0x1b, 0x67, 0x44, 0xf2, 0xe7, 0x76, 0x39, 0x48,
+    0x16, 0x4e, 0x94, 0x3b, 0x55, 0x18, 0x7c, 0xa9, 0x8b, 0x4c, 0x36, 0x0f, 0xa6, 0x20, 0xea, 0xe4,
+    0x6c, 0x84, 0xbe, 0x60, 0xbd, 0x2c, 0xdf, 0x6b, 0x0a, 0xbf, 0x77, 0xa6, 0x47, 0x4e, 0x9d, 0x65,
+    0xca, 0x7d, 0xa3, 0xe7, 0x4c, 0xb9, 0x96, 0x45, 0xa9, 0x2e, 0x71, 0xeb, 0xe8, 0xa8, 0xa0, 0x2d,
+    0x62, 0x8c, 0xb2, 0xde, 0x58, 0xaa, 0xdb, 0xf4, 0x31, 0xfa, 0x2c, 0x90, 0x01, 0xc3, 0x2a, 0xac,
+    0xf4, 0x4e, 0x7e, 0xae, 0x2a, 0x99, 0x3f, 0x57, 0xf6, 0x8e, 0x65, 0xc4, 0xdc, 0x1b, 0x56, 0x31,
+    0x9c, 0xf7, 0x36, 0xb0, 0x56, 0x02, 0x3d, 0xea, 0x3d, 0x23, 0xd5, 0x7b, 0xba, 0x8d, 0xeb, 0xf7,
+    0x6e, 0x68, 0x5c, 0x6f, 0xb4, 0xab, 0xd2, 0x17, 0x26, 0xba, 0xb2, 0x71, 0xbd, 0xd1, 0xae, 0x4e,
+    0x8b, 0xc2, 0xeb, 0x75, 0x7b, 0xa2, 0x35, 0x6c, 0x03, 0xe9, 0xf6, 0x2d, 0xfc, 0x74, 0x3d, 0x51,
+    0x1a, 0x1f, 0x0c, 0x3e, 0x08, 0x46, 0x30, 0x29, 0x5f, 0x73, 0x98, 0x4f, 0x3f, 0x97, 0xb9, 0x78,
+    0x74, 0x86, 0xdd, 0x9c, 0x01, 0x54, 0xca, 0xf8, 0x3a, 0x94, 0x34, 0x30, 0x35, 0x50, 0xd4, 0x6b,
+    0x46, 0xbb, 0xa0, 0xc1, 0xad, 0x40, 0xac, 0x28, 0xdb, 0x33, 0x7b, 0x49, 0x14, 0x14, 0x56, 0x9c,
+    0xff, 0x91, 0xd9, 0x49, 0xe6, 0x1e, 0x58, 0x0e, 0x12, 0xee, 0xd5, 0x59, 0x92, 0x3e, 0xb9, 0x4d,
+    0xc0, 0xc2, 0xf9, 0x15, 0x6c, 0x89, 0xd2, 0xc5, 0xa0, 0x61, 0xc5, 0x9d, 0x17, 0x07, 0x13, 0x23,
+    0xdb, 0xde, 0x6b, 0xdc, 0xdb, 0x10, 0x73, 0x05, 0x7c, 0xd9, 0xbd, 0x9a, 0x36, 0x15, 0x43, 0x27,
+    0x88, 0x89, 0x9c, 0x83, 0xac, 0xf7, 0xf3, 0xe3, 0x90, 0xd2, 0xa1, 0x97, 0xde, 0x88, 0x46, 0x9d,
+    0x85, 0xc1, 0xf4, 0x02, 0xab, 0xf5, 0x77, 0x2d, 0xac, 0x87, 0x83, 0x3f, 0x35, 0x0e, 0x8c, 0x66,
+    0x26, 0x17, 0xf3, 0x38, 0xd5, 0x8d, 0x3e, 0x3a, 0x00, 0x8f, 0x9c, 0x81, 0xe2, 0xa0, 0x90, 0x52,
+    0xac, 0x36, 0x9a, 0x91, 0xae, 0x10, 0x72, 0x00, 0x5d, 0x3f, 0x1c, 0x7e, 0x0f, 0x6b, 0x2b, 0xd9,
+    0xf6, 0xb7, 0x2b, 0xf8, 0xdd, 0x9d, 0xc0, 0xb4, 0x14, 0x4a, 0xa1, 0xfa, 0xb1, 0x86, 0x06, 0xe8,
+    0x1d, 0x11, 0xc1, 0x07, 0x57, 0x9f, 0x0e, 0x8d, 0x76, 0xd3, 0xba, 0xa2, 0x80, 0x8d, 0x40, 0xcc,
+    0x3c, 0xd5, 0x9c, 0x5c, 0x03, 0x96, 0x9c, 0xb6, 0x67, 0x81, 0x0e, 0xe3, 0x90, 0x51, 0xaa, 0x49,
+    0x06, 0x9e, 0xcc, 0xfa, 0xa3, 0x15, 0x92, 0x19, 0x10, 0x99, 0x48, 0x5d, 0x1d, 0x9e, 0xee, 0xd6,
+    0x4e, 0xe6, 0xaa, 0x33, 0x93, 0xa7, 0x72, 0x7f, 0x95, 0x4c, 0x4f, 0x36, 0x91, 0xfb, 0xc7, 0x4c,
+    0x75, 0xfb, 0xe4, 0x4e, 0xbe, 0xd5, 0x48, 0xc2, 0x3b, 0xee, 0x0d, 0x5f, 0x4a, 0xcc, 0x70, 0x58,
+    0xce, 0x4c, 0x08, 0x62, 0x56, 0x76, 0x1a, 0x6e, 0xf5, 0x56, 0xce, 0x61, 0x54, 0x40, 0x81, 0x5e,
+    0xe2, 0x0c, 0xd4, 0xe8, 0xb8, 0xb9, 0x9a, 0xeb, 0x15, 0xa2, 0xee, 0xc1, 0x37, 0x5f, 0xfa, 0xd7,
+    0x3c, 0x5f, 0xbb, 0xa6, 0xc6, 0xd5, 0x36, 0xbd, 0x5e, 0x7f, 0x39, 0xa1, 0x1a, 0x43, 0xef, 0xc5,
+    0x08, 0x47, 0x79, 0xe2, 0xb0, 0xe9, 0xd5, 0xe7, 0x22, 0xa6, 0x63, 0xc9, 0xaf, 0x29, 0x9c, 0x06,
+    0x7e, 0x6d, 0xa2, 0xaf, 0xc6, 0xad, 0xd3, 0xbe, 0x6c, 0xd9, 0xf4, 0x44, 0x37, 0x4f, 0xee, 0xc3,
+    0xec, 0xc6, 0x74, 0xda, 0x71, 0x62, 0x0b, 0xa6, 0x58, 0x13, 0xed, 0x79, 0xe0, 0x6b, 0x85, 0x84,
+    0xcd, 0x41, 0xde, 0x2d, 0xc0, 0x38, 0xa3, 0x1f, 0xc3, 0xad, 0x0f, 0x06, 0xbb, 0x82, 0x50, 0xf9,
+    0xcb, 0x99, 0x21, 0xaa, 0xc9, 0xe3, 0x08, 0xa7, 0xa7, 0xd1, 0xf5, 0x54, 0x6c, 0xc1, 0x8d, 0x49,
+    0xa3, 0xca, 0x79, 0xaf, 0x58, 0x20, 0x75, 0x9a, 0x8a, 0x34, 0x69, 0x59, 0x0c, 0x9a, 0x96, 0x7e,
+    0x14, 0xaf, 0xb8, 0xae, 0x11, 0x19, 0xc2, 0x72, 0xba, 0x89, 0xda, 0x16, 0x77, 0x1c, 0x73, 0x77,
+    0x0a, 0x39, 0xbd, 0xdd, 0x6a, 0x50, 0xee, 0xcd, 0x15, 0x9d, 0xef, 0x59, 0xac, 0x59, 0xb6, 0xac,
+    0xdb, 0x2b, 0x13, 0xb7, 0x11, 0x3c, 0x18, 0xf1, 0x10, 0x39, 0xef, 0xcc, 0xac, 0x76, 0x45, 0xc2,
+    0xb1, 0xe9, 0x63, 0x04, 0x7d, 0x86, 0xe6, 0x2f, 0xa6, 0x28, 0xeb, 0xe3, 0xb8, 0x79, 0x87, 0xc7,
+    0xdf, 0x8f, 0x8b, 0x5d, 0xf2, 0x66, 0xbf, 0x1e, 0xa0, 0xd3, 0x51, 0xba, 0xdd, 0xac, 0x99, 0x07,
+    0x23, 0x5e, 0x38, 0x43, 0xd8, 0xe5, 0x19, 0xa4, 0x93, 0xfe, 0x97, 0xed, 0xbe, 0x4d, 0x2a, 0x73,
+    0x9f, 0xaf, 0x99, 0xfa, 0x61, 0x3f, 0x09, 0x16, 0xdf, 0xba, 0x58, 0xaa, 0xb3, 0x0f, 0x13, 0xa7,
+    0xb3, 0xc2, 0xd8, 0x18, 0xbc, 0x45, 0xc6, 0x47, 0x1f, 0xbd, 0x69, 0xca, 0x7c, 0x29, 0xcf, 0xf5,
+    0x7f, 0xc6, 0xef, 0x9c, 0xa3, 0x1e, 0x26, 0x00, 0x00,
+};
+
+static const uint8_t asset_update_min_html[959] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x56, 0xc1, 0x6e, 0xdb, 0x38,
+    0x10, 0xfd, 0x15, 0xae, 0x83, 0x00, 0x2d, 0x10, 0x59, 0x96, 0x62, 0x67, 0x53, 0x99, 0x14, 0x90,
+    0x6e, 0xb1, 0xd7, 0x1e, 0x9a, 0x7e, 0x00, 0x45, 0x8e, 0x2c, 0xc6, 0x34, 0x49, 0x90, 0x23, 0xdb,
+    0xea, 0xd7, 0x2f, 0x28, 0xca, 0x89, 0xed, 0x26, 0xe8, 0x71, 0x2f, 0x94, 0x34, 0x43, 0x3e, 0xce,
+    0x1b, 0xbe, 0x19, 0x8a, 0xfe, 0x25, 0xad, 0xc0, 0xc1, 0x01, 0xe9, 0x70, 0xa7, 0x6b, 0x3a, 0x8d,
+    0xc0, 0x65, 0x4d, 0x77, 0x80, 0x9c, 0x18, 0xbe, 0x03, 0xb6, 0x57, 0x70, 0x70, 0xd6, 0x23, 0x11,
+    0xd6, 0x20, 0x18, 0x64, 0xb3, 0x83, 0x92, 0xd8, 0x31, 0x09, 0x7b, 0x25, 0x20, 0x1b, 0x3f, 0xee,
+    0x94, 0x51, 0xa8, 0xb8, 0xce, 0x82, 0xe0, 0x1a, 0x58, 0x31, 0xab, 0x29, 0x2a, 0xd4, 0x50, 0x7f,
+    0x7f, 0x7e, 0x22, 0x3f, 0x9d, 0xe4, 0x08, 0x34, 0x4f, 0x16, 0xaa, 0x95, 0xd9, 0x12, 0x0f, 0x9a,
+    0x05, 0x1c, 0x34, 0x84, 0x0e, 0x00, 0x49, 0xe7, 0xa1, 0x4d, 0xdf, 0xf3, 0x9d, 0x32, 0x73, 0x11,
+    0x42, 0x4d, 0xf3, 0x14, 0x48, 0x63, 0xe5, 0x50, 0x53, 0xa9, 0xf6, 0x44, 0x68, 0x1e, 0x02, 0x8b,
+    0x51, 0x70, 0x65, 0xc0, 0x9f, 0x1b, 0x0d, 0xdf, 0xd7, 0x94, 0x27, 0x98, 0xfc, 0xcd, 0x96, 0xc5,
+    0xbd, 0x6a, 0x1a, 0xf6, 0x1b, 0x12, 0x59, 0x7c, 0xb5, 0x47, 0x36, 0x5b, 0x90, 0x05, 0x29, 0x97,
+    0xa4, 0x5c, 0xce, 0x48, 0xe2, 0x51, 0x3c, 0x90, 0x0e, 0xd4, 0xa6, 0xc3, 0xf8, 0xd6, 0x2a, 0xad,
+    0x99, 0xb1, 0x06, 0x48, 0x40, 0x6f, 0xb7, 0xc0, 0x44, 0xef, 0x3d, 0x18, 0xfc, 0xc7, 0x6a, 0xeb,
+    0x27, 0x5b, 0xa2, 0xcc, 0xca, 0xf9, 0xea, 0x64, 0xd0, 0xca, 0x80, 0xe0, 0x8e, 0x79, 0xdb, 0x1b,
+    0x79, 0x6e, 0x7c, 0xb1, 0xca, 0xbc, 0x5a, 0x07, 0x0d, 0x6c, 0x0f, 0x1e, 0x95, 0xe0, 0x3a, 0xe3,
+    0x5a, 0x6d, 0x4c, 0xb5, 0x53, 0x52, 0x6a, 0x58, 0xef, 0xb8, 0xdf, 0x28, 0x93, 0xf9, 0x18, 0x45,
+    0xb5, 0x74, 0xc7, 0x31, 0x49, 0x40, 0x8e, 0x05, 0x2b, 0xbe, 0x90, 0xa1, 0x60, 0x45, 0x49, 0x8e,
+    0x25, 0x5b, 0x91, 0xa1, 0x64, 0x45, 0x59, 0xd3, 0x3c, 0x7a, 0x6b, 0xea, 0xac, 0x1e, 0xc6, 0x79,
+    0xce, 0x2a, 0x83, 0x81, 0xcd, 0x8a, 0x92, 0x14, 0x5f, 0xc8, 0x8a, 0xc4, 0x67, 0x49, 0x56, 0xb3,
+    0x9a, 0xe6, 0xa7, 0x39, 0x35, 0xcd, 0xc3, 0x7e, 0x53, 0x93, 0xaf, 0x5c, 0x6c, 0x09, 0x5a, 0xf2,
+    0x8d, 0x87, 0xae, 0xb1, 0xdc, 0x4b, 0x9a, 0xf3, 0x9a, 0xe6, 0x52, 0xed, 0x6b, 0xda, 0x15, 0x17,
+    0xc7, 0xd5, 0x15, 0x17, 0x69, 0xe7, 0x5e, 0xd6, 0xb4, 0xbb, 0x9f, 0x78, 0x88, 0x98, 0x8f, 0xea,
+    0xa6, 0x59, 0x34, 0x20, 0x56, 0xeb, 0xd6, 0x1a, 0xcc, 0x82, 0xfa, 0x05, 0x55, 0x59, 0xba, 0xe3,
+    0x89, 0x4e, 0x63, 0x11, 0xed, 0xae, 0x2a, 0x17, 0xee, 0x58, 0x27, 0x50, 0xf2, 0x6d, 0xd4, 0x0c,
+    0xcd, 0xbb, 0xfb, 0x9a, 0xba, 0x3f, 0x40, 0x15, 0xcb, 0xf7, 0xa1, 0x7e, 0x80, 0x06, 0x81, 0x04,
+    0x3b, 0x20, 0x8d, 0x32, 0xdc, 0x0f, 0xf1, 0xd0, 0x20, 0x92, 0xea, 0x9d, 0xb6, 0x5c, 0xce, 0xc9,
+    0x53, 0x8b, 0xe0, 0x09, 0x27, 0xa1, 0x17, 0x02, 0x42, 0x68, 0x7b, 0x3d, 0xb9, 0xee, 0xc6, 0x55,
+    0x49, 0xb8, 0xe4, 0xa0, 0xb4, 0x26, 0x1e, 0x1a, 0x6b, 0x91, 0xf0, 0x1e, 0xed, 0x8e, 0x8f, 0x27,
+    0xa3, 0x87, 0x39, 0xcd, 0xdd, 0x39, 0xf5, 0x80, 0xe0, 0x32, 0x65, 0x5a, 0x3b, 0x05, 0xfc, 0x4e,
+    0x4c, 0x54, 0xf3, 0x06, 0xf4, 0x25, 0x21, 0x10, 0xd0, 0xb6, 0xc5, 0x5a, 0xaa, 0xe0, 0x34, 0x1f,
+    0xaa, 0x46, 0x5b, 0xb1, 0xbd, 0xe2, 0xf3, 0xf8, 0x96, 0x99, 0xe7, 0xc1, 0x41, 0x45, 0xf3, 0x11,
+    0x27, 0x6d, 0x9e, 0xc0, 0x4e, 0xcb, 0x5b, 0x0d, 0xc7, 0xf5, 0x86, 0xbb, 0x8f, 0xf7, 0x9b, 0x12,
+    0x28, 0x7a, 0x1f, 0xac, 0xaf, 0x46, 0x4d, 0x80, 0x5f, 0x5f, 0xac, 0x1f, 0x45, 0x97, 0x29, 0x84,
+    0x5d, 0xa8, 0x04, 0x8c, 0xfe, 0x08, 0x19, 0xc3, 0xa0, 0xca, 0xb8, 0x1e, 0x49, 0xec, 0x06, 0xcc,
+    0x73, 0xa9, 0x6c, 0x2a, 0xfe, 0x7e, 0x8c, 0x2e, 0x1b, 0x9b, 0xc4, 0x9e, 0xeb, 0x1e, 0x58, 0xab,
+    0xfc, 0xee, 0xc0, 0x3d, 0x10, 0xd1, 0x81, 0xd8, 0x82, 0x64, 0xd3, 0xb3, 0x26, 0xff, 0x9e, 0x3c,
+    0x9f, 0xe6, 0x8d, 0x32, 0x77, 0x24, 0x8e, 0xf3, 0xcd, 0xaf, 0xcf, 0x27, 0x56, 0xe4, 0x7f, 0x8c,
+    0x3a, 0x38, 0xd5, 0xb6, 0x21, 0xc6, 0xa8, 0x21, 0x0c, 0x01, 0x61, 0xf7, 0x51, 0x94, 0x53, 0x31,
+    0xa4, 0xf1, 0x0c, 0x7e, 0x14, 0x99, 0x92, 0xcc, 0x22, 0xcf, 0xc6, 0xf7, 0x44, 0x63, 0xf6, 0xbb,
+    0x1a, 0xd6, 0x8d, 0xf5, 0x12, 0x7c, 0x55, 0xb8, 0x23, 0x91, 0x3c, 0x74, 0x20, 0xc9, 0xcd, 0x6a,
+    0xf9, 0x00, 0x7f, 0xf3, 0xb5, 0xe3, 0x52, 0x2a, 0xb3, 0x49, 0xd3, 0xc6, 0x36, 0x52, 0x15, 0x8b,
+    0xc5, 0xed, 0xb4, 0x22, 0x8b, 0x14, 0xfa, 0x50, 0x15, 0xd1, 0x7b, 0x95, 0x91, 0x0b, 0x51, 0xcd,
+    0x92, 0x42, 0xa6, 0x68, 0x9c, 0xb7, 0x1b, 0x0f, 0x21, 0x64, 0xaf, 0xad, 0xf1, 0x4a, 0x3b, 0xb1,
+    0x9f, 0xbd, 0x57, 0x49, 0x1f, 0xc9, 0xec, 0xa5, 0x0f, 0xa8, 0xda, 0x21, 0x9b, 0x1a, 0x7e, 0x15,
+    0x1c, 0x17, 0x90, 0x35, 0x80, 0x07, 0x00, 0x73, 0x05, 0xb4, 0x8a, 0x38, 0xc1, 0x71, 0xf3, 0xae,
+    0xf8, 0x2f, 0xab, 0xb9, 0xfe, 0x39, 0x56, 0xa1, 0x32, 0x9b, 0xf9, 0x7c, 0x4e, 0xf3, 0xb8, 0xaa,
+    0x26, 0x69, 0xf1, 0x89, 0x0a, 0xf8, 0x78, 0xc2, 0x97, 0x58, 0x8f, 0x85, 0x5c, 0xb6, 0xfc, 0x1a,
+    0x6b, 0x71, 0x3b, 0x21, 0x4c, 0x47, 0xf5, 0xc6, 0xa5, 0xe1, 0x62, 0xbb, 0x19, 0x9b, 0x6e, 0x75,
+    0x53, 0x3e, 0xdc, 0x97, 0xf7, 0x8f, 0xeb, 0xd4, 0xe0, 0x53, 0x62, 0x2f, 0x73, 0xbd, 0x72, 0xc7,
+    0xb5, 0xdd, 0x83, 0x6f, 0xb5, 0x3d, 0x54, 0x9d, 0x92, 0x12, 0xcc, 0xfb, 0xc9, 0x6d, 0xf8, 0x29,
+    0xad, 0xb3, 0xf3, 0x0d, 0x16, 0xe5, 0xe3, 0xa3, 0x2c, 0xa6, 0xb3, 0x5c, 0xdc, 0xbe, 0xed, 0xb4,
+    0xb8, 0x5d, 0xa3, 0xe7, 0x26, 0x28, 0x54, 0xd6, 0x54, 0xa3, 0x9f, 0xcc, 0xef, 0xc3, 0xec, 0x52,
+    0x60, 0x69, 0x6c, 0x7a, 0x44, 0xfb, 0x9a, 0x84, 0x06, 0xcd, 0xd4, 0x79, 0x1a, 0x34, 0x99, 0x35,
+    0xc4, 0x1a, 0xa1, 0x95, 0xd8, 0xb2, 0x80, 0xdc, 0xe3, 0xf7, 0xe7, 0xa7, 0x4f, 0x9f, 0xa7, 0x48,
+    0xde, 0x14, 0x54, 0xff, 0x88, 0xbe, 0xd7, 0xde, 0x9d, 0x00, 0x2f, 0x37, 0x99, 0x48, 0xa1, 0xe5,
+    0x01, 0xb3, 0xb3, 0x5b, 0x34, 0x79, 0x83, 0xf0, 0xca, 0x21, 0x09, 0x5e, 0xb0, 0x0e, 0xb4, 0x03,
+    0x1f, 0xc6, 0x9b, 0xf8, 0x25, 0x5e, 0xc4, 0xc9, 0x77, 0x31, 0x27, 0x55, 0xd8, 0xef, 0x53, 0xf2,
+    0x74, 0x5d, 0xe7, 0xe3, 0xaf, 0xc4, 0x7f, 0x49, 0x60, 0x9e, 0xef, 0x60, 0x08, 0x00, 0x00,
+};
+
+static const uint8_t asset_update_min_js[1928] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x56, 0xfd, 0x73, 0xdb, 0x36,
+    0x12, 0xfd, 0x57, 0x18, 0xce, 0x9d, 0x4b, 0x54, 0x6b, 0x06, 0x58, 0x7c, 0x47, 0xa6, 0x33, 0x49,
+    0x9b, 0x99, 0xdc, 0x5c, 0x3b, 0xed, 0xd4, 0xee, 0x4d, 0x67, 0x3c, 0xca, 0x95, 0x26, 0x21, 0x89,
+    0x2d, 0x0d, 0xa8, 0x24, 0x18, 0xc7, 0xe7, 0xe8, 0xfe, 0xf6, 0x1b, 0xe8, 0xc3, 0x71, 0x3e, 0xa6,
+    0x77, 0xf7, 0x8b, 0x08, 0x4a, 0xbb, 0x8b, 0x87, 0xb7, 0xfb, 0x1e, 0xd4, 0x04, 0x3f, 0xc6, 0xec,
+    0xe2, 0xf5, 0x0b, 0x94, 0xea, 0x9f, 0x7f, 0xaf, 0xae, 0x18, 0x63, 0x8a, 0x4b, 0x14, 0xd4, 0x00,
+    0x33, 0xd6, 0x0a, 0xa1, 0x85, 0x60, 0xc0, 0xa9, 0xb0, 0x1c, 0xb9, 0xd0, 0x0c, 0xb8, 0x45, 0x46,
+    0xa9, 0x95, 0x9a, 0x83, 0x55, 0xcc, 0x1a, 0xcd, 0x14, 0x07, 0x26, 0xa9, 0xb1, 0x9a, 0x5a, 0xcb,
+    0x01, 0x85, 0xe4, 0x8a, 0x4b, 0x2d, 0x0c, 0xa0, 0xd1, 0x54, 0x2b, 0x8e, 0xc8, 0x80, 0x2b, 0x14,
+    0xdc, 0x30, 0x6a, 0x28, 0x70, 0x46, 0xa5, 0x35, 0x82, 0x32, 0x50, 0x54, 0x23, 0x4a, 0xd4, 0x06,
+    0x98, 0x40, 0x65, 0x4c, 0xaa, 0x06, 0xcc, 0xa2, 0xa4, 0xda, 0x70, 0x63, 0x00, 0x99, 0x42, 0xaa,
+    0x0d, 0x52, 0x05, 0xa8, 0x98, 0x30, 0xc6, 0x30, 0xca, 0x81, 0xa3, 0x30, 0x88, 0x28, 0x53, 0x29,
+    0xc3, 0x25, 0xb7, 0x34, 0xd5, 0x12, 0x14, 0x11, 0x51, 0x68, 0x2d, 0x00, 0x95, 0xe0, 0x42, 0x53,
+    0x6d, 0x40, 0x51, 0x61, 0xa8, 0x56, 0x68, 0x40, 0x6b, 0x8a, 0x52, 0x5a, 0xc3, 0x81, 0xa1, 0xb0,
+    0x4c, 0x52, 0x86, 0x08, 0x4c, 0x4a, 0x49, 0x0d, 0x53, 0x16, 0x81, 0x59, 0xab, 0xa8, 0x12, 0xd6,
+    0x28, 0x40, 0x29, 0x05, 0x22, 0x35, 0x06, 0x01, 0x0d, 0x32, 0xc3, 0x05, 0x17, 0x16, 0xd0, 0x4a,
+    0xb4, 0x56, 0x19, 0x6a, 0x80, 0x23, 0xa3, 0x9c, 0x71, 0x95, 0xc8, 0xe0, 0x5c, 0x49, 0xcd, 0x8c,
+    0x65, 0xc0, 0xa5, 0x11, 0x12, 0x8d, 0x66, 0x0c, 0x18, 0xe3, 0x16, 0x55, 0x22, 0x83, 0x73, 0x83,
+    0x82, 0x19, 0x2b, 0x41, 0x29, 0xc5, 0xa9, 0x46, 0x2a, 0x41, 0x6b, 0x9e, 0x4a, 0x31, 0x04, 0x86,
+    0x56, 0x68, 0xa9, 0xb9, 0x46, 0x60, 0xdc, 0x2a, 0x66, 0x10, 0x2d, 0x03, 0xa6, 0xac, 0x64, 0x86,
+    0x6b, 0x4a, 0x81, 0x59, 0xa3, 0x94, 0x62, 0x54, 0x32, 0x40, 0x96, 0x8e, 0xa0, 0xb8, 0xa4, 0x89,
+    0x61, 0x65, 0xa5, 0xa2, 0x5c, 0x03, 0x6a, 0x4e, 0x85, 0x91, 0x16, 0x59, 0xc2, 0x4a, 0x39, 0x45,
+    0xc1, 0x18, 0x70, 0x94, 0x56, 0x73, 0x6a, 0x28, 0x05, 0xce, 0x85, 0xd4, 0x4a, 0xe8, 0x84, 0x55,
+    0x32, 0x45, 0x95, 0x34, 0x4c, 0x03, 0x57, 0x94, 0x72, 0x89, 0x86, 0x0a, 0x10, 0xd4, 0x0a, 0xa9,
+    0x99, 0xa5, 0x16, 0x50, 0x4b, 0x81, 0x9c, 0x0b, 0x01, 0x82, 0x53, 0x44, 0xad, 0xb9, 0x00, 0x49,
+    0x95, 0x15, 0x46, 0x31, 0x05, 0x4a, 0x5a, 0xaa, 0xa8, 0x94, 0x0a, 0x8c, 0xe1, 0xd6, 0x6a, 0xa3,
+    0x35, 0x58, 0x69, 0x18, 0xb7, 0x52, 0x33, 0x60, 0x1c, 0x31, 0x75, 0x85, 0x19, 0x60, 0x32, 0x61,
+    0x47, 0x9a, 0xc6, 0x42, 0x0b, 0x6d, 0x34, 0xd7, 0xda, 0x02, 0xb3, 0x52, 0x4a, 0x95, 0x7a, 0x04,
+    0x98, 0x50, 0x52, 0x61, 0x98, 0x04, 0xdc, 0x6d, 0x43, 0x85, 0x44, 0x40, 0xae, 0x98, 0x91, 0x28,
+    0x50, 0x00, 0x0a, 0x34, 0x82, 0x2b, 0x91, 0x7a, 0xa9, 0xa5, 0xd2, 0x5c, 0x30, 0xa3, 0x81, 0x23,
+    0x15, 0x94, 0x33, 0xa1, 0x2d, 0x70, 0x8e, 0x96, 0xa3, 0x44, 0x6b, 0x16, 0xf3, 0x7a, 0xbc, 0xf3,
+    0x4d, 0xb6, 0x9c, 0x7c, 0x13, 0xbb, 0xe0, 0xb3, 0x71, 0x5d, 0xa3, 0x54, 0xaf, 0xdd, 0xbb, 0xc2,
+    0x91, 0xfb, 0x66, 0x37, 0xdc, 0xb1, 0x72, 0xd5, 0xf9, 0x8b, 0x61, 0xa8, 0xef, 0xca, 0xe5, 0x10,
+    0x6e, 0x0a, 0x07, 0xae, 0x3a, 0x2f, 0xdc, 0xf9, 0xf9, 0x39, 0x25, 0x65, 0x0c, 0x17, 0x71, 0xe8,
+    0xfc, 0xaa, 0x60, 0x8a, 0x94, 0x9b, 0xba, 0xbd, 0x88, 0xf5, 0x10, 0x0b, 0x03, 0x39, 0xcd, 0x09,
+    0x29, 0x7f, 0x0b, 0x9d, 0x2f, 0xf2, 0x9c, 0xcc, 0xbb, 0x65, 0x71, 0xdb, 0xf9, 0x36, 0xdc, 0x96,
+    0xcd, 0x70, 0xb7, 0x89, 0xe1, 0xe4, 0x64, 0xff, 0x2c, 0xc7, 0xe9, 0x3a, 0xf6, 0x0f, 0x5b, 0xf9,
+    0xca, 0xbb, 0xdb, 0xec, 0xdb, 0x3a, 0xd6, 0xff, 0xe8, 0xdc, 0x6d, 0x51, 0xdf, 0xd6, 0x5d, 0xcc,
+    0x3e, 0x8a, 0x2c, 0xdb, 0x6e, 0xe5, 0xc6, 0x58, 0xe4, 0x17, 0xaf, 0x5f, 0x9c, 0xa2, 0x54, 0x39,
+    0x38, 0x42, 0xe6, 0x83, 0x8b, 0xd3, 0xe0, 0xb3, 0x58, 0x3c, 0x82, 0x79, 0xdf, 0x3b, 0xbf, 0x8a,
+    0xeb, 0x67, 0x66, 0x0b, 0x85, 0x83, 0x48, 0xaa, 0x73, 0x5f, 0xae, 0x5c, 0xfc, 0xb9, 0xf3, 0x91,
+    0x63, 0x21, 0xbe, 0x8e, 0x84, 0x90, 0xed, 0x71, 0x5b, 0x57, 0x5e, 0xdf, 0x45, 0xf7, 0xdd, 0x2e,
+    0x03, 0xc2, 0x0e, 0x45, 0x0a, 0x34, 0xbb, 0x7a, 0x85, 0x9f, 0x69, 0x3c, 0x3f, 0x57, 0x67, 0x67,
+    0x8a, 0xcc, 0x43, 0x39, 0xba, 0x58, 0x7c, 0x12, 0xe0, 0x08, 0x81, 0x70, 0xe5, 0x17, 0x15, 0x43,
+    0x33, 0xdf, 0xd7, 0x1c, 0x3e, 0x3e, 0x4a, 0x28, 0xaf, 0xa7, 0xe5, 0xd2, 0x0d, 0x64, 0x3e, 0xa4,
+    0x02, 0x07, 0x14, 0xa1, 0xdc, 0x83, 0x3c, 0x35, 0xf0, 0x7d, 0x1d, 0xd7, 0xe5, 0xb2, 0x0f, 0x61,
+    0x28, 0xfc, 0x53, 0xc9, 0x95, 0xd1, 0xd4, 0x32, 0x24, 0x04, 0xbe, 0x18, 0x2f, 0xc0, 0x9f, 0x9d,
+    0xf1, 0x5d, 0x0b, 0x0e, 0xfb, 0x8d, 0xd5, 0xe1, 0x94, 0xa9, 0x31, 0xf1, 0xbd, 0x3b, 0x3b, 0xe3,
+    0x78, 0x1a, 0xa1, 0xae, 0xae, 0x98, 0xd6, 0x96, 0x72, 0xae, 0x93, 0xf6, 0x99, 0x10, 0x8c, 0x0b,
+    0xd4, 0x1a, 0x18, 0x65, 0x49, 0xfa, 0x28, 0x10, 0x76, 0xa3, 0xba, 0x13, 0x3a, 0x30, 0x2e, 0xad,
+    0xb1, 0x9c, 0x31, 0x0b, 0xa8, 0x28, 0x4d, 0x8a, 0x42, 0x01, 0x49, 0x97, 0x5c, 0x28, 0x2e, 0x81,
+    0x49, 0xc1, 0x84, 0xb4, 0x88, 0x72, 0x01, 0xfd, 0x03, 0x4d, 0x1c, 0xf7, 0x34, 0x28, 0x41, 0xe6,
+    0xcb, 0x30, 0x14, 0xbd, 0x8b, 0x99, 0xab, 0xe8, 0xdc, 0x9d, 0x1d, 0x01, 0xcf, 0xdd, 0xac, 0x52,
+    0x82, 0xdc, 0x1f, 0x7f, 0x8d, 0x15, 0x9d, 0xc7, 0x33, 0xa6, 0xe6, 0x71, 0x36, 0x23, 0xfd, 0x55,
+    0x5c, 0x54, 0xc3, 0xa3, 0xe6, 0xb8, 0x59, 0x6a, 0xcf, 0xa3, 0x52, 0x4c, 0xcd, 0xdd, 0x99, 0x12,
+    0x73, 0x37, 0x9b, 0x7d, 0x98, 0xca, 0xb1, 0xe8, 0xaf, 0xdc, 0x29, 0x93, 0x0b, 0xd0, 0xe4, 0xcd,
+    0x87, 0x17, 0x66, 0xc8, 0x9b, 0xc3, 0xfa, 0xfc, 0xfc, 0x9c, 0x83, 0x3f, 0x04, 0xe2, 0x02, 0xd8,
+    0x43, 0x60, 0x7a, 0xb1, 0xfb, 0x38, 0x4c, 0x61, 0x8c, 0xce, 0xfb, 0x2b, 0xb7, 0xa8, 0x76, 0x89,
+    0x6a, 0x31, 0x8b, 0xb3, 0xb4, 0xd2, 0x8b, 0x99, 0xdf, 0xf6, 0x2e, 0x5e, 0x45, 0xf0, 0xd0, 0x40,
+    0x07, 0x2d, 0xac, 0x61, 0x82, 0xe5, 0xa2, 0xaa, 0x3f, 0x39, 0xe7, 0xc7, 0xd8, 0x42, 0xb5, 0x9c,
+    0x15, 0x63, 0xd1, 0x82, 0x4a, 0xfb, 0xb5, 0xc0, 0xd8, 0xfe, 0x89, 0x92, 0x90, 0x59, 0xd1, 0x9e,
+    0xac, 0xdf, 0xfc, 0xbb, 0x3d, 0x99, 0xc8, 0xec, 0x78, 0x6d, 0x5c, 0xb9, 0x45, 0xda, 0x6f, 0xf1,
+    0x9e, 0xc2, 0x50, 0x15, 0x63, 0x11, 0x01, 0x53, 0x42, 0x04, 0xc6, 0xf7, 0x4f, 0xc4, 0x94, 0x18,
+    0x4f, 0xfc, 0x9b, 0x78, 0xd2, 0xbc, 0xf1, 0x27, 0x0d, 0x79, 0x4f, 0xe7, 0xcb, 0x6a, 0x82, 0xa9,
+    0x5a, 0xc3, 0xba, 0x6a, 0xa1, 0xad, 0xba, 0x59, 0x78, 0x4f, 0xa1, 0xab, 0x1a, 0x68, 0x2a, 0x0f,
+    0xbe, 0x8a, 0x10, 0xab, 0x30, 0x1b, 0xde, 0xd3, 0xed, 0x67, 0xe8, 0xcb, 0x65, 0x18, 0x5e, 0xd5,
+    0xcd, 0xba, 0x38, 0x4c, 0xcc, 0x7d, 0x9d, 0x1a, 0x90, 0x3e, 0x66, 0xee, 0x3d, 0xdd, 0x92, 0xed,
+    0x83, 0x9c, 0x6a, 0xb2, 0xfd, 0xc4, 0x1f, 0xba, 0x9b, 0x7a, 0xe5, 0xbe, 0xdd, 0x6b, 0x30, 0x65,
+    0xdf, 0x77, 0xcb, 0xe2, 0x49, 0x24, 0x87, 0x8c, 0xc7, 0xee, 0x91, 0x34, 0xff, 0xe4, 0x20, 0xfa,
+    0x6f, 0x5d, 0x13, 0x6e, 0x36, 0x83, 0x1b, 0xc7, 0x2e, 0xf8, 0x8b, 0x38, 0xb8, 0xfa, 0xe6, 0x98,
+    0xe2, 0xa7, 0xbe, 0x9f, 0x1f, 0x69, 0x4b, 0x03, 0xf5, 0xb2, 0x0f, 0xd7, 0xc5, 0x95, 0x5b, 0x90,
+    0x72, 0xdc, 0x05, 0x16, 0xa4, 0xdc, 0x74, 0x1b, 0x77, 0xb9, 0x1e, 0xc2, 0xb4, 0x5a, 0xef, 0x94,
+    0xf7, 0x85, 0x72, 0x45, 0xbe, 0xfa, 0x57, 0xb7, 0xc9, 0x3f, 0x78, 0xc1, 0x07, 0x28, 0x7b, 0x17,
+    0x49, 0x79, 0x3f, 0xb9, 0x71, 0x13, 0xfc, 0xe8, 0x8a, 0x40, 0xca, 0x3a, 0x4d, 0xec, 0xcb, 0x9d,
+    0x26, 0x0b, 0xf2, 0xd9, 0x31, 0xc7, 0x64, 0x63, 0x3f, 0x5c, 0xbe, 0x28, 0x8e, 0x2d, 0x75, 0x55,
+    0x1b, 0x9a, 0xe9, 0xc6, 0xf9, 0x98, 0xe6, 0xf4, 0x55, 0xef, 0xd2, 0xf2, 0xe5, 0xdd, 0xdf, 0xda,
+    0x22, 0x0f, 0xb1, 0x3e, 0x5d, 0x76, 0xbd, 0xcb, 0x09, 0xc4, 0x0f, 0x51, 0x7f, 0x4c, 0x6e, 0xb8,
+    0xbb, 0x70, 0xbd, 0x6b, 0x62, 0x18, 0x8a, 0xaf, 0x3a, 0xbf, 0x99, 0xe2, 0x95, 0xaf, 0x6f, 0x5c,
+    0x95, 0x4f, 0x9b, 0xb6, 0x8e, 0xee, 0x34, 0xde, 0x6d, 0x5c, 0xbe, 0x78, 0xd6, 0xac, 0x5d, 0xf3,
+    0xbb, 0x6b, 0xbf, 0x22, 0x10, 0xfe, 0x7c, 0x8f, 0xeb, 0xe8, 0x73, 0x02, 0xe3, 0x9f, 0x07, 0x6d,
+    0x86, 0xb0, 0x4a, 0xc4, 0x9c, 0x5e, 0xd7, 0x43, 0x4e, 0xc0, 0xff, 0x97, 0x68, 0x37, 0x34, 0xce,
+    0xc7, 0x9c, 0x40, 0xfd, 0x3f, 0x96, 0x6d, 0x82, 0x8f, 0x75, 0xe7, 0xdd, 0xb0, 0x37, 0x75, 0x5a,
+    0x55, 0x95, 0x2b, 0xd3, 0xe9, 0xc7, 0x83, 0xd2, 0x8f, 0x7d, 0x7d, 0x1b, 0xba, 0x36, 0x1b, 0xd7,
+    0xe1, 0xf6, 0x32, 0xd4, 0xc9, 0xaf, 0x7f, 0xec, 0x5d, 0x3d, 0xba, 0x6c, 0xdc, 0x31, 0x92, 0xd5,
+    0x59, 0xca, 0xc9, 0x96, 0xdd, 0x30, 0xc6, 0x32, 0x3f, 0x7a, 0x58, 0x7b, 0xac, 0x75, 0x45, 0x93,
+    0xbd, 0xc4, 0xf2, 0x6d, 0xdd, 0x4f, 0x6e, 0x37, 0x48, 0x4d, 0xf0, 0xcb, 0x6e, 0xb8, 0x29, 0x7e,
+    0x7d, 0x31, 0xb8, 0xec, 0x2e, 0x4c, 0xd9, 0x38, 0x1d, 0x16, 0xb7, 0xb5, 0x8f, 0x59, 0x0c, 0xd9,
+    0xb2, 0xaf, 0xc7, 0x75, 0x16, 0xd7, 0xdd, 0x98, 0xfd, 0xe5, 0xbe, 0xdf, 0x66, 0x7b, 0x96, 0x9f,
+    0x67, 0x97, 0x6b, 0x97, 0xb5, 0xee, 0x6d, 0xd7, 0xb8, 0xec, 0xb6, 0xeb, 0xfb, 0x6c, 0x70, 0xd7,
+    0x21, 0xc4, 0xf2, 0x57, 0x72, 0x40, 0x3a, 0x0f, 0x65, 0xdb, 0x8d, 0xf5, 0x75, 0xef, 0xda, 0xea,
+    0x09, 0x85, 0x50, 0x36, 0x7d, 0x3d, 0x8e, 0xdf, 0x75, 0x63, 0x2c, 0xeb, 0xb6, 0x2d, 0xf2, 0x3e,
+    0xd4, 0x6d, 0xe7, 0x57, 0x89, 0xa3, 0x72, 0x8c, 0x77, 0xbb, 0x2b, 0x68, 0xdc, 0xf4, 0xf5, 0x5d,
+    0x95, 0x5f, 0xf7, 0xa1, 0xf9, 0x3d, 0x7f, 0x30, 0xfc, 0xfd, 0xa0, 0xb5, 0x1f, 0x8f, 0x16, 0x6c,
+    0x3e, 0xbd, 0x4d, 0x06, 0xa0, 0x7b, 0xb7, 0xbf, 0xe9, 0x7c, 0x81, 0x30, 0x3c, 0xba, 0x7a, 0x08,
+    0x81, 0x55, 0xc5, 0x59, 0x55, 0x55, 0x9b, 0x2b, 0xba, 0x38, 0x39, 0x61, 0xdc, 0xee, 0xd6, 0x6c,
+    0x31, 0x4f, 0x5e, 0xd3, 0xcc, 0xe3, 0x70, 0x77, 0xdf, 0x1c, 0x36, 0x7a, 0x2c, 0xc5, 0x01, 0x56,
+    0x64, 0xdb, 0xd4, 0xb1, 0x59, 0xa7, 0x7b, 0xfb, 0x41, 0x02, 0x0f, 0xec, 0x27, 0x12, 0x76, 0x8c,
+    0x77, 0x63, 0xe6, 0x43, 0xe2, 0xff, 0x6d, 0xdd, 0x77, 0x6d, 0x96, 0x44, 0xb3, 0x2f, 0x54, 0xe6,
+    0x04, 0x1e, 0x33, 0xc1, 0x3e, 0x62, 0x62, 0x70, 0x37, 0xe1, 0xad, 0x7b, 0x4c, 0x46, 0xea, 0x6f,
+    0xf1, 0x19, 0x23, 0x3e, 0x78, 0x97, 0x1f, 0xaf, 0xd5, 0x6e, 0x77, 0xf2, 0x5f, 0xbe, 0xff, 0xee,
+    0x75, 0x8c, 0x9b, 0x9f, 0xdc, 0x1f, 0x93, 0x1b, 0xe3, 0xbc, 0x2b, 0xc3, 0xc6, 0xf9, 0x22, 0xff,
+    0xf1, 0x87, 0x8b, 0xcb, 0x1c, 0xf2, 0xa7, 0xf5, 0xa6, 0x7b, 0x1a, 0x62, 0xfd, 0x3c, 0xa9, 0xa1,
+    0xca, 0x67, 0x45, 0x3e, 0x6e, 0xba, 0xe5, 0x72, 0xcc, 0xab, 0xaa, 0xea, 0x9f, 0x1f, 0x5f, 0x9e,
+    0xe5, 0xf5, 0x66, 0x93, 0x13, 0x78, 0x42, 0x09, 0xac, 0x4e, 0x4e, 0xba, 0x74, 0x25, 0x1e, 0x0a,
+    0xbe, 0x76, 0x75, 0xeb, 0x86, 0x22, 0xff, 0x26, 0xf8, 0xe8, 0x7c, 0x3c, 0x7d, 0xe5, 0x9b, 0xb0,
+    0x83, 0x08, 0x07, 0x47, 0x80, 0xe6, 0xcb, 0x09, 0xbf, 0x9c, 0xee, 0xed, 0x37, 0x87, 0x86, 0x40,
+    0x57, 0x4e, 0x9b, 0x74, 0xb6, 0x32, 0xf8, 0xe3, 0xa8, 0xa7, 0x7f, 0x3d, 0xc9, 0xdd, 0xdc, 0x61,
+    0xb0, 0xbf, 0x09, 0x37, 0x9b, 0x29, 0x26, 0x76, 0x3e, 0x5c, 0x41, 0xbb, 0x36, 0x0e, 0x61, 0xf2,
+    0x6d, 0x0a, 0x0b, 0x75, 0xeb, 0xda, 0xa7, 0xae, 0x8c, 0x21, 0xd6, 0xfd, 0xd7, 0x8c, 0x52, 0x32,
+    0x1f, 0x0f, 0x04, 0xdd, 0x76, 0x6d, 0x5c, 0x57, 0x71, 0x96, 0xff, 0x35, 0x07, 0x5f, 0x46, 0xf7,
+    0x2e, 0x1e, 0xf0, 0xee, 0xbf, 0xdb, 0x6e, 0xa1, 0x2b, 0x83, 0x4f, 0x15, 0xaa, 0x22, 0x39, 0xf2,
+    0x9f, 0x73, 0x8f, 0x34, 0xe9, 0xae, 0x2b, 0xc7, 0x58, 0xc7, 0x69, 0x7c, 0x5e, 0x3c, 0x6a, 0xf4,
+    0xcf, 0xbb, 0xa9, 0xcf, 0xc6, 0xa9, 0x69, 0xdc, 0x38, 0x2e, 0xa7, 0xfe, 0x49, 0xf6, 0xd3, 0x6e,
+    0xe0, 0x3b, 0xbf, 0x2a, 0xcb, 0x32, 0x87, 0xfc, 0xf0, 0x53, 0xb2, 0x92, 0x8f, 0xc0, 0xe5, 0x8c,
+    0xd2, 0xcf, 0xd0, 0x1d, 0xbe, 0x1c, 0x5d, 0xbc, 0xec, 0x6e, 0x5c, 0x98, 0x62, 0xb1, 0x83, 0x77,
+    0xb0, 0xf5, 0x3e, 0x34, 0x75, 0xb2, 0xcb, 0x72, 0x3d, 0xb8, 0x65, 0x95, 0x3f, 0xcd, 0xb7, 0x20,
+    0x1d, 0x27, 0xe4, 0xd9, 0x17, 0x10, 0x2d, 0xeb, 0xae, 0x77, 0xed, 0xb3, 0x2c, 0x9f, 0x75, 0xe5,
+    0x70, 0xf0, 0xe1, 0x4b, 0xf7, 0x2e, 0x7e, 0x32, 0x75, 0x64, 0xcf, 0x84, 0x1b, 0x86, 0x30, 0xec,
+    0xa9, 0x78, 0x54, 0xea, 0x9b, 0xe0, 0xbd, 0xdb, 0x1b, 0xf4, 0x2e, 0x20, 0x6b, 0xa7, 0xf4, 0xdf,
+    0xf3, 0x20, 0xf5, 0xff, 0x73, 0x82, 0xd3, 0x46, 0xa3, 0xf3, 0x6d, 0x31, 0x90, 0xed, 0x7f, 0x00,
+    0xc9, 0xe0, 0x7b, 0xb3, 0xc6, 0x0d, 0x00, 0x00,
+};
+
+const web_asset_t web_assets[] = {
+    { "/app.js", "application/javascript", "1d30f37078d35293", asset_app_min_js, sizeof(asset_app_min_js), true },
+    { "/helpers.js", "application/javascript", "c309c2d74870700e", asset_helpers_min_js, sizeof(asset_helpers_min_js), true },
+    { "/index.html", "text/html", "b17938a14235dd1c", asset_index_min_html, sizeof(asset_index_min_html), true },
+    { "/routine.html", "text/html", "6e27e84bcdfdd4e3", asset_routine_min_html, sizeof(asset_routine_min_html), true },
+    { "/routine.js", "application/javascript", "3f4d61acf6af6e17", asset_routine_min_js, sizeof(asset_routine_min_js), true },
+    { "/style.css", "text/css", "213901cb059dff54", asset_style_min_css, sizeof(asset_style_min_css), true },
+    { "/update.html", "text/html", "da90f326b4349831", asset_update_min_html, sizeof(asset_update_min_html), true },
+    { "/update.js", "application/javascript", "17a472e74d02ed62", asset_update_min_js, sizeof(asset_update_min_js), true },
+};
+
+const size_t web_assets_count = sizeof(web_assets) / sizeof(web_assets[0]);
+
+#endif
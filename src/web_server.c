@@ -1,17 +1,94 @@
 #include "web_server.h"
+#include "web_assets.h"
+#include "event_stream.h"
+#include "json_writer.h"
+#include "status_json.h"
+#include "cbor_writer.h"
+#include "status_cbor.h"
 #include "relay_controller.h"
+#include "relay_output.h"
+#include "routine_store.h"
+#include "scheduler.h"
+#include "mqtt_bridge.h"
+#include "moisture.h"
+#include "history.h"
+#include "metrics.h"
+#include "web_workers.h"
+#include "ota_update.h"
+#include "ota_gzip.h"
+#include "json_reader.h"
 #include "esp_http_server.h"
 #include "esp_log.h"
 #include "esp_spiffs.h"
 #include "esp_ota_ops.h"
-#include "esp_partition.h"
 #include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <ctype.h>
+#include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
-#include "cJSON.h"
 
 static const char *TAG = "WEB";
 
+#define ASSET_MANIFEST "/spiffs/etags.txt"
+#define MAX_ASSETS 16
+
+// Validators for the packed web assets, loaded once from the manifest
+// written by pack_web.js so conditional GETs never touch the filesystem
+typedef struct {
+    char name[24];
+    char hash[20];
+    bool has_gz;
+} asset_info_t;
+
+static asset_info_t asset_table[MAX_ASSETS];
+static int asset_count = 0;
+
+static void load_asset_etags(void) {
+    FILE *f = fopen(ASSET_MANIFEST, "r");
+    if (f == NULL) {
+        ESP_LOGW(TAG, "No asset manifest, serving without validators");
+        return;
+    }
+
+    char line[64];
+    asset_count = 0;
+    while (asset_count < MAX_ASSETS && fgets(line, sizeof(line), f)) {
+        asset_info_t *a = &asset_table[asset_count];
+        int gz = 0;
+        if (sscanf(line, "%23s %19s %d", a->name, a->hash, &gz) >= 2) {
+            a->has_gz = gz != 0;
+            asset_count++;
+        }
+    }
+    fclose(f);
+    ESP_LOGI(TAG, "Loaded %d asset validators", asset_count);
+}
+
+static const asset_info_t* find_asset(const char *filepath) {
+    const char *name = strrchr(filepath, '/');
+    name = name ? name + 1 : filepath;
+    for (int i = 0; i < asset_count; i++) {
+        if (strcmp(asset_table[i].name, name) == 0) {
+            return &asset_table[i];
+        }
+    }
+    return NULL;
+}
+
+static bool req_header_contains(httpd_req_t *req, const char *field, const char *token) {
+    char value[128];
+    size_t len = httpd_req_get_hdr_value_len(req, field);
+    if (len == 0) return false;
+    // A truncated value is still worth searching
+    esp_err_t err = httpd_req_get_hdr_value_str(req, field, value, sizeof(value));
+    if (err != ESP_OK && err != ESP_ERR_HTTPD_RESULT_TRUNC) return false;
+    return strstr(value, token) != NULL;
+}
+
 // Mount SPIFFS
 esp_err_t init_spiffs(void) {
     ESP_LOGI(TAG, "Initializing SPIFFS");
@@ -41,156 +118,317 @@ esp_err_t init_spiffs(void) {
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to get SPIFFS partition information (%s)", esp_err_to_name(ret));
     } else {
-        ESP_LOGI(TAG, "SPIFFS: total: %d, used: %d", total, used);
+        ESP_LOGI(TAG, "SPIFFS: total: %u, used: %u", (unsigned)total, (unsigned)used);
     }
 
+    load_asset_etags();
+
     ESP_LOGI(TAG, "SPIFFS initialized");
     return ESP_OK;
 }
 
-static const char* mode_to_str(relay_mode_t mode) {
-    switch (mode) {
-        case RELAY_MODE_MANUAL: return "manual";
-        case RELAY_MODE_TIMED: return "timed";
-        default: return "off";
-    }
+// Responses are encoded straight into this buffer; larger documents are
+// streamed out in chunks. Only used from the httpd task; handlers on the
+// web workers bring their own.
+static char json_buf[1024];
+
+static bool json_chunk_flush(void *ctx, const char *buf, size_t len) {
+    return httpd_resp_send_chunk((httpd_req_t *)ctx, buf, len) == ESP_OK;
 }
 
-// API endpoint to get relay status (JSON)
-static esp_err_t api_status_handler(httpd_req_t *req) {
-    cJSON *root = cJSON_CreateObject();
-    cJSON *relays_arr = cJSON_AddArrayToObject(root, "relays");
-    
-    for (int i = 0; i < NUM_RELAYS; i++) {
-        relay_mode_t mode = relay_get_mode(i);
-        uint32_t remaining = (mode != RELAY_MODE_OFF) ? relay_get_remaining_time(i) : 0;
-        
-        cJSON *relay = cJSON_CreateObject();
-        cJSON_AddNumberToObject(relay, "id", i);
-        cJSON_AddStringToObject(relay, "state", (mode != RELAY_MODE_OFF) ? "on" : "off");
-        cJSON_AddStringToObject(relay, "mode", mode_to_str(mode));
-        cJSON_AddNumberToObject(relay, "rem", remaining);
-        cJSON_AddItemToArray(relays_arr, relay);
-    }
-    
-    // Add routine status
-    routine_state_t* rs = relay_get_routine_status();
-    cJSON *routine = cJSON_AddObjectToObject(root, "routine");
-    cJSON_AddBoolToObject(routine, "running", rs->is_running);
-    if (rs->is_running) {
-        cJSON_AddStringToObject(routine, "name", rs->name);
-        cJSON_AddNumberToObject(routine, "currentStep", rs->current_step);
-        cJSON_AddNumberToObject(routine, "numSteps", rs->num_steps);
-        cJSON *steps_arr = cJSON_AddArrayToObject(routine, "steps");
-        for (int i = 0; i < rs->num_steps; i++) {
-            cJSON *step = cJSON_CreateObject();
-            cJSON_AddStringToObject(step, "name", rs->steps[i].name);
-            cJSON_AddNumberToObject(step, "id", rs->steps[i].relay_id);
-            cJSON_AddNumberToObject(step, "duration", rs->steps[i].duration_sec / 60);
-            cJSON_AddItemToArray(steps_arr, step);
-        }
-    }
-    
-    char *json_str = cJSON_PrintUnformatted(root);
+static void json_begin_response_buf(httpd_req_t *req, json_writer_t *w, char *buf, size_t len) {
     httpd_resp_set_type(req, "application/json");
     httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
-    
-    free(json_str);
-    cJSON_Delete(root);
-    return ESP_OK;
+    json_writer_init(w, buf, len, json_chunk_flush, req);
+}
+
+static void json_begin_response(httpd_req_t *req, json_writer_t *w) {
+    json_begin_response_buf(req, w, json_buf, sizeof(json_buf));
+}
+
+// Sends a single response when the document fit in json_buf, otherwise
+// the buffered tail plus the terminating chunk
+static esp_err_t json_end_response(httpd_req_t *req, json_writer_t *w) {
+    if (!w->flushed) {
+        return httpd_resp_send(req, w->buf, w->len);
+    }
+    if (!json_writer_flush(w)) {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// CBOR replaces JSON under /api/v2 and for clients that ask for it
+static bool wants_cbor(httpd_req_t *req) {
+    return strncmp(req->uri, "/api/v2/", 8) == 0 ||
+           req_header_contains(req, "Accept", "application/cbor");
+}
+
+static bool cbor_chunk_flush(void *ctx, const uint8_t *buf, size_t len) {
+    return httpd_resp_send_chunk((httpd_req_t *)ctx, (const char *)buf, len) == ESP_OK;
+}
+
+static void cbor_begin_response(httpd_req_t *req, cbor_writer_t *w) {
+    httpd_resp_set_type(req, "application/cbor");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    cbor_writer_init(w, (uint8_t *)json_buf, sizeof(json_buf), cbor_chunk_flush, req);
+}
+
+static esp_err_t cbor_end_response(httpd_req_t *req, cbor_writer_t *w) {
+    if (!w->flushed) {
+        return httpd_resp_send(req, (const char *)w->buf, w->len);
+    }
+    if (!cbor_writer_flush(w)) {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// API endpoint to get relay status (JSON, or CBOR with ?since=<version>
+// deltas)
+static esp_err_t api_status_handler(httpd_req_t *req) {
+    if (wants_cbor(req)) {
+        char query[48];
+        char since_str[12];
+        bool delta = false;
+        uint32_t since = 0;
+        if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+            httpd_query_key_value(query, "since", since_str, sizeof(since_str)) == ESP_OK) {
+            char *end;
+            since = strtoul(since_str, &end, 10);
+            if (end == since_str || *end != '\0') {
+                httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid since");
+                return ESP_FAIL;
+            }
+            delta = true;
+        }
+        cbor_writer_t w;
+        cbor_begin_response(req, &w);
+        status_cbor_write(&w, delta, since);
+        return cbor_end_response(req, &w);
+    }
+
+    json_writer_t w;
+    json_begin_response(req, &w);
+    status_json_write(&w);
+    return json_end_response(req, &w);
 }
 
 // API endpoint to control relay (REST API)
 static esp_err_t api_relay_handler(httpd_req_t *req) {
-    char buf[128];
-    
     // Parse query string from URI (e.g., /api/relay?id=0&action=on)
-    size_t query_len = httpd_req_get_url_query_len(req);
-    if (query_len > 0) {
-        char *query = malloc(query_len + 1);
-        if (httpd_req_get_url_query_str(req, query, query_len + 1) == ESP_OK) {
-            char action[8] = {0};
-            char relay_str[8] = {0};
-            char duration_str[16] = {0};
-
-            // Parse parameters
-            if (httpd_query_key_value(query, "id", relay_str, sizeof(relay_str)) == ESP_OK &&
-                httpd_query_key_value(query, "action", action, sizeof(action)) == ESP_OK) {
-
-                int relay = atoi(relay_str);
-
-                if (relay < 0 || relay >= NUM_RELAYS) {
-                    free(query);
-                    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid relay ID");
-                    return ESP_FAIL;
-                }
+    char query[96];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing parameters");
+        return ESP_FAIL;
+    }
 
-                if (strcmp(action, "on") == 0) {
-                    relay_on(relay);
-                    ESP_LOGI(TAG, "API: Relay %d turned ON", relay);
-                } else if (strcmp(action, "off") == 0) {
-                    relay_off(relay);
-                    ESP_LOGI(TAG, "API: Relay %d turned OFF", relay);
-                } else if (strcmp(action, "toggle") == 0) {
-                    relay_toggle(relay);
-                    ESP_LOGI(TAG, "API: Relay %d toggled", relay);
-                } else if (strcmp(action, "timed") == 0) {
-                    uint32_t duration = 0;
-                    if (httpd_query_key_value(query, "duration", duration_str, sizeof(duration_str)) == ESP_OK) {
-                        duration = atoi(duration_str);
-                    }
-                    relay_on_with_timer(relay, duration);
-                    ESP_LOGI(TAG, "API: Relay %d turned ON for %u seconds", relay, (unsigned int)duration);
-                } else {
-                    free(query);
-                    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid action");
-                    return ESP_FAIL;
-                }
+    char action[8] = {0};
+    char relay_str[8] = {0};
+    char duration_str[16] = {0};
+
+    // Parse parameters
+    if (httpd_query_key_value(query, "id", relay_str, sizeof(relay_str)) != ESP_OK ||
+        httpd_query_key_value(query, "action", action, sizeof(action)) != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing parameters");
+        return ESP_FAIL;
+    }
+
+    int relay = atoi(relay_str);
+
+    if (relay < 0 || relay >= relay_count()) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid relay ID");
+        return ESP_FAIL;
+    }
+
+    if (strcmp(action, "on") == 0) {
+        relay_on(relay);
+        ESP_LOGI(TAG, "API: Relay %d turned ON", relay);
+    } else if (strcmp(action, "off") == 0) {
+        relay_off(relay);
+        ESP_LOGI(TAG, "API: Relay %d turned OFF", relay);
+    } else if (strcmp(action, "toggle") == 0) {
+        relay_toggle(relay);
+        ESP_LOGI(TAG, "API: Relay %d toggled", relay);
+    } else if (strcmp(action, "timed") == 0) {
+        uint32_t duration = 0;
+        if (httpd_query_key_value(query, "duration", duration_str, sizeof(duration_str)) == ESP_OK) {
+            duration = atoi(duration_str);
+        }
+        relay_on_with_timer(relay, duration);
+        ESP_LOGI(TAG, "API: Relay %d turned ON for %u seconds", relay, (unsigned int)duration);
+    } else {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid action");
+        return ESP_FAIL;
+    }
+
+    // Return JSON response
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    relay_mode_t mode = relay_snapshot_mode(&snap, relay);
+    if (wants_cbor(req)) {
+        cbor_writer_t w;
+        cbor_begin_response(req, &w);
+        cbor_map(&w, 5);
+        cbor_kv_int(&w, "relay", relay);
+        cbor_kv_str(&w, "state", (mode != RELAY_MODE_OFF) ? "on" : "off");
+        cbor_kv_str(&w, "mode", relay_mode_to_str(mode));
+        cbor_kv_uint(&w, "rem", relay_snapshot_remaining(&snap, relay));
+        cbor_kv_bool(&w, "success", true);
+        return cbor_end_response(req, &w);
+    }
+    json_writer_t w;
+    json_begin_response(req, &w);
+    json_obj_begin(&w);
+    json_kv_int(&w, "relay", relay);
+    json_kv_str(&w, "state", (mode != RELAY_MODE_OFF) ? "on" : "off");
+    json_kv_str(&w, "mode", relay_mode_to_str(mode));
+    json_kv_uint(&w, "rem", relay_snapshot_remaining(&snap, relay));
+    json_kv_bool(&w, "success", true);
+    json_obj_end(&w);
+    return json_end_response(req, &w);
+}
 
-                // Return JSON response
-                relay_mode_t mode = relay_get_mode(relay);
-                uint32_t remaining = (mode != RELAY_MODE_OFF) ? relay_get_remaining_time(relay) : 0;
-                snprintf(buf, sizeof(buf),
-                    "{\"relay\":%d,\"state\":\"%s\",\"mode\":\"%s\",\"rem\":%u,\"success\":true}",
-                    relay,
-                    (mode != RELAY_MODE_OFF) ? "on" : "off",
-                    mode_to_str(mode),
-                    (unsigned int)remaining
-                );
-
-                httpd_resp_set_type(req, "application/json");
-                httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-                httpd_resp_send(req, buf, HTTPD_RESP_USE_STRLEN);
-                free(query);
-                return ESP_OK;
+// --- Batched relay commands --------------------------------------------------
+
+#define RELAY_BATCH_MAX_SIZE 1024
+
+typedef struct {
+    json_reader_t reader;
+    relay_command_t cmds[MAX_RELAY_COMMANDS];
+    int count;
+    bool has_id;
+    bool has_action;
+    bool has_duration;
+    char err[64];
+} relay_batch_t;
+
+static bool batch_reject(relay_batch_t *b, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(b->err, sizeof(b->err), fmt, args);
+    va_end(args);
+    return false;
+}
+
+// Depth 0 is the array, 1 a command and 2 its members
+static bool on_batch_token(void *ctx, const json_token_t *tok) {
+    relay_batch_t *b = (relay_batch_t *)ctx;
+    relay_command_t *c = &b->cmds[b->count];
+    int n = b->count + 1;
+    int32_t v;
+
+    switch (tok->depth) {
+        case 0:
+            if (tok->type == JSON_ARR_BEGIN || tok->type == JSON_ARR_END) return true;
+            return batch_reject(b, "Expected an array of commands");
+
+        case 1:
+            if (tok->type == JSON_OBJ_BEGIN) {
+                if (b->count >= MAX_RELAY_COMMANDS) return batch_reject(b, "Too many commands (max %d)", MAX_RELAY_COMMANDS);
+                memset(c, 0, sizeof(*c));
+                b->has_id = false;
+                b->has_action = false;
+                b->has_duration = false;
+                return true;
             }
-            free(query);
+            if (tok->type != JSON_OBJ_END) return batch_reject(b, "Command %d: not an object", n);
+            if (!b->has_id || !b->has_action) return batch_reject(b, "Command %d: needs an id and an action", n);
+            if (c->action == RELAY_CMD_TIMED && !b->has_duration) return batch_reject(b, "Command %d: needs a duration", n);
+            b->count++;
+            return true;
+
+        case 2:
+            if (tok->key == NULL) return true;
+            if (strcmp(tok->key, "id") == 0) {
+                if (!json_token_int(tok, &v) || v < 0 || v >= relay_count()) {
+                    return batch_reject(b, "Command %d: invalid relay id", n);
+                }
+                c->relay_num = v;
+                b->has_id = true;
+            } else if (strcmp(tok->key, "action") == 0) {
+                static const char *const actions[] = {"off", "on", "timed", "toggle"};
+                int action = -1;
+                for (int i = 0; i < 4 && tok->type == JSON_STRING; i++) {
+                    if (strcmp(tok->str, actions[i]) == 0) action = i;
+                }
+                if (action < 0) return batch_reject(b, "Command %d: invalid action", n);
+                c->action = action;
+                b->has_action = true;
+            } else if (strcmp(tok->key, "duration") == 0) {
+                if (!json_token_int(tok, &v) || v < 1 || v > MAX_ON_TIME_SEC) {
+                    return batch_reject(b, "Command %d: duration must be 1 to %d seconds", n, MAX_ON_TIME_SEC);
+                }
+                c->seconds = v;
+                b->has_duration = true;
+            }
+            return true;
+
+        default:
+            return true;
+    }
+}
+
+// POST /api/relays: applies a list of commands as one change (see
+// relay_apply()) and returns the full status. Nothing switches unless
+// every command is valid.
+static esp_err_t api_relays_handler(httpd_req_t *req) {
+    int remaining = req->content_len;
+    if (remaining <= 0) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Content length required");
+        return ESP_FAIL;
+    }
+    if (remaining > RELAY_BATCH_MAX_SIZE) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Content too long");
+        return ESP_FAIL;
+    }
+
+    relay_batch_t batch;
+    memset(&batch, 0, sizeof(batch));
+    json_reader_init(&batch.reader, on_batch_token, &batch);
+
+    bool ok = true;
+    char buf[256];
+    while (ok && remaining > 0) {
+        int received = httpd_req_recv(req, buf, remaining < (int)sizeof(buf) ? remaining : (int)sizeof(buf));
+        if (received <= 0) {
+            if (received == HTTPD_SOCK_ERR_TIMEOUT) continue;
+            return ESP_FAIL;
         }
+        remaining -= received;
+        ok = json_reader_feed(&batch.reader, buf, received);
+    }
+    if (ok) {
+        ok = json_reader_finish(&batch.reader);
+    }
+    if (!ok) {
+        if (batch.err[0] == '\0') {
+            snprintf(batch.err, sizeof(batch.err), "Invalid JSON at byte %u: %s",
+                     (unsigned)batch.reader.pos, batch.reader.error);
+        }
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, batch.err);
+        return ESP_FAIL;
     }
 
-    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing parameters");
-    return ESP_FAIL;
+    relay_apply(batch.cmds, batch.count);
+    ESP_LOGI(TAG, "API: Applied %d relay commands", batch.count);
+
+    json_writer_t w;
+    json_begin_response(req, &w);
+    status_json_write(&w);
+    return json_end_response(req, &w);
 }
 
 // New handlers for routine control
 static esp_err_t api_routine_control_handler(httpd_req_t *req) {
-    size_t query_len = httpd_req_get_url_query_len(req);
-    if (query_len == 0) {
+    char query[64];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK) {
         httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing query string");
         return ESP_FAIL;
     }
 
-    char *query = malloc(query_len + 1);
-    if (httpd_req_get_url_query_str(req, query, query_len + 1) != ESP_OK) {
-        free(query);
-        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to get query");
-        return ESP_FAIL;
-    }
-
     char action[16] = {0};
     if (httpd_query_key_value(query, "action", action, sizeof(action)) != ESP_OK) {
-        free(query);
         httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing action");
         return ESP_FAIL;
     }
@@ -202,80 +440,64 @@ static esp_err_t api_routine_control_handler(httpd_req_t *req) {
     } else if (strcmp(action, "start") == 0) {
         char index_str[8] = {0};
         if (httpd_query_key_value(query, "index", index_str, sizeof(index_str)) != ESP_OK) {
-            free(query);
             httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing routine index");
             return ESP_FAIL;
         }
-        int index = atoi(index_str);
-
-        // Load routines from file to get the steps
-        FILE *f = fopen("/spiffs/routines.json", "r");
-        if (!f) {
-            free(query);
-            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Routines file not found");
-            return ESP_FAIL;
-        }
-        fseek(f, 0, SEEK_END);
-        long fsize = ftell(f);
-        fseek(f, 0, SEEK_SET);
-        char *data = malloc(fsize + 1);
-        fread(data, 1, fsize, f);
-        fclose(f);
-        data[fsize] = 0;
-
-        cJSON *routines_arr = cJSON_Parse(data);
-        free(data);
-        if (!routines_arr) {
-            free(query);
-            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to parse routines");
-            return ESP_FAIL;
-        }
 
-        cJSON *routine_item = cJSON_GetArrayItem(routines_arr, index);
-        if (!routine_item) {
-            cJSON_Delete(routines_arr);
-            free(query);
+        // Routines were validated and compiled when they were saved
+        esp_err_t err = routine_store_start(atoi(index_str));
+        if (err == ESP_ERR_NOT_FOUND) {
             httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Routine index out of range");
             return ESP_FAIL;
         }
-
-        const char* name = cJSON_GetObjectItem(routine_item, "name")->valuestring;
-        cJSON *steps_arr = cJSON_GetObjectItem(routine_item, "steps");
-        int num_steps = cJSON_GetArraySize(steps_arr);
-        routine_step_t steps[MAX_ROUTINE_STEPS];
-        int count = 0;
-        for (int i = 0; i < num_steps && count < MAX_ROUTINE_STEPS; i++) {
-            cJSON *step_item = cJSON_GetArrayItem(steps_arr, i);
-            if (cJSON_GetObjectItem(step_item, "enabled")->valueint) {
-                steps[count].relay_id = cJSON_GetObjectItem(step_item, "id")->valueint;
-                steps[count].duration_sec = cJSON_GetObjectItem(step_item, "duration")->valueint * 60;
-                strncpy(steps[count].name, cJSON_GetObjectItem(step_item, "name")->valuestring, sizeof(steps[count].name) - 1);
-                count++;
-            }
+        if (err == ESP_ERR_NO_MEM) {
+            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Out of memory");
+            return ESP_FAIL;
         }
-        if (relay_start_routine(name, steps, count)) {
-            httpd_resp_sendstr(req, "{\"success\":true}");
-        } else {
+        if (err != ESP_OK) {
             httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "A routine is already running");
+            return ESP_FAIL;
         }
-        cJSON_Delete(routines_arr);
-        free(query);
-        return ESP_OK;
     }
 
-    free(query);
     httpd_resp_sendstr(req, "{\"success\":true}");
     return ESP_OK;
 }
 
+// Sets the caching headers for a packed asset. Returns true when the
+// client's copy is current and a 304 has already been sent. The etag
+// buffer must outlive the response since httpd keeps a pointer to it.
+static bool send_not_modified(httpd_req_t *req, const char *hash, bool gz, char *etag, size_t etag_len) {
+    // The gzip body is a different representation, so it gets its own tag
+    snprintf(etag, etag_len, "\"%s%s\"", hash, gz ? "-gz" : "");
+    httpd_resp_set_hdr(req, "ETag", etag);
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+
+    if (req_header_contains(req, "If-None-Match", etag)) {
+        httpd_resp_set_status(req, "304 Not Modified");
+        httpd_resp_send(req, NULL, 0);
+        return true;
+    }
+    return false;
+}
+
 // Helper function to serve files from SPIFFS
 static esp_err_t serve_spiffs_file(httpd_req_t *req, const char *filepath, const char *content_type) {
-    ESP_LOGI(TAG, "Serving file: %s", filepath);
-    struct stat st;
-    if (stat(filepath, &st) != 0) {
-        ESP_LOGE(TAG, "File not found: %s", filepath);
-        httpd_resp_send_404(req);
-        return ESP_FAIL;
+    ESP_LOGD(TAG, "Serving file: %s", filepath);
+
+    const asset_info_t *asset = find_asset(filepath);
+    bool use_gz = asset && asset->has_gz && req_header_contains(req, "Accept-Encoding", "gzip");
+
+    char etag[28];
+    if (asset && send_not_modified(req, asset->hash, use_gz, etag, sizeof(etag))) {
+        return ESP_OK;
+    }
+
+    char gz_path[40];
+    if (use_gz) {
+        snprintf(gz_path, sizeof(gz_path), "%s.gz", filepath);
+        filepath = gz_path;
     }
 
     FILE *f = fopen(filepath, "r");
@@ -285,9 +507,10 @@ static esp_err_t serve_spiffs_file(httpd_req_t *req, const char *filepath, const
         return ESP_FAIL;
     }
 
-    ESP_LOGI(TAG, "File opened successfully, size: %ld", st.st_size);
-
     httpd_resp_set_type(req, content_type);
+    if (use_gz) {
+        httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    }
 
     char buf[1024];
     size_t read_bytes;
@@ -306,7 +529,7 @@ static esp_err_t serve_spiffs_file(httpd_req_t *req, const char *filepath, const
 }
 
 static esp_err_t api_routines_handler(httpd_req_t *req) {
-    const char* filepath = "/spiffs/routines.json";
+    const char* filepath = ROUTINES_FILE;
     if (req->method == HTTP_GET) {
         struct stat st;
         if (stat(filepath, &st) != 0) {
@@ -327,39 +550,33 @@ static esp_err_t api_routines_handler(httpd_req_t *req) {
             return ESP_FAIL;
         }
 
-        if (total_len > 4096) { // Safety limit
+        if (total_len > ROUTINES_MAX_SIZE) { // Safety limit
             httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Content too long");
             return ESP_FAIL;
         }
 
-        char *buf = malloc(total_len + 1);
-        if (buf == NULL) {
-            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to allocate memory");
-            return ESP_FAIL;
-        }
-
-        int received = 0;
-        while (remaining > 0) {
-            int ret = httpd_req_recv(req, buf + received, remaining);
-            if (ret <= 0) {
-                if (ret == HTTPD_SOCK_ERR_TIMEOUT) continue;
-                free(buf);
+        // Streamed through a fixed buffer: validated and compiled as it
+        // arrives, and only swapped in once the whole document is good
+        esp_err_t ret = routine_store_upload_begin();
+        char buf[512];
+        while (ret == ESP_OK && remaining > 0) {
+            int received = httpd_req_recv(req, buf, remaining < (int)sizeof(buf) ? remaining : (int)sizeof(buf));
+            if (received <= 0) {
+                if (received == HTTPD_SOCK_ERR_TIMEOUT) continue;
+                routine_store_upload_abort();
                 return ESP_FAIL;
             }
-            received += ret;
-            remaining -= ret;
+            remaining -= received;
+            ret = routine_store_upload_write(buf, received);
         }
-        buf[received] = '\0';
-
-        FILE *f = fopen(filepath, "w");
-        if (f == NULL) {
-            free(buf);
-            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to open file for writing");
+        if (ret == ESP_OK) {
+            ret = routine_store_upload_finish();
+        }
+        if (ret != ESP_OK) {
+            httpd_resp_send_err(req, ret == ESP_ERR_INVALID_ARG ? HTTPD_400_BAD_REQUEST : HTTPD_500_INTERNAL_SERVER_ERROR,
+                                routine_store_upload_error());
             return ESP_FAIL;
         }
-        fputs(buf, f);
-        fclose(f);
-        free(buf);
         
         httpd_resp_sendstr(req, "{\"success\":true}");
         return ESP_OK;
@@ -367,103 +584,401 @@ static esp_err_t api_routines_handler(httpd_req_t *req) {
     return ESP_FAIL;
 }
 
-// API endpoint for OTA updates
-static esp_err_t api_ota_handler(httpd_req_t *req) {
-    char buf[1024];
+static esp_err_t api_schedules_handler(httpd_req_t *req) {
+    if (req->method == HTTP_GET) {
+        json_writer_t w;
+        json_begin_response(req, &w);
+        scheduler_write_json(&w);
+        return json_end_response(req, &w);
+    }
+
     int remaining = req->content_len;
-    int total_len = remaining;
-    
-    if (total_len <= 0) {
+    if (remaining <= 0) {
         httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Content length required");
         return ESP_FAIL;
     }
+    if (remaining > SCHEDULES_MAX_SIZE) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Content too long");
+        return ESP_FAIL;
+    }
 
-    // Check if it's firmware or spiffs
-    bool is_spiffs = false;
-    char query[64];
+    esp_err_t ret = scheduler_upload_begin();
+    char buf[256];
+    while (ret == ESP_OK && remaining > 0) {
+        int received = httpd_req_recv(req, buf, remaining < (int)sizeof(buf) ? remaining : (int)sizeof(buf));
+        if (received <= 0) {
+            if (received == HTTPD_SOCK_ERR_TIMEOUT) continue;
+            return ESP_FAIL;
+        }
+        remaining -= received;
+        ret = scheduler_upload_write(buf, received);
+    }
+    if (ret == ESP_OK) {
+        ret = scheduler_upload_finish();
+    }
+    if (ret != ESP_OK) {
+        httpd_resp_send_err(req, ret == ESP_ERR_INVALID_ARG ? HTTPD_400_BAD_REQUEST : HTTPD_500_INTERNAL_SERVER_ERROR,
+                            scheduler_upload_error());
+        return ESP_FAIL;
+    }
+
+    httpd_resp_sendstr(req, "{\"success\":true}");
+    return ESP_OK;
+}
+
+// GET /api/mqtt: the broker settings; POST replaces them and reconnects
+static esp_err_t api_mqtt_handler(httpd_req_t *req) {
+    if (req->method == HTTP_GET) {
+        json_writer_t w;
+        json_begin_response(req, &w);
+        mqtt_bridge_write_json(&w);
+        return json_end_response(req, &w);
+    }
+
+    int remaining = req->content_len;
+    if (remaining <= 0) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Content length required");
+        return ESP_FAIL;
+    }
+    if (remaining > MQTT_CONFIG_MAX_SIZE) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Content too long");
+        return ESP_FAIL;
+    }
+
+    esp_err_t ret = mqtt_bridge_upload_begin();
+    char buf[256];
+    while (ret == ESP_OK && remaining > 0) {
+        int received = httpd_req_recv(req, buf, remaining < (int)sizeof(buf) ? remaining : (int)sizeof(buf));
+        if (received <= 0) {
+            if (received == HTTPD_SOCK_ERR_TIMEOUT) continue;
+            return ESP_FAIL;
+        }
+        remaining -= received;
+        ret = mqtt_bridge_upload_write(buf, received);
+    }
+    if (ret == ESP_OK) {
+        ret = mqtt_bridge_upload_finish();
+    }
+    if (ret != ESP_OK) {
+        httpd_resp_send_err(req, ret == ESP_ERR_INVALID_ARG ? HTTPD_400_BAD_REQUEST : HTTPD_500_INTERNAL_SERVER_ERROR,
+                            mqtt_bridge_upload_error());
+        return ESP_FAIL;
+    }
+
+    httpd_resp_sendstr(req, "{\"success\":true}");
+    return ESP_OK;
+}
+
+// Optional unsigned query parameter; false if present but not a number
+static bool query_uint(const char *query, const char *key, uint32_t *out) {
+    char value[16];
+    if (httpd_query_key_value(query, key, value, sizeof(value)) != ESP_OK) return true;
+    char *end;
+    unsigned long v = strtoul(value, &end, 10);
+    if (end == value || *end != '\0' || value[0] == '-' || v > UINT32_MAX) return false;
+    *out = v;
+    return true;
+}
+
+// GET /api/zones[?count=<n>][&parallel=<n>][&capacity=<n>][&zone=<z>&cost=<n>]:
+// the zone count and the limits routine steps run under, each changed and
+// saved if given
+static esp_err_t api_zones_handler(httpd_req_t *req) {
+    uint32_t count = UINT32_MAX, parallel = UINT32_MAX, capacity = UINT32_MAX, zone = UINT32_MAX,
+             cost = UINT32_MAX;
+    char query[96];
     if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
-        char type[16];
-        if (httpd_query_key_value(query, "type", type, sizeof(type)) == ESP_OK) {
-            if (strcmp(type, "spiffs") == 0) {
-                is_spiffs = true;
+        if (!query_uint(query, "count", &count) ||
+            (count != UINT32_MAX && relay_set_count(count > RELAY_MAX ? 0 : (int)count) != ESP_OK)) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid zone count");
+            return ESP_FAIL;
+        }
+        if (!query_uint(query, "parallel", &parallel) || !query_uint(query, "capacity", &capacity)) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid routine limits");
+            return ESP_FAIL;
+        }
+        if (parallel != UINT32_MAX || capacity != UINT32_MAX) {
+            routine_limits_t limits;
+            relay_get_routine_limits(&limits);
+            if (relay_set_routine_limits(parallel != UINT32_MAX ? (int)(parallel > MAX_ROUTINE_STEPS ? 0 : parallel)
+                                                                : limits.parallel,
+                                         capacity != UINT32_MAX ? capacity : limits.capacity) != ESP_OK) {
+                httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid routine limits");
+                return ESP_FAIL;
             }
         }
+        if (!query_uint(query, "zone", &zone) || !query_uint(query, "cost", &cost) ||
+            (zone == UINT32_MAX) != (cost == UINT32_MAX) ||
+            (zone != UINT32_MAX && (zone >= (uint32_t)relay_channels() || relay_set_zone_cost(zone, cost) != ESP_OK))) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid zone or cost");
+            return ESP_FAIL;
+        }
     }
 
-    esp_ota_handle_t update_handle = 0;
-    const esp_partition_t *update_partition = NULL;
-    
-    if (is_spiffs) {
-        update_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, "storage");
-        if (!update_partition) {
-            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "SPIFFS partition not found");
+    routine_limits_t limits;
+    relay_get_routine_limits(&limits);
+    json_writer_t w;
+    json_begin_response(req, &w);
+    json_obj_begin(&w);
+    json_kv_int(&w, "count", relay_count());
+    json_kv_int(&w, "max", relay_channels());
+    json_kv_str(&w, "output", relay_output_name());
+    json_kv_int(&w, "parallel", limits.parallel);
+    json_kv_uint(&w, "capacity", limits.capacity);
+    json_key(&w, "costs");
+    json_arr_begin(&w);
+    for (int i = 0; i < relay_count(); i++) {
+        json_int(&w, limits.cost[i]);
+    }
+    json_arr_end(&w);
+    json_obj_end(&w);
+    return json_end_response(req, &w);
+}
+
+// GET /api/moisture[?zone=<n>[&sensor=<s>&dry=<pct>&wet=<pct>]]: the
+// sensors and the zones tied to them. With a zone, ties it to the sensor,
+// or unties it if no sensor is given, and saves that.
+static esp_err_t api_moisture_handler(httpd_req_t *req) {
+    uint32_t zone = UINT32_MAX, sensor = UINT32_MAX, dry = 30, wet = 60;
+    char query[64];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        if (!query_uint(query, "zone", &zone) || !query_uint(query, "sensor", &sensor) ||
+            !query_uint(query, "dry", &dry) || !query_uint(query, "wet", &wet)) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid parameter");
             return ESP_FAIL;
         }
-        ESP_LOGI(TAG, "Starting SPIFFS OTA update...");
-        esp_partition_erase_range(update_partition, 0, update_partition->size);
-    } else {
-        update_partition = esp_ota_get_next_update_partition(NULL);
-        if (!update_partition) {
-            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "OTA partition not found");
+        if (zone != UINT32_MAX) {
+            if (moisture_sensors() == 0) {
+                httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "No moisture sensors");
+                return ESP_FAIL;
+            }
+            if (zone >= (uint32_t)relay_count() || (sensor != UINT32_MAX && sensor >= (uint32_t)moisture_sensors())) {
+                httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid zone or sensor");
+                return ESP_FAIL;
+            }
+            if (sensor != UINT32_MAX && (dry >= wet || wet > 100)) {
+                httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "dry must be below wet, at most 100");
+                return ESP_FAIL;
+            }
+            if (moisture_set_zone(zone, sensor == UINT32_MAX ? -1 : (int)sensor, dry, wet) != ESP_OK) {
+                httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to save");
+                return ESP_FAIL;
+            }
+        }
+    }
+
+    json_writer_t w;
+    json_begin_response(req, &w);
+    moisture_write_config_json(&w);
+    return json_end_response(req, &w);
+}
+
+// GET /api/history?from=&to=&zone= (times in UTC seconds, all optional)
+static esp_err_t api_history_handler(httpd_req_t *req) {
+    uint32_t from = 0, to = UINT32_MAX, zone = UINT32_MAX;
+    char query[96];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        if (!query_uint(query, "from", &from) || !query_uint(query, "to", &to) || from > to) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid time range");
             return ESP_FAIL;
         }
-        ESP_LOGI(TAG, "Starting Firmware OTA update to partition: %s", update_partition->label);
-        esp_err_t err = esp_ota_begin(update_partition, OTA_SIZE_UNKNOWN, &update_handle);
-        if (err != ESP_OK) {
-            ESP_LOGE(TAG, "esp_ota_begin failed (%s)", esp_err_to_name(err));
-            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "esp_ota_begin failed");
+        if (!query_uint(query, "zone", &zone) || (zone != UINT32_MAX && zone >= (uint32_t)relay_count())) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid zone");
             return ESP_FAIL;
         }
     }
 
-    int received = 0;
-    while (remaining > 0) {
-        int ret = httpd_req_recv(req, buf, (remaining < sizeof(buf)) ? remaining : sizeof(buf));
-        if (ret <= 0) {
+    // Runs on a web worker
+    char buf[768];
+    json_writer_t w;
+    json_begin_response_buf(req, &w, buf, sizeof(buf));
+    if (history_write_json(&w, from, to, zone == UINT32_MAX ? -1 : (int)zone) != ESP_OK) {
+        // Nothing was written yet
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "text/plain");
+        httpd_resp_sendstr(req, "History not available");
+        return ESP_FAIL;
+    }
+    return json_end_response(req, &w);
+}
+
+// Parses the X-SHA256 header: 64 hex digits. False if it is malformed.
+static bool parse_sha256(const char *hex, uint8_t *out) {
+    if (strlen(hex) != 64) return false;
+    for (int i = 0; i < 32; i++) {
+        unsigned byte;
+        if (!isxdigit((unsigned char)hex[2 * i]) || !isxdigit((unsigned char)hex[2 * i + 1]) ||
+            sscanf(hex + 2 * i, "%2x", &byte) != 1) {
+            return false;
+        }
+        out[i] = (uint8_t)byte;
+    }
+    return true;
+}
+
+// Receives a plain image straight into the update's buffers. ESP_FAIL if
+// the upload broke off.
+static esp_err_t ota_receive(httpd_req_t *req, size_t total_len) {
+    size_t received = 0;
+    while (received < total_len) {
+        uint8_t *buf = ota_update_buffer();
+        if (buf == NULL) break;     // The writer failed; finishing reports why
+
+        size_t want = total_len - received < OTA_BUF_SIZE ? total_len - received : OTA_BUF_SIZE;
+        size_t got = 0;
+        while (got < want) {
+            int ret = httpd_req_recv(req, (char *)buf + got, want - got);
             if (ret == HTTPD_SOCK_ERR_TIMEOUT) continue;
-            if (!is_spiffs && update_handle) esp_ota_abort(update_handle);
-            return ESP_FAIL;
+            if (ret <= 0) return ESP_FAIL;
+            got += ret;
         }
-        
-        if (is_spiffs) {
-            esp_partition_write(update_partition, received, buf, ret);
-        } else {
-            esp_ota_write(update_handle, buf, ret);
+        ota_update_submit(buf, got);
+        received += got;
+
+        if (received % (100 * 1024) < got) {
+            ESP_LOGI(TAG, "OTA Progress: %d%% (%u/%u)", (int)((uint64_t)received * 100 / total_len),
+                     (unsigned)received, (unsigned)total_len);
+        }
+    }
+    return ESP_OK;
+}
+
+// Receives a gzip image through the inflater, which fills the update's
+// buffers. ESP_ERR_INVALID_ARG if it is not valid gzip, ESP_ERR_NOT_FINISHED
+// or ESP_ERR_INVALID_CRC if the stream ends wrong (see ota_gzip.h).
+static esp_err_t ota_receive_gzip(httpd_req_t *req, size_t total_len) {
+    ota_gzip_t *gz = ota_gzip_new();
+    if (gz == NULL) return ESP_ERR_NO_MEM;
+
+    char buf[1024];
+    size_t received = 0;
+    esp_err_t err = ESP_OK;
+    while (received < total_len && err == ESP_OK) {
+        int ret = httpd_req_recv(req, buf, total_len - received < sizeof(buf) ? total_len - received : sizeof(buf));
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT) continue;
+        if (ret <= 0) {
+            ota_gzip_free(gz);
+            return ESP_FAIL;
         }
-        
         received += ret;
-        remaining -= ret;
-        
-        if (received % (100 * 1024) < ret) {
-             ESP_LOGI(TAG, "OTA Progress: %d%% (%d/%d)", (int)((float)received/total_len * 100), received, total_len);
+        err = ota_gzip_write(gz, (const uint8_t *)buf, ret);
+
+        if (received % (100 * 1024) < (size_t)ret) {
+            ESP_LOGI(TAG, "OTA Progress: %d%% (%u/%u, %u inflated)", (int)((uint64_t)received * 100 / total_len),
+                     (unsigned)received, (unsigned)total_len, (unsigned)ota_gzip_size(gz));
         }
     }
+    if (err == ESP_OK) err = ota_gzip_finish(gz);
+    ota_gzip_free(gz);
+    // The writer failed; finishing reports why
+    return err == ESP_FAIL ? ESP_OK : err;
+}
 
-    if (is_spiffs) {
-        ESP_LOGI(TAG, "SPIFFS OTA finished, received %d bytes", received);
-    } else {
-        esp_err_t err = esp_ota_end(update_handle);
-        if (err != ESP_OK) {
-            ESP_LOGE(TAG, "esp_ota_end failed (%s)", esp_err_to_name(err));
-            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "esp_ota_end failed");
+// API endpoint for OTA updates, run on a web worker. The body is received
+// straight into the update's buffers while its writer task flashes the
+// previous one; see ota_update.h. With "Content-Encoding: gzip" the body is inflated on the
+// way, and X-SHA256 is the digest of the inflated image.
+static esp_err_t api_ota_handler(httpd_req_t *req) {
+    size_t total_len = req->content_len;
+    if (total_len == 0) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Content length required");
+        return ESP_FAIL;
+    }
+
+    // Check if it's firmware or spiffs
+    ota_target_t target = OTA_TARGET_APP;
+    char query[64];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        char type[16];
+        if (httpd_query_key_value(query, "type", type, sizeof(type)) == ESP_OK) {
+            if (strcmp(type, "spiffs") == 0) {
+                target = OTA_TARGET_SPIFFS;
+            }
+        }
+    }
+
+    bool gzip = false;
+    char encoding[16];
+    if (httpd_req_get_hdr_value_str(req, "Content-Encoding", encoding, sizeof(encoding)) == ESP_OK) {
+        if (strcmp(encoding, "gzip") != 0) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Only gzip Content-Encoding is supported");
             return ESP_FAIL;
         }
-        err = esp_ota_set_boot_partition(update_partition);
-        if (err != ESP_OK) {
-            ESP_LOGE(TAG, "esp_ota_set_boot_partition failed (%s)", esp_err_to_name(err));
-            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "esp_ota_set_boot_partition failed");
+        gzip = true;
+    }
+
+    uint8_t digest[32];
+    bool has_digest = false;
+    char hex[72];
+    if (httpd_req_get_hdr_value_str(req, "X-SHA256", hex, sizeof(hex)) == ESP_OK) {
+        if (!parse_sha256(hex, digest)) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "X-SHA256 must be 64 hex digits");
             return ESP_FAIL;
         }
-        ESP_LOGI(TAG, "Firmware OTA finished, received %d bytes. Rebooting...", received);
+        has_digest = true;
     }
 
+    // The inflated size is only known at the end
+    esp_err_t err = ota_update_begin(target, gzip ? 0 : total_len, has_digest ? digest : NULL);
+    if (err == ESP_ERR_INVALID_SIZE) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Image is larger than the partition");
+        return ESP_FAIL;
+    } else if (err == ESP_ERR_NOT_FOUND) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR,
+                            target == OTA_TARGET_SPIFFS ? "SPIFFS partition not found" : "OTA partition not found");
+        return ESP_FAIL;
+    } else if (err == ESP_ERR_INVALID_STATE) {
+        httpd_resp_set_status(req, "409 Conflict");
+        httpd_resp_set_type(req, "text/plain");
+        httpd_resp_sendstr(req, "Update already in progress");
+        return ESP_FAIL;
+    } else if (err != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to start the update");
+        return ESP_FAIL;
+    }
+
+    err = gzip ? ota_receive_gzip(req, total_len) : ota_receive(req, total_len);
+    if (err != ESP_OK) {
+        ota_update_abort();
+        if (err == ESP_ERR_NO_MEM) {
+            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Out of memory for decompression");
+        } else if (err != ESP_FAIL) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST,
+                                err == ESP_ERR_INVALID_ARG ? "Corrupt gzip stream" : "Truncated or damaged gzip stream");
+        }
+        return ESP_FAIL;
+    }
+
+    err = ota_update_finish();
+    if (err == ESP_ERR_INVALID_SIZE) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Image is larger than the partition");
+        return ESP_FAIL;
+    } else if (err == ESP_ERR_NOT_FINISHED) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Image is truncated or empty");
+        return ESP_FAIL;
+    } else if (err == ESP_ERR_INVALID_CRC) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST,
+                            target == OTA_TARGET_SPIFFS ? "SHA-256 mismatch, the filesystem is damaged: upload it again"
+                                                        : "SHA-256 mismatch, the update was not applied");
+        return ESP_FAIL;
+    } else if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Not a valid firmware image");
+        return ESP_FAIL;
+    } else if (err != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Writing the update to flash failed");
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "%s OTA finished, received %u bytes. Rebooting...",
+             target == OTA_TARGET_SPIFFS ? "SPIFFS" : "Firmware", (unsigned)total_len);
     httpd_resp_sendstr(req, "Update successful. Rebooting...");
-    
+
     vTaskDelay(pdMS_TO_TICKS(2000));
     esp_restart();
     return ESP_OK;
 }
 
+#if !WEB_EMBED_ASSETS
 static esp_err_t update_handler(httpd_req_t *req) {
     return serve_spiffs_file(req, "/spiffs/update.min.html", "text/html");
 }
@@ -501,162 +1016,359 @@ static esp_err_t favicon_handler(httpd_req_t *req) {
 static esp_err_t routine_js_handler(httpd_req_t *req) {
     return serve_spiffs_file(req, "/spiffs/routine.min.js", "application/javascript");
 }
+#endif
+
+#if WEB_EMBED_ASSETS
+static const char* mime_from_path(const char *path) {
+    const char *ext = strrchr(path, '.');
+    if (ext == NULL) return "text/plain";
+    if (strcmp(ext, ".html") == 0) return "text/html";
+    if (strcmp(ext, ".css") == 0) return "text/css";
+    if (strcmp(ext, ".js") == 0) return "application/javascript";
+    if (strcmp(ext, ".json") == 0) return "application/json";
+    if (strcmp(ext, ".ico") == 0) return "image/x-icon";
+    return "text/plain";
+}
+
+// Maps a request URI onto its canonical asset path: strips the query,
+// resolves the page aliases ("/" and extensionless pages) and drops the
+// ".min" infix so "/app.js" and "/app.min.js" share one entry.
+static bool canonical_asset_path(const char *uri, char *out, size_t out_len) {
+    size_t len = strcspn(uri, "?#");
+    if (len == 0 || len >= out_len) return false;
+
+    if (len == 1) {
+        strlcpy(out, "/index.html", out_len);
+        return true;
+    }
+
+    memcpy(out, uri, len);
+    out[len] = '\0';
+
+    char *min = strstr(out, ".min.");
+    if (min) {
+        memmove(min, min + 4, strlen(min + 4) + 1);
+    }
+
+    const char *slash = strrchr(out, '/');
+    if (strchr(slash, '.') == NULL) {
+        if (strlcat(out, ".html", out_len) >= out_len) return false;
+    }
+    return true;
+}
+
+static const web_asset_t* find_embedded_asset(const char *path) {
+    for (size_t i = 0; i < web_assets_count; i++) {
+        if (strcmp(web_assets[i].uri, path) == 0) {
+            return &web_assets[i];
+        }
+    }
+    return NULL;
+}
+
+// Single wildcard handler for the UI: sends embedded assets straight from
+// memory-mapped flash, anything else falls back to SPIFFS
+static esp_err_t static_asset_handler(httpd_req_t *req) {
+    char path[48];
+    if (!canonical_asset_path(req->uri, path, sizeof(path))) {
+        httpd_resp_send_404(req);
+        return ESP_FAIL;
+    }
+
+    const web_asset_t *asset = find_embedded_asset(path);
+    if (asset && (!asset->gzip || req_header_contains(req, "Accept-Encoding", "gzip"))) {
+        char etag[28];
+        if (send_not_modified(req, asset->hash, asset->gzip, etag, sizeof(etag))) {
+            return ESP_OK;
+        }
+        httpd_resp_set_type(req, asset->mime);
+        if (asset->gzip) {
+            httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+        }
+        return httpd_resp_send(req, (const char *)asset->data, asset->len);
+    }
+
+    // SPIFFS keeps the minified name for html/css/js
+    char filepath[64];
+    const char *ext = strrchr(path, '.');
+    const char *mime = mime_from_path(path);
+    if (strcmp(mime, "text/html") == 0 || strcmp(mime, "text/css") == 0 ||
+        strcmp(mime, "application/javascript") == 0) {
+        snprintf(filepath, sizeof(filepath), "/spiffs%.*s.min%s", (int)(ext - path), path, ext);
+    } else {
+        snprintf(filepath, sizeof(filepath), "/spiffs%s", path);
+    }
+    return serve_spiffs_file(req, filepath, mime);
+}
+#endif
 
 void web_server_start(void) {
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
-    config.max_uri_handlers = 20;
+    // As many as can be instrumented; 33 are used (19 with embedded assets)
+    config.max_uri_handlers = METRICS_MAX_ENDPOINTS;
+    // Several dashboards at once: each holds an event stream and opens a
+    // few more sockets while a page loads. httpd keeps three of lwIP's
+    // sockets for itself.
+#ifdef CONFIG_LWIP_MAX_SOCKETS
+    config.max_open_sockets = CONFIG_LWIP_MAX_SOCKETS - 3;
+#endif
+    // When they are all taken, close the least recently used one rather
+    // than refuse the new client
+    config.lru_purge_enable = true;
+    // Find phones that left without closing, so their sockets come back
+    config.keep_alive_enable = true;
+    config.keep_alive_idle = 10;
+    config.keep_alive_interval = 5;
+    config.keep_alive_count = 3;
+#if WEB_EMBED_ASSETS
+    config.uri_match_fn = httpd_uri_match_wildcard;
+#endif
     httpd_handle_t server = NULL;
 
+    if (web_workers_start() != ESP_OK) {
+        ESP_LOGW(TAG, "Web workers missing, long requests run on the httpd task");
+    }
+
     if (httpd_start(&server, &config) == ESP_OK) {
-        // Web UI endpoints
+        // API endpoints
+        httpd_uri_t api_status_uri = {
+            .uri = "/api/status",
+            .method = HTTP_GET,
+            .handler = api_status_handler
+        };
+        metrics_register_uri(server, &api_status_uri);
+        
+        httpd_uri_t api_relay_uri = {
+            .uri = "/api/relay",
+            .method = HTTP_GET,
+            .handler = api_relay_handler
+        };
+        metrics_register_uri(server, &api_relay_uri);
+
+        // The same two in CBOR, for integrations that poll often
+        httpd_uri_t api_v2_status_uri = {
+            .uri = "/api/v2/status",
+            .method = HTTP_GET,
+            .handler = api_status_handler
+        };
+        metrics_register_uri(server, &api_v2_status_uri);
+
+        httpd_uri_t api_v2_relay_uri = {
+            .uri = "/api/v2/relay",
+            .method = HTTP_GET,
+            .handler = api_relay_handler
+        };
+        metrics_register_uri(server, &api_v2_relay_uri);
+
+        httpd_uri_t api_relays_uri = {
+            .uri = "/api/relays",
+            .method = HTTP_POST,
+            .handler = api_relays_handler
+        };
+        metrics_register_uri(server, &api_relays_uri);
+
+        httpd_uri_t api_routines_uri = {
+            .uri = "/api/routines",
+            .method = HTTP_GET,
+            .handler = api_routines_handler
+        };
+        metrics_register_uri(server, &api_routines_uri);
+
+        httpd_uri_t api_routines_post_uri = {
+            .uri = "/api/routines",
+            .method = HTTP_POST,
+            .handler = api_routines_handler
+        };
+        metrics_register_uri(server, &api_routines_post_uri);
+
+        httpd_uri_t api_schedules_uri = {
+            .uri = "/api/schedules",
+            .method = HTTP_GET,
+            .handler = api_schedules_handler
+        };
+        metrics_register_uri(server, &api_schedules_uri);
+
+        httpd_uri_t api_schedules_post_uri = {
+            .uri = "/api/schedules",
+            .method = HTTP_POST,
+            .handler = api_schedules_handler
+        };
+        metrics_register_uri(server, &api_schedules_post_uri);
+
+        httpd_uri_t api_mqtt_uri = {
+            .uri = "/api/mqtt",
+            .method = HTTP_GET,
+            .handler = api_mqtt_handler
+        };
+        metrics_register_uri(server, &api_mqtt_uri);
+
+        httpd_uri_t api_mqtt_post_uri = {
+            .uri = "/api/mqtt",
+            .method = HTTP_POST,
+            .handler = api_mqtt_handler
+        };
+        metrics_register_uri(server, &api_mqtt_post_uri);
+
+        httpd_uri_t api_zones_uri = {
+            .uri = "/api/zones",
+            .method = HTTP_GET,
+            .handler = api_zones_handler
+        };
+        metrics_register_uri(server, &api_zones_uri);
+
+        httpd_uri_t api_moisture_uri = {
+            .uri = "/api/moisture",
+            .method = HTTP_GET,
+            .handler = api_moisture_handler
+        };
+        metrics_register_uri(server, &api_moisture_uri);
+
+        httpd_uri_t api_history_uri = {
+            .uri = "/api/history",
+            .method = HTTP_GET,
+            .handler = api_history_handler
+        };
+        web_workers_register_uri(server, &api_history_uri);
+        
+        httpd_uri_t api_ota_uri = {
+            .uri = "/api/ota",
+            .method = HTTP_POST,
+            .handler = api_ota_handler
+        };
+        web_workers_register_uri(server, &api_ota_uri);
+
+        httpd_uri_t api_routine_control_uri = {
+            .uri = "/api/routine/control",
+            .method = HTTP_GET,
+            .handler = api_routine_control_handler
+        };
+        metrics_register_uri(server, &api_routine_control_uri);
+
+        if (event_stream_register(server) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to start event stream");
+        }
+
+        if (metrics_register(server) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to register /metrics");
+        }
+
+#if WEB_EMBED_ASSETS
+        // Web UI: one wildcard handler, registered last so the API wins.
+        // A slow client can take a while over the larger assets.
+        httpd_uri_t static_uri = {
+            .uri = "/*",
+            .method = HTTP_GET,
+            .handler = static_asset_handler
+        };
+        web_workers_register_uri(server, &static_uri);
+#else
+        // Web UI endpoints, served from SPIFFS on the web workers
         httpd_uri_t index_uri = {
             .uri = "/",
             .method = HTTP_GET,
             .handler = index_handler
         };
-        httpd_register_uri_handler(server, &index_uri);
+        web_workers_register_uri(server, &index_uri);
 
         httpd_uri_t update_page_uri = {
             .uri = "/update",
             .method = HTTP_GET,
             .handler = update_handler
         };
-        httpd_register_uri_handler(server, &update_page_uri);
+        web_workers_register_uri(server, &update_page_uri);
 
         httpd_uri_t update_min_page_uri = {
             .uri = "/update.min.html",
             .method = HTTP_GET,
             .handler = update_handler
         };
-        httpd_register_uri_handler(server, &update_min_page_uri);
+        web_workers_register_uri(server, &update_min_page_uri);
 
         httpd_uri_t update_js_uri = {
             .uri = "/update.js",
             .method = HTTP_GET,
             .handler = update_js_handler
         };
-        httpd_register_uri_handler(server, &update_js_uri);
+        web_workers_register_uri(server, &update_js_uri);
 
         httpd_uri_t update_min_js_uri = {
             .uri = "/update.min.js",
             .method = HTTP_GET,
             .handler = update_js_handler
         };
-        httpd_register_uri_handler(server, &update_min_js_uri);
+        web_workers_register_uri(server, &update_min_js_uri);
 
         httpd_uri_t routine_page_uri = {
             .uri = "/routine",
             .method = HTTP_GET,
             .handler = routine_handler
         };
-        httpd_register_uri_handler(server, &routine_page_uri);
+        web_workers_register_uri(server, &routine_page_uri);
 
         httpd_uri_t style_min_uri = {
             .uri = "/style.css",
             .method = HTTP_GET,
             .handler = style_handler
         };
-        httpd_register_uri_handler(server, &style_min_uri);
+        web_workers_register_uri(server, &style_min_uri);
 
         httpd_uri_t ap_min_js_uri = {
             .uri = "/app.js",
             .method = HTTP_GET,
             .handler = app_js_handler
         };
-        httpd_register_uri_handler(server, &ap_min_js_uri);
+        web_workers_register_uri(server, &ap_min_js_uri);
 
         httpd_uri_t routine_min_js_uri = {
             .uri = "/routine.js",
             .method = HTTP_GET,
             .handler = routine_js_handler
         };
-        httpd_register_uri_handler(server, &routine_min_js_uri);
+        web_workers_register_uri(server, &routine_min_js_uri);
 
         httpd_uri_t helpers_js_uri = {
             .uri = "/helpers.js",
             .method = HTTP_GET,
             .handler = helpers_js_handler
         };
-        httpd_register_uri_handler(server, &helpers_js_uri);
+        web_workers_register_uri(server, &helpers_js_uri);
 
         httpd_uri_t helpers_min_js_uri = {
             .uri = "/helpers.min.js",
             .method = HTTP_GET,
             .handler = helpers_js_handler
         };
-        httpd_register_uri_handler(server, &helpers_min_js_uri);
+        web_workers_register_uri(server, &helpers_min_js_uri);
 
         httpd_uri_t style_uri = {
             .uri = "/style.min.css",
             .method = HTTP_GET,
             .handler = style_handler
         };
-        httpd_register_uri_handler(server, &style_uri);
+        web_workers_register_uri(server, &style_uri);
 
         httpd_uri_t app_js_uri = {
             .uri = "/app.min.js",
             .method = HTTP_GET,
             .handler = app_js_handler
         };
-        httpd_register_uri_handler(server, &app_js_uri);
+        web_workers_register_uri(server, &app_js_uri);
 
         httpd_uri_t routine_js_uri = {
             .uri = "/routine.min.js",
             .method = HTTP_GET,
             .handler = routine_js_handler
         };
-        httpd_register_uri_handler(server, &routine_js_uri);
-
-        // API endpoints
-        httpd_uri_t api_status_uri = {
-            .uri = "/api/status",
-            .method = HTTP_GET,
-            .handler = api_status_handler
-        };
-        httpd_register_uri_handler(server, &api_status_uri);
-        
-        httpd_uri_t api_relay_uri = {
-            .uri = "/api/relay",
-            .method = HTTP_GET,
-            .handler = api_relay_handler
-        };
-        httpd_register_uri_handler(server, &api_relay_uri);
-
-        httpd_uri_t api_routines_uri = {
-            .uri = "/api/routines",
-            .method = HTTP_GET,
-            .handler = api_routines_handler
-        };
-        httpd_register_uri_handler(server, &api_routines_uri);
-
-        httpd_uri_t api_routines_post_uri = {
-            .uri = "/api/routines",
-            .method = HTTP_POST,
-            .handler = api_routines_handler
-        };
-        httpd_register_uri_handler(server, &api_routines_post_uri);
-        
-        httpd_uri_t api_ota_uri = {
-            .uri = "/api/ota",
-            .method = HTTP_POST,
-            .handler = api_ota_handler
-        };
-        httpd_register_uri_handler(server, &api_ota_uri);
-
-        httpd_uri_t api_routine_control_uri = {
-            .uri = "/api/routine/control",
-            .method = HTTP_GET,
-            .handler = api_routine_control_handler
-        };
-        httpd_register_uri_handler(server, &api_routine_control_uri);
+        web_workers_register_uri(server, &routine_js_uri);
 
         httpd_uri_t favicon_uri = {
             .uri = "/favicon.ico",
             .method = HTTP_GET,
             .handler = favicon_handler
         };
-        httpd_register_uri_handler(server, &favicon_uri);
-        
+        web_workers_register_uri(server, &favicon_uri);
+#endif
+
         ESP_LOGI(TAG, "Web server started with API endpoints");
     }
 }
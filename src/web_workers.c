@@ -0,0 +1,144 @@
+#include "web_workers.h"
+#include "metrics.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+static const char *TAG = "WEB_WORKERS";
+
+// The instrumented handler behind a deferred URI
+typedef struct {
+    esp_err_t (*handler)(httpd_req_t *req);
+    void *user_ctx;
+} binding_t;
+
+// A request waiting for a worker: the async copy and what to run on it
+typedef struct {
+    httpd_req_t *req;
+    const binding_t *binding;
+} job_t;
+
+typedef struct {
+    TaskHandle_t task;
+    bool idle;                  // Waiting for a notification, under the lock
+} worker_t;
+
+// The queue and the idle flags are shared under the lock. Only the httpd
+// task adds to the queue; the workers take from it.
+static portMUX_TYPE workers_lock = portMUX_INITIALIZER_UNLOCKED;
+static worker_t workers[WEB_WORKERS];
+static job_t queue[WEB_WORKERS_QUEUE];
+static uint32_t queue_head = 0, queue_tail = 0;   // Added and taken, in all
+static binding_t bindings[WEB_WORKERS_MAX_URIS];
+static int num_bindings = 0;
+static bool started = false;       // A worker runs; set before the server starts
+
+static void worker_task(void *pvParameters) {
+    worker_t *self = pvParameters;
+    for (;;) {
+        job_t job = {0};
+        portENTER_CRITICAL(&workers_lock);
+        bool found = queue_head != queue_tail;
+        if (found) {
+            job = queue[queue_tail % WEB_WORKERS_QUEUE];
+            queue_tail++;
+        }
+        self->idle = !found;
+        portEXIT_CRITICAL(&workers_lock);
+        if (!found) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        job.req->user_ctx = job.binding->user_ctx;
+        job.binding->handler(job.req);
+        // Hands the socket back to the server and frees the copy
+        httpd_req_async_handler_complete(job.req);
+    }
+}
+
+// Turns the request away without reading its body; the client may try
+// again in a moment
+static esp_err_t send_busy(httpd_req_t *req) {
+    httpd_resp_set_status(req, "503 Service Unavailable");
+    httpd_resp_set_type(req, "text/plain");
+    httpd_resp_set_hdr(req, "Retry-After", "1");
+    httpd_resp_sendstr(req, "Server busy, try again");
+    return ESP_FAIL;
+}
+
+// Runs on the httpd task: queues a copy of the request for the workers
+// and returns, so the server moves on to its other sockets. A request is
+// never served here once the workers run, or one upload could hold up
+// every relay command.
+static esp_err_t deferred_handler(httpd_req_t *req) {
+    const binding_t *binding = req->user_ctx;
+    if (!started) {
+        req->user_ctx = binding->user_ctx;
+        return binding->handler(req);
+    }
+
+    portENTER_CRITICAL(&workers_lock);
+    bool room = queue_head - queue_tail < WEB_WORKERS_QUEUE;
+    portEXIT_CRITICAL(&workers_lock);
+    httpd_req_t *copy = NULL;
+    if (!room || httpd_req_async_handler_begin(req, &copy) != ESP_OK) {
+        ESP_LOGW(TAG, "No room to queue %s", req->uri);
+        return send_busy(req);
+    }
+
+    // Still room: the workers only ever free slots
+    TaskHandle_t wake = NULL;
+    portENTER_CRITICAL(&workers_lock);
+    queue[queue_head % WEB_WORKERS_QUEUE] = (job_t){ .req = copy, .binding = binding };
+    queue_head++;
+    for (int i = 0; i < WEB_WORKERS && wake == NULL; i++) {
+        if (workers[i].idle) {
+            workers[i].idle = false;
+            wake = workers[i].task;
+        }
+    }
+    portEXIT_CRITICAL(&workers_lock);
+    // With none idle, the next worker to finish takes it
+    if (wake) xTaskNotifyGive(wake);
+    return ESP_OK;
+}
+
+esp_err_t web_workers_start(void) {
+    for (int i = 0; i < WEB_WORKERS; i++) {
+        if (workers[i].task != NULL) continue;
+        char name[16];
+        snprintf(name, sizeof(name), "web_worker_%d", i);
+        // One below the httpd task, so a control call preempts a busy worker
+        if (xTaskCreate(worker_task, name, WEB_WORKER_STACK, &workers[i], 4, &workers[i].task) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create %s", name);
+            workers[i].task = NULL;
+            return ESP_ERR_NO_MEM;
+        }
+        // One worker is enough to queue for
+        started = true;
+    }
+    return ESP_OK;
+}
+
+esp_err_t web_workers_register_uri(httpd_handle_t server, const httpd_uri_t *uri) {
+    if (num_bindings >= WEB_WORKERS_MAX_URIS) {
+        ESP_LOGW(TAG, "No room to defer %s", uri->uri);
+        return metrics_register_uri(server, uri);
+    }
+    httpd_uri_t instrumented;
+    metrics_instrument_uri(uri, &instrumented);
+    binding_t *binding = &bindings[num_bindings];
+    *binding = (binding_t){
+        .handler = instrumented.handler,
+        .user_ctx = instrumented.user_ctx,
+    };
+    httpd_uri_t deferred = *uri;
+    deferred.handler = deferred_handler;
+    deferred.user_ctx = binding;
+    esp_err_t err = httpd_register_uri_handler(server, &deferred);
+    if (err == ESP_OK) num_bindings++;
+    return err;
+}
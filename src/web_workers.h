@@ -0,0 +1,26 @@
+#pragma once
+
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+#define WEB_WORKERS 2               // Long requests served at once
+#define WEB_WORKERS_MAX_URIS 20     // Handlers that can be deferred
+#define WEB_WORKERS_QUEUE 8         // Requests waiting for a worker
+#define WEB_WORKER_STACK 5120
+
+// esp_http_server runs every handler on its one task, so a long upload or
+// a file going out to a slow client holds up every other request,
+// including relay commands. Handlers registered here run on a small pool
+// of worker tasks instead (async requests), leaving the httpd task free
+// for the short control and status calls. A handler may run on any
+// worker, two at once, so it must not share static buffers.
+
+// Creates the workers. Without them, deferred handlers run on the httpd
+// task as before.
+esp_err_t web_workers_start(void);
+
+// Like metrics_register_uri(), but the handler runs on a worker. When all
+// are busy the request waits its turn in a queue, holding its socket;
+// with the queue full it gets a 503 with Retry-After. It never runs on
+// the httpd task while the workers are up.
+esp_err_t web_workers_register_uri(httpd_handle_t server, const httpd_uri_t *uri);
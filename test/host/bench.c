@@ -0,0 +1,1588 @@
+// Host microbenchmark for the relay controller, the JSON encoders and the
+// HTTP handlers. Time is wall-clock on the host, so only compare numbers
+// from the same machine; wakeups, latencies in ticks, allocations and
+// bytes are deterministic and carry over to the device.
+
+#include "sim.h"
+#include "relay_controller.h"
+#include "relay_safety.h"
+#include "json_writer.h"
+#include "status_json.h"
+#include "status_cbor.h"
+#include "event_stream.h"
+#include "routine_store.h"
+#include "scheduler.h"
+#include "journal.h"
+#include "history.h"
+#include "metrics.h"
+#include "mqtt_bridge.h"
+#include "web_server.h"
+#include "driver/gpio.h"
+#include "esp_system.h"
+#include "esp_task_wdt.h"
+#include "mbedtls/sha256.h"
+#include <zlib.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef HAVE_CJSON
+#include "cJSON.h"
+#endif
+
+// The GPIO backend's relays
+#define BENCH_ZONES 4
+static const int relay_gpio[BENCH_ZONES] = {6, 7, 5, 10};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void report(const char *what, uint64_t ns, int iterations, uint32_t allocs, uint64_t bytes) {
+    printf("  %-34s %9.0f ns/op  %6.2f allocs/op  %8.1f heap B/op\n", what,
+           (double)ns / iterations, (double)allocs / iterations, (double)bytes / iterations);
+}
+
+// --- GPIO timestamps -------------------------------------------------------
+
+static TickType_t gpio_changed_at[SIM_GPIO_COUNT];
+static uint32_t relay_on_count;
+
+static void on_gpio(int gpio, uint32_t level) {
+    gpio_changed_at[gpio] = sim_now();
+    if (level == 0) relay_on_count++;   // Relays are active low
+}
+
+// --- Routine engine --------------------------------------------------------
+
+static routine_step_t bench_steps[BENCH_ZONES];
+
+// The step watering now; these routines run one step at a time
+static int current_step(void) {
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    return snap.active_steps ? __builtin_ctzll(snap.active_steps) : __builtin_popcountll(snap.done_steps);
+}
+
+static void start_bench_routine(uint16_t step_sec) {
+    for (int i = 0; i < BENCH_ZONES; i++) {
+        bench_steps[i].relay_id = i;
+        bench_steps[i].duration_sec = step_sec;
+        snprintf(bench_steps[i].name, sizeof(bench_steps[i].name), "Zone %d", i + 1);
+    }
+    relay_start_routine("Bench", bench_steps, BENCH_ZONES);
+    sim_idle();
+}
+
+// The routine task logs what it is about to do: a step it readies before
+// switching the relay on, a skip before switching it off, the end before
+// marking the routine finished. Stopping the routine from the log line
+// lands between the two.
+enum { THEN_NOTHING, THEN_RESTART, THEN_MANUAL };
+static const char *stop_at;     // Log format to stop at, NULL for none
+static int lines_to_pass;
+static int stop_then;
+
+static void stop_and(int then) {
+    relay_stop_routine();
+    if (then == THEN_RESTART) {
+        // A routine of one step on relay 4
+        static routine_step_t step = {.relay_id = 3, .duration_sec = 600, .name = "Restart"};
+        relay_start_routine("Restart", &step, 1);
+    } else if (then == THEN_MANUAL) {
+        relay_on(0);
+    }
+}
+
+static void on_routine_log(const char *tag, const char *fmt) {
+    if (stop_at == NULL || strcmp(tag, "ROUTINE") != 0 || strncmp(fmt, stop_at, strlen(stop_at)) != 0) return;
+    if (lines_to_pass-- != 0) return;
+    stop_at = NULL;
+    stop_and(stop_then);
+}
+
+// Relay 4 on for THEN_RESTART, relay 1 for THEN_MANUAL, else none
+static void check_after_stop(const char *label, int then) {
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    printf("  %-34s relays on 0x%llx, routine %s\n", label, (unsigned long long)snap.on_mask,
+           snap.routine_running ? "running" : "stopped");
+    relay_mask_t expect = then == THEN_RESTART ? RELAY_BIT(3) : then == THEN_MANUAL ? RELAY_BIT(0) : 0;
+    if (snap.on_mask != expect || snap.routine_running != (then == THEN_RESTART)) {
+        sim_fail("relays after the stop");
+    }
+    relay_stop_routine();
+    relay_off(0);
+    sim_advance(pdMS_TO_TICKS(2000));
+}
+
+// Runs a routine of 5 s steps, skipping in the first one if skip, for
+// run_ms and stops it at the (lines + 1)th log line starting with at
+static void stop_mid_routine(const char *label, const char *at, int lines, int then, bool skip,
+                             uint32_t run_ms) {
+    stop_at = at;
+    lines_to_pass = lines;
+    stop_then = then;
+    sim_set_log_hook(on_routine_log);
+    start_bench_routine(5);
+    if (skip) {
+        sim_advance(pdMS_TO_TICKS(2000));
+        relay_skip_routine_step();
+    }
+    sim_advance(pdMS_TO_TICKS(run_ms));
+    sim_set_log_hook(NULL);
+    stop_at = NULL;
+    check_after_stop(label, then);
+}
+
+static void bench_routine(void) {
+    printf("\nRoutine engine (virtual time, 1 tick = 1 ms)\n");
+
+    // Four 15 minute steps: one simulated hour of watering
+    start_bench_routine(15 * 60);
+    sim_reset_wakeups();
+    uint64_t t0 = now_ns();
+    sim_advance(pdMS_TO_TICKS(60 * 60 * 1000));
+    uint64_t wall = now_ns() - t0;
+    printf("  routine_task wakeups per hour:     %lu\n", (unsigned long)sim_task_wakeups("routine_task"));
+    printf("  host time to simulate the hour:    %.1f ms\n", wall / 1e6);
+    relay_stop_routine();
+    sim_advance(pdMS_TO_TICKS(5000));
+
+    // Skip/stop latency: request at several phases within a step and
+    // measure until the step's relay output actually switches off
+    const int trials = 20;
+    TickType_t skip_max = 0, next_max = 0, stop_max = 0;
+    uint64_t skip_sum = 0, next_sum = 0, stop_sum = 0;
+    for (int t = 0; t < trials; t++) {
+        start_bench_routine(600);
+        sim_advance(pdMS_TO_TICKS(10000 + t * 37));
+        int step = current_step();
+        int gpio = relay_gpio[step];
+        int next_gpio = relay_gpio[step + 1];
+        TickType_t requested = sim_now();
+        gpio_changed_at[gpio] = 0;
+        gpio_changed_at[next_gpio] = 0;
+        relay_skip_routine_step();
+        sim_advance(pdMS_TO_TICKS(1000));
+        TickType_t latency = gpio_changed_at[gpio] ? gpio_changed_at[gpio] - requested : pdMS_TO_TICKS(1000);
+        skip_sum += latency;
+        if (latency > skip_max) skip_max = latency;
+        latency = gpio_changed_at[next_gpio] ? gpio_changed_at[next_gpio] - requested : pdMS_TO_TICKS(1000);
+        next_sum += latency;
+        if (latency > next_max) next_max = latency;
+
+        sim_advance(pdMS_TO_TICKS(5000 + t * 53));
+        gpio = relay_gpio[current_step()];
+        requested = sim_now();
+        gpio_changed_at[gpio] = 0;
+        relay_stop_routine();
+        sim_advance(pdMS_TO_TICKS(1000));
+        latency = gpio_changed_at[gpio] ? gpio_changed_at[gpio] - requested : pdMS_TO_TICKS(1000);
+        stop_sum += latency;
+        if (latency > stop_max) stop_max = latency;
+        sim_advance(pdMS_TO_TICKS(2000));
+    }
+    printf("  skip -> relay off latency:         avg %.1f ms, max %lu ms (%d trials)\n",
+           (double)skip_sum / trials, (unsigned long)skip_max, trials);
+    printf("  skip -> next step on latency:      avg %.1f ms, max %lu ms\n",
+           (double)next_sum / trials, (unsigned long)next_max);
+    printf("  stop -> relay off latency:         avg %.1f ms, max %lu ms (%d trials)\n",
+           (double)stop_sum / trials, (unsigned long)stop_max, trials);
+
+    // Stops the routine task only sees once it is done with what it was at
+    stop_mid_routine("stop while step 2 starts:", "Step %d: Watering", 1, THEN_NOTHING, false, 7000);
+    stop_mid_routine("stop and restart then:", "Step %d: Watering", 1, THEN_RESTART, false, 7000);
+    stop_mid_routine("stop, zone 1 on by hand at a skip:", "Step %d skipped", 0, THEN_MANUAL, true, 3000);
+    stop_mid_routine("stop and restart as it finishes:", "Routine '%s' finished", 0, THEN_RESTART, false,
+                     22000);
+    // And one it sleeps through
+    start_bench_routine(5);
+    sim_advance(pdMS_TO_TICKS(2000));
+    stop_and(THEN_RESTART);
+    sim_advance(pdMS_TO_TICKS(1000));
+    check_after_stop("stop and restart while it waits:", THEN_RESTART);
+}
+
+// --- JSON encoding ---------------------------------------------------------
+
+static size_t sink_bytes;
+
+static bool sink_flush(void *ctx, const char *buf, size_t len) {
+    sink_bytes += len;
+    return true;
+}
+
+#ifdef HAVE_CJSON
+// The /api/status encoder as it was before json_writer
+static char *status_cjson(void) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON *relays_arr = cJSON_AddArrayToObject(root, "relays");
+    relay_snapshot_t snap;
+    static routine_state_t state;
+    routine_state_t *rs = &state;
+    relay_snapshot(&snap, rs);
+    for (int i = 0; i < BENCH_ZONES; i++) {
+        relay_mode_t mode = relay_snapshot_mode(&snap, i);
+        uint32_t remaining = relay_snapshot_remaining(&snap, i);
+        cJSON *relay = cJSON_CreateObject();
+        cJSON_AddNumberToObject(relay, "id", i);
+        cJSON_AddStringToObject(relay, "state", (mode != RELAY_MODE_OFF) ? "on" : "off");
+        cJSON_AddStringToObject(relay, "mode", relay_mode_to_str(mode));
+        cJSON_AddNumberToObject(relay, "rem", remaining);
+        cJSON_AddItemToArray(relays_arr, relay);
+    }
+    cJSON *routine = cJSON_AddObjectToObject(root, "routine");
+    cJSON_AddBoolToObject(routine, "running", rs->is_running);
+    if (rs->is_running) {
+        cJSON_AddStringToObject(routine, "name", rs->name);
+        cJSON *active_arr = cJSON_AddArrayToObject(routine, "activeSteps");
+        cJSON *done_arr = cJSON_AddArrayToObject(routine, "doneSteps");
+        for (int i = 0; i < rs->num_steps; i++) {
+            if (rs->active_steps & STEP_BIT(i)) cJSON_AddItemToArray(active_arr, cJSON_CreateNumber(i));
+            if (rs->done_steps & STEP_BIT(i)) cJSON_AddItemToArray(done_arr, cJSON_CreateNumber(i));
+        }
+        cJSON_AddNumberToObject(routine, "numSteps", rs->num_steps);
+        cJSON *steps_arr = cJSON_AddArrayToObject(routine, "steps");
+        for (int i = 0; i < rs->num_steps; i++) {
+            cJSON *step = cJSON_CreateObject();
+            cJSON_AddStringToObject(step, "name", rs->steps[i].name);
+            cJSON_AddNumberToObject(step, "id", rs->steps[i].relay_id);
+            cJSON_AddNumberToObject(step, "duration", rs->steps[i].duration_sec / 60);
+            cJSON_AddItemToArray(steps_arr, step);
+        }
+    }
+    char *out = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return out;
+}
+#endif
+
+static void bench_json(void) {
+    const int iterations = 200000;
+    static char buf[1024];
+
+    printf("\n/api/status encoding (routine running, 4 steps)\n");
+    start_bench_routine(600);
+    sim_advance(pdMS_TO_TICKS(1000));
+
+    json_writer_t w;
+    sim_heap_reset();
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        sink_bytes = 0;
+        json_writer_init(&w, buf, sizeof(buf), sink_flush, NULL);
+        status_json_write(&w);
+        json_writer_flush(&w);
+    }
+    report("json_writer", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    printf("  document size: %zu bytes\n", sink_bytes);
+
+    // The read side of every status document and event
+    relay_snapshot_t snap;
+    static routine_state_t rs;
+    uint32_t steps = 0;
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        relay_snapshot(&snap, &rs);
+        steps += rs.num_steps;
+    }
+    report("relay_snapshot (with routine)", now_ns() - t0, iterations, 0, 0);
+    if (steps != (uint32_t)iterations * BENCH_ZONES) sim_fail("routine copy");
+
+#ifdef HAVE_CJSON
+    sim_heap_reset();
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        free(status_cjson());
+    }
+    report("cJSON build + PrintUnformatted", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+#else
+    printf("  cJSON baseline skipped (configure with CJSON_DIR or IDF_PATH)\n");
+#endif
+
+    relay_stop_routine();
+    sim_advance(pdMS_TO_TICKS(2000));
+}
+
+// --- HTTP handlers ---------------------------------------------------------
+
+static void bench_request(const char *label, httpd_method_t method, const char *uri, int iterations) {
+    const sim_response_t *resp = NULL;
+    sim_heap_reset();
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        resp = sim_httpd_request(method, uri, NULL, NULL, 0);
+    }
+    report(label, now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    if (resp->status != 200) {
+        sim_fail("status %d for %s", resp->status, uri);
+    }
+}
+
+static void bench_http(void) {
+    printf("\nHTTP handlers (in-process dispatch, response captured in RAM)\n");
+    bench_request("GET /api/status", HTTP_GET, "/api/status", 50000);
+    bench_request("GET /api/relay?id=2&action=on", HTTP_GET, "/api/relay?id=2&action=on", 50000);
+    bench_request("GET /api/relay?id=2&action=off", HTTP_GET, "/api/relay?id=2&action=off", 50000);
+
+    // Event stream fan-out: three subscribers, one relay change per flush
+    int fds[MAX_EVENT_CLIENTS];
+    for (int i = 0; i < MAX_EVENT_CLIENTS; i++) {
+        fds[i] = sim_httpd_request(HTTP_GET, "/api/events", NULL, NULL, 0)->sockfd;
+    }
+    const int iterations = 50000;
+    size_t before = sim_httpd_socket_bytes(fds[0]);
+    sim_heap_reset();
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        if (i & 1) relay_off(3); else relay_on(3);
+        sim_idle();
+    }
+    report("relay change -> 3 SSE clients", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    printf("  event size per client: %.1f bytes\n",
+           (double)(sim_httpd_socket_bytes(fds[0]) - before) / iterations);
+
+    // A routine stop switches every relay and the routine at once; the
+    // listener coalesces that into one frame
+    start_bench_routine(600);
+    sim_advance(pdMS_TO_TICKS(1000));
+    before = sim_httpd_socket_bytes(fds[0]);
+    relay_stop_routine();
+    sim_idle();
+    printf("  routine stop burst per client: %zu bytes\n", sim_httpd_socket_bytes(fds[0]) - before);
+
+    for (int i = 0; i < MAX_EVENT_CLIENTS; i++) {
+        sim_httpd_close(fds[i]);
+    }
+}
+
+// --- CBOR status -------------------------------------------------------------
+
+static bool cbor_sink_flush(void *ctx, const uint8_t *buf, size_t len) {
+    sink_bytes += len;
+    return true;
+}
+
+static uint32_t status_version(void) {
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    return snap.version;
+}
+
+// One /api/v2/status poll
+static const sim_response_t *v2_poll(const char *label, uint32_t since, bool delta) {
+    char uri[48];
+    if (delta) {
+        snprintf(uri, sizeof(uri), "/api/v2/status?since=%lu", (unsigned long)since);
+    } else {
+        snprintf(uri, sizeof(uri), "/api/v2/status");
+    }
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, uri, NULL, NULL, 0);
+    if (resp->status != 200 || strcmp(resp->content_type, "application/cbor") != 0) {
+        sim_fail("%d %s for %s", resp->status, resp->content_type, uri);
+    }
+    if (label) printf("  %-34s %zu bytes\n", label, resp->body_len);
+    return resp;
+}
+
+static void bench_cbor(void) {
+    const int iterations = 200000;
+    static uint8_t buf[1024];
+
+    printf("\nCBOR status (/api/v2/status)\n");
+    start_bench_routine(600);
+    sim_advance(pdMS_TO_TICKS(1000));
+
+    cbor_writer_t w;
+    sim_heap_reset();
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        sink_bytes = 0;
+        cbor_writer_init(&w, buf, sizeof(buf), cbor_sink_flush, NULL);
+        status_cbor_write(&w, false, 0);
+        cbor_writer_flush(&w);
+    }
+    report("status_cbor_write, full", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    printf("  document size: %zu bytes\n", sink_bytes);
+
+    uint32_t v = status_version();
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        sink_bytes = 0;
+        cbor_writer_init(&w, buf, sizeof(buf), cbor_sink_flush, NULL);
+        status_cbor_write(&w, true, v);
+        cbor_writer_flush(&w);
+    }
+    report("status_cbor_write, unchanged", now_ns() - t0, iterations, 0, 0);
+    printf("  document size: %zu bytes\n", sink_bytes);
+
+    bench_request("GET /api/v2/status", HTTP_GET, "/api/v2/status", 50000);
+
+    printf("  body per poll, routine running (JSON %zu bytes):\n",
+           sim_httpd_request(HTTP_GET, "/api/status", NULL, NULL, 0)->body_len);
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/api/status", "Accept: application/cbor\n", NULL, 0);
+    printf("  %-34s %zu bytes, %s\n", "Accept: application/cbor:", resp->body_len, resp->content_type);
+    v2_poll("full:", 0, false);
+    v = status_version();
+    resp = v2_poll("since=<current>, unchanged:", v, true);
+    // {"version": v} and nothing else
+    if (resp->body_len != 14 || (uint8_t)resp->body[0] != 0xa1) sim_fail("delta layout");
+
+    relay_on(3);
+    v2_poll("since=<current>, relay 3 on:", v, true);
+    v = status_version();
+    relay_skip_routine_step();
+    sim_idle();
+    v2_poll("since=<current>, step skipped:", v, true);
+    v2_poll("since=<stale, from before reset>:", v + 0x40000000u, true);
+
+    resp = sim_httpd_request(HTTP_GET, "/api/v2/status?since=abc", NULL, NULL, 0);
+    printf("  %-34s %d \"%.*s\"\n", "since=abc:", resp->status, (int)resp->body_len, resp->body);
+    resp = sim_httpd_request(HTTP_GET, "/api/v2/relay?id=3&action=off", NULL, NULL, 0);
+    printf("  %-34s %d, %zu bytes\n", "GET /api/v2/relay?id=3&action=off", resp->status, resp->body_len);
+
+    relay_stop_routine();
+    sim_advance(pdMS_TO_TICKS(2000));
+}
+
+// --- Batched relay commands ------------------------------------------------
+
+static void bench_batch(void) {
+    printf("\nBatched relay commands (POST /api/relays vs one GET /api/relay per relay)\n");
+    static const char set[] = "[{\"id\":0,\"action\":\"on\"},"
+                              "{\"id\":1,\"action\":\"timed\",\"duration\":300},"
+                              "{\"id\":2,\"action\":\"timed\",\"duration\":300},"
+                              "{\"id\":3,\"action\":\"off\"}]";
+    static const char clear[] = "[{\"id\":0,\"action\":\"off\"},{\"id\":1,\"action\":\"off\"},"
+                                "{\"id\":2,\"action\":\"off\"},{\"id\":3,\"action\":\"off\"}]";
+    static const char *const singles[] = {
+        "/api/relay?id=0&action=on", "/api/relay?id=1&action=timed&duration=300",
+        "/api/relay?id=2&action=timed&duration=300", "/api/relay?id=3&action=off",
+        "/api/relay?id=0&action=off", "/api/relay?id=1&action=off",
+        "/api/relay?id=2&action=off", "/api/relay?id=3&action=off",
+    };
+    const int iterations = 20000;
+
+    const sim_response_t *resp = NULL;
+    uint32_t writes = sim_gpio_writes;
+    sim_heap_reset();
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        resp = sim_httpd_request(HTTP_POST, "/api/relays", NULL, (i & 1) ? clear : set,
+                                 (i & 1) ? sizeof(clear) - 1 : sizeof(set) - 1);
+        sim_idle();
+    }
+    report("POST /api/relays (4 commands)", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    if (resp->status != 200) sim_fail("status %d", resp->status);
+    printf("  GPIO writes per 4-relay change:    %.1f\n", (double)(sim_gpio_writes - writes) / iterations);
+
+    writes = sim_gpio_writes;
+    sim_heap_reset();
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        for (int r = 0; r < BENCH_ZONES; r++) {
+            resp = sim_httpd_request(HTTP_GET, singles[(i & 1) * BENCH_ZONES + r], NULL, NULL, 0);
+        }
+        sim_idle();
+    }
+    report("4x GET /api/relay", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    printf("  GPIO writes per 4-relay change:    %.1f\n", (double)(sim_gpio_writes - writes) / iterations);
+
+    // Timers armed in one batch expire on the same tick
+    sim_httpd_request(HTTP_POST, "/api/relays", NULL, set, sizeof(set) - 1);
+    bool in_step = relay_get_remaining_time(1) == relay_get_remaining_time(2);
+    printf("  timed relays in step:              %s\n", in_step ? "yes" : "no");
+    if (!in_step) sim_fail("timers out of step");
+
+    // One bad command rejects the whole batch
+    static const char bad[] = "[{\"id\":3,\"action\":\"on\"},{\"id\":9,\"action\":\"on\"}]";
+    resp = sim_httpd_request(HTTP_POST, "/api/relays", NULL, bad, sizeof(bad) - 1);
+    bool untouched = relay_get_mode(3) == RELAY_MODE_OFF;
+    printf("  invalid batch:                     %d, relay 4 %s\n", resp->status, untouched ? "untouched" : "switched");
+    if (resp->status != 400 || !untouched) sim_fail("batch");
+    sim_httpd_request(HTTP_POST, "/api/relays", NULL, clear, sizeof(clear) - 1);
+    sim_idle();
+}
+
+// --- Routine uploads -------------------------------------------------------
+
+static const char *zone_names[BENCH_ZONES] = {"Front Lawn", "Back Garden", "Vegetables", "Drip Line"};
+static char routines_doc[SIM_RESP_MAX * 4];
+
+// The shape routine.js posts: every step carries a name, order and flag
+static size_t make_routines(int num_routines, int steps_per_routine) {
+    size_t len = 0;
+    len += snprintf(routines_doc + len, sizeof(routines_doc) - len, "[");
+    for (int r = 0; r < num_routines; r++) {
+        len += snprintf(routines_doc + len, sizeof(routines_doc) - len,
+                        "%s{\"name\":\"Routine %d\",\"steps\":[", r ? "," : "", r + 1);
+        for (int s = 0; s < steps_per_routine; s++) {
+            int id = (r + s) % BENCH_ZONES;
+            len += snprintf(routines_doc + len, sizeof(routines_doc) - len,
+                            "%s{\"id\":%d,\"name\":\"%s\",\"duration\":%d,\"enabled\":%s,\"order\":%d}",
+                            s ? "," : "", id, zone_names[id], 1 + (r + s) % 20, s % 5 == 4 ? "false" : "true", s);
+        }
+        len += snprintf(routines_doc + len, sizeof(routines_doc) - len, "]}");
+    }
+    len += snprintf(routines_doc + len, sizeof(routines_doc) - len, "]");
+    return len;
+}
+
+static void bench_routines(void) {
+    printf("\nRoutine uploads (POST /api/routines, 512 B receive chunks)\n");
+    const int sizes[] = {4, 16, 32};
+    for (int i = 0; i < 3; i++) {
+        int n = sizes[i];
+        size_t len = make_routines(n, 6);
+        const sim_response_t *resp = NULL;
+        const int iterations = 200;
+        sim_heap_reset();
+        int64_t base = sim_heap.live;
+        uint64_t t0 = now_ns();
+        for (int k = 0; k < iterations; k++) {
+            resp = sim_httpd_request(HTTP_POST, "/api/routines", NULL, routines_doc, len);
+        }
+        uint64_t ns = now_ns() - t0;
+        char label[48];
+        snprintf(label, sizeof(label), "%d routines, %zu B", n, len);
+        report(label, ns, iterations, sim_heap.allocs, sim_heap.bytes);
+        printf("    status %d, peak heap above baseline %lld B, %d routines loaded\n",
+               resp->status, (long long)(sim_heap.peak - base), routine_store_count());
+    }
+
+    // Starting a routine is a table lookup
+    const int iterations = 20000;
+    sim_heap_reset();
+    uint64_t t0 = now_ns();
+    for (int k = 0; k < iterations; k++) {
+        sim_httpd_request(HTTP_GET, "/api/routine/control?action=start&index=31", NULL, NULL, 0);
+        relay_stop_routine();
+    }
+    report("start routine 32 (+ stop)", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+
+    // Malformed documents are refused on upload and leave the table alone
+    static const char bad[] = "[{\"name\":\"Broken\",\"steps\":[{\"id\":7,\"duration\":5}]}]";
+    const sim_response_t *resp = sim_httpd_request(HTTP_POST, "/api/routines", NULL, bad, sizeof(bad) - 1);
+    printf("  malformed upload: %d \"%.*s\", %d routines still loaded\n",
+           resp->status, (int)resp->body_len, resp->body, routine_store_count());
+    if (resp->status != 400 || routine_store_count() != 32) sim_fail("routine upload");
+}
+
+// --- MQTT ------------------------------------------------------------------
+
+static const char *mqtt_mode(int relay) {
+    return relay_mode_to_str(relay_get_mode(relay));
+}
+
+static void bench_mqtt(void) {
+    printf("\nMQTT (in-process broker)\n");
+    static const char settings[] =
+        "{\"uri\":\"mqtt://192.168.1.10\",\"username\":\"aw\",\"password\":\"secret\",\"prefix\":\"garden\"}";
+    const sim_response_t *resp = sim_httpd_request(HTTP_POST, "/api/mqtt", NULL, settings, sizeof(settings) - 1);
+    printf("  POST /api/mqtt:                    %d, client started for %s\n", resp->status,
+           sim_mqtt_uri() ? sim_mqtt_uri() : "(none)");
+    sim_mqtt_connect();
+    sim_advance(pdMS_TO_TICKS(MQTT_COALESCE_MS + 10));
+
+    size_t len = 0;
+    const char *status = sim_mqtt_retained("garden/status", &len);
+    resp = sim_httpd_request(HTTP_GET, "/api/status", NULL, NULL, 0);
+    printf("  retained garden/status on connect: %zu bytes, %s /api/status\n", len,
+           status && len == resp->body_len && memcmp(status, resp->body, len) == 0 ? "same as" : "differs from");
+    status = sim_mqtt_retained("garden/online", &len);
+    printf("  garden/online:                     %.*s\n", status ? (int)len : 6, status ? status : "(none)");
+    resp = sim_httpd_request(HTTP_GET, "/api/mqtt", NULL, NULL, 0);
+    printf("  GET /api/mqtt:                     %.*s\n", (int)resp->body_len, resp->body);
+
+    // Bursts: one message per change window, however many relays moved
+    static const char batch[] =
+        "[{\"id\":0,\"action\":\"on\"},{\"id\":1,\"action\":\"on\"},"
+        "{\"id\":2,\"action\":\"on\"},{\"id\":3,\"action\":\"on\"}]";
+    uint32_t before = sim_mqtt_publishes;
+    sim_httpd_request(HTTP_POST, "/api/relays", NULL, batch, sizeof(batch) - 1);
+    sim_advance(pdMS_TO_TICKS(MQTT_COALESCE_MS + 10));
+    printf("  4-relay batch:                     %u message(s)\n", (unsigned)(sim_mqtt_publishes - before));
+    if (sim_mqtt_publishes - before != 1) sim_fail("publishes");
+    before = sim_mqtt_publishes;
+    for (int i = 0; i < BENCH_ZONES; i++) relay_off(i);
+    sim_advance(pdMS_TO_TICKS(MQTT_COALESCE_MS + 10));
+    printf("  4 relay_off() calls in a row:      %u message(s)\n", (unsigned)(sim_mqtt_publishes - before));
+    if (sim_mqtt_publishes - before != 1) sim_fail("publishes");
+
+    // A watering hour: one 4-step routine of 10 minutes per step
+    before = sim_mqtt_publishes;
+    uint64_t bytes = sim_mqtt_bytes;
+    start_bench_routine(600);
+    sim_advance(pdMS_TO_TICKS(3600 * 1000));
+    uint32_t msgs = sim_mqtt_publishes - before;
+    bytes = sim_mqtt_bytes - bytes;
+    printf("  4-step routine:                    %u messages, %llu bytes\n", (unsigned)msgs, (unsigned long long)bytes);
+    resp = sim_httpd_request(HTTP_GET, "/api/status", NULL, NULL, 0);
+    printf("  the same hour polled every 5 s:    720 requests, %zu bytes of JSON bodies\n", 720 * resp->body_len);
+
+    // Commands
+    sim_mqtt_deliver("garden/relay/2/set", "on", false);
+    printf("  relay/2/set on:                    relay 2 %s\n", mqtt_mode(2));
+    if (relay_get_mode(2) != RELAY_MODE_MANUAL) sim_fail("relay 2 mode");
+    sim_mqtt_deliver("garden/relay/2/set", "300", false);
+    printf("  relay/2/set 300:                   relay 2 %s, %u s left\n", mqtt_mode(2),
+           (unsigned)relay_get_remaining_time(2));
+    if (relay_get_mode(2) != RELAY_MODE_TIMED || relay_get_remaining_time(2) != 300) sim_fail("relay 2 timer");
+    sim_mqtt_deliver("garden/relay/2/set", "off", false);
+    printf("  relay/2/set off:                   relay 2 %s\n", mqtt_mode(2));
+    if (relay_get_mode(2) != RELAY_MODE_OFF) sim_fail("relay 2 mode");
+    sim_mqtt_deliver("garden/relay/1/set", "on", true);
+    printf("  retained relay/1/set on:           relay 1 %s (ignored)\n", mqtt_mode(1));
+    if (relay_get_mode(1) != RELAY_MODE_OFF) sim_fail("retained command");
+    sim_mqtt_deliver("garden/relay/7/set", "on", false);
+    sim_mqtt_deliver("garden/relay/1/set", "5000", false);
+    printf("  relay/7/set on, relay/1/set 5000:  relay 1 %s (ignored)\n", mqtt_mode(1));
+    if (relay_get_mode(1) != RELAY_MODE_OFF) sim_fail("invalid command");
+    sim_mqtt_deliver("garden/routine/set", "0", false);
+    sim_idle();
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    printf("  routine/set 0:                     running %s\n", snap.routine_running ? "yes" : "no");
+    if (!snap.routine_running) sim_fail("routine start");
+    sim_mqtt_deliver("garden/routine/set", "stop", false);
+    sim_idle();
+    relay_snapshot(&snap, NULL);
+    printf("  routine/set stop:                  running %s\n", snap.routine_running ? "yes" : "no");
+    if (snap.routine_running) sim_fail("routine stop");
+    sim_advance(pdMS_TO_TICKS(MQTT_COALESCE_MS + 10));
+
+    static const char bad[] = "{\"uri\":\"http://192.168.1.10\"}";
+    resp = sim_httpd_request(HTTP_POST, "/api/mqtt", NULL, bad, sizeof(bad) - 1);
+    printf("  invalid uri:                       %d \"%.*s\"\n", resp->status, (int)resp->body_len, resp->body);
+    if (resp->status != 400) sim_fail("uri accepted");
+
+    // An unclean drop leaves the will; the device keeps quiet until it is
+    // back and then publishes the state it missed
+    sim_mqtt_drop();
+    status = sim_mqtt_retained("garden/online", &len);
+    printf("  dropped, garden/online:            %.*s\n", status ? (int)len : 6, status ? status : "(none)");
+    if (status == NULL || len != 7 || memcmp(status, "offline", 7) != 0) sim_fail("will");
+    before = sim_mqtt_publishes;
+    relay_on(0);
+    sim_advance(pdMS_TO_TICKS(MQTT_COALESCE_MS + 10));
+    printf("  relay change while dropped:        %u message(s)\n", (unsigned)(sim_mqtt_publishes - before));
+    if (sim_mqtt_publishes != before) sim_fail("publish while dropped");
+    sim_mqtt_connect();
+    sim_advance(pdMS_TO_TICKS(MQTT_COALESCE_MS + 10));
+    status = sim_mqtt_retained("garden/status", &len);
+    char copy[SIM_MQTT_PAYLOAD_MAX + 1] = "";
+    if (status) memcpy(copy, status, len);
+    copy[status ? len : 0] = '\0';
+    printf("  reconnected, garden/status:        relay 0 %s\n",
+           strstr(copy, "{\"id\":0,\"state\":\"on\"") ? "on" : "stale");
+    if (strstr(copy, "{\"id\":0,\"state\":\"on\"") == NULL) sim_fail("status after reconnect");
+    relay_off(0);
+
+    // Off again, so the later sections run without a broker
+    static const char off[] = "{\"uri\":\"\"}";
+    resp = sim_httpd_request(HTTP_POST, "/api/mqtt", NULL, off, sizeof(off) - 1);
+    printf("  uri \"\":                            %d, client %s\n", resp->status, sim_mqtt_uri() ? "running" : "stopped");
+    sim_advance(pdMS_TO_TICKS(1000));
+}
+
+// --- Scheduler -------------------------------------------------------------
+
+// Monday 2026-03-23 00:00 CET; the simulated week includes the switch to
+// summer time
+#define SCHED_T0 1774220400LL
+#define SCHED_TZ "CET-1CEST,M3.5.0,M10.5.0/3"
+
+typedef struct {
+    const char *type;
+    int routine;
+    int minute;         // daily/weekly
+    int days;           // weekly, bit 0 = Sunday
+    int every;          // interval, minutes
+    int64_t at;         // interval start / one-shot time
+    bool enabled;
+} bench_schedule_t;
+
+// No two runs fall within the same minute, so none is skipped as busy
+static const bench_schedule_t bench_schedules[] = {
+    {"daily", 0, 6 * 60, 0, 0, 0, true},
+    {"daily", 1, 18 * 60 + 30, 0, 0, 0, true},
+    {"weekly", 2, 7 * 60, 0x2a, 0, 0, true},                            // Mon, Wed, Fri
+    {"weekly", 3, 9 * 60 + 15, 0x41, 0, 0, true},                       // Sat, Sun
+    {"interval", 0, 0, 0, 90, SCHED_T0 + 10 * 60, true},
+    {"once", 1, 0, 0, 0, SCHED_T0 + 2 * 86400 + 12 * 3600 + 5 * 60, true},
+    {"daily", 2, 20 * 60, 0, 0, 0, false},
+};
+#define NUM_BENCH_SCHEDULES (int)(sizeof(bench_schedules) / sizeof(bench_schedules[0]))
+
+static size_t make_schedules(char *doc, size_t cap) {
+    size_t len = snprintf(doc, cap, "{\"timezone\":\"%s\",\"catchup\":60,\"schedules\":[", SCHED_TZ);
+    for (int i = 0; i < NUM_BENCH_SCHEDULES; i++) {
+        const bench_schedule_t *b = &bench_schedules[i];
+        len += snprintf(doc + len, cap - len, "%s{\"type\":\"%s\",\"routine\":%d,\"enabled\":%s",
+                        i ? "," : "", b->type, b->routine, b->enabled ? "true" : "false");
+        if (b->minute || strcmp(b->type, "daily") == 0 || strcmp(b->type, "weekly") == 0) {
+            len += snprintf(doc + len, cap - len, ",\"time\":\"%02d:%02d\"", b->minute / 60, b->minute % 60);
+        }
+        if (b->days) {
+            len += snprintf(doc + len, cap - len, ",\"days\":[");
+            for (int d = 0, n = 0; d < 7; d++) {
+                if (b->days & (1 << d)) len += snprintf(doc + len, cap - len, "%s%d", n++ ? "," : "", d);
+            }
+            len += snprintf(doc + len, cap - len, "]");
+        }
+        if (b->every) len += snprintf(doc + len, cap - len, ",\"every\":%d,\"start\":%lld", b->every, (long long)b->at);
+        else if (b->at) len += snprintf(doc + len, cap - len, ",\"at\":%lld", (long long)b->at);
+        len += snprintf(doc + len, cap - len, "}");
+    }
+    len += snprintf(doc + len, cap - len, "]}");
+    return len;
+}
+
+// Reference count of runs in [from, to): every minute checked against
+// every schedule, independently of the scheduler's heap arithmetic
+static int expected_runs(int64_t from, int64_t to) {
+    int runs = 0;
+    for (int64_t t = from; t < to; t += 60) {
+        time_t tt = (time_t)t;
+        struct tm tm;
+        localtime_r(&tt, &tm);
+        int minute = tm.tm_hour * 60 + tm.tm_min;
+        for (int i = 0; i < NUM_BENCH_SCHEDULES; i++) {
+            const bench_schedule_t *b = &bench_schedules[i];
+            if (!b->enabled) continue;
+            if (strcmp(b->type, "daily") == 0) runs += minute == b->minute;
+            if (strcmp(b->type, "weekly") == 0) runs += minute == b->minute && (b->days & (1 << tm.tm_wday));
+            if (strcmp(b->type, "interval") == 0) runs += t >= b->at && (t - b->at) % (b->every * 60) == 0;
+            if (strcmp(b->type, "once") == 0) runs += t == b->at;
+        }
+    }
+    return runs;
+}
+
+static void bench_scheduler(void) {
+    printf("\nScheduler (virtual time, %d schedules, %s)\n", NUM_BENCH_SCHEDULES, SCHED_TZ);
+
+    // Four one-step routines, one per relay, a minute each
+    static const char routines[] =
+        "[{\"name\":\"A\",\"steps\":[{\"id\":0,\"duration\":1}]},"
+        "{\"name\":\"B\",\"steps\":[{\"id\":1,\"duration\":1}]},"
+        "{\"name\":\"C\",\"steps\":[{\"id\":2,\"duration\":1}]},"
+        "{\"name\":\"D\",\"steps\":[{\"id\":3,\"duration\":1}]}]";
+    sim_httpd_request(HTTP_POST, "/api/routines", NULL, routines, sizeof(routines) - 1);
+
+    scheduler_init();
+    static char doc[2048];
+    size_t len = make_schedules(doc, sizeof(doc));
+    const sim_response_t *resp = sim_httpd_request(HTTP_POST, "/api/schedules", NULL, doc, len);
+    if (resp->status != 200) {
+        printf("  upload failed: %d %.*s\n", resp->status, (int)resp->body_len, resp->body);
+        return;
+    }
+    sim_idle();
+
+    // The first SNTP sync sets the clock a minute before the week starts
+    sim_sntp_sync(SCHED_T0 - 60);
+    sim_idle();
+
+    sim_reset_wakeups();
+    relay_on_count = 0;
+    uint32_t nvs_before = sim_nvs_writes;
+    uint64_t t0 = now_ns();
+    sim_advance(pdMS_TO_TICKS((7 * 86400 + 60) * 1000ULL));
+    uint64_t wall = now_ns() - t0;
+    setenv("TZ", SCHED_TZ, 1);
+    tzset();
+    int expected = expected_runs(SCHED_T0, SCHED_T0 + 7 * 86400);
+    printf("  runs started in one week:          %lu (expected %d)\n", (unsigned long)relay_on_count, expected);
+    if (relay_on_count != (uint32_t)expected) sim_fail("run count");
+    printf("  scheduler_task wakeups per week:   %lu (1 s polling: %d)\n",
+           (unsigned long)sim_task_wakeups("scheduler_task"), 7 * 86400);
+    printf("  NVS writes per week:               %lu\n", (unsigned long)(sim_nvs_writes - nvs_before));
+    printf("  host time to simulate the week:    %.1f ms\n", wall / 1e6);
+
+    // Powered off from 01:00 to 05:00 (CEST): the interval schedule missed
+    // its 01:10, 02:40 and 04:10 runs; only 04:10 is inside the 60 minute
+    // catch-up window, so exactly one run starts
+    relay_on_count = 0;
+    sim_sntp_sync(time(NULL) + 4 * 3600);
+    sim_idle();
+    printf("  4 h gap, catch-up runs started:    %lu (expected 1)\n", (unsigned long)relay_on_count);
+    if (relay_on_count != 1) sim_fail("catch-up");
+    sim_advance(pdMS_TO_TICKS(120 * 1000));
+
+    bench_request("GET /api/schedules", HTTP_GET, "/api/schedules", 20000);
+    const int iterations = 2000;
+    sim_heap_reset();
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        resp = sim_httpd_request(HTTP_POST, "/api/schedules", NULL, doc, len);
+    }
+    report("POST /api/schedules", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    sim_idle();
+
+    static const char bad[] = "{\"schedules\":[{\"type\":\"weekly\",\"routine\":0,\"time\":\"25:00\",\"days\":[1]}]}";
+    resp = sim_httpd_request(HTTP_POST, "/api/schedules", NULL, bad, sizeof(bad) - 1);
+    printf("  malformed upload: %d \"%.*s\"\n", resp->status, (int)resp->body_len, resp->body);
+    if (resp->status != 400) sim_fail("schedule accepted");
+}
+
+// --- Idle ------------------------------------------------------------------
+
+// Every wakeup is a light sleep cut short, so with nothing to do the count
+// should only be the scheduler's hourly clock check
+static void bench_idle(void) {
+    printf("\nIdle (no routine, no schedules, no clients)\n");
+    static const char none[] = "{\"schedules\":[]}";
+    sim_httpd_request(HTTP_POST, "/api/schedules", NULL, none, sizeof(none) - 1);
+    sim_advance(pdMS_TO_TICKS(5 * 60 * 1000));
+    sim_reset_wakeups();
+    sim_advance(pdMS_TO_TICKS(60 * 60 * 1000));
+    printf("  task wakeups per idle hour:        %lu\n", (unsigned long)sim_task_wakeups(NULL));
+    printf("  timer callbacks per idle hour:     %lu\n", (unsigned long)sim_timer_fires);
+}
+
+// --- State journal ---------------------------------------------------------
+
+#define JOURNAL_STEP_SEC 300
+
+// Runs the bench routine to at_sec, keeps NVS as it was then, and replays
+// a reset that kept the device down for down_sec, with `parallel` steps
+// at a time. Prints what recovery did next to the position the routine
+// should be at (its first running step).
+static void journal_reset_case(const char *label, int at_sec, int down_sec, bool power_loss, int parallel) {
+    relay_set_routine_limits(parallel, 0);
+    static const char *const outcomes[] = {"clean", "resumed", "finished", "aborted"};
+    routine_store_start(0);
+    sim_advance(pdMS_TO_TICKS(at_sec * 1000));
+    sim_nvs_save();
+
+    relay_stop_routine();
+    sim_advance(pdMS_TO_TICKS(down_sec * 1000));
+    sim_nvs_restore();
+    int64_t now = time(NULL);
+    if (power_loss) sim_set_time(100);
+    sim_reset_reason = power_loss ? ESP_RST_POWERON : ESP_RST_TASK_WDT;
+
+    journal_outcome_t outcome = journal_recover();
+    if (power_loss) sim_set_time(now);
+    sim_idle();
+    relay_snapshot_t snap;
+    static routine_state_t rs;
+    relay_snapshot(&snap, &rs);
+
+    int pos = at_sec + down_sec;
+    printf("  %-34s %s", label, outcomes[outcome]);
+    if (outcome == JOURNAL_RESUMED) {
+        int step = __builtin_ctzll(snap.active_steps);
+        printf(" at step %d, %lu s left", step + 1,
+               (unsigned long)relay_snapshot_remaining(&snap, rs.steps[step].relay_id));
+    }
+    int rounds = (BENCH_ZONES + parallel - 1) / parallel;
+    bool resumes = !power_loss && down_sec <= JOURNAL_RESUME_WINDOW_SEC && pos < rounds * JOURNAL_STEP_SEC;
+    int step = pos / JOURNAL_STEP_SEC * parallel;
+    int left = JOURNAL_STEP_SEC - pos % JOURNAL_STEP_SEC;
+    if (resumes) printf(" (expected step %d, %d s)", step + 1, left);
+    printf("\n");
+    // The replay rounds the time left down to the second
+    if (resumes && (outcome != JOURNAL_RESUMED || __builtin_ctzll(snap.active_steps) != step ||
+                    relay_snapshot_remaining(&snap, rs.steps[step].relay_id) + 1 < (uint32_t)left)) {
+        sim_fail("resume point");
+    } else if (!resumes && outcome == JOURNAL_RESUMED) {
+        sim_fail("resume");
+    }
+
+    relay_stop_routine();
+    sim_advance(pdMS_TO_TICKS(1000));
+}
+
+static void bench_journal(void) {
+    printf("\nState journal (NVS, virtual time, 4 steps of 5 min)\n");
+    static const char routines[] =
+        "[{\"name\":\"J\",\"steps\":[{\"id\":0,\"duration\":5},{\"id\":1,\"duration\":5},"
+        "{\"id\":2,\"duration\":5},{\"id\":3,\"duration\":5}]}]";
+    sim_httpd_request(HTTP_POST, "/api/routines", NULL, routines, sizeof(routines) - 1);
+    journal_init();
+    sim_idle();
+
+    uint32_t writes = sim_nvs_writes;
+    routine_store_start(0);
+    sim_advance(pdMS_TO_TICKS((BENCH_ZONES * JOURNAL_STEP_SEC + 10) * 1000));
+    printf("  NVS writes per routine run:        %lu\n", (unsigned long)(sim_nvs_writes - writes));
+
+    const int iterations = 20000;
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        journal_recover();
+    }
+    report("boot replay (nothing to resume)", now_ns() - t0, iterations, 0, 0);
+
+    journal_reset_case("watchdog 450 s in, 30 s down:", 450, 30, false, 1);
+    journal_reset_case("watchdog 450 s in, 240 s down:", 450, 240, false, 1);
+    journal_reset_case("watchdog 1140 s in, 120 s down:", 1140, 120, false, 1);
+    journal_reset_case("watchdog 450 s in, 1200 s down:", 450, 1200, false, 1);
+    journal_reset_case("power loss 450 s in:", 450, 5, true, 1);
+    // Two steps at a time: the replay packs the downtime the same way
+    journal_reset_case("2 at a time, 150 s in, 30 s down:", 150, 30, false, 2);
+    journal_reset_case("2 at a time, 250 s in, 240 s down:", 250, 240, false, 2);
+    journal_reset_case("2 at a time, 500 s in, 200 s down:", 500, 200, false, 2);
+    relay_set_routine_limits(1, 0);
+}
+
+// --- Watering history ------------------------------------------------------
+
+#define HISTORY_DAYS 540
+
+static uint32_t dump_records;
+static uint32_t dump_oldest;
+
+static bool count_records(void *ctx, const char *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dump_records += buf[i] == '{';
+        // The first record is the oldest
+        if (!dump_oldest && i + 8 < len && strncmp(buf + i, "\"start\":", 8) == 0) {
+            dump_oldest = strtoul(buf + i + 8, NULL, 10);
+        }
+    }
+    return true;
+}
+
+// Jumps the clock to sec past midnight on the given day. Only the watering
+// windows run in virtual ticks, which keeps 540 days well short of the
+// 32-bit tick count wrapping (the simulator does not handle it).
+static void clock_to(int64_t day0, int day, int sec) {
+    sim_set_time(day0 + (int64_t)day * 86400 + sec);
+}
+
+static void bench_history(void) {
+    printf("\nWatering history (64 KB flash ring, %d days of 8 waterings)\n", HISTORY_DAYS);
+    history_init();
+    sim_idle();
+
+    // A day: routine J at 06:00 (4 steps), two timed relays at 13:00, one
+    // relay switched on and off by hand at 20:00 and one left on until the
+    // safety timeout
+    int64_t day0 = (time(NULL) / 86400 + 1) * 86400;
+    uint32_t erases = sim_flash_erases;
+    uint64_t t0 = now_ns();
+    for (int d = 0; d < HISTORY_DAYS; d++) {
+        clock_to(day0, d, 6 * 3600);
+        routine_store_start(0);
+        sim_advance(pdMS_TO_TICKS((BENCH_ZONES * JOURNAL_STEP_SEC + 10) * 1000));
+        clock_to(day0, d, 13 * 3600);
+        relay_on_with_timer(0, 600);
+        relay_on_with_timer(1, 300);
+        sim_advance(pdMS_TO_TICKS(610 * 1000));
+        clock_to(day0, d, 20 * 3600);
+        relay_on(2);
+        relay_on(3);
+        sim_advance(pdMS_TO_TICKS(900 * 1000));
+        relay_off(2);
+        sim_advance(pdMS_TO_TICKS((MAX_ON_TIME_SEC - 900 + 10) * 1000));
+    }
+    clock_to(day0, HISTORY_DAYS, 0);
+    uint64_t wall = now_ns() - t0;
+
+    static char buf[1024];
+    json_writer_t w;
+    dump_records = 0;
+    dump_oldest = 0;
+    uint64_t read_before = sim_flash_read_bytes;
+    json_writer_init(&w, buf, sizeof(buf), count_records, NULL);
+    history_write_json(&w, 0, UINT32_MAX, -1);
+    json_writer_flush(&w);
+    uint64_t dump_read = sim_flash_read_bytes - read_before;
+    printf("  waterings logged:                  %d\n", HISTORY_DAYS * 8);
+    printf("  records kept:                      %lu, oldest %lld days old\n", (unsigned long)dump_records,
+           (long long)((time(NULL) - dump_oldest) / 86400));
+    printf("  sector erases:                     %lu\n", (unsigned long)(sim_flash_erases - erases));
+    printf("  host time to simulate:             %.1f ms\n", wall / 1e6);
+
+    int complete = 0;
+    for (int d = HISTORY_DAYS - 30; d < HISTORY_DAYS; d++) {
+        dump_records = 0;
+        json_writer_init(&w, buf, sizeof(buf), count_records, NULL);
+        history_write_json(&w, day0 + d * 86400, day0 + (d + 1) * 86400, -1);
+        json_writer_flush(&w);
+        complete += dump_records == 8;
+    }
+    printf("  last 30 days with all 8 waterings: %d\n", complete);
+    if (complete != 30) sim_fail("history gap");
+
+    char uri[96];
+    int last = HISTORY_DAYS - 1;
+    snprintf(uri, sizeof(uri), "/api/history?from=%lld&to=%lld&zone=3",
+             (long long)(day0 + last * 86400), (long long)(day0 + (last + 1) * 86400));
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, uri, NULL, NULL, 0);
+    printf("  one day, zone 3: %d %.*s\n", resp->status, (int)resp->body_len, resp->body);
+
+    const int iterations = 2000;
+    read_before = sim_flash_read_bytes;
+    sim_heap_reset();
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        sim_httpd_request(HTTP_GET, uri, NULL, NULL, 0);
+    }
+    report("GET /api/history (1 day, 1 zone)", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    printf("  flash read per query:              %llu B (full dump: %llu B)\n",
+           (unsigned long long)((sim_flash_read_bytes - read_before) / iterations), (unsigned long long)dump_read);
+
+    resp = sim_httpd_request(HTTP_GET, "/api/history?zone=9", NULL, NULL, 0);
+    printf("  invalid zone: %d \"%.*s\"\n", resp->status, (int)resp->body_len, resp->body);
+    if (resp->status != 400) sim_fail("zone accepted");
+}
+
+// --- Metrics ---------------------------------------------------------------
+
+static esp_err_t noop_handler(httpd_req_t *req) {
+    return httpd_resp_send(req, NULL, 0);
+}
+
+static void bench_metrics(void) {
+    printf("\nMetrics (GET /metrics, handler instrumentation)\n");
+
+    // The same handler registered bare and through the metrics wrapper
+    httpd_uri_t bare = { .uri = "/bench/bare", .method = HTTP_GET, .handler = noop_handler };
+    httpd_uri_t wrapped = { .uri = "/bench/wrapped", .method = HTTP_GET, .handler = noop_handler };
+    httpd_register_uri_handler(NULL, &bare);
+    metrics_register_uri(NULL, &wrapped);
+    // Interleaved in short runs so drift on the host hits both alike
+    const int runs = 2000, per_run = 100;
+    uint64_t bare_ns = 0, wrapped_ns = 0;
+    for (int r = 0; r < runs; r++) {
+        uint64_t t0 = now_ns();
+        for (int i = 0; i < per_run; i++) sim_httpd_request(HTTP_GET, "/bench/bare", NULL, NULL, 0);
+        uint64_t t1 = now_ns();
+        for (int i = 0; i < per_run; i++) sim_httpd_request(HTTP_GET, "/bench/wrapped", NULL, NULL, 0);
+        bare_ns += t1 - t0;
+        wrapped_ns += now_ns() - t1;
+    }
+    printf("  no-op handler, bare:               %.0f ns/op\n", (double)bare_ns / (runs * per_run));
+    printf("  no-op handler, instrumented:       %.0f ns/op\n", (double)wrapped_ns / (runs * per_run));
+
+    bench_request("GET /metrics", HTTP_GET, "/metrics", 5000);
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/metrics", NULL, NULL, 0);
+    int lines = 0;
+    for (size_t i = 0; i < resp->body_len; i++) lines += resp->body[i] == '\n';
+    printf("  page size:                         %zu bytes, %d lines in the first %zu\n", resp->body_sent, lines,
+           resp->body_len);
+    const char *status = strstr(resp->body, "autowater_http_requests_total{method=\"GET\",uri=\"/api/status\"}");
+    if (status) printf("  %.*s\n", (int)strcspn(status, "\n"), status);
+    const char *relay = strstr(resp->body, "autowater_relay_switches_total{relay=\"0\"}");
+    if (relay) printf("  %.*s\n", (int)strcspn(relay, "\n"), relay);
+}
+
+// --- OTA -------------------------------------------------------------------
+
+#define OTA_APP_SIZE (900 * 1024)
+#define OTA_SPIFFS_SIZE 0x150000     // mkspiffs pads the image to the partition
+#define OTA_SPIFFS_USED (320 * 1024) // The rest of the image is free space, all ones
+
+static uint8_t ota_image[OTA_SPIFFS_SIZE + 4096];   // Room for one too large
+static uint8_t ota_gz[OTA_SPIFFS_SIZE + 1024];
+
+typedef struct {
+    const char *uri;
+    const uint8_t *body;        // ota_image if NULL
+    size_t len;
+    size_t image_len;           // Inflated size of a gzip body
+    char headers[96];
+    int status;
+    char msg[64];
+    TickType_t took;
+    uint32_t stall_ms, max_stall_ms;
+    bool done;
+} ota_run_t;
+
+// The upload runs in a task named like the server's, since receiving and
+// flashing block in virtual time
+static void ota_client_task(void *arg) {
+    ota_run_t *run = arg;
+    TickType_t start = xTaskGetTickCount();
+    const uint8_t *body = run->body ? run->body : ota_image;
+    const sim_response_t *resp = sim_httpd_request(HTTP_POST, run->uri, run->headers, (const char *)body, run->len);
+    run->status = resp->status;
+    snprintf(run->msg, sizeof(run->msg), "%.*s", (int)resp->body_len, resp->body);
+    run->took = resp->finished_at - start;
+    run->stall_ms = resp->client_stall_ms;
+    run->max_stall_ms = resp->client_max_stall_ms;
+    run->done = true;
+}
+
+// Random (incompressible, never all ones) up to used, free space after it
+static void ota_fill(size_t used) {
+    uint32_t x = 12345;
+    for (size_t i = 0; i < sizeof(ota_image); i++) {
+        x = x * 1103515245 + 12345;
+        ota_image[i] = i < used ? (uint8_t)(x >> 16) : 0xff;
+    }
+    ota_image[0] = 0xe9;    // App image magic
+}
+
+static void ota_digest(ota_run_t *run, size_t len, bool corrupt) {
+    uint8_t sha[32];
+    mbedtls_sha256(ota_image, len, sha, 0);
+    if (corrupt) sha[0] ^= 1;
+    char *p = run->headers + sprintf(run->headers, "X-SHA256: ");
+    for (int i = 0; i < 32; i++) p += sprintf(p, "%02x", sha[i]);
+    strcat(run->headers, "\n");
+}
+
+// Compresses the first len bytes of ota_image into ota_gz like
+// pack_ota.js does, for a gzip upload of it
+static void ota_gzip(ota_run_t *run, size_t len) {
+    z_stream z = {0};
+    deflateInit2(&z, 9, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    z.next_in = ota_image;
+    z.avail_in = len;
+    z.next_out = ota_gz;
+    z.avail_out = sizeof(ota_gz);
+    deflate(&z, Z_FINISH);
+    run->body = ota_gz;
+    run->len = z.total_out;
+    run->image_len = len;
+    deflateEnd(&z);
+    ota_digest(run, len, false);
+    strcat(run->headers, "Content-Encoding: gzip\n");
+}
+
+// What the slots held before: an older 850 KB app, and a filesystem with
+// 300 KB in use and the rest erased. Free from the main context.
+static void ota_old_images(void) {
+    static uint8_t chunk[4096];
+    memset(chunk, 0x5a, sizeof(chunk));
+    const esp_partition_t *app = esp_partition_find_first(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_ANY, "ota_1");
+    const esp_partition_t *fs = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "storage");
+    esp_partition_erase_range(app, 0, app->size);
+    esp_partition_erase_range(fs, 0, fs->size);
+    for (size_t at = 0; at < 850 * 1024; at += sizeof(chunk)) esp_partition_write(app, at, chunk, sizeof(chunk));
+    for (size_t at = 0; at < 300 * 1024; at += sizeof(chunk)) esp_partition_write(fs, at, chunk, sizeof(chunk));
+}
+
+static void run_ota(const char *label, ota_run_t *run, int expect_status) {
+    ota_old_images();
+    uint32_t erases = sim_flash_erases;
+    uint64_t written = sim_flash_write_bytes;
+    xTaskCreate(ota_client_task, "httpd", 4096, run, 5, NULL);
+    while (!run->done) sim_advance(pdMS_TO_TICKS(100));
+    sim_advance(pdMS_TO_TICKS(3000));   // Past the reboot delay
+    double sec = run->took / 1000.0;
+    size_t image_len = run->image_len ? run->image_len : run->len;
+    printf("  %-34s %d \"%s\"\n", label, run->status, run->msg);
+    if (run->status != expect_status) sim_fail("status %d", run->status);
+    if (run->image_len) printf("  %-34s %zu KB sent\n", "", run->len / 1024);
+    printf("  %-34s %.2f s, %.0f KB/s, client stalled %.2f s (longest %u ms)\n", "",
+           sec, image_len / 1024.0 / sec, run->stall_ms / 1000.0, (unsigned)run->max_stall_ms);
+    printf("  %-34s %lu KB erased, %llu KB programmed\n", "", (unsigned long)(sim_flash_erases - erases) * 4,
+           (unsigned long long)((sim_flash_write_bytes - written) / 1024));
+}
+
+static void bench_ota(void) {
+    printf("\nOTA (virtual time: sector erase 45 ms, 64 KB block erase 150 ms, write 2.4 ms/KB,\n"
+           "     read 0.1 ms/KB, network 500 KB/s through a %d B TCP window)\n", 5760);
+    sim_costs = (sim_costs_t){
+        .erase_sector_us = 45000,
+        .erase_block_us = 150000,
+        .write_kb_us = 2400,
+        .read_kb_us = 100,
+        .recv_kb_us = 2000,
+        .recv_window = 5760,
+    };
+
+    ota_fill(OTA_APP_SIZE);
+    ota_run_t app = {.uri = "/api/ota?type=app", .len = OTA_APP_SIZE};
+    ota_digest(&app, app.len, false);
+    uint32_t restarts = sim_restarts;
+    run_ota("firmware, 900 KB:", &app, 200);
+    printf("  %-34s %s, %lu restart\n", "", sim_boot_partition ? sim_boot_partition->label : "no boot change",
+           (unsigned long)(sim_restarts - restarts));
+    if (sim_boot_partition == NULL || sim_restarts - restarts != 1) sim_fail("boot change");
+
+    ota_fill(OTA_SPIFFS_USED);
+    ota_run_t spiffs = {.uri = "/api/ota?type=spiffs", .len = OTA_SPIFFS_SIZE};
+    ota_digest(&spiffs, spiffs.len, false);
+    run_ota("filesystem, 1344 KB (320 KB used):", &spiffs, 200);
+
+    ota_fill(OTA_APP_SIZE);
+    sim_boot_partition = NULL;
+    ota_run_t bad = {.uri = "/api/ota?type=app", .len = OTA_APP_SIZE};
+    ota_digest(&bad, bad.len, true);
+    restarts = sim_restarts;
+    run_ota("firmware, wrong digest:", &bad, 400);
+    printf("  %-34s %s, %lu restart\n", "", sim_boot_partition ? sim_boot_partition->label : "no boot change",
+           (unsigned long)(sim_restarts - restarts));
+    if (sim_boot_partition != NULL || sim_restarts != restarts) sim_fail("boot change");
+
+    // The same filesystem image gzipped: its free space costs next to
+    // nothing on the wire. Inflating takes no virtual time here.
+    ota_fill(OTA_SPIFFS_USED);
+    ota_run_t spiffs_gz = {.uri = "/api/ota?type=spiffs"};
+    ota_gzip(&spiffs_gz, OTA_SPIFFS_SIZE);
+    run_ota("filesystem, gzip:", &spiffs_gz, 200);
+
+    // A slow link, where the bytes sent are what counts
+    sim_costs.recv_kb_us = 20000;
+    ota_run_t spiffs_slow = {.uri = "/api/ota?type=spiffs", .len = OTA_SPIFFS_SIZE};
+    ota_digest(&spiffs_slow, spiffs_slow.len, false);
+    run_ota("filesystem, 50 KB/s link:", &spiffs_slow, 200);
+    ota_run_t spiffs_gz_slow = {.uri = "/api/ota?type=spiffs"};
+    ota_gzip(&spiffs_gz_slow, OTA_SPIFFS_SIZE);
+    run_ota("filesystem, gzip, 50 KB/s link:", &spiffs_gz_slow, 200);
+    sim_costs.recv_kb_us = 2000;
+
+    // Random app bytes do not compress; cut the stream short
+    ota_fill(OTA_APP_SIZE);
+    sim_boot_partition = NULL;
+    ota_run_t cut = {.uri = "/api/ota?type=app"};
+    ota_gzip(&cut, OTA_APP_SIZE);
+    cut.len -= 100;
+    restarts = sim_restarts;
+    run_ota("firmware, truncated gzip:", &cut, 400);
+    printf("  %-34s %s, %lu restart\n", "", sim_boot_partition ? sim_boot_partition->label : "no boot change",
+           (unsigned long)(sim_restarts - restarts));
+    if (sim_boot_partition != NULL || sim_restarts != restarts) sim_fail("boot change");
+
+    // The inflated size is only checked as it is flashed and at the end
+    ota_fill(OTA_SPIFFS_USED);
+    ota_run_t empty = {.uri = "/api/ota?type=spiffs"};
+    ota_gzip(&empty, 0);
+    run_ota("filesystem, empty gzip:", &empty, 400);
+    if (strcmp(empty.msg, "Image is truncated or empty") != 0) sim_fail("empty image");
+    ota_run_t large = {.uri = "/api/ota?type=spiffs"};
+    ota_gzip(&large, sizeof(ota_image));
+    run_ota("filesystem, gzip, 4 KB too large:", &large, 400);
+    if (strcmp(large.msg, "Image is larger than the partition") != 0) sim_fail("large image");
+
+    // Two uploads at once, each on its own worker: the second is turned away
+    // and leaves the first alone
+    ota_old_images();
+    ota_fill(OTA_APP_SIZE);
+    ota_run_t first = {.uri = "/api/ota?type=app", .len = OTA_APP_SIZE};
+    ota_digest(&first, first.len, false);
+    ota_run_t second = first;
+    restarts = sim_restarts;
+    xTaskCreate(ota_client_task, "httpd", 4096, &first, 5, NULL);
+    sim_advance(pdMS_TO_TICKS(50));
+    xTaskCreate(ota_client_task, "httpd", 4096, &second, 5, NULL);
+    while (!first.done || !second.done) sim_advance(pdMS_TO_TICKS(100));
+    sim_advance(pdMS_TO_TICKS(3000));
+    printf("  %-34s %d \"%s\"; %d \"%s\"\n", "two firmware uploads at once:", first.status, first.msg,
+           second.status, second.msg);
+    printf("  %-34s %s, %lu restart\n", "", sim_boot_partition ? sim_boot_partition->label : "no boot change",
+           (unsigned long)(sim_restarts - restarts));
+    if (first.status != 200 || second.status != 409 || sim_boot_partition == NULL || sim_restarts - restarts != 1) {
+        sim_fail("concurrent update");
+    }
+    sim_costs = (sim_costs_t){0};
+}
+
+// --- Web workers ---------------------------------------------------------------
+
+typedef struct {
+    const ota_run_t *upload;
+    uint32_t commands;
+    uint32_t total_ms, max_ms;
+} relay_client_t;
+
+// A dashboard switching relay 1 every 250 ms while the upload runs
+static void relay_client_task(void *arg) {
+    relay_client_t *rc = arg;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    for (uint32_t i = 0; !rc->upload->done; i++) {
+        TickType_t sent = xTaskGetTickCount();
+        const sim_response_t *resp = sim_httpd_request(HTTP_GET, i & 1 ? "/api/relay?id=1&action=off"
+                                                                        : "/api/relay?id=1&action=on", NULL, NULL, 0);
+        uint32_t ms = resp->finished_at - sent;
+        rc->commands++;
+        rc->total_ms += ms;
+        if (ms > rc->max_ms) rc->max_ms = ms;
+        vTaskDelay(pdMS_TO_TICKS(250));
+    }
+    vTaskDelete(NULL);
+}
+
+static void run_concurrent(const char *label, bool async) {
+    sim_httpd_async = async;
+    ota_old_images();
+    ota_fill(OTA_APP_SIZE);
+    ota_run_t upload = {.uri = "/api/ota?type=app", .len = OTA_APP_SIZE};
+    ota_digest(&upload, upload.len, false);
+    relay_client_t rc = {.upload = &upload};
+    xTaskCreate(ota_client_task, "httpd", 4096, &upload, 5, NULL);
+    xTaskCreate(relay_client_task, "dashboard", 4096, &rc, 5, NULL);
+    while (!upload.done) sim_advance(pdMS_TO_TICKS(100));
+    sim_advance(pdMS_TO_TICKS(3000));   // Past the reboot delay
+    printf("  %-34s upload %d in %.2f s; %u relay commands, latency avg %.0f ms, max %u ms\n", label,
+           upload.status, upload.took / 1000.0, (unsigned)rc.commands,
+           rc.commands ? (double)rc.total_ms / rc.commands : 0.0, (unsigned)rc.max_ms);
+    // Without a copy for a worker the upload is turned away, rather than
+    // holding up the relay commands on the httpd task
+    if (upload.status != (async ? 200 : 503) || (async && (rc.commands == 0 || rc.max_ms > 100))) {
+        sim_fail("relay latency");
+    }
+    sim_httpd_async = true;
+    relay_off(1);
+    sim_idle();
+}
+
+// Two phones on a weak link fetching the dashboard script over and over,
+// which keeps both workers busy
+#define SLOW_FILE_SIZE (200 * 1024)
+
+typedef struct {
+    const ota_run_t *upload;
+    uint32_t files, refused;
+} file_client_t;
+
+static void file_client_task(void *arg) {
+    file_client_t *fc = arg;
+    while (!fc->upload->done) {
+        const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/app.js", NULL, NULL, 0);
+        if (resp->status == 200 && resp->body_sent == SLOW_FILE_SIZE) {
+            fc->files++;
+        } else {
+            fc->refused++;
+            vTaskDelay(pdMS_TO_TICKS(100));
+        }
+    }
+    vTaskDelete(NULL);
+}
+
+static void run_busy_workers(const char *label) {
+    static uint8_t file[SLOW_FILE_SIZE];
+    memset(file, 'x', sizeof(file));
+    FILE *f = fopen("/spiffs/app.min.js", "w");
+    fwrite(file, 1, sizeof(file), f);
+    fclose(f);
+
+    ota_old_images();
+    ota_fill(OTA_APP_SIZE);
+    ota_run_t upload = {.uri = "/api/ota?type=app", .len = OTA_APP_SIZE};
+    ota_digest(&upload, upload.len, false);
+    relay_client_t rc = {.upload = &upload};
+    file_client_t fc[2] = {{.upload = &upload}, {.upload = &upload}};
+    xTaskCreate(file_client_task, "phone_0", 4096, &fc[0], 5, NULL);
+    xTaskCreate(file_client_task, "phone_1", 4096, &fc[1], 5, NULL);
+    sim_advance(pdMS_TO_TICKS(50));
+    xTaskCreate(ota_client_task, "httpd", 4096, &upload, 5, NULL);
+    xTaskCreate(relay_client_task, "dashboard", 4096, &rc, 5, NULL);
+    while (!upload.done) sim_advance(pdMS_TO_TICKS(100));
+    // Let the last files go out; the restart is past by then too
+    sim_advance(pdMS_TO_TICKS(SLOW_FILE_SIZE / 1024 * sim_costs.send_kb_us / 1000 + 3000));
+    printf("  %-34s upload %d in %.2f s; %u relay commands, latency avg %.0f ms, max %u ms\n", label,
+           upload.status, upload.took / 1000.0, (unsigned)rc.commands,
+           rc.commands ? (double)rc.total_ms / rc.commands : 0.0, (unsigned)rc.max_ms);
+    printf("  %-34s %u files of %u KB sent, %u refused\n", "", (unsigned)(fc[0].files + fc[1].files),
+           SLOW_FILE_SIZE / 1024, (unsigned)(fc[0].refused + fc[1].refused));
+    if (upload.status != 200 || rc.commands == 0 || rc.max_ms > 100) sim_fail("relay latency");
+    remove("/spiffs/app.min.js");
+    relay_off(1);
+    sim_idle();
+}
+
+static void bench_workers(void) {
+    printf("\nWeb workers (virtual time, 900 KB firmware upload as in the OTA section,\n"
+           "            GET /api/relay every 250 ms from another client)\n");
+    sim_costs = (sim_costs_t){
+        .erase_sector_us = 45000,
+        .erase_block_us = 150000,
+        .write_kb_us = 2400,
+        .read_kb_us = 100,
+        .recv_kb_us = 2000,
+        .recv_window = 5760,
+    };
+    run_concurrent("no memory for an async copy:", false);
+    run_concurrent("upload on a worker:", true);
+    // Responses go out at 50 KB/s
+    sim_costs.send_kb_us = 20000;
+    run_busy_workers("both workers on 200 KB files:");
+    sim_costs = (sim_costs_t){0};
+}
+
+// --- Safety cutoff -----------------------------------------------------------
+
+#define SAFETY_UPLOADS 3
+
+// The timer clients run until deadlines_done, and count the deadlines
+// that pass during an upload
+static bool deadlines_done;
+static bool uploading;
+static uint32_t deadline_runs, deadline_total_ms, deadline_max_ms;
+
+// Switches a relay on for 1 to 3 s again and again, with pauses that move
+// the deadline around the erases, and times each switch-off at its pin
+static void timer_client_task(void *arg) {
+    const int relay = (intptr_t)arg;
+    const int pin = relay_gpio[relay];
+    const uint32_t gap_ms = 17 + 18 * relay;
+    for (uint32_t i = 0; !deadlines_done; i++) {
+        uint32_t sec = 1 + i % 3;
+        relay_on_with_timer(relay, sec);
+        TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(sec * 1000);
+        while (sim_gpio_level[pin] == 0) vTaskDelay(pdMS_TO_TICKS(5));
+        if (uploading) {
+            uint32_t ms = gpio_changed_at[pin] - deadline;
+            deadline_runs++;
+            deadline_total_ms += ms;
+            if (ms > deadline_max_ms) deadline_max_ms = ms;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10 + gap_ms * (i % 7)));
+    }
+    vTaskDelete(NULL);
+}
+
+static void run_deadlines(const char *label, bool stalls, bool timer_stuck) {
+    sim_costs.flash_stalls_cpu = stalls;
+    sim_timer_service_stalled = timer_stuck;
+    deadlines_done = false;
+    deadline_runs = deadline_total_ms = deadline_max_ms = 0;
+    relay_safety_stats_t before, after;
+    relay_safety_get_stats(&before);
+    uint32_t alarms = sim_gptimer_alarms;
+    // Relays 1, 3 and 4; the dashboard has relay 2
+    xTaskCreate(timer_client_task, "timed", 4096, (void *)0, 5, NULL);
+    xTaskCreate(timer_client_task, "timed", 4096, (void *)2, 5, NULL);
+    xTaskCreate(timer_client_task, "timed", 4096, (void *)3, 5, NULL);
+
+    ota_fill(OTA_APP_SIZE);
+    TickType_t took = 0;
+    uint32_t max_command_ms = 0;
+    bool ok = true;
+    for (int u = 0; u < SAFETY_UPLOADS; u++) {
+        ota_old_images();
+        ota_run_t upload = {.uri = "/api/ota?type=app", .len = OTA_APP_SIZE};
+        ota_digest(&upload, upload.len, false);
+        relay_client_t rc = {.upload = &upload};
+        uploading = true;
+        xTaskCreate(ota_client_task, "httpd", 4096, &upload, 5, NULL);
+        xTaskCreate(relay_client_task, "dashboard", 4096, &rc, 5, NULL);
+        while (!upload.done) sim_advance(pdMS_TO_TICKS(100));
+        uploading = false;
+        took += upload.took;
+        if (rc.max_ms > max_command_ms) max_command_ms = rc.max_ms;
+        ok &= upload.status == 200;
+        sim_advance(pdMS_TO_TICKS(3000));   // Past the reboot delay
+        relay_off(1);
+    }
+    deadlines_done = true;
+    sim_advance(pdMS_TO_TICKS(4000));
+    sim_timer_service_stalled = false;
+    sim_advance(pdMS_TO_TICKS(10));
+    relay_safety_get_stats(&after);
+
+    printf("  %-34s %d uploads, %.2f s each; relay commands max %u ms\n", label, SAFETY_UPLOADS,
+           took / 1000.0 / SAFETY_UPLOADS, (unsigned)max_command_ms);
+    printf("  %-34s %u deadlines in them: pin off avg %.1f ms, max %u ms late\n", "",
+           (unsigned)deadline_runs, deadline_runs ? (double)deadline_total_ms / deadline_runs : 0.0,
+           (unsigned)deadline_max_ms);
+    printf("  %-34s %u relays cut off by %u timer interrupts in all\n", "", (unsigned)(after.cutoffs - before.cutoffs),
+           (unsigned)(sim_gptimer_alarms - alarms));
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    if (!ok || snap.on_mask) sim_fail("end state");
+}
+
+static void bench_safety(void) {
+    printf("\nSafety cutoff (virtual time: the upload and dashboard of the web workers section,\n"
+           "               relays 1, 3 and 4 on for 1 to 3 s over and over; cutoff %d ms past a deadline)\n",
+           RELAY_SAFETY_GRACE_MS);
+    sim_costs = (sim_costs_t){
+        .erase_sector_us = 45000,
+        .erase_block_us = 150000,
+        .write_kb_us = 2400,
+        .read_kb_us = 100,
+        .recv_kb_us = 2000,
+        .recv_window = 5760,
+    };
+    run_deadlines("flash blocks only its task:", false, false);
+    run_deadlines("flash stalls the CPU:", true, false);
+    run_deadlines("timer service stuck as well:", true, true);
+    sim_costs = (sim_costs_t){0};
+
+    // The timer queue full as a relay goes on: the safety task arms the
+    // deadline again, rather than leaving it to the cutoff
+    relay_safety_stats_t before, after;
+    relay_safety_get_stats(&before);
+    sim_timer_queue_full = true;
+    relay_on_with_timer(0, 2);
+    TickType_t deadline = sim_now() + pdMS_TO_TICKS(2000);
+    gpio_changed_at[relay_gpio[0]] = 0;
+    sim_advance(pdMS_TO_TICKS(5));
+    sim_timer_queue_full = false;
+    sim_advance(pdMS_TO_TICKS(3000));
+    relay_safety_get_stats(&after);
+    uint32_t late = gpio_changed_at[relay_gpio[0]] ? gpio_changed_at[relay_gpio[0]] - deadline : UINT32_MAX;
+    uint32_t retries = after.timer_retries - before.timer_retries;
+    uint32_t cutoffs = after.cutoffs - before.cutoffs;
+    printf("  %-34s relay 1 off %u ms past its deadline; %u commands retried, %u cut off\n",
+           "timer queue full for 5 ms:", (unsigned)late, (unsigned)retries, (unsigned)cutoffs);
+    if (late > 1 || retries == 0 || cutoffs) sim_fail("deadline after a full timer queue");
+
+    // The task watchdog's interrupt, called as the watchdog would
+    relay_command_t on[] = {
+        {.relay_num = 0, .action = RELAY_CMD_ON},
+        {.relay_num = 2, .action = RELAY_CMD_TIMED, .seconds = 600},
+        {.relay_num = 3, .action = RELAY_CMD_ON},
+    };
+    relay_apply(on, 3);
+    sim_idle();
+    esp_task_wdt_isr_user_handler();
+    // Before any task has run
+    int pins_on = 0;
+    for (int i = 0; i < BENCH_ZONES; i++) pins_on += sim_gpio_level[relay_gpio[i]] == 0;
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    printf("  %-34s 3 relays on; %d on at the pins in the interrupt, %d in the state\n",
+           "task watchdog timeout:", pins_on, __builtin_popcountll(snap.on_mask));
+    sim_idle();
+    relay_snapshot(&snap, NULL);
+    printf("  %-34s %d in the state once the safety task ran\n", "", __builtin_popcountll(snap.on_mask));
+    relay_on(0);
+    sim_idle();
+    printf("  %-34s pin %s\n", "relay 1 switched on after it:",
+           sim_gpio_level[relay_gpio[0]] == 0 ? "on" : "off");
+    relay_off(0);
+    sim_idle();
+    printf("  %-34s %s\n", "hardware timer, all relays off:", sim_gptimer_running ? "running" : "stopped");
+    if (pins_on || snap.on_mask || sim_gpio_level[relay_gpio[0]] == 0 || sim_gptimer_running) {
+        sim_fail("watchdog cutoff");
+    }
+}
+
+int main(void) {
+    char spiffs_dir[] = "/tmp/autowater_spiffs_XXXXXX";
+    sim_spiffs_root = mkdtemp(spiffs_dir);
+
+    sim_init();
+    sim_set_gpio_hook(on_gpio);
+    relay_init();
+    mqtt_bridge_init();
+    sim_idle();
+
+    printf("Autowater host benchmark\n");
+    bench_routine();
+    bench_json();
+    web_server_start();
+    bench_http();
+    bench_cbor();
+    bench_batch();
+    bench_routines();
+    bench_mqtt();
+    bench_scheduler();
+    bench_idle();
+    bench_journal();
+    bench_history();
+    bench_metrics();
+    bench_ota();
+    bench_workers();
+    bench_safety();
+
+    remove("/spiffs/routines.json");
+    rmdir(spiffs_dir);
+    return sim_checks_result();
+}
@@ -0,0 +1,241 @@
+// Host benchmark for the flow meter build (FLOW_METER_GPIO set): a
+// simulated meter on the supply line whose pulse rate follows the open
+// valves. Measures what volume steps deliver, how fast dry and burst
+// zones close and what the counting costs; all in virtual time.
+
+#include "sim.h"
+#include "relay_controller.h"
+#include "flow_meter.h"
+#include "history.h"
+#include "json_writer.h"
+#include "routine_store.h"
+#include "web_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// The GPIO backend's relays and what each zone draws at full pressure:
+// two normal zones, a dry one and one with a burst pipe
+#define BENCH_ZONES 4
+static const int relay_gpio[BENCH_ZONES] = {6, 7, 5, 10};
+static const uint32_t zone_ml_per_min[BENCH_ZONES] = {12000, 8000, 0, 60000};
+
+static uint32_t pressure = 100;     // Percent of the full flow
+static uint32_t stuck_ml_per_min;   // Through a valve that no longer closes
+
+// What went through each zone in its last on period, from the meter's
+// pulses, and for how long it was on
+static TickType_t opened_at[BENCH_ZONES];
+static uint64_t opened_pulses[BENCH_ZONES];
+static uint32_t delivered_ml[BENCH_ZONES];
+static uint32_t open_ms[BENCH_ZONES];
+
+static uint32_t pulses_to_ml(uint64_t pulses) {
+    return (uint32_t)(pulses * 1000 / FLOW_PULSES_PER_LITRE);
+}
+
+static void on_gpio(int gpio, uint32_t level) {
+    uint32_t ml_per_min = stuck_ml_per_min;
+    for (int z = 0; z < BENCH_ZONES; z++) {
+        if (relay_gpio[z] == gpio) {
+            uint64_t pulses = sim_pcnt_pulses();
+            if (level == 0) {
+                opened_at[z] = sim_now();
+                opened_pulses[z] = pulses;
+            } else {
+                delivered_ml[z] = pulses_to_ml(pulses - opened_pulses[z]);
+                open_ms[z] = sim_now() - opened_at[z];
+            }
+        }
+        // Relays are active low
+        if (sim_gpio_level[relay_gpio[z]] == 0) ml_per_min += zone_ml_per_min[z] * pressure / 100;
+    }
+    sim_pcnt_set_rate((uint64_t)ml_per_min * FLOW_PULSES_PER_LITRE / 60);
+}
+
+// The last watering's "end", from /api/history
+static const char *last_end(int zone) {
+    static char end[16];
+    char uri[64];
+    snprintf(uri, sizeof(uri), "/api/history?zone=%d", zone);
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, uri, NULL, NULL, 0);
+    const char *p = NULL;
+    for (const char *q = resp->body; (q = strstr(q, "\"end\":\"")) != NULL; q++) p = q;
+    if (resp->status != 200 || p == NULL) return "none";
+    sscanf(p + 7, "%15[^\"]", end);
+    return end;
+}
+
+// The "flow" object of /api/status
+static const char *flow_status(void) {
+    static char flow[96];
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/api/status", NULL, NULL, 0);
+    const char *p = strstr(resp->body, "\"flow\":");
+    if (p == NULL) return "missing";
+    sscanf(p + 7, "%95[^}]", flow);
+    strcat(flow, "}");
+    return flow;
+}
+
+static bool zone_on(int zone) {
+    return relay_get_state(zone);
+}
+
+static void bench_setup(void) {
+    printf("\nSetup (GPIO %d, %d pulses per litre)\n", FLOW_METER_GPIO, FLOW_PULSES_PER_LITRE);
+    printf("  flow meter:                        %s\n", flow_meter_present() ? "yes" : "no");
+    printf("  counter running while all closed:  %s\n", sim_pcnt_running ? "yes" : "no");
+    if (!flow_meter_present() || sim_pcnt_running) sim_fail("setup");
+    printf("  GET /api/status flow:              %s\n", flow_status());
+}
+
+static void bench_manual(void) {
+    printf("\nManual watering, zone 1 at 12 L/min for 60 s\n");
+
+    sim_reset_wakeups();
+    uint32_t reads = sim_pcnt_reads;
+    relay_on_with_timer(0, 60);
+    sim_advance(pdMS_TO_TICKS(30 * 1000));
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/api/status", NULL, NULL, 0);
+    printf("  halfway, GET /api/status:          %.*s\n", (int)resp->body_len, resp->body);
+    sim_advance(pdMS_TO_TICKS(30 * 1000 + 10));
+    printf("  delivered:                         %lu ml in %lu ms, end \"%s\"\n", (unsigned long)delivered_ml[0],
+           (unsigned long)open_ms[0], last_end(0));
+    if (delivered_ml[0] < 12000 || delivered_ml[0] > 12100 || strcmp(last_end(0), "timer") != 0) sim_fail("volume");
+    sim_advance(pdMS_TO_TICKS(FLOW_SETTLE_SEC * 1000));
+    printf("  counter reads:                     %lu (interrupts: none)\n",
+           (unsigned long)(sim_pcnt_reads - reads));
+    printf("  counter running %d s after:        %s\n", FLOW_SETTLE_SEC, sim_pcnt_running ? "yes" : "no");
+    if (sim_pcnt_running) sim_fail("counter left running");
+
+    reads = sim_pcnt_reads;
+    sim_reset_wakeups();
+    sim_advance(pdMS_TO_TICKS(3600 * 1000));
+    printf("  idle hour:                         %lu timer callbacks, %lu counter reads\n",
+           (unsigned long)sim_timer_fires, (unsigned long)(sim_pcnt_reads - reads));
+}
+
+// One routine, a volume step on each normal zone with a 10 minute cap
+static const char routines[] =
+    "[{\"name\":\"Volume\",\"steps\":["
+    "{\"id\":0,\"name\":\"Plants\",\"duration\":10,\"litres\":20},"
+    "{\"id\":1,\"name\":\"Grass\",\"duration\":10,\"litres\":4}]},"
+    "{\"name\":\"Time\",\"steps\":[{\"id\":0,\"name\":\"Plants\",\"duration\":2}]}]";
+
+static void run_routine(int index) {
+    char uri[64];
+    snprintf(uri, sizeof(uri), "/api/routine/control?action=start&index=%d", index);
+    sim_httpd_request(HTTP_GET, uri, NULL, NULL, 0);
+    sim_idle();
+    for (int s = 0; s < 30 * 60; s++) {
+        relay_snapshot_t snap;
+        relay_snapshot(&snap, NULL);
+        if (!snap.routine_running) break;
+        sim_advance(pdMS_TO_TICKS(1000));
+    }
+}
+
+static void bench_volume(void) {
+    printf("\nVolume steps (zone 1: 20 L, zone 2: 4 L, 10 min caps)\n");
+
+    const sim_response_t *resp = sim_httpd_request(HTTP_POST, "/api/routines", NULL, routines, sizeof(routines) - 1);
+    if (resp->status != 200) sim_fail("upload: %d %.*s", resp->status, (int)resp->body_len, resp->body);
+
+    for (int pass = 0; pass < 2; pass++) {
+        pressure = pass == 0 ? 100 : 50;
+        sim_reset_wakeups();
+        uint32_t reads = sim_pcnt_reads;
+        run_routine(0);
+        printf("  %3lu%% pressure, step 1:            %lu ml in %.1f s, end \"%s\"\n", (unsigned long)pressure,
+               (unsigned long)delivered_ml[0], open_ms[0] / 1000.0, last_end(0));
+        printf("  %3lu%% pressure, step 2:            %lu ml in %.1f s, end \"%s\"\n", (unsigned long)pressure,
+               (unsigned long)delivered_ml[1], open_ms[1] / 1000.0, last_end(1));
+        printf("    counter reads %lu, timer callbacks %lu\n", (unsigned long)(sim_pcnt_reads - reads),
+               (unsigned long)sim_timer_fires);
+        if (delivered_ml[0] < 20000 || delivered_ml[0] > 20100 || delivered_ml[1] < 4000 || delivered_ml[1] > 4100) {
+            sim_fail("volume");
+        }
+        sim_advance(pdMS_TO_TICKS(FLOW_SETTLE_SEC * 1000));
+    }
+    for (int pass = 0; pass < 2; pass++) {
+        pressure = pass == 0 ? 100 : 50;
+        run_routine(1);
+        printf("  %3lu%% pressure, 2 min on time:     %lu ml\n", (unsigned long)pressure,
+               (unsigned long)delivered_ml[0]);
+        sim_advance(pdMS_TO_TICKS(FLOW_SETTLE_SEC * 1000));
+    }
+    pressure = 100;
+
+    static const char bad[] = "[{\"name\":\"Bad\",\"steps\":[{\"id\":0,\"duration\":5,\"litres\":5000}]}]";
+    resp = sim_httpd_request(HTTP_POST, "/api/routines", NULL, bad, sizeof(bad) - 1);
+    printf("  litres 5000:                       %d \"%.*s\"\n", resp->status, (int)resp->body_len, resp->body);
+    if (resp->status != 400) sim_fail("litres accepted");
+
+    // A step resumed after a reset gets its volume, capped by the time left
+    routine_step_t steps[MAX_ROUTINE_STEPS];
+    int n = routine_store_steps(0, steps);
+    routine_progress_t progress = { .done = 1, .left = { [1] = 20 } };
+    relay_resume_routine("Volume", steps, n, &progress);
+    sim_idle();
+    sim_advance(pdMS_TO_TICKS(25 * 1000));
+    printf("  resumed step 2, 20 s left:         %lu ml in %.1f s, end \"%s\"\n",
+           (unsigned long)delivered_ml[1], open_ms[1] / 1000.0, last_end(1));
+    sim_advance(pdMS_TO_TICKS(FLOW_SETTLE_SEC * 1000));
+}
+
+static void bench_alarms(void) {
+    printf("\nAlarms\n");
+
+    relay_on_with_timer(2, 300);
+    sim_advance(pdMS_TO_TICKS(60 * 1000));
+    printf("  dry zone 3:                        closed after %.1f s, end \"%s\", alarm %s\n", open_ms[2] / 1000.0,
+           last_end(2), flow_status());
+    if (zone_on(2) || open_ms[2] > (FLOW_START_SEC + 2) * 1000) sim_fail("dry zone");
+
+    relay_on_with_timer(3, 300);
+    sim_advance(pdMS_TO_TICKS(60 * 1000));
+    printf("  burst zone 4 (60 L/min):           closed after %.1f s with %lu ml, end \"%s\"\n",
+           open_ms[3] / 1000.0, (unsigned long)delivered_ml[3], last_end(3));
+    printf("                                     %s\n", flow_status());
+    if (zone_on(3) || open_ms[3] > (FLOW_LEAK_SEC + 3) * 1000) sim_fail("burst zone");
+
+    relay_on_with_timer(0, 30);
+    sim_advance(pdMS_TO_TICKS(20 * 1000));
+    printf("  normal zone 1 again:               %s\n", flow_status());
+    if (strstr(flow_status(), "\"alarm\":\"none\"") == NULL) sim_fail("alarm not cleared");
+    // The valve sticks half open as it closes
+    stuck_ml_per_min = 2000;
+    sim_advance(pdMS_TO_TICKS((10 + FLOW_SETTLE_SEC + 2) * 1000));
+    printf("  2 L/min after zone 1 closed:       %s\n", flow_status());
+    if (strstr(flow_status(), "\"alarm\":\"leak\"") == NULL) sim_fail("no leak alarm");
+    printf("  counter running:                   %s\n", sim_pcnt_running ? "yes" : "no");
+    stuck_ml_per_min = 0;
+    sim_pcnt_set_rate(0);
+}
+
+int main(void) {
+    char spiffs_dir[] = "/tmp/autowater_flow_XXXXXX";
+    sim_spiffs_root = mkdtemp(spiffs_dir);
+
+    sim_init();
+    sim_set_gpio_hook(on_gpio);
+    sim_sntp_sync(1821484800);
+    history_init();
+    relay_init();
+    flow_meter_init();
+    web_server_start();
+    sim_idle();
+
+    printf("Autowater flow meter benchmark (virtual time)\n");
+    bench_setup();
+    bench_manual();
+    bench_volume();
+    bench_alarms();
+
+    remove("/spiffs/routines.json");
+    rmdir(spiffs_dir);
+    return sim_checks_result();
+}
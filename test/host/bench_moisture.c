@@ -0,0 +1,292 @@
+// Host benchmark for the soil-moisture build (MOISTURE_ADC_CHANNELS=0,1):
+// two sensors whose readings come from a sample trace, played into the
+// ADC with conversion noise and pump spikes. Shows what the filter makes
+// of the noise, what sampling costs and which routine steps the readings
+// skip or shorten; all in virtual time.
+
+#include "sim.h"
+#include "relay_controller.h"
+#include "moisture.h"
+#include "history.h"
+#include "json_writer.h"
+#include "web_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_ZONES 4
+static const int relay_gpio[BENCH_ZONES] = {6, 7, 5, 10};
+#define STEP_SEC 600
+
+// --- The ADC's input -------------------------------------------------------
+
+#define TRACE_MAX 400
+static uint32_t trace_minute[TRACE_MAX];
+static uint16_t trace_raw[TRACE_MAX][2];
+static int trace_len = 0;
+static TickType_t trace_start;
+
+static bool playing = false;
+static uint16_t level[2] = {2200, 2200};   // What the sensors put out when not playing
+static uint32_t noise = 32;                 // Peak conversion noise, LSB
+static uint32_t spike_every = 0;            // One conversion in this many spikes, 0 for none
+static bool pump_spikes = false;            // Spikes only while a zone is on
+
+// Sums of what the ADC delivered per channel, for the plain mean
+static uint64_t delivered_sum[2];
+static uint32_t delivered_n[2];
+
+static uint32_t rng = 2463534242u;
+
+static uint32_t xorshift(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static bool load_trace(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return false;
+    char line[128];
+    while (fgets(line, sizeof(line), f) && trace_len < TRACE_MAX) {
+        unsigned m, a, b;
+        if (line[0] == '#' || sscanf(line, "%u,%u,%u", &m, &a, &b) != 3) continue;
+        trace_minute[trace_len] = m;
+        trace_raw[trace_len][0] = a;
+        trace_raw[trace_len][1] = b;
+        trace_len++;
+    }
+    fclose(f);
+    return trace_len > 1;
+}
+
+// The trace at the current virtual time, interpolated between its lines
+static uint16_t trace_level(int sensor) {
+    uint64_t ms = (uint64_t)(sim_now() - trace_start) * portTICK_PERIOD_MS;
+    int i = 0;
+    while (i + 2 < trace_len && (uint64_t)trace_minute[i + 1] * 60000 <= ms) i++;
+    uint64_t t0 = (uint64_t)trace_minute[i] * 60000, t1 = (uint64_t)trace_minute[i + 1] * 60000;
+    int32_t a = trace_raw[i][sensor], b = trace_raw[i + 1][sensor];
+    if (ms >= t1) return b;
+    // A reading that jumps (a loose cable) does so at the line
+    if (a > MOISTURE_RAW_MAX || b > MOISTURE_RAW_MAX) return a;
+    return a + (b - a) * (int64_t)(ms - t0) / (int64_t)(t1 - t0);
+}
+
+static bool any_zone_on(void) {
+    for (int z = 0; z < BENCH_ZONES; z++) {
+        if (sim_gpio_level[relay_gpio[z]] == 0) return true;
+    }
+    return false;
+}
+
+static uint16_t adc_source(int channel) {
+    int sensor = channel;
+    int32_t v = playing ? trace_level(sensor) : level[sensor];
+    if (v < 4095) {
+        // Roughly normal: the sum of four uniform draws
+        int32_t n = 0;
+        for (int k = 0; k < 4; k++) n += (int32_t)(xorshift() % (2 * noise / 4 + 1)) - (int32_t)(noise / 4);
+        v += n;
+        if (spike_every && (!pump_spikes || any_zone_on()) && xorshift() % spike_every == 0) v += 900;
+    }
+    v = v < 0 ? 0 : v > 4095 ? 4095 : v;
+    delivered_sum[sensor] += v;
+    delivered_n[sensor]++;
+    return v;
+}
+
+// --- Watering ----------------------------------------------------------------
+
+static TickType_t opened_at[BENCH_ZONES];
+static uint32_t watered_sec[BENCH_ZONES];
+
+static void on_gpio(int gpio, uint32_t level_now) {
+    for (int z = 0; z < BENCH_ZONES; z++) {
+        if (relay_gpio[z] != gpio) continue;
+        // Relays are active low
+        if (level_now == 0) opened_at[z] = sim_now();
+        else watered_sec[z] += (sim_now() - opened_at[z] + 500) / 1000;
+    }
+}
+
+static const char routines[] =
+    "[{\"name\":\"Daily\",\"steps\":["
+    "{\"id\":0,\"name\":\"Lawn\",\"duration\":10},"
+    "{\"id\":1,\"name\":\"Bed\",\"duration\":10},"
+    "{\"id\":2,\"name\":\"Hedge\",\"duration\":10},"
+    "{\"id\":3,\"name\":\"Pots\",\"duration\":10}]}]";
+
+// The "moisture" array of /api/status
+static const char *status_moisture(void) {
+    static char out[96];
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/api/status", NULL, NULL, 0);
+    const char *p = strstr(resp->body, "\"moisture\":");
+    if (p == NULL) return "missing";
+    sscanf(p + 11, "%95[^]]", out);
+    strcat(out, "]");
+    return out;
+}
+
+// --- Sections ----------------------------------------------------------------
+
+static void bench_setup(void) {
+    printf("\nSetup (ADC1 channels 0 and 1, dry %d, wet %d raw, a burst every %d s)\n", MOISTURE_RAW_DRY,
+           MOISTURE_RAW_WET, MOISTURE_PERIOD_SEC);
+    printf("  sensors:                           %d\n", moisture_sensors());
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/api/moisture?zone=0&sensor=0&dry=35&wet=60",
+                                                   NULL, NULL, 0);
+    if (resp->status != 200) sim_fail("status %d %.*s", resp->status, (int)resp->body_len, resp->body);
+    resp = sim_httpd_request(HTTP_GET, "/api/moisture?zone=1&sensor=1&dry=30&wet=48", NULL, NULL, 0);
+    printf("  GET /api/moisture:                 %d %.*s\n", resp->status, (int)resp->body_len, resp->body);
+    if (resp->status != 200) sim_fail("status %d", resp->status);
+    resp = sim_httpd_request(HTTP_GET, "/api/moisture?zone=2&sensor=0&dry=60&wet=40", NULL, NULL, 0);
+    printf("  dry 60, wet 40:                    %d \"%.*s\"\n", resp->status, (int)resp->body_len, resp->body);
+    if (resp->status != 400) sim_fail("status %d", resp->status);
+    resp = sim_httpd_request(HTTP_GET, "/api/moisture?zone=2&sensor=2", NULL, NULL, 0);
+    printf("  sensor 2:                          %d \"%.*s\"\n", resp->status, (int)resp->body_len, resp->body);
+    if (resp->status != 400) sim_fail("status %d", resp->status);
+    resp = sim_httpd_request(HTTP_POST, "/api/routines", NULL, routines, sizeof(routines) - 1);
+    if (resp->status != 200) sim_fail("upload: %d %.*s", resp->status, (int)resp->body_len, resp->body);
+}
+
+static void bench_filter(void) {
+    printf("\nFilter (sensor at 2200 raw, %u LSB noise; one burst = %d conversions)\n", (unsigned)noise,
+           MOISTURE_FRAME_SAMPLES);
+    static const struct {
+        const char *what;
+        uint32_t spike_every;
+    } cases[] = {
+        { "noise only:", 0 },
+        { "1 in 32 spiked by +900:", 32 },
+        { "1 in 8 spiked by +900:", 8 },
+    };
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        spike_every = cases[c].spike_every;
+        int32_t worst_burst = 0, worst_mean = 0;
+        for (int b = 0; b < 20; b++) {
+            delivered_sum[0] = delivered_n[0] = 0;
+            sim_advance(pdMS_TO_TICKS(MOISTURE_PERIOD_SEC * 1000));
+            char body[256];
+            const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/api/moisture", NULL, NULL, 0);
+            snprintf(body, sizeof(body), "%.*s", (int)resp->body_len, resp->body);
+            const char *p = strstr(body, "\"raw\":");
+            int raw = p ? atoi(p + 6) : 0;
+            int32_t mean = delivered_n[0] ? (int32_t)(delivered_sum[0] / delivered_n[0]) : 0;
+            if (abs(raw - 2200) > worst_burst) worst_burst = abs(raw - 2200);
+            if (abs(mean - 2200) > worst_mean) worst_mean = abs(mean - 2200);
+        }
+        int percent;
+        moisture_step_share(0, &percent);
+        printf("  %-34s burst off by up to %d raw (plain mean: %d), %d%%\n", cases[c].what, (int)worst_burst,
+               (int)worst_mean, percent);
+        if (worst_burst > 8) sim_fail("filter error");
+    }
+    spike_every = 0;
+}
+
+static void bench_cost(void) {
+    printf("\nSampling cost, one hour\n");
+    uint32_t frames = sim_adc_frames;
+    uint64_t conversions = sim_adc_conversions, running = sim_adc_running_ms;
+    sim_reset_wakeups();
+    sim_advance(pdMS_TO_TICKS(3600 * 1000));
+    printf("  conversions:                       %llu\n", (unsigned long long)(sim_adc_conversions - conversions));
+    printf("  ADC interrupts (DMA frames):       %lu\n", (unsigned long)(sim_adc_frames - frames));
+    printf("  moisture_task wakeups:             %lu\n", (unsigned long)sim_task_wakeups("moisture_task"));
+    printf("  ADC running:                       %llu ms (%.3f%% of the hour)\n",
+           (unsigned long long)(sim_adc_running_ms - running), (sim_adc_running_ms - running) / 36000.0);
+    printf("  running between bursts:            %s\n", sim_adc_running ? "yes" : "no");
+}
+
+// What the bench expects of each run, per zone: a share of the step in
+// percent, -1 for "less than all but more than nothing"
+static const struct {
+    uint32_t minute;
+    const char *what;
+    int expect[BENCH_ZONES];
+} runs[] = {
+    { 6 * 60, "day 1 06:00", {100, -1, 100, 100} },
+    { 18 * 60, "day 1 18:00", {100, -1, 100, 100} },
+    { 30 * 60, "day 2 06:00, after rain", {0, 0, 100, 100} },
+    { 42 * 60, "day 2 18:00, sensor 1 loose", {-1, 100, 100, 100} },
+};
+
+static void bench_trace(void) {
+    const char *path = TRACE_DIR "/moisture_48h.csv";
+    if (!load_trace(path)) {
+        printf("\nTrace %s: not found\n", path);
+        return;
+    }
+    printf("\nTrace playback (%s, %d lines, pump spikes 1 in 32)\n", strrchr(path, '/') + 1, trace_len);
+    printf("  zones 1 and 2 follow sensors 0 and 1; zones 3 and 4 have none\n");
+    printf("  %-34s seconds watered per zone, of %d\n", "run", STEP_SEC);
+    spike_every = 32;
+    pump_spikes = true;
+    playing = true;
+    trace_start = sim_now();
+    uint32_t wakeups, frames = sim_adc_frames;
+    sim_reset_wakeups();
+    for (size_t r = 0; r < sizeof(runs) / sizeof(runs[0]); r++) {
+        TickType_t at = trace_start + pdMS_TO_TICKS(runs[r].minute * 60000);
+        sim_advance(at - sim_now());
+        const char *moisture = status_moisture();
+        char moisture_copy[96];
+        snprintf(moisture_copy, sizeof(moisture_copy), "%s", moisture);
+        memset(watered_sec, 0, sizeof(watered_sec));
+        sim_httpd_request(HTTP_GET, "/api/routine/control?action=start&index=0", NULL, NULL, 0);
+        sim_idle();
+        for (int s = 0; s < 60 * 60; s++) {
+            relay_snapshot_t snap;
+            relay_snapshot(&snap, NULL);
+            if (!snap.routine_running) break;
+            sim_advance(pdMS_TO_TICKS(1000));
+        }
+        printf("  %-34s %3lu %3lu %3lu %3lu\n", runs[r].what, (unsigned long)watered_sec[0],
+               (unsigned long)watered_sec[1], (unsigned long)watered_sec[2], (unsigned long)watered_sec[3]);
+        printf("    moisture at the start:           %s\n", moisture_copy);
+        for (int z = 0; z < BENCH_ZONES; z++) {
+            int e = runs[r].expect[z];
+            bool ok = e < 0 ? watered_sec[z] > 0 && watered_sec[z] < STEP_SEC : watered_sec[z] == (uint32_t)(STEP_SEC * e / 100);
+            if (!ok) sim_fail("time on zone %d", z + 1);
+        }
+    }
+    wakeups = sim_task_wakeups("moisture_task");
+    TickType_t end = trace_start + pdMS_TO_TICKS(48 * 3600 * 1000u);
+    if (end > sim_now()) sim_advance(end - sim_now());
+    printf("  48 h:                              %lu moisture_task wakeups to the last run, %lu ADC interrupts\n",
+           (unsigned long)wakeups, (unsigned long)(sim_adc_frames - frames));
+    printf("  GET /api/status moisture:          %s\n", status_moisture());
+    playing = false;
+    pump_spikes = false;
+    spike_every = 0;
+}
+
+int main(void) {
+    char spiffs_dir[] = "/tmp/autowater_moisture_XXXXXX";
+    sim_spiffs_root = mkdtemp(spiffs_dir);
+
+    sim_init();
+    sim_set_gpio_hook(on_gpio);
+    sim_adc_set_source(adc_source);
+    sim_sntp_sync(1821484800);
+    history_init();
+    relay_init();
+    moisture_init();
+    web_server_start();
+    sim_idle();
+
+    printf("Autowater soil-moisture benchmark (virtual time)\n");
+    bench_setup();
+    bench_filter();
+    bench_cost();
+    bench_trace();
+
+    remove("/spiffs/routines.json");
+    rmdir(spiffs_dir);
+    return sim_checks_result();
+}
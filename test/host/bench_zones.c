@@ -0,0 +1,449 @@
+// Host benchmark for the 64-zone build: eight 74HC595s chained on SPI
+// (RELAY_OUTPUT=1, RELAY_SR_CHIPS=8). Counts bus transactions and timers
+// for batches, expiries and zone count changes; times are wall-clock on
+// the host like in bench.c.
+
+#include "sim.h"
+#include "relay_controller.h"
+#include "relay_output.h"
+#include "relay_safety.h"
+#include "json_writer.h"
+#include "status_json.h"
+#include "history.h"
+#include "web_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void report(const char *what, uint64_t ns, int iterations, uint32_t allocs, uint64_t bytes) {
+    printf("  %-34s %9.0f ns/op  %6.2f allocs/op  %8.1f heap B/op\n", what,
+           (double)ns / iterations, (double)allocs / iterations, (double)bytes / iterations);
+}
+
+// The relays the last frame switched on: active low, last chip first
+static relay_mask_t frame_mask(void) {
+    relay_mask_t on = 0;
+    for (size_t c = 0; c < sim_spi_frame_len; c++) {
+        on |= (relay_mask_t)(uint8_t)~sim_spi_frame[c] << ((sim_spi_frame_len - 1 - c) * 8);
+    }
+    return on;
+}
+
+static relay_mask_t on_mask(void) {
+    relay_snapshot_t snap;
+    relay_snapshot(&snap, NULL);
+    return snap.on_mask;
+}
+
+static void all_timed(uint32_t base, uint32_t step) {
+    static relay_command_t cmds[RELAY_MAX];
+    for (int i = 0; i < RELAY_MAX; i++) {
+        cmds[i] = (relay_command_t){ .relay_num = i, .action = RELAY_CMD_TIMED, .seconds = base + i * step };
+    }
+    relay_apply(cmds, RELAY_MAX);
+}
+
+static void all_off(void) {
+    static relay_command_t cmds[RELAY_MAX];
+    for (int i = 0; i < RELAY_MAX; i++) {
+        cmds[i] = (relay_command_t){ .relay_num = i, .action = RELAY_CMD_OFF };
+    }
+    relay_apply(cmds, RELAY_MAX);
+}
+
+static uint32_t dump_records;
+
+static bool count_records(void *ctx, const char *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dump_records += buf[i] == '{';
+    }
+    return true;
+}
+
+static void bench_init(void) {
+    uint32_t timers = sim_timers_created;
+    relay_init();
+    timers = sim_timers_created - timers;
+    sim_idle();
+
+    printf("\nSetup (%s backend)\n", relay_output_name());
+    printf("  zones:                             %d of %d\n", relay_count(), relay_channels());
+    printf("  FreeRTOS timers for the relays:    %lu (one per relay before: %d)\n", (unsigned long)timers,
+           relay_channels());
+    printf("  relay state (snapshot):            %u bytes\n", (unsigned)sizeof(relay_snapshot_t));
+    printf("  SPI with DMA:                      %s\n", sim_spi_dma ? "yes" : "no");
+    printf("  frame at init:                     %u bytes, %s\n", (unsigned)sim_spi_frame_len,
+           frame_mask() == 0 ? "all off" : "not all off");
+    if (relay_count() != RELAY_MAX || timers != 1 || frame_mask() != 0) sim_fail("setup");
+}
+
+static void bench_batches(void) {
+    printf("\n64-zone batches\n");
+
+    // Everything on in one batch, with staggered times
+    sim_reset_wakeups();
+    uint32_t tx = sim_spi_transactions;
+    all_timed(60, 1);
+    printf("  SPI transactions, 64 relays on:    %lu (%u bytes)\n",
+           (unsigned long)(sim_spi_transactions - tx), (unsigned)sim_spi_frame_len);
+    if (frame_mask() != ~(relay_mask_t)0 || on_mask() != ~(relay_mask_t)0) sim_fail("frame");
+
+    // Each expiry is its own deadline, one after the other
+    tx = sim_spi_transactions;
+    sim_advance(pdMS_TO_TICKS(60 * 1000 - 1));
+    bool early = on_mask() != ~(relay_mask_t)0;
+    sim_advance(pdMS_TO_TICKS(64 * 1000));
+    printf("  staggered expiries:                %lu timer fires, %lu SPI transactions\n",
+           (unsigned long)sim_timer_fires, (unsigned long)(sim_spi_transactions - tx));
+    if (early || on_mask() != 0 || frame_mask() != 0 || sim_spi_transactions - tx != RELAY_MAX) sim_fail("expiry");
+
+    // Equal times expire on one tick, in one transaction
+    sim_reset_wakeups();
+    all_timed(30, 0);
+    tx = sim_spi_transactions;
+    sim_advance(pdMS_TO_TICKS(31 * 1000));
+    printf("  64 equal expiries:                 %lu timer fire, %lu SPI transaction\n",
+           (unsigned long)sim_timer_fires, (unsigned long)(sim_spi_transactions - tx));
+    if (on_mask() != 0 || sim_timer_fires != 1 || sim_spi_transactions - tx != 1) sim_fail("expiry");
+
+    // Up to 16 commands over HTTP
+    static const char body[] =
+        "[{\"id\":0,\"action\":\"on\"},{\"id\":7,\"action\":\"on\"},{\"id\":8,\"action\":\"on\"},"
+        "{\"id\":15,\"action\":\"on\"},{\"id\":16,\"action\":\"on\"},{\"id\":23,\"action\":\"on\"},"
+        "{\"id\":24,\"action\":\"on\"},{\"id\":31,\"action\":\"on\"},{\"id\":32,\"action\":\"on\"},"
+        "{\"id\":39,\"action\":\"on\"},{\"id\":40,\"action\":\"on\"},{\"id\":47,\"action\":\"on\"},"
+        "{\"id\":48,\"action\":\"on\"},{\"id\":55,\"action\":\"on\"},{\"id\":56,\"action\":\"on\"},"
+        "{\"id\":63,\"action\":\"timed\",\"duration\":300}]";
+    tx = sim_spi_transactions;
+    const sim_response_t *resp = sim_httpd_request(HTTP_POST, "/api/relays", NULL, body, sizeof(body) - 1);
+    printf("  SPI transactions, POST 16 relays:  %lu\n", (unsigned long)(sim_spi_transactions - tx));
+    if (resp->status != 200 || frame_mask() != 0x8181818181818181ull || sim_spi_transactions - tx != 1) {
+        sim_fail("batch");
+    }
+    resp = sim_httpd_request(HTTP_GET, "/api/relay?id=63&action=off", NULL, NULL, 0);
+    if (resp->status != 200 || (on_mask() & RELAY_BIT(63))) sim_fail("relay 63");
+    all_off();
+
+    const int iterations = 20000;
+    sim_heap_reset();
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        if (i & 1) {
+            all_off();
+        } else {
+            all_timed(60, 1);
+        }
+    }
+    report("relay_apply (64 commands)", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    all_off();
+
+    static char buf[STATUS_JSON_MAX];
+    all_timed(1200, 0);
+    json_writer_t w;
+    sim_heap_reset();
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+        status_json_write(&w);
+    }
+    report("status_json_write (64 zones)", now_ns() - t0, iterations, sim_heap.allocs, sim_heap.bytes);
+    printf("  /api/status with 64 zones on:      %u bytes (buffers hold %d)\n", (unsigned)w.len, STATUS_JSON_MAX);
+    if (w.error) sim_fail("overflow");
+    all_off();
+}
+
+static void bench_zone_count(void) {
+    printf("\nZone count\n");
+
+    sim_advance(pdMS_TO_TICKS(2000));
+    uint32_t from = (uint32_t)time(NULL);
+    all_timed(600, 0);
+    uint32_t tx = sim_spi_transactions;
+    uint32_t writes = sim_nvs_writes;
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/api/zones?count=16", NULL, NULL, 0);
+    printf("  64 -> 16 with all on:              %lu SPI transaction, %lu NVS write\n",
+           (unsigned long)(sim_spi_transactions - tx), (unsigned long)(sim_nvs_writes - writes));
+    if (resp->status != 200 || relay_count() != 16 || frame_mask() != 0xffff || on_mask() != 0xffff) {
+        sim_fail("count change");
+    }
+    printf("  GET /api/zones:                    %.*s\n", (int)resp->body_len, resp->body);
+
+    resp = sim_httpd_request(HTTP_GET, "/api/relay?id=20&action=on", NULL, NULL, 0);
+    printf("  relay 20 with 16 zones:            %d\n", resp->status);
+    if (resp->status != 400) sim_fail("status %d", resp->status);
+    resp = sim_httpd_request(HTTP_GET, "/api/zones?count=65", NULL, NULL, 0);
+    printf("  count=65:                          %d\n", resp->status);
+    if (resp->status != 400) sim_fail("status %d", resp->status);
+    resp = sim_httpd_request(HTTP_GET, "/api/zones?count=0", NULL, NULL, 0);
+    printf("  count=0:                           %d\n", resp->status);
+    if (resp->status != 400) sim_fail("status %d", resp->status);
+
+    // All 16 go off with one timer fire; the ones dropped were logged too
+    sim_reset_wakeups();
+    sim_advance(pdMS_TO_TICKS(601 * 1000));
+    sim_idle();
+    static char buf[512];
+    json_writer_t w;
+    dump_records = 0;
+    json_writer_init(&w, buf, sizeof(buf), count_records, NULL);
+    history_write_json(&w, from, UINT32_MAX, -1);
+    json_writer_flush(&w);
+    printf("  waterings logged for 64 zones:     %lu\n", (unsigned long)dump_records);
+    if (dump_records != RELAY_MAX || sim_timer_fires != 1) sim_fail("history");
+
+    resp = sim_httpd_request(HTTP_GET, "/api/zones?count=64", NULL, NULL, 0);
+    if (resp->status != 200 || relay_count() != RELAY_MAX) sim_fail("count change");
+}
+
+// --- Parallel routine steps ------------------------------------------------
+
+#define PAR_STEPS 12
+
+// Minutes, and each zone's flow in L/min as its cost
+static const uint16_t par_minutes[PAR_STEPS] = {10, 5, 15, 10, 5, 20, 10, 5, 15, 10, 5, 10};
+static const uint16_t par_cost[PAR_STEPS] = {12, 8, 8, 6, 15, 10, 6, 8, 12, 4, 6, 10};
+
+// Runs the 12 steps under the limits and samples the relays every second.
+// Prints the time taken against the least the limits allow, and the most
+// zones and flow seen at once.
+static void parallel_case(const char *label, int parallel, int capacity, int wait_step) {
+    char uri[64];
+    snprintf(uri, sizeof(uri), "/api/zones?parallel=%d&capacity=%d", parallel, capacity);
+    if (sim_httpd_request(HTTP_GET, uri, NULL, NULL, 0)->status != 200) sim_fail("limits");
+
+    static routine_step_t steps[PAR_STEPS];
+    uint32_t total = 0, longest = 0, volume = 0;
+    for (int i = 0; i < PAR_STEPS; i++) {
+        steps[i] = (routine_step_t){ .relay_id = i, .duration_sec = par_minutes[i] * 60, .wait = i == wait_step };
+        snprintf(steps[i].name, sizeof(steps[i].name), "Zone %d", i + 1);
+        total += steps[i].duration_sec;
+        volume += steps[i].duration_sec * par_cost[i];
+        if (steps[i].duration_sec > longest) longest = steps[i].duration_sec;
+    }
+    uint32_t bound = total / parallel;
+    if (capacity > 0 && volume / capacity > bound) bound = volume / capacity;
+    if (longest > bound) bound = longest;
+
+    static uint32_t on_sec[PAR_STEPS];
+    memset(on_sec, 0, sizeof(on_sec));
+    int peak = 0, peak_load = 0;
+    bool over = false;
+    uint32_t sec = 0;
+    relay_start_routine("Packed", steps, PAR_STEPS);
+    relay_snapshot_t snap;
+    do {
+        sim_advance(pdMS_TO_TICKS(1000));
+        sec++;
+        relay_snapshot(&snap, NULL);
+        int open = __builtin_popcountll(snap.on_mask);
+        int load = 0;
+        for (int i = 0; i < PAR_STEPS; i++) {
+            if (snap.on_mask & RELAY_BIT(i)) {
+                on_sec[i]++;
+                load += par_cost[i];
+            }
+        }
+        if (open > peak) peak = open;
+        if (load > peak_load) peak_load = load;
+        if (open > parallel || (capacity > 0 && open > 1 && load > capacity)) over = true;
+    } while (snap.routine_running && sec < total + 60);
+
+    printf("  %-34s %lu min (at best %lu), at most %d zones and %d L/min at once\n", label,
+           (unsigned long)sec / 60, (unsigned long)bound / 60, peak, peak_load);
+    bool short_step = false;
+    for (int i = 0; i < PAR_STEPS; i++) {
+        if (on_sec[i] + 1 < steps[i].duration_sec || on_sec[i] > steps[i].duration_sec + 1u) short_step = true;
+    }
+    if (over || short_step || snap.routine_running) sim_fail("run");
+    sim_advance(pdMS_TO_TICKS(5000));
+}
+
+// Prints the "activeSteps" and "doneSteps" lists of /api/status
+static void print_step_lists(const char *label) {
+    static char body[STATUS_JSON_MAX + 1];
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/api/status", NULL, NULL, 0);
+    snprintf(body, sizeof(body), "%.*s", (int)resp->body_len, resp->body);
+    char *from = strstr(body, "\"activeSteps\"");
+    char *to = strstr(body, "\"numSteps\"");
+    printf("  %-34s %.*s\n", label, from && to ? (int)(to - from - 1) : 0, from);
+}
+
+static void bench_parallel(void) {
+    printf("\nParallel routine steps (12 steps, 120 min in all, virtual time)\n");
+
+    for (int i = 0; i < PAR_STEPS; i++) {
+        char uri[48];
+        snprintf(uri, sizeof(uri), "/api/zones?zone=%d&cost=%u", i, par_cost[i]);
+        if (sim_httpd_request(HTTP_GET, uri, NULL, NULL, 0)->status != 200) sim_fail("cost");
+    }
+    const sim_response_t *resp = sim_httpd_request(HTTP_GET, "/api/zones?parallel=0", NULL, NULL, 0);
+    printf("  parallel=0:                        %d\n", resp->status);
+    if (resp->status != 400) sim_fail("status %d", resp->status);
+    resp = sim_httpd_request(HTTP_GET, "/api/zones?parallel=65", NULL, NULL, 0);
+    printf("  parallel=65:                       %d\n", resp->status);
+    if (resp->status != 400) sim_fail("status %d", resp->status);
+    resp = sim_httpd_request(HTTP_GET, "/api/zones?zone=3", NULL, NULL, 0);
+    printf("  zone without cost:                 %d\n", resp->status);
+    if (resp->status != 400) sim_fail("status %d", resp->status);
+
+    routine_limits_t limits = { .parallel = 3 };
+    for (int i = 0; i < PAR_STEPS; i++) limits.cost[i] = par_cost[i];
+    static routine_step_t steps[MAX_ROUTINE_STEPS];
+    for (int i = 0; i < MAX_ROUTINE_STEPS; i++) {
+        steps[i] = (routine_step_t){ .relay_id = i, .duration_sec = 600 };
+    }
+    const int iterations = 200000;
+    volatile step_mask_t sink = 0;
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        sink = relay_routine_startable(steps, MAX_ROUTINE_STEPS, i & 0xff, 0x100, &limits);
+    }
+    report("relay_routine_startable (64 steps)", now_ns() - t0, iterations, 0, 0);
+    (void)sink;
+
+    parallel_case("1 at a time:", 1, 0, -1);
+    parallel_case("2 at a time:", 2, 0, -1);
+    parallel_case("3 at a time:", 3, 0, -1);
+    parallel_case("4 at a time, 24 L/min pump:", 4, 24, -1);
+    parallel_case("same, step 7 waits for 1-6:", 4, 24, 6);
+
+    // Every running step is listed
+    sim_httpd_request(HTTP_GET, "/api/zones?parallel=3&capacity=0", NULL, NULL, 0);
+    relay_start_routine("Packed", steps, 5);
+    sim_advance(pdMS_TO_TICKS(1000));
+    print_step_lists("/api/status, 3 at a time:");
+    relay_skip_routine_step();
+    sim_advance(pdMS_TO_TICKS(1000));
+    print_step_lists("after a skip:");
+    relay_stop_routine();
+    sim_httpd_request(HTTP_GET, "/api/zones?parallel=1&capacity=0", NULL, NULL, 0);
+    sim_advance(pdMS_TO_TICKS(1000));
+}
+
+// --- A step for every zone ------------------------------------------------
+
+// Appends a routine of one-minute steps on zones 1 to n, each under its own
+// full-length name
+static size_t long_routine(char *doc, size_t size, size_t len, const char *name, int n) {
+    len += snprintf(doc + len, size - len, "{\"name\":\"%s\",\"steps\":[", name);
+    for (int i = 0; i < n; i++) {
+        len += snprintf(doc + len, size - len, "%s{\"id\":%d,\"name\":\"Zone %02d of the long routine....\",\"duration\":1}",
+                        i ? "," : "", i % RELAY_MAX, i + 1);
+    }
+    return len + snprintf(doc + len, size - len, "]}");
+}
+
+static void bench_long_routine(void) {
+    printf("\nA routine with a step for every zone (4 at a time, virtual time)\n");
+
+    static char doc[16 * 1024];
+    size_t len = long_routine(doc, sizeof(doc), snprintf(doc, sizeof(doc), "["), "Every zone", RELAY_MAX);
+    len += snprintf(doc + len, sizeof(doc) - len, "]");
+    const sim_response_t *resp = sim_httpd_request(HTTP_POST, "/api/routines", NULL, doc, len);
+    printf("  upload, 64 steps:                  %d\n", resp->status);
+    if (resp->status != 200) sim_fail("upload: %d %.*s", resp->status, (int)resp->body_len, resp->body);
+
+    len = long_routine(doc, sizeof(doc), snprintf(doc, sizeof(doc), "["), "Too long", RELAY_MAX + 1);
+    len += snprintf(doc + len, sizeof(doc) - len, "]");
+    resp = sim_httpd_request(HTTP_POST, "/api/routines", NULL, doc, len);
+    printf("  upload, 65 steps:                  %d \"%.*s\"\n", resp->status, (int)resp->body_len, resp->body);
+    if (resp->status != 400) sim_fail("65 steps accepted");
+
+    // The status document has room for the whole routine with every zone on
+    sim_httpd_request(HTTP_GET, "/api/zones?parallel=4&capacity=0", NULL, NULL, 0);
+    sim_httpd_request(HTTP_GET, "/api/routine/control?action=start&index=0", NULL, NULL, 0);
+    sim_advance(pdMS_TO_TICKS(5 * 60 * 1000 + 500));
+    all_timed(600, 0);
+    static char buf[STATUS_JSON_MAX];
+    json_writer_t w;
+    json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    status_json_write(&w);
+    printf("  /api/status, every zone on:        %u of %u bytes\n", (unsigned)w.len, (unsigned)sizeof(buf));
+    if (w.error) sim_fail("status overflow");
+    all_off();
+
+    relay_snapshot_t snap;
+    uint32_t sec = 0;
+    do {
+        sim_advance(pdMS_TO_TICKS(1000));
+        sec++;
+        relay_snapshot(&snap, NULL);
+    } while (snap.routine_running && sec < 30 * 60);
+    printf("  run:                               %lu min, %d of %d steps done\n", (unsigned long)(5 + sec / 60),
+           __builtin_popcountll(snap.done_steps), RELAY_MAX);
+    if (snap.routine_running || snap.done_steps != ~(step_mask_t)0) sim_fail("run");
+    sim_httpd_request(HTTP_GET, "/api/zones?parallel=1", NULL, NULL, 0);
+    remove("/spiffs/routines.json");
+}
+
+// --- Safety cutoff ----------------------------------------------------------
+
+static uint32_t oe_changes;
+static TickType_t oe_high_at;
+
+static void on_gpio(int gpio, uint32_t level) {
+    if (gpio != RELAY_SPI_OE_PIN) return;
+    oe_changes++;
+    if (level) oe_high_at = sim_now();
+}
+
+// With the timer service stuck, the cutoff pulls OE high, which darkens
+// every output; the safety task then shifts out a frame without the relay
+// and brings the others back
+static void bench_cutoff(void) {
+    printf("\nSafety cutoff (timer service stuck, cutoff %d ms past a deadline)\n", RELAY_SAFETY_GRACE_MS);
+    sim_set_gpio_hook(on_gpio);
+    relay_command_t cmds[] = {
+        {.relay_num = 0, .action = RELAY_CMD_TIMED, .seconds = 1},
+        {.relay_num = 40, .action = RELAY_CMD_ON},
+    };
+    relay_apply(cmds, 2);
+    sim_idle();
+    TickType_t on_at = sim_now();
+    uint32_t tx = sim_spi_transactions;
+    oe_changes = 0;
+    sim_timer_service_stalled = true;
+    sim_advance(pdMS_TO_TICKS(1000 + RELAY_SAFETY_GRACE_MS + 50));
+    printf("  relay 1 on for 1 s:                OE high %u ms past its deadline\n",
+           (unsigned)(oe_high_at - on_at - pdMS_TO_TICKS(1000)));
+    printf("  after the safety task:             OE %s (%lu changes), %lu SPI transaction, relay 1 %s, relay 41 %s\n",
+           sim_gpio_level[RELAY_SPI_OE_PIN] ? "high" : "low", (unsigned long)oe_changes,
+           (unsigned long)(sim_spi_transactions - tx), frame_mask() & RELAY_BIT(0) ? "on" : "off",
+           frame_mask() & RELAY_BIT(40) ? "on" : "off");
+    if (sim_gpio_level[RELAY_SPI_OE_PIN] || oe_changes != 2 || on_mask() != RELAY_BIT(40) ||
+        frame_mask() != RELAY_BIT(40)) {
+        sim_fail("cutoff");
+    }
+    sim_timer_service_stalled = false;
+    relay_off(40);
+    sim_idle();
+    sim_set_gpio_hook(NULL);
+}
+
+int main(void) {
+    char spiffs_dir[] = "/tmp/autowater_zones_XXXXXX";
+    sim_spiffs_root = mkdtemp(spiffs_dir);
+
+    sim_init();
+    history_init();
+    printf("Autowater 64-zone benchmark\n");
+    bench_init();
+    web_server_start();
+    bench_batches();
+    bench_zone_count();
+    bench_parallel();
+    bench_long_routine();
+    bench_cutoff();
+
+    rmdir(spiffs_dir);
+    return sim_checks_result();
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#ifndef DRAM_ATTR
+#define DRAM_ATTR
+#endif
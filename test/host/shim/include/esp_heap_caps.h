@@ -0,0 +1,10 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_8BIT (1 << 2)
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+
+size_t heap_caps_get_largest_free_block(uint32_t caps);
@@ -0,0 +1,21 @@
+#pragma once
+#include <stdio.h>
+
+// Logging is off unless the harness sets sim_log_enabled, so it does not
+// dominate the timings
+extern int sim_log_enabled;
+// Called with the tag and format of every log line, printed or not, to
+// run a bench at a given point in the firmware (see sim_set_log_hook())
+extern void (*sim_log_hook)(const char *tag, const char *fmt);
+
+#define SIM_LOG(level, tag, fmt, ...) \
+    do { \
+        if (sim_log_hook) sim_log_hook(tag, fmt); \
+        if (sim_log_enabled) printf(level " (%s) " fmt "\n", tag, ##__VA_ARGS__); \
+    } while (0)
+
+#define ESP_LOGE(tag, fmt, ...) SIM_LOG("E", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) SIM_LOG("W", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) SIM_LOG("I", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) SIM_LOG("D", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...) SIM_LOG("V", tag, fmt, ##__VA_ARGS__)
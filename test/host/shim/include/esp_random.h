@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+
+// Deterministic on the host so bench runs repeat
+uint32_t esp_random(void);
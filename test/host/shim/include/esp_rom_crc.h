@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+
+// The ROM's CRC-32 (IEEE, as used by gzip and zlib)
+uint32_t esp_rom_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len);
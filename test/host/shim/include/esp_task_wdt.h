@@ -0,0 +1,5 @@
+#pragma once
+
+// Called from the task watchdog's interrupt when it times out; the
+// firmware may define it. The host has no watchdog: a bench calls it.
+void __attribute__((weak)) esp_task_wdt_isr_user_handler(void);
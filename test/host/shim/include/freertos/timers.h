@@ -0,0 +1,19 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef struct sim_timer *TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, UBaseType_t auto_reload,
+                           void *id, TimerCallbackFunction_t callback);
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t block);
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t block);
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t block);
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t block);
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t block);
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer);
+TickType_t xTimerGetExpiryTime(TimerHandle_t timer);
+TickType_t xTimerGetPeriod(TimerHandle_t timer);
+void *pvTimerGetTimerID(TimerHandle_t timer);
+TaskHandle_t xTimerGetTimerDaemonTaskHandle(void);
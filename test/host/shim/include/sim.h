@@ -0,0 +1,217 @@
+#pragma once
+// Host simulator controls used by the benchmark harness
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_http_server.h"
+#include "esp_partition.h"
+
+// --- Scheduler (sim_rtos.c) ---------------------------------------------
+// The calling thread becomes the "main" context (httpd / timer service).
+// Simulated tasks only run while main is parked in sim_idle()/sim_advance().
+void sim_init(void);
+// Lets every runnable task run until all are blocked
+void sim_idle(void);
+// Advances virtual time, firing timers and waking tasks in order
+void sim_advance(TickType_t ticks);
+TickType_t sim_now(void);
+// Wakeups (returns from a blocking call) summed over tasks with this name,
+// or over all tasks for NULL
+uint32_t sim_task_wakeups(const char *name);
+// Software and esp_timer callbacks run; cleared with the wakeups
+extern uint32_t sim_timer_fires;
+// xTimerCreate() calls since start
+extern uint32_t sim_timers_created;
+void sim_reset_wakeups(void);
+// Called whenever the simulation goes idle, e.g. to run httpd work items
+void sim_set_idle_hook(void (*hook)(void));
+// Blocks the calling task for `ticks` with the CPU held: no other task
+// wakes and only ISR-dispatched esp_timers (interrupts) fire until then.
+// Tasks notified meanwhile run once it ends.
+void sim_hold_cpu(TickType_t ticks);
+// Software timer callbacks wait while set, as if the timer service task
+// were starved or stuck; they run once it is cleared
+extern bool sim_timer_service_stalled;
+// Software timer commands (start, stop, change period) fail with pdFAIL
+// and change nothing while set, as with the timer queue full
+extern bool sim_timer_queue_full;
+
+// --- Checks (sim_esp.c) --------------------------------------------------
+// A bench check that did not hold: prints "    unexpected <what>" under the
+// current line and counts it. A bench's main returns sim_checks_result(),
+// so ctest fails the run.
+void sim_fail(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+extern uint32_t sim_checks_failed;
+// Prints the count if any check failed; 1 then, else 0
+int sim_checks_result(void);
+
+// --- Logging (sim_esp.c) -------------------------------------------------
+// hook sees the tag and format string of each ESP_LOGx call as it is
+// made, on the task making it, so a bench can act at that point
+void sim_set_log_hook(void (*hook)(const char *tag, const char *fmt));
+
+// --- GPIO (sim_esp.c) ---------------------------------------------------
+#define SIM_GPIO_COUNT 64
+extern int sim_gpio_level[SIM_GPIO_COUNT];
+// gpio_set_level() calls plus GPIO_OUT_W1TS/W1TC register writes
+extern uint32_t sim_gpio_writes;
+// Called for every pin a gpio_set_level() or register write sets, e.g. to
+// timestamp relay switching
+void sim_set_gpio_hook(void (*hook)(int gpio, uint32_t level));
+
+// --- Heap accounting (sim_esp.c, via -Wl,--wrap) ------------------------
+typedef struct {
+    uint32_t allocs;
+    uint32_t frees;
+    uint64_t bytes;     // Requested since the last reset
+    int64_t live;       // Currently allocated (usable size)
+    int64_t peak;       // Highest live since the last reset
+} sim_heap_stats_t;
+extern sim_heap_stats_t sim_heap;
+// Clears the counters; peak restarts from the current live size
+void sim_heap_reset(void);
+
+// --- Files (sim_esp.c, via -Wl,--wrap) ----------------------------------
+// When set, fopen/stat/rename/remove of "/spiffs/..." use this directory.
+// rename() refuses to replace an existing file, like SPIFFS.
+extern const char *sim_spiffs_root;
+
+// --- Flash and OTA (sim_esp.c) -------------------------------------------
+// ota_1, storage and history live in RAM; other partitions are not found
+extern uint32_t sim_flash_erases;       // 4 KB sectors erased
+extern uint64_t sim_flash_read_bytes;
+extern uint64_t sim_flash_write_bytes;
+// Where esp_ota_set_boot_partition() pointed, or NULL
+extern const esp_partition_t *sim_boot_partition;
+// esp_restart() calls; they return instead of rebooting
+extern uint32_t sim_restarts;
+
+// Time charged for flash operations and for receiving request bodies. A
+// task making the call blocks for that long in virtual time, so other
+// tasks run meanwhile; calls from the main context are free. All zero
+// (free) unless a bench sets them. See httpd_req_recv() in sim_httpd.c
+// for how a body arrives; a response is sent at send_kb_us, with the
+// sending task blocked for it.
+//
+// With flash_stalls_cpu, flash operations hold the CPU instead
+// (sim_hold_cpu()), as the cache is off while the chip is busy: one erase
+// command, page program or read at a time, with other tasks running
+// between them.
+typedef struct {
+    uint32_t erase_sector_us;   // 4 KB sector erase
+    uint32_t erase_block_us;    // 64 KB block erase, used where aligned
+    uint32_t write_kb_us;
+    uint32_t read_kb_us;
+    uint32_t recv_kb_us;        // How fast a request body arrives
+    uint32_t recv_window;       // Body bytes the client may send ahead of
+                                // httpd_req_recv(); 0 for no limit
+    uint32_t send_kb_us;        // How fast a response goes out to the client
+    bool flash_stalls_cpu;
+} sim_costs_t;
+extern sim_costs_t sim_costs;
+void sim_charge_us(uint64_t us);
+
+// --- NVS, clock and SNTP (sim_esp.c) -------------------------------------
+// NVS is kept in RAM; this counts set calls, i.e. flash writes on a device
+extern uint32_t sim_nvs_writes;
+// Copy of the NVS contents to go back to, e.g. to replay a reset at the
+// moment of the save
+void sim_nvs_save(void);
+void sim_nvs_restore(void);
+// What esp_reset_reason() reports; an esp_reset_reason_t
+extern int sim_reset_reason;
+// time() (wrapped) follows virtual time from this epoch onwards
+void sim_set_time(int64_t epoch);
+// Sets the clock and runs the SNTP sync callback, like a completed sync
+void sim_sntp_sync(int64_t epoch);
+
+// --- HTTP server (sim_httpd.c) ------------------------------------------
+#define SIM_RESP_MAX 16384
+
+typedef struct {
+    int status;
+    char content_type[48];
+    char headers[512];      // "Name: value\n" lines
+    char body[SIM_RESP_MAX];
+    size_t body_len;
+    size_t body_sent;       // Can exceed body_len, which stops at SIM_RESP_MAX
+    bool chunked;
+    bool finished;
+    TickType_t finished_at;
+    int sockfd;
+    uint32_t client_stall_ms;   // Time the client waited on a full window
+    uint32_t client_max_stall_ms;
+} sim_response_t;
+
+// Runs one request through the registered handlers. headers is a block
+// of "Name: value\n" lines or NULL. The caller acts as the httpd task and
+// then as the client: a request another one holds the server for waits,
+// and an async request is waited for. The response stays valid for the
+// next three requests.
+const sim_response_t *sim_httpd_request(httpd_method_t method, const char *uri,
+                                        const char *headers, const char *body, size_t body_len);
+// Bytes pushed with httpd_socket_send() to a kept-open session
+size_t sim_httpd_socket_bytes(int sockfd);
+// Closes a kept-open session, calling its free_ctx
+void sim_httpd_close(int sockfd);
+void sim_httpd_run_work(void);
+// False makes httpd_req_async_handler_begin() fail, as if out of memory,
+// so every handler runs on the server task
+extern bool sim_httpd_async;
+
+// --- SPI and I2C (sim_bus.c) ---------------------------------------------
+// A 74HC595 chain on SPI and expanders on I2C, recording what was sent
+#define SIM_SPI_FRAME_MAX 16
+extern uint32_t sim_spi_transactions;
+extern uint64_t sim_spi_bytes;
+extern bool sim_spi_dma;                // The bus was set up with DMA
+extern uint8_t sim_spi_frame[SIM_SPI_FRAME_MAX];   // The last transaction
+extern size_t sim_spi_frame_len;
+extern uint32_t sim_i2c_transactions;
+// Expanders that answer, by 7-bit address (all of them by default)
+extern bool sim_i2c_absent[128];
+// The last write to each address
+extern uint8_t sim_i2c_last[128][4];
+
+// --- Pulse counter (sim_pcnt.c) ------------------------------------------
+// A flow meter sending pulses at a steady rate, set in mHz (pulses per
+// 1000 s) and changed whenever the bench likes
+void sim_pcnt_set_rate(uint32_t millihertz);
+uint64_t sim_pcnt_pulses(void);         // Pulses sent so far
+extern uint32_t sim_pcnt_reads;         // pcnt_unit_get_count() calls
+extern bool sim_pcnt_running;           // The unit counts
+
+// --- ADC (sim_adc.c) ----------------------------------------------------
+// Continuous mode: the source gives every conversion's raw value for an
+// ADC1 channel
+void sim_adc_set_source(uint16_t (*source)(int channel));
+extern uint32_t sim_adc_frames;         // DMA frames done, one interrupt each
+extern uint64_t sim_adc_conversions;
+extern bool sim_adc_running;            // Converting, which blocks light sleep
+extern uint64_t sim_adc_running_ms;     // Time converting, over completed runs
+
+// --- General purpose timer (sim_gptimer.c) -------------------------------
+// One timer; its alarm is an interrupt, so a CPU hold does not delay it
+extern uint32_t sim_gptimer_alarms;     // Alarms that went off
+extern bool sim_gptimer_running;        // Started, which blocks light sleep
+
+// --- MQTT (sim_mqtt.c) ---------------------------------------------------
+// The broker: the client only connects when told to, and messages are
+// delivered to it by the caller, which stands in for the client's task
+#define SIM_MQTT_PAYLOAD_MAX 2048
+// Messages published and their payload bytes
+extern uint32_t sim_mqtt_publishes;
+extern uint64_t sim_mqtt_bytes;
+// Connects a started client (runs MQTT_EVENT_CONNECTED); false if there
+// is none or it is already connected
+bool sim_mqtt_connect(void);
+// Drops the connection uncleanly: the will is published
+void sim_mqtt_drop(void);
+// Sends a message to the client if it subscribed to a matching filter
+bool sim_mqtt_deliver(const char *topic, const char *payload, bool retain);
+// The retained message on a topic, or NULL
+const char *sim_mqtt_retained(const char *topic, size_t *len);
+// The broker the client was started with, or NULL if it is stopped
+const char *sim_mqtt_uri(void);
@@ -0,0 +1,11 @@
+#pragma once
+// Force-included into every host translation unit: fills in the newlib
+// extensions ESP-IDF code may use but older glibc lacks
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GLIBC__) && !(__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38))
+#define SIM_NEED_STRLCPY 1
+size_t strlcpy(char *dst, const char *src, size_t size);
+size_t strlcat(char *dst, const char *src, size_t size);
+#endif
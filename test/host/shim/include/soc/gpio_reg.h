@@ -0,0 +1,5 @@
+#pragma once
+
+// Addresses are only tags here; sim_reg_write() decodes them
+#define GPIO_OUT_W1TS_REG 0x60091008
+#define GPIO_OUT_W1TC_REG 0x6009100C
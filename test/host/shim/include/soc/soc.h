@@ -0,0 +1,7 @@
+#pragma once
+#include <stdint.h>
+
+// Register writes land in the simulated GPIO block (sim_esp.c)
+void sim_reg_write(uint32_t reg, uint32_t val);
+
+#define REG_WRITE(reg, val) sim_reg_write((reg), (val))
@@ -0,0 +1,149 @@
+// ADC continuous-mode driver: a DMA engine that converts the configured
+// pattern at the sample rate, hands each full frame to on_conv_done (in
+// "ISR" context, from the main context here) and queues it in the pool
+// that adc_continuous_read() empties. Values come from the bench's source.
+
+#include "esp_adc/adc_continuous.h"
+#include "esp_timer.h"
+#include "sim.h"
+
+#include <stdlib.h>
+
+uint32_t sim_adc_frames = 0;
+uint64_t sim_adc_conversions = 0;
+bool sim_adc_running = false;
+uint64_t sim_adc_running_ms = 0;
+
+struct sim_adc {
+    uint32_t pool_size;
+    uint32_t frame_size;
+    adc_digi_pattern_config_t pattern[8];
+    uint32_t pattern_num;
+    uint32_t sample_freq_hz;
+    bool configured;
+    adc_continuous_evt_cbs_t cbs;
+    void *user_data;
+    esp_timer_handle_t timer;
+    uint8_t *frame;
+    uint8_t *pool;
+    uint32_t pool_len;
+    uint32_t next;          // Pattern entry the next conversion uses
+    TickType_t started_at;
+};
+
+static struct sim_adc adc;
+static bool adc_taken = false;
+static uint16_t (*source)(int channel) = NULL;
+
+void sim_adc_set_source(uint16_t (*fn)(int channel)) {
+    source = fn;
+}
+
+static void frame_done(void *arg) {
+    uint32_t results = adc.frame_size / SOC_ADC_DIGI_RESULT_BYTES;
+    for (uint32_t i = 0; i < results; i++) {
+        const adc_digi_pattern_config_t *p = &adc.pattern[adc.next];
+        adc.next = (adc.next + 1) % adc.pattern_num;
+        adc_digi_output_data_t d = { .val = 0 };
+        d.type2.data = source ? source(p->channel) & 0xfff : 0;
+        d.type2.channel = p->channel;
+        d.type2.unit = p->unit;
+        memcpy(&adc.frame[i * SOC_ADC_DIGI_RESULT_BYTES], &d, sizeof(d));
+    }
+    sim_adc_conversions += results;
+    sim_adc_frames++;
+
+    adc_continuous_evt_data_t edata = { .conv_frame_buffer = adc.frame, .size = adc.frame_size };
+    if (adc.pool_len + adc.frame_size <= adc.pool_size) {
+        memcpy(adc.pool + adc.pool_len, adc.frame, adc.frame_size);
+        adc.pool_len += adc.frame_size;
+    } else if (adc.cbs.on_pool_ovf) {
+        adc.cbs.on_pool_ovf(&adc, &edata, adc.user_data);
+    }
+    if (adc.cbs.on_conv_done) adc.cbs.on_conv_done(&adc, &edata, adc.user_data);
+}
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle) {
+    if (adc_taken) return ESP_ERR_NOT_FOUND;
+    if (hdl_config->conv_frame_size == 0 || hdl_config->conv_frame_size % SOC_ADC_DIGI_RESULT_BYTES ||
+        hdl_config->max_store_buf_size < hdl_config->conv_frame_size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    adc_taken = true;
+    adc = (struct sim_adc){
+        .pool_size = hdl_config->max_store_buf_size,
+        .frame_size = hdl_config->conv_frame_size,
+        .frame = malloc(hdl_config->conv_frame_size),
+        .pool = malloc(hdl_config->max_store_buf_size),
+    };
+    esp_timer_create_args_t args = { .callback = frame_done, .name = "adc_dma" };
+    esp_timer_create(&args, &adc.timer);
+    *ret_handle = &adc;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config) {
+    if (sim_adc_running) return ESP_ERR_INVALID_STATE;
+    if (config->pattern_num == 0 || config->pattern_num > 8 || config->format != ADC_DIGI_OUTPUT_FORMAT_TYPE2 ||
+        config->sample_freq_hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW ||
+        config->sample_freq_hz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (uint32_t i = 0; i < config->pattern_num; i++) {
+        if (config->adc_pattern[i].unit != ADC_UNIT_1 || config->adc_pattern[i].channel > 6) return ESP_ERR_INVALID_ARG;
+        handle->pattern[i] = config->adc_pattern[i];
+    }
+    handle->pattern_num = config->pattern_num;
+    handle->sample_freq_hz = config->sample_freq_hz;
+    handle->configured = true;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs,
+                                                  void *user_data) {
+    if (sim_adc_running) return ESP_ERR_INVALID_STATE;
+    handle->cbs = *cbs;
+    handle->user_data = user_data;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle) {
+    if (!handle->configured || sim_adc_running) return ESP_ERR_INVALID_STATE;
+    uint64_t frame_us = (uint64_t)handle->frame_size / SOC_ADC_DIGI_RESULT_BYTES * 1000000 / handle->sample_freq_hz;
+    handle->next = 0;
+    handle->started_at = sim_now();
+    sim_adc_running = true;
+    esp_timer_start_periodic(handle->timer, frame_us);
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle) {
+    if (!sim_adc_running) return ESP_ERR_INVALID_STATE;
+    esp_timer_stop(handle->timer);
+    sim_adc_running = false;
+    sim_adc_running_ms += (sim_now() - handle->started_at) * portTICK_PERIOD_MS;
+    return ESP_OK;
+}
+
+// Frames stay in the pool across a stop, as on the device
+esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint32_t length_max,
+                              uint32_t *out_length, uint32_t timeout_ms) {
+    *out_length = 0;
+    if (handle->pool_len == 0) return ESP_ERR_TIMEOUT;
+    uint32_t n = length_max < handle->pool_len ? length_max : handle->pool_len;
+    n -= n % SOC_ADC_DIGI_RESULT_BYTES;
+    memcpy(buf, handle->pool, n);
+    memmove(handle->pool, handle->pool + n, handle->pool_len - n);
+    handle->pool_len -= n;
+    *out_length = n;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle) {
+    if (sim_adc_running) return ESP_ERR_INVALID_STATE;
+    esp_timer_delete(handle->timer);
+    free(handle->frame);
+    free(handle->pool);
+    adc_taken = false;
+    return ESP_OK;
+}
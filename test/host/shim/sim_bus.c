@@ -0,0 +1,74 @@
+// SPI master and I2C master drivers for the relay output backends. A
+// transmit completes at once and only leaves a record of what was sent.
+
+#include "driver/spi_master.h"
+#include "driver/i2c_master.h"
+#include "sim.h"
+
+#include <string.h>
+
+uint32_t sim_spi_transactions = 0;
+uint64_t sim_spi_bytes = 0;
+bool sim_spi_dma = false;
+uint8_t sim_spi_frame[SIM_SPI_FRAME_MAX];
+size_t sim_spi_frame_len = 0;
+uint32_t sim_i2c_transactions = 0;
+bool sim_i2c_absent[128];
+uint8_t sim_i2c_last[128][4];
+
+struct sim_spi_device {
+    int cs;
+};
+
+struct sim_i2c_device {
+    uint16_t address;
+};
+
+static struct sim_spi_device spi_devices[4];
+static int num_spi_devices = 0;
+static struct sim_i2c_device i2c_devices[8];
+static int num_i2c_devices = 0;
+static int i2c_bus;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus, spi_dma_chan_t dma) {
+    sim_spi_dma = dma != SPI_DMA_DISABLED;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev,
+                             spi_device_handle_t *handle) {
+    if (num_spi_devices >= 4) return ESP_ERR_NO_MEM;
+    spi_devices[num_spi_devices].cs = dev->spics_io_num;
+    *handle = &spi_devices[num_spi_devices++];
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans) {
+    size_t len = (trans->length + 7) / 8;
+    if (len > SIM_SPI_FRAME_MAX) return ESP_ERR_INVALID_ARG;
+    memcpy(sim_spi_frame, trans->tx_buffer, len);
+    sim_spi_frame_len = len;
+    sim_spi_transactions++;
+    sim_spi_bytes += len;
+    return ESP_OK;
+}
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *config, i2c_master_bus_handle_t *bus) {
+    *bus = (i2c_master_bus_handle_t)&i2c_bus;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus, const i2c_device_config_t *config,
+                                    i2c_master_dev_handle_t *dev) {
+    if (num_i2c_devices >= 8 || config->device_address >= 128) return ESP_ERR_INVALID_ARG;
+    i2c_devices[num_i2c_devices].address = config->device_address;
+    *dev = &i2c_devices[num_i2c_devices++];
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t dev, const uint8_t *buf, size_t size, int timeout_ms) {
+    if (sim_i2c_absent[dev->address]) return ESP_FAIL;     // No ACK
+    memcpy(sim_i2c_last[dev->address], buf, size < 4 ? size : 4);
+    sim_i2c_transactions++;
+    return ESP_OK;
+}
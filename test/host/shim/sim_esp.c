@@ -0,0 +1,612 @@
+// Host stand-ins for the ESP-IDF drivers the firmware touches: GPIO levels
+// are recorded, flash partitions and NVS live in RAM, /spiffs
+// paths are redirected to a host directory, time() follows virtual time,
+// and malloc/free are counted through the linker's --wrap so the harness
+// can report heap allocations per request.
+
+#include "sim.h"
+#include "esp_err.h"
+#include "esp_system.h"
+#include "esp_spiffs.h"
+#include "esp_partition.h"
+#include "esp_ota_ops.h"
+#include "esp_netif_sntp.h"
+#include "esp_heap_caps.h"
+#include "esp_wifi.h"
+#include "nvs.h"
+#include "driver/gpio.h"
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+
+#include <malloc.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+int sim_log_enabled = 0;
+void (*sim_log_hook)(const char *tag, const char *fmt) = NULL;
+
+void sim_set_log_hook(void (*hook)(const char *tag, const char *fmt)) {
+    sim_log_hook = hook;
+}
+
+uint32_t sim_checks_failed = 0;
+
+void sim_fail(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    printf("    unexpected ");
+    vprintf(fmt, args);
+    printf("\n");
+    va_end(args);
+    sim_checks_failed++;
+}
+
+int sim_checks_result(void) {
+    if (sim_checks_failed == 0) return 0;
+    printf("\n%lu check%s failed\n", (unsigned long)sim_checks_failed, sim_checks_failed == 1 ? "" : "s");
+    return 1;
+}
+
+int sim_gpio_level[SIM_GPIO_COUNT];
+uint32_t sim_gpio_writes = 0;
+static void (*gpio_hook)(int gpio, uint32_t level) = NULL;
+
+void sim_set_gpio_hook(void (*hook)(int gpio, uint32_t level)) {
+    gpio_hook = hook;
+}
+
+esp_err_t gpio_config(const gpio_config_t *config) {
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio, uint32_t level) {
+    if (gpio < 0 || gpio >= SIM_GPIO_COUNT) return ESP_ERR_INVALID_ARG;
+    sim_gpio_level[gpio] = level ? 1 : 0;
+    sim_gpio_writes++;
+    if (gpio_hook) gpio_hook(gpio, level);
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio) {
+    if (gpio < 0 || gpio >= SIM_GPIO_COUNT) return 0;
+    return sim_gpio_level[gpio];
+}
+
+esp_err_t gpio_sleep_sel_dis(gpio_num_t gpio) {
+    return ESP_OK;
+}
+
+esp_err_t gpio_pullup_en(gpio_num_t gpio) {
+    return ESP_OK;
+}
+
+// A W1TS/W1TC write switches every pin in the mask at once, so it counts
+// as one write however many pins change
+void sim_reg_write(uint32_t reg, uint32_t val) {
+    int level;
+    if (reg == GPIO_OUT_W1TS_REG) level = 1;
+    else if (reg == GPIO_OUT_W1TC_REG) level = 0;
+    else return;
+    sim_gpio_writes++;
+    for (int gpio = 0; gpio < 32; gpio++) {
+        if (!(val & (1u << gpio))) continue;
+        sim_gpio_level[gpio] = level;
+        if (gpio_hook) gpio_hook(gpio, level);
+    }
+}
+
+// --- Heap accounting -------------------------------------------------------
+
+sim_heap_stats_t sim_heap;
+
+void sim_heap_reset(void) {
+    sim_heap.allocs = 0;
+    sim_heap.frees = 0;
+    sim_heap.bytes = 0;
+    sim_heap.peak = sim_heap.live;
+}
+
+static void track_alloc(void *ptr) {
+    if (ptr == NULL) return;
+    sim_heap.live += malloc_usable_size(ptr);
+    if (sim_heap.live > sim_heap.peak) sim_heap.peak = sim_heap.live;
+}
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size) {
+    sim_heap.allocs++;
+    sim_heap.bytes += size;
+    void *ptr = __real_malloc(size);
+    track_alloc(ptr);
+    return ptr;
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+    sim_heap.allocs++;
+    sim_heap.bytes += n * size;
+    void *ptr = __real_calloc(n, size);
+    track_alloc(ptr);
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    sim_heap.allocs++;
+    sim_heap.bytes += size;
+    if (ptr) sim_heap.live -= malloc_usable_size(ptr);
+    ptr = __real_realloc(ptr, size);
+    track_alloc(ptr);
+    return ptr;
+}
+
+void __wrap_free(void *ptr) {
+    if (ptr) {
+        sim_heap.frees++;
+        sim_heap.live -= malloc_usable_size(ptr);
+    }
+    __real_free(ptr);
+}
+
+// --- /spiffs on the host (via -Wl,--wrap) ---------------------------------
+
+const char *sim_spiffs_root = NULL;
+
+static const char *map_path(const char *path, char *buf, size_t len) {
+    if (sim_spiffs_root == NULL || strncmp(path, "/spiffs/", 8) != 0) return path;
+    snprintf(buf, len, "%s/%s", sim_spiffs_root, path + 8);
+    return buf;
+}
+
+FILE *__real_fopen(const char *path, const char *mode);
+int __real_stat(const char *path, struct stat *st);
+int __real_rename(const char *from, const char *to);
+int __real_remove(const char *path);
+
+FILE *__wrap_fopen(const char *path, const char *mode) {
+    char buf[256];
+    return __real_fopen(map_path(path, buf, sizeof(buf)), mode);
+}
+
+int __wrap_stat(const char *path, struct stat *st) {
+    char buf[256];
+    return __real_stat(map_path(path, buf, sizeof(buf)), st);
+}
+
+int __wrap_rename(const char *from, const char *to) {
+    char from_buf[256], to_buf[256];
+    from = map_path(from, from_buf, sizeof(from_buf));
+    to = map_path(to, to_buf, sizeof(to_buf));
+    // Like SPIFFS, refuse to replace an existing file
+    struct stat st;
+    if (__real_stat(to, &st) == 0) return -1;
+    return __real_rename(from, to);
+}
+
+int __wrap_remove(const char *path) {
+    char buf[256];
+    return __real_remove(map_path(path, buf, sizeof(buf)));
+}
+
+// --- NVS in RAM -------------------------------------------------------------
+
+#define SIM_NVS_ENTRIES 32
+#define SIM_NVS_VALUE_MAX 1024
+
+typedef struct {
+    char ns[16];
+    char key[16];
+    uint8_t value[SIM_NVS_VALUE_MAX];
+    size_t len;
+} sim_nvs_entry_t;
+
+static sim_nvs_entry_t nvs_entries[SIM_NVS_ENTRIES];
+static char nvs_namespaces[8][16];
+static int nvs_num_namespaces = 0;
+uint32_t sim_nvs_writes = 0;
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *out_handle) {
+    for (int i = 0; i < nvs_num_namespaces; i++) {
+        if (strcmp(nvs_namespaces[i], name) == 0) {
+            *out_handle = i + 1;
+            return ESP_OK;
+        }
+    }
+    // Like NVS, a namespace only exists once it was opened for writing
+    if (mode == NVS_READONLY) return ESP_ERR_NVS_NOT_FOUND;
+    if (nvs_num_namespaces >= 8) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    strlcpy(nvs_namespaces[nvs_num_namespaces], name, sizeof(nvs_namespaces[0]));
+    *out_handle = ++nvs_num_namespaces;
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    return ESP_OK;
+}
+
+static sim_nvs_entry_t *nvs_find(nvs_handle_t handle, const char *key, bool create) {
+    const char *ns = nvs_namespaces[handle - 1];
+    sim_nvs_entry_t *free_entry = NULL;
+    for (int i = 0; i < SIM_NVS_ENTRIES; i++) {
+        sim_nvs_entry_t *e = &nvs_entries[i];
+        if (e->ns[0] == '\0') {
+            if (free_entry == NULL) free_entry = e;
+        } else if (strcmp(e->ns, ns) == 0 && strcmp(e->key, key) == 0) {
+            return e;
+        }
+    }
+    if (!create || free_entry == NULL) return NULL;
+    strlcpy(free_entry->ns, ns, sizeof(free_entry->ns));
+    strlcpy(free_entry->key, key, sizeof(free_entry->key));
+    return free_entry;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length) {
+    sim_nvs_entry_t *e = nvs_find(handle, key, false);
+    if (e == NULL) return ESP_ERR_NVS_NOT_FOUND;
+    if (out_value == NULL) {
+        *length = e->len;
+        return ESP_OK;
+    }
+    if (*length < e->len) return ESP_ERR_NVS_INVALID_LENGTH;
+    memcpy(out_value, e->value, e->len);
+    *length = e->len;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+    if (length > SIM_NVS_VALUE_MAX) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    sim_nvs_entry_t *e = nvs_find(handle, key, true);
+    if (e == NULL) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    memcpy(e->value, value, length);
+    e->len = length;
+    sim_nvs_writes++;
+    return ESP_OK;
+}
+
+static sim_nvs_entry_t nvs_saved[SIM_NVS_ENTRIES];
+
+void sim_nvs_save(void) {
+    memcpy(nvs_saved, nvs_entries, sizeof(nvs_saved));
+}
+
+void sim_nvs_restore(void) {
+    memcpy(nvs_entries, nvs_saved, sizeof(nvs_entries));
+}
+
+esp_err_t nvs_get_i64(nvs_handle_t handle, const char *key, int64_t *out_value) {
+    size_t len = sizeof(*out_value);
+    return nvs_get_blob(handle, key, out_value, &len);
+}
+
+esp_err_t nvs_set_i64(nvs_handle_t handle, const char *key, int64_t value) {
+    return nvs_set_blob(handle, key, &value, sizeof(value));
+}
+
+// --- Wall clock and SNTP ---------------------------------------------------
+
+// Seconds since the epoch at virtual tick 0. Zero until the harness sets
+// the clock, so time() starts near 1970 like an unsynced RTC.
+static int64_t clock_base = 0;
+static esp_sntp_time_cb_t sntp_cb = NULL;
+
+time_t __wrap_time(time_t *out) {
+    time_t t = (time_t)(clock_base + sim_now() / configTICK_RATE_HZ);
+    if (out) *out = t;
+    return t;
+}
+
+void sim_set_time(int64_t epoch) {
+    clock_base = epoch - sim_now() / configTICK_RATE_HZ;
+}
+
+esp_err_t esp_netif_sntp_init(const esp_sntp_config_t *config) {
+    sntp_cb = config->sync_cb;
+    return ESP_OK;
+}
+
+void sim_sntp_sync(int64_t epoch) {
+    sim_set_time(epoch);
+    if (sntp_cb) {
+        struct timeval tv = { .tv_sec = (time_t)epoch };
+        sntp_cb(&tv);
+    }
+}
+
+// --- libc ---------------------------------------------------------------
+
+#ifdef SIM_NEED_STRLCPY
+size_t strlcpy(char *dst, const char *src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+
+size_t strlcat(char *dst, const char *src, size_t size) {
+    size_t used = strnlen(dst, size);
+    if (used == size) return size + strlen(src);
+    return used + strlcpy(dst + used, src, size - used);
+}
+#endif
+
+// --- System ---------------------------------------------------------------
+
+const char *esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_FAIL: return "ESP_FAIL";
+        case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FINISHED: return "ESP_ERR_NOT_FINISHED";
+        case ESP_ERR_OTA_VALIDATE_FAILED: return "ESP_ERR_OTA_VALIDATE_FAILED";
+        default: return "ESP_ERR";
+    }
+}
+
+int sim_reset_reason = ESP_RST_POWERON;
+
+esp_reset_reason_t esp_reset_reason(void) {
+    return (esp_reset_reason_t)sim_reset_reason;
+}
+
+// Counted; the caller carries on, where a device would reboot
+void esp_restart(void) {
+    sim_restarts++;
+}
+
+uint32_t esp_random(void) {
+    static uint32_t x = 0x2545f491;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+uint32_t esp_get_free_heap_size(void) {
+    return 256 * 1024;
+}
+
+uint32_t esp_get_minimum_free_heap_size(void) {
+    return 256 * 1024;
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    return calloc(n, size);
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return 128 * 1024;
+}
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t *ap_info) {
+    return ESP_FAIL;
+}
+
+// --- Flash ---------------------------------------------------------------------
+
+esp_err_t esp_vfs_spiffs_register(const esp_vfs_spiffs_conf_t *conf) {
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t esp_spiffs_info(const char *partition_label, size_t *total_bytes, size_t *used_bytes) {
+    return ESP_ERR_NOT_FOUND;
+}
+
+// The data partitions and the OTA app slot live in RAM, with NOR flash
+// rules: writes can only clear bits and erases are whole sectors
+#define SIM_PAGE 256
+#define SIM_SECTOR 4096
+#define SIM_BLOCK 0x10000
+
+typedef struct {
+    esp_partition_t part;
+    uint8_t *flash;
+    bool ready;
+} sim_partition_t;
+
+static uint8_t storage_flash[0x150000];
+static uint8_t ota_flash[0x100000];
+static uint8_t history_flash[0x10000];
+#define SIM_PARTITION(t, st, addr, mem, name) \
+    {.part = {.type = (t), .subtype = (st), .address = (addr), .size = sizeof(mem), \
+              .erase_size = SIM_SECTOR, .label = (name)}, .flash = (mem)}
+static sim_partition_t partitions[] = {
+    SIM_PARTITION(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_1, 0x110000, ota_flash, "ota_1"),
+    SIM_PARTITION(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, 0x210000, storage_flash, "storage"),
+    SIM_PARTITION(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, 0x360000, history_flash, "history"),
+};
+#define NUM_PARTITIONS (sizeof(partitions) / sizeof(partitions[0]))
+
+uint32_t sim_flash_erases = 0;
+uint64_t sim_flash_read_bytes = 0;
+uint64_t sim_flash_write_bytes = 0;
+sim_costs_t sim_costs = {0};
+uint32_t sim_restarts = 0;
+const esp_partition_t *sim_boot_partition = NULL;
+
+// Microseconds not yet charged, per task, below one tick
+static __thread uint64_t charge_left_us;
+
+static TickType_t charge_ticks(uint64_t us) {
+    if (xTaskGetCurrentTaskHandle() == NULL) return 0;
+    charge_left_us += us;
+    TickType_t ticks = charge_left_us / (1000000 / configTICK_RATE_HZ);
+    charge_left_us -= (uint64_t)ticks * (1000000 / configTICK_RATE_HZ);
+    return ticks;
+}
+
+void sim_charge_us(uint64_t us) {
+    vTaskDelay(charge_ticks(us));
+}
+
+// One flash command
+static void charge_flash_us(uint64_t us) {
+    if (sim_costs.flash_stalls_cpu) {
+        sim_hold_cpu(charge_ticks(us));
+    } else {
+        sim_charge_us(us);
+    }
+}
+
+static sim_partition_t *find(const esp_partition_t *partition) {
+    for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+        if (&partitions[i].part == partition) return &partitions[i];
+    }
+    return NULL;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label) {
+    for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+        sim_partition_t *p = &partitions[i];
+        if (label ? strcmp(label, p->part.label) != 0
+                  : (p->part.type != type || (subtype != ESP_PARTITION_SUBTYPE_ANY && p->part.subtype != subtype))) {
+            continue;
+        }
+        if (!p->ready) {
+            memset(p->flash, 0xff, p->part.size);
+            p->ready = true;
+        }
+        return &p->part;
+    }
+    return NULL;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size) {
+    sim_partition_t *p = find(partition);
+    if (p == NULL) return ESP_ERR_NOT_SUPPORTED;
+    if (src_offset + size > partition->size) return ESP_ERR_INVALID_SIZE;
+    memcpy(dst, p->flash + src_offset, size);
+    sim_flash_read_bytes += size;
+    charge_flash_us((uint64_t)size * sim_costs.read_kb_us / 1024);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t dst_offset, const void *src, size_t size) {
+    sim_partition_t *p = find(partition);
+    if (p == NULL) return ESP_ERR_NOT_SUPPORTED;
+    if (dst_offset + size > partition->size) return ESP_ERR_INVALID_SIZE;
+    const uint8_t *b = src;
+    for (size_t i = 0; i < size; i++) {
+        p->flash[dst_offset + i] &= b[i];
+    }
+    sim_flash_write_bytes += size;
+    if (sim_costs.flash_stalls_cpu) {
+        // Page by page, like spi_flash
+        for (size_t at = 0; at < size; at += SIM_PAGE) {
+            size_t n = size - at < SIM_PAGE ? size - at : SIM_PAGE;
+            charge_flash_us((uint64_t)n * sim_costs.write_kb_us / 1024);
+        }
+    } else {
+        sim_charge_us((uint64_t)size * sim_costs.write_kb_us / 1024);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size) {
+    sim_partition_t *p = find(partition);
+    if (p == NULL) return ESP_ERR_NOT_SUPPORTED;
+    if (offset % SIM_SECTOR || size % SIM_SECTOR || offset + size > partition->size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(p->flash + offset, 0xff, size);
+    sim_flash_erases += size / SIM_SECTOR;
+    // Like spi_flash: 64 KB block erases where aligned, sectors elsewhere
+    // (the partition offsets here are block aligned)
+    uint64_t us = 0;
+    for (size_t at = offset; at < offset + size;) {
+        bool block = at % SIM_BLOCK == 0 && offset + size - at >= SIM_BLOCK;
+        uint32_t cmd_us = block ? sim_costs.erase_block_us : sim_costs.erase_sector_us;
+        if (sim_costs.flash_stalls_cpu) charge_flash_us(cmd_us);
+        us += cmd_us;
+        at += block ? SIM_BLOCK : SIM_SECTOR;
+    }
+    if (!sim_costs.flash_stalls_cpu) sim_charge_us(us);
+    return ESP_OK;
+}
+
+// --- OTA ---------------------------------------------------------------------
+
+static struct {
+    const esp_partition_t *part;
+    size_t wrote;
+    bool sequential;
+} ota;
+
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *start_from) {
+    return esp_partition_find_first(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_1, NULL);
+}
+
+const esp_partition_t *esp_ota_get_running_partition(void) {
+    return NULL;
+}
+
+esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp_ota_handle_t *out_handle) {
+    if (find(partition) == NULL) return ESP_ERR_NOT_SUPPORTED;
+    ota.part = partition;
+    ota.wrote = 0;
+    ota.sequential = image_size == OTA_WITH_SEQUENTIAL_WRITES;
+    // Like IDF: a known size erases that much, an unknown one everything
+    if (!ota.sequential) {
+        size_t size = image_size == OTA_SIZE_UNKNOWN ? partition->size
+                                                     : (image_size + SIM_SECTOR - 1) / SIM_SECTOR * SIM_SECTOR;
+        esp_err_t err = esp_partition_erase_range(partition, 0, size);
+        if (err != ESP_OK) return err;
+    }
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size) {
+    if (handle != 1 || ota.part == NULL) return ESP_ERR_INVALID_ARG;
+    if (ota.sequential) {
+        // Erase the sectors this write starts, like IDF
+        size_t from = (ota.wrote + SIM_SECTOR - 1) / SIM_SECTOR * SIM_SECTOR;
+        size_t to = (ota.wrote + size + SIM_SECTOR - 1) / SIM_SECTOR * SIM_SECTOR;
+        if (to > from) {
+            esp_err_t err = esp_partition_erase_range(ota.part, from, to - from);
+            if (err != ESP_OK) return err;
+        }
+    }
+    esp_err_t err = esp_partition_write(ota.part, ota.wrote, data, size);
+    if (err == ESP_OK) ota.wrote += size;
+    return err;
+}
+
+esp_err_t esp_ota_end(esp_ota_handle_t handle) {
+    if (handle != 1 || ota.part == NULL) return ESP_ERR_INVALID_ARG;
+    ota.part = NULL;
+    return ota.wrote > 0 ? ESP_OK : ESP_ERR_OTA_VALIDATE_FAILED;
+}
+
+esp_err_t esp_ota_abort(esp_ota_handle_t handle) {
+    ota.part = NULL;
+    return ESP_OK;
+}
+
+// Checks the image magic byte, the part of IDF's validation that a test
+// image can meet
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *partition) {
+    sim_partition_t *p = find(partition);
+    if (p == NULL || partition->type != ESP_PARTITION_TYPE_APP) return ESP_ERR_INVALID_ARG;
+    if (p->flash[0] != 0xe9) return ESP_ERR_OTA_VALIDATE_FAILED;
+    sim_boot_partition = partition;
+    return ESP_OK;
+}
@@ -0,0 +1,136 @@
+// General purpose timer driver: one counter on virtual time whose alarm
+// is an ISR-dispatched esp_timer, so it goes off on time even while a
+// task holds the CPU (see sim_hold_cpu()). Counts and alarms are exact;
+// the alarm itself only fires on a tick boundary.
+
+#include "driver/gptimer.h"
+#include "esp_timer.h"
+#include "sim.h"
+
+uint32_t sim_gptimer_alarms = 0;
+bool sim_gptimer_running = false;
+
+struct sim_gptimer {
+    uint32_t resolution_hz;
+    bool enabled;
+    uint64_t count;             // At started_us, or the count while stopped
+    int64_t started_us;
+    gptimer_alarm_config_t alarm;
+    bool alarm_armed;
+    gptimer_event_callbacks_t cbs;
+    void *user_data;
+    esp_timer_handle_t timer;
+};
+
+static struct sim_gptimer gptimer;
+static bool gptimer_taken = false;
+
+static uint64_t count_now(struct sim_gptimer *t) {
+    if (!sim_gptimer_running) return t->count;
+    return t->count + (uint64_t)(esp_timer_get_time() - t->started_us) * t->resolution_hz / 1000000;
+}
+
+// Points the esp_timer at the alarm, if it can go off
+static void schedule(struct sim_gptimer *t) {
+    if (esp_timer_is_active(t->timer)) esp_timer_stop(t->timer);
+    if (!sim_gptimer_running || !t->alarm_armed) return;
+    uint64_t count = count_now(t);
+    uint64_t ahead = t->alarm.alarm_count > count ? t->alarm.alarm_count - count : 0;
+    esp_timer_start_once(t->timer, (ahead * 1000000 + t->resolution_hz - 1) / t->resolution_hz);
+}
+
+static void alarm_fired(void *arg) {
+    struct sim_gptimer *t = arg;
+    gptimer_alarm_event_data_t edata = { .count_value = count_now(t), .alarm_value = t->alarm.alarm_count };
+    sim_gptimer_alarms++;
+    if (t->alarm.flags.auto_reload_on_alarm) {
+        t->count = t->alarm.reload_count;
+        t->started_us = esp_timer_get_time();
+    } else {
+        t->alarm_armed = false;
+    }
+    if (t->cbs.on_alarm) t->cbs.on_alarm(t, &edata, t->user_data);
+    schedule(t);
+}
+
+esp_err_t gptimer_new_timer(const gptimer_config_t *config, gptimer_handle_t *ret_timer) {
+    if (gptimer_taken) return ESP_ERR_NOT_FOUND;
+    if (config->resolution_hz == 0 || config->direction != GPTIMER_COUNT_UP) return ESP_ERR_INVALID_ARG;
+    gptimer_taken = true;
+    gptimer = (struct sim_gptimer){ .resolution_hz = config->resolution_hz };
+    esp_timer_create_args_t args = {
+        .callback = alarm_fired,
+        .arg = &gptimer,
+        .dispatch_method = ESP_TIMER_ISR,
+        .name = "gptimer",
+    };
+    esp_timer_create(&args, &gptimer.timer);
+    *ret_timer = &gptimer;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_del_timer(gptimer_handle_t timer) {
+    if (timer->enabled) return ESP_ERR_INVALID_STATE;
+    esp_timer_delete(timer->timer);
+    gptimer_taken = false;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_register_event_callbacks(gptimer_handle_t timer, const gptimer_event_callbacks_t *cbs,
+                                           void *user_data) {
+    if (timer->enabled) return ESP_ERR_INVALID_STATE;
+    timer->cbs = *cbs;
+    timer->user_data = user_data;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_set_alarm_action(gptimer_handle_t timer, const gptimer_alarm_config_t *config) {
+    if (config) {
+        timer->alarm = *config;
+        timer->alarm_armed = true;
+    } else {
+        timer->alarm_armed = false;
+    }
+    schedule(timer);
+    return ESP_OK;
+}
+
+esp_err_t gptimer_set_raw_count(gptimer_handle_t timer, uint64_t value) {
+    timer->count = value;
+    timer->started_us = esp_timer_get_time();
+    schedule(timer);
+    return ESP_OK;
+}
+
+esp_err_t gptimer_get_raw_count(gptimer_handle_t timer, uint64_t *value) {
+    *value = count_now(timer);
+    return ESP_OK;
+}
+
+esp_err_t gptimer_enable(gptimer_handle_t timer) {
+    if (timer->enabled) return ESP_ERR_INVALID_STATE;
+    timer->enabled = true;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_disable(gptimer_handle_t timer) {
+    if (!timer->enabled || sim_gptimer_running) return ESP_ERR_INVALID_STATE;
+    timer->enabled = false;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_start(gptimer_handle_t timer) {
+    if (!timer->enabled || sim_gptimer_running) return ESP_ERR_INVALID_STATE;
+    timer->started_us = esp_timer_get_time();
+    sim_gptimer_running = true;
+    schedule(timer);
+    return ESP_OK;
+}
+
+esp_err_t gptimer_stop(gptimer_handle_t timer) {
+    if (!sim_gptimer_running) return ESP_ERR_INVALID_STATE;
+    timer->count = count_now(timer);
+    sim_gptimer_running = false;
+    schedule(timer);
+    return ESP_OK;
+}
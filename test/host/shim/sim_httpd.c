@@ -0,0 +1,489 @@
+// In-process stand-in for esp_http_server. Requests are dispatched to the
+// registered handlers on the calling thread (main, or a sim task) and the response is
+// captured in a static buffer, so the capture itself never allocates.
+// The calling thread stands in for the httpd task: only one request at a
+// time gets to run its handler there, and the others wait their turn.
+// A handler can hand its request to another task with
+// httpd_req_async_handler_begin(), which frees the server again.
+
+#include "sim.h"
+#include "esp_http_server.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define MAX_HANDLERS 64
+#define MAX_SESSIONS 16
+#define MAX_WORK 32
+#define FIRST_SOCKFD 54
+#define RESP_SLOTS 8            // Responses of requests still in flight
+
+typedef struct {
+    httpd_uri_t uri;
+} handler_t;
+
+typedef struct {
+    int fd;
+    void *ctx;
+    httpd_free_ctx_fn_t free_ctx;
+    size_t bytes;
+} session_t;
+
+typedef struct {
+    httpd_work_fn_t fn;
+    void *arg;
+} work_t;
+
+typedef struct req_ctx {
+    const char *headers;
+    const char *query;
+    const char *body;
+    size_t body_len;
+    size_t body_pos;
+    size_t arrived;         // Body bytes the client has got to us so far
+    int64_t clock_us;       // Virtual time up to which arrival is counted
+    int sockfd;
+    sim_response_t *resp;
+    bool async;             // Handed to another task, which completes it
+    bool completed;
+    TaskHandle_t client;    // Waits for completion; NULL for main
+    struct req_ctx *origin; // In an async copy, the request it was copied from
+} req_ctx_t;
+
+static httpd_config_t server_config;
+static bool server_started = false;
+static handler_t handlers[MAX_HANDLERS];
+static int num_handlers = 0;
+static session_t sessions[MAX_SESSIONS];
+static work_t work_queue[MAX_WORK];
+static int work_head = 0, work_tail = 0;
+static int next_fd = FIRST_SOCKFD;
+static sim_response_t resp_slots[RESP_SLOTS];
+static bool resp_in_flight[RESP_SLOTS];
+static int next_resp = 0;
+static bool server_busy = false;    // The httpd task is running a handler
+bool sim_httpd_async = true;
+
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config) {
+    server_config = *config;
+    server_started = true;
+    *handle = &server_config;
+    sim_set_idle_hook(sim_httpd_run_work);
+    return ESP_OK;
+}
+
+esp_err_t httpd_stop(httpd_handle_t handle) {
+    server_started = false;
+    return ESP_OK;
+}
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler) {
+    if (num_handlers >= server_config.max_uri_handlers) {
+        return ESP_ERR_HTTPD_HANDLERS_FULL;
+    }
+    for (int i = 0; i < num_handlers; i++) {
+        if (handlers[i].uri.method == uri_handler->method &&
+            strcmp(handlers[i].uri.uri, uri_handler->uri) == 0) {
+            return ESP_ERR_HTTPD_HANDLER_EXISTS;
+        }
+    }
+    handlers[num_handlers++].uri = *uri_handler;
+    return ESP_OK;
+}
+
+bool httpd_uri_match_wildcard(const char *uri_template, const char *uri_to_match, size_t match_upto) {
+    size_t tpl_len = strlen(uri_template);
+    if (tpl_len > 0 && uri_template[tpl_len - 1] == '*') {
+        return match_upto >= tpl_len - 1 && strncmp(uri_template, uri_to_match, tpl_len - 1) == 0;
+    }
+    return match_upto == tpl_len && strncmp(uri_template, uri_to_match, tpl_len) == 0;
+}
+
+static req_ctx_t *ctx_of(httpd_req_t *r) {
+    return (req_ctx_t *)r->aux;
+}
+
+// --- Request accessors ----------------------------------------------------
+
+static const char *find_header(httpd_req_t *r, const char *field, size_t *len) {
+    const char *h = ctx_of(r)->headers;
+    size_t field_len = strlen(field);
+    while (h && *h) {
+        const char *eol = strchr(h, '\n');
+        size_t line_len = eol ? (size_t)(eol - h) : strlen(h);
+        if (line_len > field_len && h[field_len] == ':' && strncasecmp(h, field, field_len) == 0) {
+            const char *v = h + field_len + 1;
+            while (*v == ' ') v++;
+            *len = line_len - (v - h);
+            return v;
+        }
+        h = eol ? eol + 1 : NULL;
+    }
+    return NULL;
+}
+
+size_t httpd_req_get_hdr_value_len(httpd_req_t *r, const char *field) {
+    size_t len = 0;
+    return find_header(r, field, &len) ? len : 0;
+}
+
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t *r, const char *field, char *val, size_t val_size) {
+    size_t len = 0;
+    const char *v = find_header(r, field, &len);
+    if (v == NULL) return ESP_ERR_NOT_FOUND;
+    size_t n = len < val_size - 1 ? len : val_size - 1;
+    memcpy(val, v, n);
+    val[n] = '\0';
+    return n < len ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+}
+
+size_t httpd_req_get_url_query_len(httpd_req_t *r) {
+    const char *q = ctx_of(r)->query;
+    return q ? strlen(q) : 0;
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t *r, char *buf, size_t buf_len) {
+    const char *q = ctx_of(r)->query;
+    if (q == NULL) return ESP_ERR_NOT_FOUND;
+    size_t len = strlen(q);
+    size_t n = len < buf_len - 1 ? len : buf_len - 1;
+    memcpy(buf, q, n);
+    buf[n] = '\0';
+    return n < len ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+}
+
+esp_err_t httpd_query_key_value(const char *qry, const char *key, char *val, size_t val_size) {
+    size_t key_len = strlen(key);
+    const char *p = qry;
+    while (p && *p) {
+        const char *end = strchr(p, '&');
+        size_t pair_len = end ? (size_t)(end - p) : strlen(p);
+        if (pair_len > key_len && p[key_len] == '=' && strncmp(p, key, key_len) == 0) {
+            size_t len = pair_len - key_len - 1;
+            size_t n = len < val_size - 1 ? len : val_size - 1;
+            memcpy(val, p + key_len + 1, n);
+            val[n] = '\0';
+            return n < len ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+        }
+        p = end ? end + 1 : NULL;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+// The client streams the body at recv_kb_us per KB for as long as the
+// TCP window (recv_window bytes not yet read) has room, like a sender
+// that is ahead of us. A read takes what has arrived, waiting for one
+// segment when nothing has.
+#define SIM_MSS 1440
+
+static void arrive(req_ctx_t *c) {
+    int64_t now_us = (int64_t)xTaskGetTickCount() * 1000;
+    uint64_t can = (uint64_t)(now_us - c->clock_us) * 1024 / sim_costs.recv_kb_us;
+    size_t limit = c->body_pos + (sim_costs.recv_window ? sim_costs.recv_window : c->body_len);
+    if (limit > c->body_len) limit = c->body_len;
+    size_t room = limit > c->arrived ? limit - c->arrived : 0;
+    if (can > room) {
+        // The window was full for the rest of the time: the client sat idle
+        if (c->arrived + room < c->body_len) {
+            uint32_t ms = (uint32_t)((can - room) * sim_costs.recv_kb_us / 1024 / 1000);
+            c->resp->client_stall_ms += ms;
+            if (ms > c->resp->client_max_stall_ms) c->resp->client_max_stall_ms = ms;
+        }
+        c->arrived += room;
+        c->clock_us = now_us;
+    } else {
+        c->arrived += can;
+        c->clock_us += (int64_t)(can * sim_costs.recv_kb_us / 1024);
+    }
+}
+
+int httpd_req_recv(httpd_req_t *r, char *buf, size_t buf_len) {
+    req_ctx_t *c = ctx_of(r);
+    if (sim_costs.recv_kb_us == 0 || xTaskGetCurrentTaskHandle() == NULL) {
+        c->arrived = c->body_len;
+    } else {
+        arrive(c);
+        while (c->arrived == c->body_pos && c->body_pos < c->body_len) {
+            size_t want = c->body_len - c->body_pos < SIM_MSS ? c->body_len - c->body_pos : SIM_MSS;
+            sim_charge_us((uint64_t)want * sim_costs.recv_kb_us / 1024 + 1);
+            arrive(c);
+        }
+    }
+    size_t left = c->arrived - c->body_pos;
+    size_t n = left < buf_len ? left : buf_len;
+    memcpy(buf, c->body + c->body_pos, n);
+    c->body_pos += n;
+    return (int)n;
+}
+
+int httpd_req_to_sockfd(httpd_req_t *r) {
+    return ctx_of(r)->sockfd;
+}
+
+// --- Responses ------------------------------------------------------------
+
+esp_err_t httpd_resp_set_status(httpd_req_t *r, const char *status) {
+    ctx_of(r)->resp->status = atoi(status);
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type) {
+    sim_response_t *resp = ctx_of(r)->resp;
+    snprintf(resp->content_type, sizeof(resp->content_type), "%s", type);
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_hdr(httpd_req_t *r, const char *field, const char *value) {
+    sim_response_t *resp = ctx_of(r)->resp;
+    size_t used = strlen(resp->headers);
+    snprintf(resp->headers + used, sizeof(resp->headers) - used, "%s: %s\n", field, value);
+    return ESP_OK;
+}
+
+static void append_body(sim_response_t *resp, const char *buf, size_t len) {
+    size_t room = SIM_RESP_MAX - resp->body_len;
+    size_t n = len < room ? len : room;
+    memcpy(resp->body + resp->body_len, buf, n);
+    resp->body_len += n;
+    resp->body_sent += len;
+}
+
+// A task sending a response waits for it to go out, like a send on a
+// socket with a full buffer
+static void charge_send(size_t len) {
+    if (sim_costs.send_kb_us && xTaskGetCurrentTaskHandle() != NULL) {
+        sim_charge_us((uint64_t)len * sim_costs.send_kb_us / 1024);
+    }
+}
+
+static void finish(sim_response_t *resp) {
+    resp->finished = true;
+    resp->finished_at = xTaskGetTickCount();
+}
+
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len) {
+    sim_response_t *resp = ctx_of(r)->resp;
+    if (buf_len == HTTPD_RESP_USE_STRLEN) buf_len = buf ? strlen(buf) : 0;
+    if (buf && buf_len > 0) {
+        append_body(resp, buf, buf_len);
+        charge_send(buf_len);
+    }
+    finish(resp);
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len) {
+    sim_response_t *resp = ctx_of(r)->resp;
+    resp->chunked = true;
+    if (buf_len == HTTPD_RESP_USE_STRLEN) buf_len = buf ? strlen(buf) : 0;
+    if (buf == NULL || buf_len == 0) {
+        finish(resp);
+        return ESP_OK;
+    }
+    append_body(resp, buf, buf_len);
+    charge_send(buf_len);
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_err(httpd_req_t *req, httpd_err_code_t error, const char *msg) {
+    static const int codes[] = {
+        [HTTPD_500_INTERNAL_SERVER_ERROR] = 500, [HTTPD_501_METHOD_NOT_IMPLEMENTED] = 501,
+        [HTTPD_505_VERSION_NOT_SUPPORTED] = 505, [HTTPD_400_BAD_REQUEST] = 400,
+        [HTTPD_401_UNAUTHORIZED] = 401, [HTTPD_403_FORBIDDEN] = 403,
+        [HTTPD_404_NOT_FOUND] = 404, [HTTPD_405_METHOD_NOT_ALLOWED] = 405,
+        [HTTPD_408_REQ_TIMEOUT] = 408, [HTTPD_411_LENGTH_REQUIRED] = 411,
+        [HTTPD_413_CONTENT_TOO_LARGE] = 413, [HTTPD_414_URI_TOO_LONG] = 414,
+        [HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE] = 431,
+    };
+    sim_response_t *resp = ctx_of(req)->resp;
+    resp->status = codes[error];
+    resp->body_len = 0;
+    resp->body_sent = 0;
+    return httpd_resp_send(req, msg ? msg : "Error", HTTPD_RESP_USE_STRLEN);
+}
+
+// --- Sessions and work queue ----------------------------------------------
+
+static session_t *find_session(int fd) {
+    for (int i = 0; i < MAX_SESSIONS; i++) {
+        if (sessions[i].fd == fd && fd != 0) return &sessions[i];
+    }
+    return NULL;
+}
+
+int httpd_socket_send(httpd_handle_t hd, int sockfd, const char *buf, size_t buf_len, int flags) {
+    session_t *s = find_session(sockfd);
+    if (s == NULL) return HTTPD_SOCK_ERR_INVALID;
+    s->bytes += buf_len;
+    return (int)buf_len;
+}
+
+void sim_httpd_close(int sockfd) {
+    session_t *s = find_session(sockfd);
+    if (s == NULL) return;
+    if (s->free_ctx) s->free_ctx(s->ctx);
+    memset(s, 0, sizeof(*s));
+}
+
+esp_err_t httpd_sess_trigger_close(httpd_handle_t handle, int sockfd) {
+    sim_httpd_close(sockfd);
+    return ESP_OK;
+}
+
+size_t sim_httpd_socket_bytes(int sockfd) {
+    session_t *s = find_session(sockfd);
+    return s ? s->bytes : 0;
+}
+
+esp_err_t httpd_queue_work(httpd_handle_t handle, httpd_work_fn_t work, void *arg) {
+    int next = (work_tail + 1) % MAX_WORK;
+    if (next == work_head) return ESP_FAIL;
+    work_queue[work_tail].fn = work;
+    work_queue[work_tail].arg = arg;
+    work_tail = next;
+    return ESP_OK;
+}
+
+void sim_httpd_run_work(void) {
+    while (work_head != work_tail) {
+        work_t w = work_queue[work_head];
+        work_head = (work_head + 1) % MAX_WORK;
+        w.fn(w.arg);
+    }
+}
+
+// --- Async requests ---------------------------------------------------------
+
+// Like esp_http_server, the copy is allocated, so the heap counters see it
+esp_err_t httpd_req_async_handler_begin(httpd_req_t *r, httpd_req_t **out) {
+    if (!sim_httpd_async) return ESP_ERR_NO_MEM;
+    httpd_req_t *copy = malloc(sizeof(*copy));
+    req_ctx_t *c = malloc(sizeof(*c));
+    if (copy == NULL || c == NULL) {
+        free(copy);
+        free(c);
+        return ESP_ERR_NO_MEM;
+    }
+    *c = *ctx_of(r);
+    c->origin = ctx_of(r);
+    memcpy(copy, r, sizeof(*copy));     // uri is const
+    copy->aux = c;
+    ctx_of(r)->async = true;
+    *out = copy;
+    return ESP_OK;
+}
+
+esp_err_t httpd_req_async_handler_complete(httpd_req_t *r) {
+    req_ctx_t *c = ctx_of(r);
+    if (c->origin == NULL) return ESP_ERR_INVALID_ARG;
+    c->origin->completed = true;
+    if (c->origin->client) xTaskNotifyGive(c->origin->client);
+    free(c);
+    free(r);
+    return ESP_OK;
+}
+
+// --- Dispatch ---------------------------------------------------------------
+
+// Waits for the httpd task to be free. The main context moves virtual
+// time on meanwhile; a task polls every tick.
+static void acquire_server(void) {
+    while (server_busy) {
+        if (xTaskGetCurrentTaskHandle() == NULL) {
+            sim_advance(1);
+        } else {
+            vTaskDelay(1);
+        }
+    }
+    server_busy = true;
+}
+
+const sim_response_t *sim_httpd_request(httpd_method_t method, const char *uri,
+                                        const char *headers, const char *body, size_t body_len) {
+    // Skip the slots of requests other tasks are still waiting on
+    while (resp_in_flight[next_resp]) next_resp = (next_resp + 1) % RESP_SLOTS;
+    int slot = next_resp;
+    next_resp = (next_resp + 1) % RESP_SLOTS;
+    sim_response_t *resp = &resp_slots[slot];
+    memset(resp, 0, sizeof(*resp));
+    resp->status = 200;
+    snprintf(resp->content_type, sizeof(resp->content_type), "text/html");
+
+    size_t path_len = strcspn(uri, "?");
+    const httpd_uri_t *match = NULL;
+    for (int i = 0; i < num_handlers && !match; i++) {
+        const httpd_uri_t *h = &handlers[i].uri;
+        if ((int)h->method != (int)method) continue;
+        bool ok = server_config.uri_match_fn
+            ? server_config.uri_match_fn(h->uri, uri, path_len)
+            : (strlen(h->uri) == path_len && strncmp(h->uri, uri, path_len) == 0);
+        if (ok) match = h;
+    }
+
+    if (match == NULL) {
+        resp->status = 404;
+        resp->finished = true;
+        return resp;
+    }
+
+    req_ctx_t ctx = {
+        .headers = headers,
+        .query = uri[path_len] == '?' ? uri + path_len + 1 : NULL,
+        .body = body,
+        .body_len = body_len,
+        .body_pos = 0,
+        .sockfd = next_fd++,
+        .resp = resp,
+        .client = xTaskGetCurrentTaskHandle(),
+    };
+    httpd_req_t req = {
+        .handle = &server_config,
+        .method = method,
+        .content_len = body_len,
+        .aux = &ctx,
+        .user_ctx = match->user_ctx,
+    };
+    snprintf((char *)req.uri, sizeof(req.uri), "%s", uri);
+    resp->sockfd = ctx.sockfd;
+
+    resp_in_flight[slot] = true;
+    acquire_server();
+    // The body starts arriving once the server reads the request
+    ctx.clock_us = (int64_t)xTaskGetTickCount() * 1000;
+    esp_err_t ret = match->handler(&req);
+    server_busy = false;
+
+    if (ctx.async) {
+        // The caller is the client: it waits for the response
+        if (ctx.client == NULL) {
+            sim_idle();
+            while (!ctx.completed) sim_advance(1);
+        } else {
+            while (!ctx.completed) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    } else if (ret != ESP_OK && !resp->finished && resp->body_len == 0) {
+        resp->status = 500;
+    }
+
+    // Handlers that attach a session context keep their socket open
+    if (req.sess_ctx) {
+        for (int i = 0; i < MAX_SESSIONS; i++) {
+            if (sessions[i].fd == 0) {
+                sessions[i].fd = ctx.sockfd;
+                sessions[i].ctx = req.sess_ctx;
+                sessions[i].free_ctx = req.free_ctx;
+                sessions[i].bytes = 0;
+                break;
+            }
+        }
+    }
+
+    resp_in_flight[slot] = false;
+    // Let tasks the handler woke run, unless a task made the request
+    if (xTaskGetCurrentTaskHandle() == NULL) sim_idle();
+    return resp;
+}
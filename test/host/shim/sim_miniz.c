@@ -0,0 +1,47 @@
+// tinfl and the ROM CRC-32 on top of zlib, for the gzip OTA path
+
+#include "miniz.h"
+#include "esp_rom_crc.h"
+
+#include <string.h>
+
+tinfl_status tinfl_decompress(tinfl_decompressor *r, const mz_uint8 *pIn_buf_next, size_t *pIn_buf_size,
+                              mz_uint8 *pOut_buf_start, mz_uint8 *pOut_buf_next, size_t *pOut_buf_size,
+                              const mz_uint32 decomp_flags) {
+    if (decomp_flags & (TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_COMPUTE_ADLER32)) return TINFL_STATUS_BAD_PARAM;
+    if (r->m_state == 0) {
+        memset(&r->z, 0, sizeof(r->z));
+        if (inflateInit2(&r->z, -15) != Z_OK) return TINFL_STATUS_FAILED;
+        r->m_state = 1;
+    }
+    if (r->m_state >= 2) {
+        *pIn_buf_size = *pOut_buf_size = 0;
+        return r->m_state == 2 ? TINFL_STATUS_DONE : TINFL_STATUS_FAILED;
+    }
+
+    r->z.next_in = (Bytef *)pIn_buf_next;
+    r->z.avail_in = (uInt)*pIn_buf_size;
+    r->z.next_out = pOut_buf_next;
+    r->z.avail_out = (uInt)*pOut_buf_size;
+    int ret = inflate(&r->z, Z_NO_FLUSH);
+    *pIn_buf_size -= r->z.avail_in;
+    *pOut_buf_size -= r->z.avail_out;
+
+    if (ret == Z_STREAM_END) {
+        inflateEnd(&r->z);
+        r->m_state = 2;
+        return TINFL_STATUS_DONE;
+    }
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+        inflateEnd(&r->z);
+        r->m_state = 3;
+        return TINFL_STATUS_FAILED;
+    }
+    if (r->z.avail_out == 0) return TINFL_STATUS_HAS_MORE_OUTPUT;
+    return (decomp_flags & TINFL_FLAG_HAS_MORE_INPUT) ? TINFL_STATUS_NEEDS_MORE_INPUT
+                                                      : TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len) {
+    return (uint32_t)crc32(crc, buf, len);
+}
@@ -0,0 +1,194 @@
+// esp-mqtt on a broker in the same process. Events are dispatched from
+// whoever triggers them (sim_mqtt_connect(), sim_mqtt_deliver()), standing
+// in for the client's task.
+
+#include "mqtt_client.h"
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SUBS 8
+#define MAX_RETAINED 16
+#define TOPIC_MAX 96
+
+struct sim_mqtt_client {
+    char uri[128];
+    char will_topic[TOPIC_MAX];
+    char will_msg[32];
+    esp_event_handler_t handler;
+    void *handler_arg;
+    bool started;
+    bool connected;
+    char subs[MAX_SUBS][TOPIC_MAX];
+    int num_subs;
+};
+
+typedef struct {
+    char topic[TOPIC_MAX];
+    char payload[SIM_MQTT_PAYLOAD_MAX];
+    size_t len;
+} retained_t;
+
+static struct sim_mqtt_client the_client;
+static bool client_created = false;
+static retained_t retained[MAX_RETAINED];
+static int num_retained = 0;
+
+uint32_t sim_mqtt_publishes = 0;
+uint64_t sim_mqtt_bytes = 0;
+
+static void dispatch(esp_mqtt_event_id_t id, const char *topic, const char *data, int len, bool retain) {
+    struct sim_mqtt_client *c = &the_client;
+    if (c->handler == NULL) return;
+    esp_mqtt_event_t event = {
+        .event_id = id,
+        .client = c,
+        .data = (char *)data,
+        .data_len = len,
+        .total_data_len = len,
+        .topic = (char *)topic,
+        .topic_len = topic ? (int)strlen(topic) : 0,
+        .retain = retain,
+    };
+    c->handler(c->handler_arg, "MQTT_EVENTS", id, &event);
+}
+
+static void apply_config(struct sim_mqtt_client *c, const esp_mqtt_client_config_t *config) {
+    strncpy(c->uri, config->broker.address.uri ? config->broker.address.uri : "", sizeof(c->uri) - 1);
+    const char *topic = config->session.last_will.topic;
+    const char *msg = config->session.last_will.msg;
+    strncpy(c->will_topic, topic ? topic : "", sizeof(c->will_topic) - 1);
+    strncpy(c->will_msg, msg ? msg : "", sizeof(c->will_msg) - 1);
+}
+
+esp_mqtt_client_handle_t esp_mqtt_client_init(const esp_mqtt_client_config_t *config) {
+    if (client_created) return NULL;
+    memset(&the_client, 0, sizeof(the_client));
+    apply_config(&the_client, config);
+    client_created = true;
+    return &the_client;
+}
+
+esp_err_t esp_mqtt_set_config(esp_mqtt_client_handle_t client, const esp_mqtt_client_config_t *config) {
+    apply_config(client, config);
+    return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_register_event(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t event,
+                                         esp_event_handler_t event_handler, void *event_handler_arg) {
+    client->handler = event_handler;
+    client->handler_arg = event_handler_arg;
+    return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_start(esp_mqtt_client_handle_t client) {
+    if (client->started) return ESP_FAIL;
+    client->started = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_stop(esp_mqtt_client_handle_t client) {
+    if (!client->started) return ESP_FAIL;
+    // A clean disconnect: the will is not published
+    client->started = false;
+    client->connected = false;
+    client->num_subs = 0;
+    return ESP_OK;
+}
+
+int esp_mqtt_client_subscribe_single(esp_mqtt_client_handle_t client, const char *topic, int qos) {
+    if (!client->connected || client->num_subs == MAX_SUBS) return -1;
+    strncpy(client->subs[client->num_subs++], topic, TOPIC_MAX - 1);
+    return client->num_subs;
+}
+
+static void store(const char *topic, const char *data, size_t len) {
+    retained_t *r = NULL;
+    for (int i = 0; i < num_retained && !r; i++) {
+        if (strcmp(retained[i].topic, topic) == 0) r = &retained[i];
+    }
+    if (r == NULL) {
+        if (num_retained == MAX_RETAINED) return;
+        r = &retained[num_retained++];
+        strlcpy(r->topic, topic, sizeof(r->topic));
+    }
+    r->len = len < sizeof(r->payload) ? len : sizeof(r->payload);
+    memcpy(r->payload, data, r->len);
+}
+
+int esp_mqtt_client_publish(esp_mqtt_client_handle_t client, const char *topic, const char *data,
+                            int len, int qos, int retain) {
+    if (!client->connected) return -1;
+    if (len == 0) len = strlen(data);
+    sim_mqtt_publishes++;
+    sim_mqtt_bytes += len;
+    if (retain) store(topic, data, len);
+    return (int)sim_mqtt_publishes;
+}
+
+int esp_mqtt_client_enqueue(esp_mqtt_client_handle_t client, const char *topic, const char *data,
+                            int len, int qos, int retain, bool store_msg) {
+    // The outbox drains at once while connected
+    return esp_mqtt_client_publish(client, topic, data, len, qos, retain);
+}
+
+bool sim_mqtt_connect(void) {
+    struct sim_mqtt_client *c = &the_client;
+    if (!client_created || !c->started || c->connected) return false;
+    c->connected = true;
+    dispatch(MQTT_EVENT_CONNECTED, NULL, NULL, 0, false);
+    return true;
+}
+
+void sim_mqtt_drop(void) {
+    struct sim_mqtt_client *c = &the_client;
+    if (!c->connected) return;
+    c->connected = false;
+    c->num_subs = 0;
+    if (c->will_topic[0]) store(c->will_topic, c->will_msg, strlen(c->will_msg));
+    dispatch(MQTT_EVENT_DISCONNECTED, NULL, NULL, 0, false);
+}
+
+// MQTT topic filter match with + and a trailing #
+static bool topic_matches(const char *filter, const char *topic) {
+    while (*filter && *topic) {
+        if (*filter == '#') return true;
+        if (*filter == '+') {
+            while (*topic && *topic != '/') topic++;
+            filter++;
+            continue;
+        }
+        if (*filter != *topic) return false;
+        filter++;
+        topic++;
+    }
+    return *filter == *topic || strcmp(filter, "/#") == 0 || strcmp(filter, "#") == 0;
+}
+
+bool sim_mqtt_deliver(const char *topic, const char *payload, bool retain) {
+    struct sim_mqtt_client *c = &the_client;
+    if (!c->connected) return false;
+    for (int i = 0; i < c->num_subs; i++) {
+        if (topic_matches(c->subs[i], topic)) {
+            dispatch(MQTT_EVENT_DATA, topic, payload, strlen(payload), retain);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *sim_mqtt_retained(const char *topic, size_t *len) {
+    for (int i = 0; i < num_retained; i++) {
+        if (strcmp(retained[i].topic, topic) == 0) {
+            if (len) *len = retained[i].len;
+            return retained[i].payload;
+        }
+    }
+    return NULL;
+}
+
+const char *sim_mqtt_uri(void) {
+    return client_created && the_client.started ? the_client.uri : NULL;
+}
@@ -0,0 +1,527 @@
+// Single-CPU discrete-event simulation of the FreeRTOS task, notification
+// and timer APIs (plus esp_timer). Every simulated task is a pthread, but
+// a global "cpu" mutex guarantees only one of them - or the main thread -
+// runs at a time. Virtual time only moves in sim_advance(), once every
+// runnable task has blocked, so runs are deterministic.
+//
+// A task can hold the CPU for a while, as a flash operation does with
+// the cache off (sim_hold_cpu()): until it ends no other task wakes and
+// only ISR-dispatched esp_timers fire.
+
+#include "sim.h"
+#include "freertos/timers.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NEVER ((TickType_t)0xffffffffUL)
+
+typedef enum { TASK_RUNNING, TASK_BLOCKED, TASK_DONE } task_state_t;
+
+struct sim_task {
+    pthread_t thread;
+    pthread_cond_t cond;
+    TaskFunction_t fn;
+    void *arg;
+    char name[16];
+    uint32_t stack_depth;
+    task_state_t state;
+    TickType_t wake_at;
+    bool waiting_notify;
+    bool notify_pending;
+    struct sim_mutex *waiting_mutex;
+    uint32_t notify_value;
+    bool deleted;
+    uint32_t wakeups;
+    struct sim_task *next;
+};
+
+struct sim_timer {
+    char name[16];
+    bool is_esp_timer;
+    bool isr;               // esp_timer with ESP_TIMER_ISR dispatch
+    TickType_t period;
+    bool auto_reload;
+    bool active;
+    TickType_t expiry;
+    void *id;
+    TimerCallbackFunction_t callback;
+    esp_timer_cb_t esp_callback;
+    void *esp_arg;
+    struct sim_timer *next;
+};
+
+static pthread_mutex_t cpu = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t idle_cond = PTHREAD_COND_INITIALIZER;
+static int running = 0;
+static TickType_t now = 0;
+static struct sim_task *tasks = NULL;
+static struct sim_timer *timers = NULL;
+static __thread struct sim_task *current = NULL;
+static void (*idle_hook)(void) = NULL;
+// The tick sim_hold_cpu() lets go of the CPU at
+static TickType_t held_until = 0;
+
+// When something due at t can run, given the hold
+static TickType_t after_hold(TickType_t t) {
+    return t < held_until ? held_until : t;
+}
+
+void sim_init(void) {
+    pthread_mutex_lock(&cpu);
+}
+
+void sim_set_idle_hook(void (*hook)(void)) {
+    idle_hook = hook;
+}
+
+TickType_t sim_now(void) {
+    return now;
+}
+
+static void wait_idle(void) {
+    while (running > 0) {
+        pthread_cond_wait(&idle_cond, &cpu);
+    }
+}
+
+void sim_idle(void) {
+    wait_idle();
+    if (idle_hook) {
+        idle_hook();
+        wait_idle();
+    }
+}
+
+// Called with the cpu held by the blocking task
+static void block_current(void) {
+    struct sim_task *t = current;
+    assert(t != NULL && "blocking call from the main context");
+    t->state = TASK_BLOCKED;
+    running--;
+    pthread_cond_broadcast(&idle_cond);
+    while (t->state != TASK_RUNNING) {
+        pthread_cond_wait(&t->cond, &cpu);
+    }
+    t->wakeups++;
+}
+
+static void wake(struct sim_task *t) {
+    if (t->state != TASK_BLOCKED || t->deleted) return;
+    if (now < held_until) {
+        // Notified during a hold: it runs once the hold ends
+        if (t->wake_at > held_until) t->wake_at = held_until;
+        return;
+    }
+    t->state = TASK_RUNNING;
+    t->waiting_notify = false;
+    t->wake_at = NEVER;
+    running++;
+    pthread_cond_signal(&t->cond);
+}
+
+static void finish_current(void) {
+    struct sim_task *t = current;
+    t->state = TASK_DONE;
+    running--;
+    pthread_cond_broadcast(&idle_cond);
+    pthread_mutex_unlock(&cpu);
+    pthread_exit(NULL);
+}
+
+static void *task_entry(void *p) {
+    struct sim_task *t = p;
+    pthread_mutex_lock(&cpu);
+    current = t;
+    t->fn(t->arg);
+    // FreeRTOS tasks must not return; treat it like vTaskDelete(NULL)
+    finish_current();
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                       void *param, UBaseType_t priority, TaskHandle_t *handle) {
+    struct sim_task *t = calloc(1, sizeof(*t));
+    t->fn = fn;
+    t->arg = param;
+    strncpy(t->name, name, sizeof(t->name) - 1);
+    t->stack_depth = stack_depth;
+    t->state = TASK_RUNNING;
+    t->wake_at = NEVER;
+    pthread_cond_init(&t->cond, NULL);
+    t->next = tasks;
+    tasks = t;
+    running++;
+    if (handle) *handle = t;
+    pthread_create(&t->thread, NULL, task_entry, t);
+    pthread_detach(t->thread);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                                   void *param, UBaseType_t priority, TaskHandle_t *handle,
+                                   BaseType_t core_id) {
+    return xTaskCreate(fn, name, stack_depth, param, priority, handle);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (task == NULL || task == current) {
+        finish_current();
+    }
+    // A deleted task never runs again; its thread stays parked
+    task->deleted = true;
+    if (task->state == TASK_RUNNING) {
+        running--;
+        pthread_cond_broadcast(&idle_cond);
+    }
+    task->state = TASK_DONE;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (ticks == 0) return;
+    current->wake_at = now + ticks;
+    block_current();
+}
+
+void sim_hold_cpu(TickType_t ticks) {
+    if (ticks == 0) return;
+    // One held by another task at this tick goes first
+    held_until = after_hold(now) + ticks;
+    vTaskDelay(held_until - now);
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return now;
+}
+
+TickType_t xTaskGetTickCountFromISR(void) {
+    return now;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return current;
+}
+
+TaskHandle_t xTaskGetHandle(const char *name) {
+    for (struct sim_task *t = tasks; t; t = t->next) {
+        if (t->state != TASK_DONE && strcmp(t->name, name) == 0) return t;
+    }
+    return NULL;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    return task ? task->stack_depth : 0;
+}
+
+void vTaskSuspendAll(void) {
+}
+
+BaseType_t xTaskResumeAll(void) {
+    return pdFALSE;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+    BaseType_t ret = pdPASS;
+    switch (action) {
+        case eSetBits: task->notify_value |= value; break;
+        case eIncrement: task->notify_value++; break;
+        case eSetValueWithOverwrite: task->notify_value = value; break;
+        case eSetValueWithoutOverwrite:
+            if (task->notify_pending) ret = pdFAIL;
+            else task->notify_value = value;
+            break;
+        default: break;
+    }
+    task->notify_pending = true;
+    if (task->waiting_notify) {
+        wake(task);
+    }
+    return ret;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                              BaseType_t *higher_prio_woken) {
+    if (higher_prio_woken) *higher_prio_woken = pdFALSE;
+    return xTaskNotify(task, value, action);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    return xTaskNotify(task, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_prio_woken) {
+    if (higher_prio_woken) *higher_prio_woken = pdFALSE;
+    xTaskNotify(task, 0, eIncrement);
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                           uint32_t *value, TickType_t ticks) {
+    struct sim_task *t = current;
+    if (!t->notify_pending) {
+        t->notify_value &= ~clear_on_entry;
+        if (ticks > 0) {
+            t->waiting_notify = true;
+            t->wake_at = (ticks == portMAX_DELAY) ? NEVER : now + ticks;
+            block_current();
+        }
+    }
+    if (value) *value = t->notify_value;
+    if (!t->notify_pending) return pdFALSE;
+    t->notify_value &= ~clear_on_exit;
+    t->notify_pending = false;
+    return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks) {
+    struct sim_task *t = current;
+    if (t->notify_value == 0 && ticks > 0) {
+        t->waiting_notify = true;
+        t->wake_at = (ticks == portMAX_DELAY) ? NEVER : now + ticks;
+        block_current();
+    }
+    uint32_t value = t->notify_value;
+    if (value) {
+        t->notify_value = clear_on_exit ? 0 : value - 1;
+    }
+    t->notify_pending = false;
+    return value;
+}
+
+// --- Mutexes -------------------------------------------------------------
+
+struct sim_mutex {
+    bool held;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return calloc(1, sizeof(struct sim_mutex));
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    while (sem->held) {
+        if (ticks == 0) return pdFALSE;
+        assert(ticks == portMAX_DELAY && "timed mutex take");
+        current->waiting_mutex = sem;
+        current->wake_at = NEVER;
+        block_current();
+    }
+    sem->held = true;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    if (!sem->held) return pdFALSE;
+    sem->held = false;
+    for (struct sim_task *t = tasks; t; t = t->next) {
+        if (t->waiting_mutex == sem) {
+            t->waiting_mutex = NULL;
+            wake(t);
+            break;
+        }
+    }
+    return pdTRUE;
+}
+
+uint32_t sim_task_wakeups(const char *name) {
+    uint32_t total = 0;
+    for (struct sim_task *t = tasks; t; t = t->next) {
+        if (name == NULL || strcmp(t->name, name) == 0) total += t->wakeups;
+    }
+    return total;
+}
+
+uint32_t sim_timer_fires = 0;
+bool sim_timer_service_stalled = false;
+bool sim_timer_queue_full = false;
+
+void sim_reset_wakeups(void) {
+    for (struct sim_task *t = tasks; t; t = t->next) {
+        t->wakeups = 0;
+    }
+    sim_timer_fires = 0;
+}
+
+// --- Software timers -----------------------------------------------------
+
+static struct sim_timer *timer_new(const char *name) {
+    struct sim_timer *tm = calloc(1, sizeof(*tm));
+    strncpy(tm->name, name ? name : "", sizeof(tm->name) - 1);
+    tm->next = timers;
+    timers = tm;
+    return tm;
+}
+
+uint32_t sim_timers_created = 0;
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, UBaseType_t auto_reload,
+                           void *id, TimerCallbackFunction_t callback) {
+    sim_timers_created++;
+    struct sim_timer *tm = timer_new(name);
+    tm->period = period;
+    tm->auto_reload = auto_reload;
+    tm->id = id;
+    tm->callback = callback;
+    return tm;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t block) {
+    if (sim_timer_queue_full && !timer->is_esp_timer) return pdFAIL;
+    timer->active = true;
+    timer->expiry = now + timer->period;
+    return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t block) {
+    return xTimerStart(timer, block);
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t block) {
+    if (sim_timer_queue_full && !timer->is_esp_timer) return pdFAIL;
+    timer->active = false;
+    return pdPASS;
+}
+
+// Like FreeRTOS, changing the period also starts the timer
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t block) {
+    if (sim_timer_queue_full) return pdFAIL;
+    timer->period = period;
+    return xTimerStart(timer, block);
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t block) {
+    timer->active = false;
+    return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer) {
+    return timer->active ? pdTRUE : pdFALSE;
+}
+
+TickType_t xTimerGetExpiryTime(TimerHandle_t timer) {
+    return timer->expiry;
+}
+
+TickType_t xTimerGetPeriod(TimerHandle_t timer) {
+    return timer->period;
+}
+
+void *pvTimerGetTimerID(TimerHandle_t timer) {
+    return timer->id;
+}
+
+TaskHandle_t xTimerGetTimerDaemonTaskHandle(void) {
+    return NULL;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out) {
+    struct sim_timer *tm = timer_new(args->name);
+    tm->is_esp_timer = true;
+    tm->isr = args->dispatch_method == ESP_TIMER_ISR;
+    tm->esp_callback = args->callback;
+    tm->esp_arg = args->arg;
+    *out = tm;
+    return ESP_OK;
+}
+
+static TickType_t us_to_ticks(uint64_t us) {
+    TickType_t ticks = (TickType_t)((us + 999) / 1000);
+    return ticks ? ticks : 1;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    if (timer->active) return ESP_ERR_INVALID_STATE;
+    timer->period = us_to_ticks(timeout_us);
+    timer->auto_reload = false;
+    return xTimerStart(timer, 0) == pdPASS ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us) {
+    if (timer->active) return ESP_ERR_INVALID_STATE;
+    timer->period = us_to_ticks(period_us);
+    timer->auto_reload = true;
+    return xTimerStart(timer, 0) == pdPASS ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (!timer->active) return ESP_ERR_INVALID_STATE;
+    timer->active = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    timer->active = false;
+    return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer) {
+    return timer->active;
+}
+
+int64_t esp_timer_get_time(void) {
+    return (int64_t)now * 1000;
+}
+
+// --- Virtual time ----------------------------------------------------------
+
+// Software timers wait while the timer service is stalled, and all but
+// ISR-dispatched esp_timers wait for a hold to end
+static bool timer_waits(const struct sim_timer *tm) {
+    return !tm->is_esp_timer && sim_timer_service_stalled;
+}
+
+static TickType_t timer_due(const struct sim_timer *tm) {
+    return tm->isr ? tm->expiry : after_hold(tm->expiry);
+}
+
+static TickType_t next_event(TickType_t limit) {
+    TickType_t next = limit;
+    for (struct sim_timer *tm = timers; tm; tm = tm->next) {
+        if (tm->active && !timer_waits(tm) && timer_due(tm) < next) next = timer_due(tm);
+    }
+    for (struct sim_task *t = tasks; t; t = t->next) {
+        if (t->state == TASK_BLOCKED && !t->deleted && after_hold(t->wake_at) < next) next = after_hold(t->wake_at);
+    }
+    return next;
+}
+
+static void fire_due(void) {
+    // Callbacks run in the main context, like the timer service task
+    for (struct sim_timer *tm = timers; tm; tm = tm->next) {
+        if (!tm->active || timer_waits(tm) || timer_due(tm) > now) continue;
+        if (tm->auto_reload) {
+            tm->expiry = now + tm->period;
+        } else {
+            tm->active = false;
+        }
+        sim_timer_fires++;
+        if (tm->is_esp_timer) {
+            tm->esp_callback(tm->esp_arg);
+        } else {
+            tm->callback(tm);
+        }
+    }
+    for (struct sim_task *t = tasks; t; t = t->next) {
+        if (t->state == TASK_BLOCKED && after_hold(t->wake_at) <= now) {
+            wake(t);
+        }
+    }
+}
+
+void sim_advance(TickType_t ticks) {
+    TickType_t target = now + ticks;
+    for (;;) {
+        sim_idle();
+        TickType_t next = next_event(target);
+        if (next > now) now = next;
+        fire_due();
+        if (now >= target && next_event(NEVER) > now && running == 0) {
+            sim_idle();
+            if (next_event(NEVER) > now) break;
+        }
+    }
+}
@@ -119,55 +119,96 @@ function adjustTimerDuration(id, delta) {
 async function updateStatus() {
     try {
         const response = await fetch('/api/status');
-        const data = await response.json();
+        applyStatus(await response.json());
+    } catch (error) {
+        console.error('Status update error:', error);
+    }
+}
 
-        data.relays.forEach(relay => {
-            if (relay.mode === 'timed' && relay.rem > 0) {
-                const expireAt = Date.now() + (relay.rem * 1000);
-                localStorage.setItem(`expire-${relay.id}`, expireAt);
-            }
-            updateRelayUI(relay.id, relay.state, relay.mode, relay.rem);
-        });
+// Applies a full /api/status response or a partial event from /api/events
+function applyStatus(data) {
+    createRelayCards(data.relays.reduce((n, relay) => Math.max(n, relay.id + 1), relayCount));
+    data.relays.forEach(relay => {
+        if (relay.mode === 'timed' && relay.rem > 0) {
+            const expireAt = Date.now() + (relay.rem * 1000);
+            localStorage.setItem(`expire-${relay.id}`, expireAt);
+        }
+        updateRelayUI(relay.id, relay.state, relay.mode, relay.rem);
+    });
 
-        // Update routine UI
-        if (data.routine) {
-            const wasRunning = activeRoutineId !== null;
-            const isRunning = data.routine.running;
-            
-            // Find which local routine matches the name (best effort)
-            const routineIndex = routines.findIndex(r => r.name === data.routine.name);
-            activeRoutineId = isRunning ? routineIndex : null;
+    // Update routine UI
+    if (data.routine) {
+        const wasRunning = activeRoutineId !== null;
+        const isRunning = data.routine.running;
+        
+        // Find which local routine matches the name (best effort)
+        const routineIndex = routines.findIndex(r => r.name === data.routine.name);
+        activeRoutineId = isRunning ? routineIndex : null;
 
-            if (wasRunning && !isRunning) {
-                showToast(`Routine completed!`, "success");
-            }
-            
-            renderRoutines();
-            
-            if (isRunning && routineIndex !== -1) {
-                const statusEl = document.getElementById(`routine-status-${routineIndex}`);
-                if (statusEl) {
-                    const current = data.routine.currentStep;
-                    const steps = data.routine.steps;
-                    const stepName = steps[current] ? steps[current].name : '?';
-                    statusEl.innerHTML = `
-                        <div class="routine-progress">
-                            <span class="step-active">Active: ${stepName} (${current + 1}/${data.routine.numSteps})</span>
-                            <div class="step-list-mini">
-                                ${steps.map((s, i) => `
-                                    <span class="step-dot ${i < current ? 'done' : (i === current ? 'busy' : 'todo')}" title="${s.name}"></span>
-                                `).join('')}
-                            </div>
+        if (wasRunning && !isRunning) {
+            showToast(`Routine completed!`, "success");
+        }
+        
+        renderRoutines();
+        
+        if (isRunning && routineIndex !== -1) {
+            const statusEl = document.getElementById(`routine-status-${routineIndex}`);
+            if (statusEl) {
+                // Several steps can water at once
+                const active = data.routine.activeSteps || [];
+                const done = data.routine.doneSteps || [];
+                const steps = data.routine.steps;
+                const stepNames = active.map(i => steps[i] ? steps[i].name : '?').join(', ') || '-';
+                statusEl.innerHTML = `
+                    <div class="routine-progress">
+                        <span class="step-active">Active: ${stepNames} (${done.length}/${data.routine.numSteps} done)</span>
+                        <div class="step-list-mini">
+                            ${steps.map((s, i) => `
+                                <span class="step-dot ${done.includes(i) ? 'done' : (active.includes(i) ? 'busy' : 'todo')}" title="${s.name}"></span>
+                            `).join('')}
                         </div>
-                    `;
-                }
+                    </div>
+                `;
             }
         }
-    } catch (error) {
-        console.error('Status update error:', error);
     }
 }
 
+// Live updates: the device pushes state changes over Server-Sent Events.
+// Polling only runs while the stream is down.
+let pollTimer = null;
+
+function startPolling() {
+    if (!pollTimer) {
+        pollTimer = setInterval(updateStatus, 10000); // Check ESP every 10s
+    }
+}
+
+function stopPolling() {
+    if (pollTimer) {
+        clearInterval(pollTimer);
+        pollTimer = null;
+    }
+}
+
+function connectEvents() {
+    if (!window.EventSource) {
+        startPolling();
+        return;
+    }
+    const events = new EventSource('/api/events');
+    events.onopen = () => stopPolling();
+    events.addEventListener('state', e => applyStatus(JSON.parse(e.data)));
+    events.addEventListener('resync', () => updateStatus());
+    // EventSource reconnects on its own; poll until it does
+    events.onerror = () => {
+        startPolling();
+        if (events.readyState === EventSource.CLOSED) {
+            setTimeout(connectEvents, 10000);
+        }
+    };
+}
+
 let routines = [];
 let activeRoutineId = null;
 let stopRequested = false;
@@ -262,18 +303,23 @@ async function runRoutine(index) {
     }
 }
 
-function createRelayCards() {
+// Cards on the page; /api/status lists every zone in use
+let relayCount = 0;
+
+// Adds cards up to `count` relays
+function createRelayCards(count) {
     const container = document.getElementById('relays');
     const lastDuration = localStorage.getItem('lastDurationMinutes') || 10;
 
-    for (let i = 0; i < 4; i++) {
+    for (; relayCount < count; relayCount++) {
+        const i = relayCount;
         const card = document.createElement('div');
         card.className = 'card';
         card.id = 'relay-' + i;
 
         card.innerHTML = `
             <div class="relay-header">
-                <span class="relay-name">${RELAY_NAMES[i]}</span>
+                <span class="relay-name">${zoneName(i)}</span>
                 <div class="status-group">
                     <button class="btn-timer-trigger" onclick="showModal(${i})" title="Timed ON">
                         <svg viewBox="0 0 24 24" width="18" height="18" fill="none" stroke="currentColor" stroke-width="2">
@@ -292,7 +338,7 @@ function createRelayCards() {
             <div id="modal-${i}" class="modal-overlay" onclick="if(event.target===this)closeModal(${i})">
                 <div class="modal">
                     <h3>Set Timer (min)</h3>
-                    <div class="step-name" style="margin-bottom: 10px;">${RELAY_NAMES[i]}</div>
+                    <div class="step-name" style="margin-bottom: 10px;">${zoneName(i)}</div>
                     <div id="modal-rem-${i}" class="modal-remaining"></div>
                     <div class="step-controls" style="justify-content: center; margin-bottom: 20px;">
                         <button class="btn-step-adjust" onclick="adjustTimerDuration(${i}, -1)">-</button>
@@ -313,14 +359,13 @@ function createRelayCards() {
 
 // Initialize on load
 document.addEventListener('DOMContentLoaded', () => {
-    createRelayCards();
     updateStatus();
     fetchRoutines();
-    setInterval(updateStatus, 10000); // Check ESP every 10s
+    connectEvents();
     
     // Smooth countdown local update
     setInterval(() => {
-        for(let i=0; i<4; i++) {
+        for (let i = 0; i < relayCount; i++) {
             const status = document.getElementById('status-' + i);
             if (status && status.classList.contains('on')) {
                 // Check if we have an expiration time for this relay
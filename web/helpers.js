@@ -1,6 +1,11 @@
 // Relay configuration
 const RELAY_NAMES = ['Plants', 'Grass', 'Patio Grass', 'Front Lawn'];
 
+// Zones past the named ones are numbered
+function zoneName(id) {
+    return RELAY_NAMES[id] || `Zone ${id + 1}`;
+}
+
 // Toast notification system
 function showToast(message, type = 'error') {
     let toastContainer = document.getElementById('toast-container');
@@ -7,6 +7,18 @@ const ICONS = {
     trash: `<svg viewBox="0 0 24 24" width="16" height="16" fill="none" stroke="currentColor" stroke-width="2" stroke-linecap="round" stroke-linejoin="round"><polyline points="3 6 5 6 21 6"></polyline><path d="M19 6v14a2 2 0 0 1-2 2H7a2 2 0 0 1-2-2V6m3 0V4a2 2 0 0 1 2-2h4a2 2 0 0 1 2 2v2"></path><line x1="10" y1="11" x2="10" y2="17"></line><line x1="14" y1="11" x2="14" y2="17"></line></svg>`
 };
 
+// Zones to pick from, from /api/zones
+let zoneCount = RELAY_NAMES.length;
+
+async function fetchZoneCount() {
+    try {
+        const response = await fetch('/api/zones');
+        if (response.ok) zoneCount = (await response.json()).count;
+    } catch (e) {
+        console.error("Failed to fetch zones", e);
+    }
+}
+
 async function fetchRoutines() {
     try {
         const response = await fetch('/api/routines');
@@ -155,13 +167,14 @@ function adjustDuration(order, delta) {
 function showStationPicker() {
     const options = document.getElementById('station-options');
     options.innerHTML = '';
-    RELAY_NAMES.forEach((name, id) => {
+    for (let id = 0; id < zoneCount; id++) {
+        const name = zoneName(id);
         const div = document.createElement('div');
         div.className = 'station-option';
         div.textContent = name;
         div.onclick = () => addStep(id, name);
         options.appendChild(div);
-    });
+    }
     document.getElementById('station-modal').style.display = 'flex';
 }
 
@@ -276,11 +289,16 @@ async function saveRoutines() {
         if (response.ok) {
             showToast("Routines saved", "success");
         } else {
-            showToast("Failed to save routines, error was: " + response.statusText);
+            // The server explains what was wrong with the routines
+            const reason = await response.text();
+            showToast("Failed to save routines: " + (reason || response.statusText));
         }
     } catch (e) {
         showToast("Error saving routines: " + e.message);
     }
 }
 
-document.addEventListener('DOMContentLoaded', fetchRoutines);
+document.addEventListener('DOMContentLoaded', () => {
+    fetchZoneCount();
+    fetchRoutines();
+});
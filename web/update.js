@@ -1,4 +1,66 @@
 
+const SHA256_K = [
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+];
+
+// SHA-256 of an ArrayBuffer as hex, sent as X-SHA256 so the device can
+// check the image before committing it. crypto.subtle only exists on
+// HTTPS and localhost, not on the device's own page, hence the fallback.
+async function sha256Hex(buf) {
+    const hex = words => Array.from(words, w => (w >>> 0).toString(16).padStart(8, '0')).join('');
+    if (window.crypto && crypto.subtle) {
+        const d = new DataView(await crypto.subtle.digest('SHA-256', buf));
+        return hex(Array.from({ length: 8 }, (_, i) => d.getUint32(i * 4)));
+    }
+
+    const len = buf.byteLength;
+    const data = new Uint8Array(((len + 72) >> 6) << 6);
+    data.set(new Uint8Array(buf));
+    data[len] = 0x80;
+    const view = new DataView(data.buffer);
+    view.setUint32(data.length - 8, Math.floor(len / 0x20000000));
+    view.setUint32(data.length - 4, (len << 3) >>> 0);
+
+    const rotr = (x, n) => (x >>> n) | (x << (32 - n));
+    const h = [0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19];
+    const w = new Uint32Array(64);
+    for (let off = 0; off < data.length; off += 64) {
+        for (let i = 0; i < 16; i++) w[i] = view.getUint32(off + i * 4);
+        for (let i = 16; i < 64; i++) {
+            const s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >>> 3);
+            const s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >>> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        let [a, b, c, d, e, f, g, k] = h;
+        for (let i = 0; i < 64; i++) {
+            const t1 = (k + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i]) | 0;
+            const t2 = ((rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c))) | 0;
+            k = g; g = f; f = e; e = (d + t1) | 0;
+            d = c; c = b; b = a; a = (t1 + t2) | 0;
+        }
+        [a, b, c, d, e, f, g, k].forEach((v, i) => { h[i] = (h[i] + v) | 0; });
+    }
+    return hex(h);
+}
+
+// A .gz image from pack_ota.js is sent as is and inflated by the device,
+// which checks X-SHA256 against the inflated image. Without
+// DecompressionStream the digest is left out; gzip's own CRC still
+// catches a damaged upload.
+async function imageDigest(image, gzip) {
+    if (!gzip) return sha256Hex(image);
+    if (!window.DecompressionStream) return null;
+    const stream = new Blob([image]).stream().pipeThrough(new DecompressionStream('gzip'));
+    return sha256Hex(await new Response(stream).arrayBuffer());
+}
+
 async function startOTA() {
     const fileInput = document.getElementById('ota-file');
     const typeInput = document.querySelector('input[name="update-type"]:checked');
@@ -23,8 +85,24 @@ async function startOTA() {
     btn.classList.add('loading');
     progressContainer.style.display = 'block';
     
+    const image = await file.arrayBuffer();
+    const head = new Uint8Array(image, 0, Math.min(2, image.byteLength));
+    const gzip = head[0] === 0x1f && head[1] === 0x8b;
+    let digest;
+    try {
+        digest = await imageDigest(image, gzip);
+    } catch (e) {
+        showToast('The file is not a valid gzip image.');
+        btn.disabled = false;
+        btn.classList.remove('loading');
+        progressContainer.style.display = 'none';
+        return;
+    }
+
     const xhr = new XMLHttpRequest();
     xhr.open('POST', `/api/ota?type=${type === 'spiffs' ? 'spiffs' : 'app'}`, true);
+    if (gzip) xhr.setRequestHeader('Content-Encoding', 'gzip');
+    if (digest) xhr.setRequestHeader('X-SHA256', digest);
     
     xhr.upload.onprogress = (e) => {
         if (e.lengthComputable) {
@@ -57,5 +135,5 @@ async function startOTA() {
         btn.classList.remove('loading');
     };
     
-    xhr.send(file);
+    xhr.send(image);
 }